@@ -123,6 +123,13 @@
  */
 
 
+/*
+ * Unsat cores are not minimized by default
+ */
+#define DEFAULT_MINIMIZE_CORE     false
+#define DEFAULT_CORE_MIN_TIMEOUT  0.0
+
+
 /*
  * All default parameters
  */
@@ -165,6 +172,9 @@ static const param_t default_settings = {
 
   DEFAULT_MAX_UPDATE_CONFLICTS,
   DEFAULT_MAX_EXTENSIONALITY,
+
+  DEFAULT_MINIMIZE_CORE,
+  DEFAULT_CORE_MIN_TIMEOUT,
 };
 
 
@@ -221,9 +231,12 @@ typedef enum param_key {
   // array solver
   PARAM_MAX_UPDATE_CONFLICTS,
   PARAM_MAX_EXTENSIONALITY,
+  // unsat cores
+  PARAM_MINIMIZE_CORE,
+  PARAM_CORE_MIN_TIMEOUT,
 } param_key_t;
 
-#define NUM_PARAM_KEYS (PARAM_MAX_EXTENSIONALITY+1)
+#define NUM_PARAM_KEYS (PARAM_CORE_MIN_TIMEOUT+1)
 
 // parameter names in lexicographic ordering
 static const char *const param_key_names[NUM_PARAM_KEYS] = {
@@ -235,6 +248,7 @@ static const char *const param_key_names[NUM_PARAM_KEYS] = {
   "c-threshold",
   "cache-tclauses",
   "clause-decay",
+  "core-min-timeout",
   "d-factor",
   "d-threshold",
   "dyn-ack",
@@ -249,6 +263,7 @@ static const char *const param_key_names[NUM_PARAM_KEYS] = {
   "max-extensionality",
   "max-interface-eqs",
   "max-update-conflicts",
+  "minimize-core",
   "optimistic-final-check",
   "prop-threshold",
   "r-factor",
@@ -272,6 +287,7 @@ static const int32_t param_code[NUM_PARAM_KEYS] = {
   PARAM_C_THRESHOLD,
   PARAM_CACHE_TCLAUSES,
   PARAM_CLAUSE_DECAY,
+  PARAM_CORE_MIN_TIMEOUT,
   PARAM_D_FACTOR,
   PARAM_D_THRESHOLD,
   PARAM_DYN_ACK,
@@ -286,6 +302,7 @@ static const int32_t param_code[NUM_PARAM_KEYS] = {
   PARAM_MAX_EXTENSIONALITY,
   PARAM_MAX_INTERFACE_EQS,
   PARAM_MAX_UPDATE_CONFLICTS,
+  PARAM_MINIMIZE_CORE,
   PARAM_OPTIMISTIC_FCHECK,
   PARAM_PROP_THRESHOLD,
   PARAM_R_FACTOR,
@@ -685,6 +702,14 @@ int32_t params_set_field(param_t *parameters, const char *key, const char *value
     }
     break;
 
+  case PARAM_MINIMIZE_CORE:
+    r = set_bool_param(value, &parameters->minimize_core);
+    break;
+
+  case PARAM_CORE_MIN_TIMEOUT:
+    r = set_double_param(value, &parameters->core_min_timeout, 0.0, DBL_MAX);
+    break;
+
   default:
     assert(k == -1);
     r = -1;
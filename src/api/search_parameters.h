@@ -170,6 +170,17 @@ struct param_s {
   uint32_t max_update_conflicts;
   uint32_t max_extensionality;
 
+  /*
+   * UNSAT CORES
+   * - minimize_core: if true, check with assumptions reduces the unsat
+   *   core to a minimal one before returning UNSAT
+   * - core_min_timeout: CPU time budget for this minimization in
+   *   seconds (0.0 means no limit). When the budget is exhausted,
+   *   the smallest core found so far is kept.
+   */
+  bool     minimize_core;
+  double   core_min_timeout;
+
 };
 
 
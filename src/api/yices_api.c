@@ -70,6 +70,8 @@
 #include "api/yval.h"
 
 #include "context/context.h"
+#include "context/context_telemetry.h"
+#include "context/mus_enumerator.h"
 
 #include "exists_forall/ef_client.h"
 
@@ -80,6 +82,7 @@
 #include "io/type_printer.h"
 #include "io/yices_pp.h"
 
+#include "model/eval_plan.h"
 #include "model/generalization.h"
 #include "model/literal_collector.h"
 #include "model/map_to_model.h"
@@ -296,6 +299,20 @@ static yices_lock_t model_list_lock;
 #endif
 
 
+/*
+ * Evaluation plans
+ */
+typedef struct {
+  dl_list_t header;
+  eval_plan_t plan;
+} eval_plan_elem_t;
+
+static dl_list_t eval_plan_list;
+#ifdef THREAD_SAFE
+static yices_lock_t eval_plan_list_lock;
+#endif
+
+
 /*
  * Context configurations
  */
@@ -331,6 +348,7 @@ static inline void init_list_locks(void){
   create_yices_lock(&bvlogic_buffer_list_lock);
   create_yices_lock(&context_list_lock);
   create_yices_lock(&model_list_lock);
+  create_yices_lock(&eval_plan_list_lock);
   create_yices_lock(&config_list_lock);
   create_yices_lock(&parameter_list_lock);
 #endif
@@ -344,6 +362,7 @@ static inline void delete_list_locks(void){
   destroy_yices_lock(&bvlogic_buffer_list_lock);
   destroy_yices_lock(&context_list_lock);
   destroy_yices_lock(&model_list_lock);
+  destroy_yices_lock(&eval_plan_list_lock);
   destroy_yices_lock(&config_list_lock);
   destroy_yices_lock(&parameter_list_lock);
 #endif
@@ -358,6 +377,7 @@ static inline void get_list_locks(void){
   get_yices_lock(&bvlogic_buffer_list_lock);
   get_yices_lock(&context_list_lock);
   get_yices_lock(&model_list_lock);
+  get_yices_lock(&eval_plan_list_lock);
   get_yices_lock(&config_list_lock);
   get_yices_lock(&parameter_list_lock);
 #endif
@@ -372,6 +392,7 @@ static inline void release_list_locks(void){
   release_yices_lock(&bvlogic_buffer_list_lock);
   release_yices_lock(&context_list_lock);
   release_yices_lock(&model_list_lock);
+  release_yices_lock(&eval_plan_list_lock);
   release_yices_lock(&config_list_lock);
   release_yices_lock(&parameter_list_lock);
 #endif
@@ -791,6 +812,78 @@ static void free_model_list(void) {
 
 
 
+/*
+ * EVALUATION PLANS
+ */
+
+/*
+ * Get header of plan p
+ */
+static inline dl_list_t *header_of_eval_plan(eval_plan_t *p) {
+  return (dl_list_t *)(((char *) p) - offsetof(eval_plan_elem_t, plan));
+}
+
+/*
+ * Get the plan of header l
+ */
+static inline eval_plan_t *eval_plan_of_header(dl_list_t *l) {
+  return (eval_plan_t *) (((char *) l) + offsetof(eval_plan_elem_t, plan));
+}
+
+/*
+ * Allocate a fresh plan and insert it in the eval_plan_list
+ * - WARNING: the plan is not initialized
+ */
+static inline eval_plan_t *_o_alloc_eval_plan(void) {
+  eval_plan_elem_t *new_elem;
+
+  new_elem = (eval_plan_elem_t *) safe_malloc(sizeof(eval_plan_elem_t));
+  list_insert_next(&eval_plan_list, &new_elem->header);
+  return &new_elem->plan;
+}
+
+static eval_plan_t *alloc_eval_plan(void) {
+  MT_PROTECT(eval_plan_t *, eval_plan_list_lock, _o_alloc_eval_plan());
+}
+
+
+/*
+ * Remove p from the list and free p
+ * - WARNING: make sure to call delete_eval_plan(p) before this
+ *   function
+ */
+static inline void _o_free_eval_plan(eval_plan_t *p) {
+  dl_list_t *elem;
+
+  elem = header_of_eval_plan(p);
+  list_remove(elem);
+  safe_free(elem);
+}
+
+static inline void free_eval_plan(eval_plan_t *p) {
+  MT_PROTECT_VOID(eval_plan_list_lock, _o_free_eval_plan(p));
+}
+
+
+/*
+ * Cleanup the plan list
+ */
+static void free_eval_plan_list(void) {
+  dl_list_t *elem, *aux;
+
+  elem = eval_plan_list.next;
+  while (elem != &eval_plan_list) {
+    aux = elem->next;
+    delete_eval_plan(eval_plan_of_header(elem));
+    safe_free(elem);
+    elem = aux;
+  }
+
+  clear_list(&eval_plan_list);
+}
+
+
+
 
 /********************************************
  *  CONFIG AND SEARCH PARAMETER STRUCTURES  *
@@ -1084,6 +1177,7 @@ EXPORTED void yices_init(void) {
   // other dynamic object lists
   clear_list(&context_list);
   clear_list(&model_list);
+  clear_list(&eval_plan_list);
   clear_list(&config_list);
   clear_list(&parameter_list);
 
@@ -1125,6 +1219,7 @@ EXPORTED void yices_exit(void) {
 
   free_context_list();
   free_model_list();
+  free_eval_plan_list();
   free_config_list();
   free_parameter_list();
 
@@ -6372,7 +6467,7 @@ int32_t _o_yices_pp_term(FILE *f, term_t t, uint32_t width, uint32_t height, uin
   area.truncate = true;
 
   init_default_yices_pp(&printer, f, &area);
-  pp_term_full(&printer, __yices_globals.terms, t);
+  pp_term_dag(&printer, __yices_globals.terms, t);
   flush_yices_pp(&printer);
 
   // check for error
@@ -6437,7 +6532,7 @@ int32_t _o_yices_pp_term_array(FILE *f, uint32_t n, const term_t a[], uint32_t w
   }
 
   for (i=0; i<n; i++) {
-    pp_term_full(&printer, __yices_globals.terms, a[i]);
+    pp_term_dag(&printer, __yices_globals.terms, a[i]);
   }
   flush_yices_pp(&printer);
 
@@ -6530,7 +6625,7 @@ char *_o_yices_term_to_string(term_t t, uint32_t width, uint32_t height, uint32_
   area.truncate = true;
 
   init_default_yices_pp(&printer, NULL, &area);
-  pp_term_full(&printer, __yices_globals.terms, t);
+  pp_term_dag(&printer, __yices_globals.terms, t);
   flush_yices_pp(&printer);
 
   str = yices_pp_get_string(&printer, &len);
@@ -9387,6 +9482,29 @@ EXPORTED void yices_stop_search(context_t *ctx) {
 }
 
 
+/*
+ * Telemetry callback
+ */
+EXPORTED int32_t yices_set_context_telemetry(context_t *ctx, void (*callback)(void *aux, const char *sample),
+                                             void *aux, double period) {
+  if (ctx->mcsat != NULL) {
+    set_error_code(CTX_OPERATION_NOT_SUPPORTED);
+    return -1;
+  }
+  if (period < 0.0) {
+    set_error_code(CTX_INVALID_PARAMETER_VALUE);
+    return -1;
+  }
+
+  if (callback == NULL) {
+    context_disable_telemetry(ctx);
+  } else {
+    context_enable_telemetry(ctx, NULL, callback, aux, period);
+  }
+  return 0;
+}
+
+
 
 /****************
  *  UNSAT CORE  *
@@ -9409,6 +9527,332 @@ EXPORTED int32_t yices_get_unsat_core(context_t *ctx, term_vector_t *v) {
 }
 
 
+/*
+ * Enumeration of MUSes and MCSes: convert indices to terms
+ * before calling the user's callback.
+ * - fun, aux = user's callback
+ * - t = assumption array
+ * - buffer = to store the terms
+ */
+typedef struct mus_mcs_callback_s {
+  int32_t (*fun)(void *aux, int32_t is_mus, uint32_t n, const term_t s[]);
+  void *aux;
+  const term_t *t;
+  ivector_t buffer;
+} mus_mcs_callback_t;
+
+static bool mus_mcs_report(void *data, bool is_mus, uint32_t n, const uint32_t *idx) {
+  mus_mcs_callback_t *cb;
+  uint32_t i;
+
+  cb = data;
+  ivector_reset(&cb->buffer);
+  for (i=0; i<n; i++) {
+    ivector_push(&cb->buffer, cb->t[idx[i]]);
+  }
+  return cb->fun(cb->aux, is_mus, n, cb->buffer.data) == 0;
+}
+
+EXPORTED smt_status_t yices_enumerate_mus_mcs(context_t *ctx, const param_t *params, uint32_t n, const term_t t[],
+                                              int32_t (*callback)(void *aux, int32_t is_mus, uint32_t n, const term_t s[]),
+                                              void *aux) {
+  param_t default_params;
+  mus_mcs_callback_t cb;
+  ivector_t assumptions;
+  smt_status_t stat;
+  uint32_t i;
+  literal_t l;
+
+  if (!unsat_core_check_assumptions(n, t)) {
+    return STATUS_ERROR; // Bad assumptions
+  }
+
+  if (ctx->mcsat != NULL || ! context_supports_multichecks(ctx)) {
+    set_error_code(CTX_OPERATION_NOT_SUPPORTED);
+    return STATUS_ERROR;
+  }
+
+  // cleanup
+  switch (context_status(ctx)) {
+  case STATUS_UNKNOWN:
+  case STATUS_SAT:
+    context_clear(ctx);
+    break;
+
+  case STATUS_IDLE:
+    break;
+
+  case STATUS_UNSAT:
+    context_clear_unsat(ctx);
+    if (context_status(ctx) == STATUS_UNSAT) {
+      // the only MUS is the empty set
+      callback(aux, true, 0, NULL);
+      return STATUS_UNSAT;
+    }
+    break;
+
+  case STATUS_SEARCHING:
+  case STATUS_INTERRUPTED:
+    set_error_code(CTX_INVALID_OPERATION);
+    return STATUS_ERROR;
+
+  case STATUS_ERROR:
+  default:
+    set_error_code(INTERNAL_EXCEPTION);
+    return STATUS_ERROR;
+  }
+
+  assert(context_status(ctx) == STATUS_IDLE);
+
+  yices_obtain_mutex();
+
+  // convert the assumptions to n literals
+  init_ivector(&assumptions, n);
+  for (i=0; i<n; i++) {
+    l = context_add_assumption(ctx, t[i]);
+    if (l < 0) {
+      // error when converting t[i] to a literal
+      convert_internalization_error(l);
+      stat = STATUS_ERROR;
+      yices_release_mutex();
+      goto cleanup;
+    }
+    ivector_push(&assumptions, l);
+  }
+  assert(assumptions.size == n);
+
+  yices_release_mutex();
+
+  // set parameters
+  if (params == NULL) {
+    yices_default_params_for_context(ctx, &default_params);
+    params = &default_params;
+  }
+
+  cb.fun = callback;
+  cb.aux = aux;
+  cb.t = t;
+  init_ivector(&cb.buffer, 0);
+  stat = enumerate_mus_mcs(ctx, params, n, assumptions.data, mus_mcs_report, &cb);
+  delete_ivector(&cb.buffer);
+
+  if (stat == STATUS_INTERRUPTED && context_status(ctx) == STATUS_INTERRUPTED && context_supports_cleaninterrupt(ctx)) {
+    context_cleanup(ctx);
+  }
+
+ cleanup:
+  delete_ivector(&assumptions);
+
+  return stat;
+}
+
+
+/*
+ * MODEL ENUMERATION
+ */
+static bool _o_enumerate_models_check_terms(uint32_t n, const term_t t[]) {
+  term_table_t *terms;
+  uint32_t i;
+
+  if (! check_good_terms(__yices_globals.manager, n, t)) {
+    return false;
+  }
+  terms = __yices_globals.terms;
+  for (i=0; i<n; i++) {
+    if (! is_boolean_term(terms, t[i]) && ! check_bitvector_term(__yices_globals.manager, t[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static bool enumerate_models_check_terms(uint32_t n, const term_t t[]) {
+  MT_PROTECT(bool,  __yices_globals.lock, _o_enumerate_models_check_terms(n, t));
+}
+
+
+/*
+ * Convert the projection terms t[0 ... n-1] to literals in ctx:
+ * one literal per Boolean term and one literal per bit of each
+ * bitvector term. The literals are added to v.
+ * - return a negative code if a term can't be internalized
+ * - return 0 otherwise
+ */
+static int32_t projection_literals(context_t *ctx, uint32_t n, const term_t t[], ivector_t *v) {
+  term_table_t *terms;
+  uint32_t i, j, k;
+  literal_t l;
+
+  terms = __yices_globals.terms;
+  for (i=0; i<n; i++) {
+    if (is_boolean_term(terms, t[i])) {
+      l = context_internalize(ctx, t[i]);
+      if (l < 0) return l;
+      ivector_push(v, l);
+    } else {
+      k = term_bitsize(terms, t[i]);
+      for (j=0; j<k; j++) {
+	l = context_internalize(ctx, mk_bitextract(__yices_globals.manager, t[i], j));
+	if (l < 0) return l;
+	ivector_push(v, l);
+      }
+    }
+  }
+  return 0;
+}
+
+
+/*
+ * Model enumeration: build a model before calling the user's callback.
+ * - fun, aux = user's callback
+ */
+typedef struct model_callback_s {
+  int32_t (*fun)(void *aux, model_t *mdl);
+  void *aux;
+} model_callback_t;
+
+static bool model_report(void *data, context_t *ctx) {
+  model_callback_t *cb;
+  model_t mdl;
+  int32_t code;
+
+  cb = data;
+  yices_obtain_mutex();
+  init_model(&mdl, __yices_globals.terms, true);
+  context_build_model(&mdl, ctx);
+  yices_release_mutex();
+
+  code = cb->fun(cb->aux, &mdl);
+
+  yices_obtain_mutex();
+  delete_model(&mdl);
+  yices_release_mutex();
+
+  return code == 0;
+}
+
+
+/*
+ * Enumerate the models of ctx projected on t[0 ... n-1]
+ * - the enumeration is done between a push and a pop so ctx is
+ *   unchanged on exit (unless the search is interrupted and
+ *   ctx doesn't support clean interrupts).
+ */
+EXPORTED smt_status_t yices_enumerate_models(context_t *ctx, const param_t *params, uint32_t n, const term_t t[],
+                                             int32_t (*callback)(void *aux, model_t *mdl), void *aux,
+                                             uint64_t *count) {
+  param_t default_params;
+  model_callback_t cb;
+  ivector_t proj;
+  uint64_t models;
+  smt_status_t stat;
+  int32_t code;
+
+  if (count != NULL) {
+    *count = 0;
+  }
+
+  if (! enumerate_models_check_terms(n, t)) {
+    return STATUS_ERROR;
+  }
+
+  if (ctx->mcsat != NULL || ! context_supports_pushpop(ctx)) {
+    set_error_code(CTX_OPERATION_NOT_SUPPORTED);
+    return STATUS_ERROR;
+  }
+
+  // cleanup
+  switch (context_status(ctx)) {
+  case STATUS_UNKNOWN:
+  case STATUS_SAT:
+    context_clear(ctx);
+    break;
+
+  case STATUS_IDLE:
+    break;
+
+  case STATUS_UNSAT:
+    context_clear_unsat(ctx);
+    if (context_status(ctx) == STATUS_UNSAT) {
+      // no model
+      return STATUS_UNSAT;
+    }
+    break;
+
+  case STATUS_SEARCHING:
+  case STATUS_INTERRUPTED:
+    set_error_code(CTX_INVALID_OPERATION);
+    return STATUS_ERROR;
+
+  case STATUS_ERROR:
+  default:
+    set_error_code(INTERNAL_EXCEPTION);
+    return STATUS_ERROR;
+  }
+
+  assert(context_status(ctx) == STATUS_IDLE);
+  context_push(ctx);
+
+  models = 0;
+  init_ivector(&proj, n);
+
+  yices_obtain_mutex();
+  code = projection_literals(ctx, n, t, &proj);
+  yices_release_mutex();
+
+  if (code < 0) {
+    // error when converting a term to literals
+    convert_internalization_error(code);
+    stat = STATUS_ERROR;
+  } else {
+    // set parameters
+    if (params == NULL) {
+      yices_default_params_for_context(ctx, &default_params);
+      params = &default_params;
+    }
+    if (callback == NULL) {
+      stat = enumerate_models(ctx, params, proj.size, proj.data, NULL, NULL, &models);
+    } else {
+      cb.fun = callback;
+      cb.aux = aux;
+      stat = enumerate_models(ctx, params, proj.size, proj.data, model_report, &cb, &models);
+    }
+  }
+
+  // remove the blocking clauses
+  switch (context_status(ctx)) {
+  case STATUS_UNKNOWN:
+  case STATUS_SAT:
+    context_clear(ctx);
+    break;
+
+  case STATUS_UNSAT:
+    context_clear_unsat(ctx);
+    break;
+
+  case STATUS_INTERRUPTED:
+    if (! context_supports_cleaninterrupt(ctx)) {
+      // ctx can't be restored: it must be reset
+      goto done;
+    }
+    context_cleanup(ctx);
+    break;
+
+  default:
+    break;
+  }
+  context_pop(ctx);
+
+ done:
+  delete_ivector(&proj);
+  if (count != NULL) {
+    *count = models;
+  }
+
+  return stat;
+}
+
+
 /**********************
  * MODEL INTERPOLANT  *
  *********************/
@@ -11866,6 +12310,75 @@ int32_t _o_yices_formulas_true_in_model(model_t *mdl, uint32_t n, const term_t f
 }
 
 
+/*
+ * Evaluation plan for formulas f[0 ... n-1]
+ * - return NULL if one f[i] is not a Boolean term
+ */
+EXPORTED eval_plan_t *yices_new_eval_plan(uint32_t n, const term_t f[]) {
+  MT_PROTECT(eval_plan_t *,  __yices_globals.lock, _o_yices_new_eval_plan(n, f));
+}
+
+eval_plan_t *_o_yices_new_eval_plan(uint32_t n, const term_t f[]) {
+  eval_plan_t *plan;
+
+  if (! check_good_terms(__yices_globals.manager, n, f) ||
+      ! check_boolean_args(__yices_globals.manager, n, f)) {
+    return NULL;
+  }
+
+  plan = alloc_eval_plan();
+  init_eval_plan(plan, __yices_globals.terms, f, n);
+
+  return plan;
+}
+
+
+/*
+ * Delete plan
+ */
+EXPORTED void yices_free_eval_plan(eval_plan_t *plan) {
+  MT_PROTECT_VOID(__yices_globals.lock, _o_yices_free_eval_plan(plan));
+}
+
+void _o_yices_free_eval_plan(eval_plan_t *plan) {
+  delete_eval_plan(plan);
+  free_eval_plan(plan);
+}
+
+
+/*
+ * Check whether the formulas of plan are all true in mdl
+ * - same return value and error codes as yices_formulas_true_in_model
+ */
+EXPORTED int32_t yices_eval_plan_true_in_model(model_t *mdl, eval_plan_t *plan) {
+  MT_PROTECT(int32_t,  __yices_globals.lock, _o_yices_eval_plan_true_in_model(mdl, plan));
+}
+
+int32_t _o_yices_eval_plan_true_in_model(model_t *mdl, eval_plan_t *plan) {
+  uint32_t i;
+  int32_t code;
+
+  eval_plan_run(plan, mdl);
+
+  /*
+   * The plan evaluates all formulas: we check them in order so that
+   * the result is the same as yices_formulas_true_in_model.
+   */
+  for (i=0; i<plan->nroots; i++) {
+    code = plan->code[i];
+    if (code < 0) {
+      set_error_code(yices_eval_error(code));
+      return -1;
+    }
+    if (! eval_plan_is_true(plan, i)) {
+      return 0;
+    }
+  }
+
+  return 1;
+}
+
+
 
 
 /*
@@ -12329,6 +12842,17 @@ static void model_list_gc_mark(void) {
   }
 }
 
+// scan the list of evaluation plans and mark their terms
+static void eval_plan_list_gc_mark(void) {
+  dl_list_t *elem;
+
+  elem = eval_plan_list.next;
+  while (elem != &eval_plan_list) {
+    eval_plan_gc_mark(eval_plan_of_header(elem));
+    elem = elem->next;
+  }
+}
+
 // mark all terms in array a, n = size of a
 static void mark_term_array(term_table_t *tbl, const term_t *a, uint32_t n) {
   uint32_t i;
@@ -12380,10 +12904,12 @@ void _o_yices_garbage_collect(const term_t t[], uint32_t nt,
   get_list_locks();
 
   /*
-   * Default roots: all terms and types in all live models and context
+   * Default roots: all terms and types in all live models, contexts,
+   * and evaluation plans
    */
   context_list_gc_mark();
   model_list_gc_mark();
+  eval_plan_list_gc_mark();
 
   /*
    * Add roots from t and tau
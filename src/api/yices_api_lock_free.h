@@ -730,6 +730,12 @@ extern int32_t _o_yices_formula_true_in_model(model_t *mdl, term_t f);
 
 extern int32_t _o_yices_formulas_true_in_model(model_t *mdl, uint32_t n, const term_t f[]);
 
+extern eval_plan_t *_o_yices_new_eval_plan(uint32_t n, const term_t f[]);
+
+extern void _o_yices_free_eval_plan(eval_plan_t *plan);
+
+extern int32_t _o_yices_eval_plan_true_in_model(model_t *mdl, eval_plan_t *plan);
+
 /*
  * ARRAYS
  */
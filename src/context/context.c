@@ -24,6 +24,7 @@
 
 #include "context/context.h"
 #include "context/context_simplifier.h"
+#include "context/context_telemetry.h"
 #include "context/context_utils.h"
 #include "context/internalization_codes.h"
 #include "context/ite_flattener.h"
@@ -5711,6 +5712,7 @@ void init_context(context_t *ctx, term_table_t *terms, smt_logic_t logic,
   init_bvconstant(&ctx->bv_buffer);
 
   ctx->trace = NULL;
+  ctx->telemetry = NULL;
 
   // mcsat options default
   init_mcsat_options(&ctx->mcsat_options);
@@ -5806,6 +5808,7 @@ void delete_context(context_t *ctx) {
   context_free_aux_poly(ctx);
 
   context_free_bvpoly_buffer(ctx);
+  context_disable_telemetry(ctx);
 
   q_clear(&ctx->aux);
   delete_bvconstant(&ctx->bv_buffer);
@@ -225,6 +225,40 @@ extern smt_status_t check_context(context_t *ctx, const param_t *parameters);
  */
 extern smt_status_t check_context_with_assumptions(context_t *ctx, const param_t *parameters, uint32_t n, const literal_t *a);
 
+/*
+ * Model enumeration (all-sat) projected on literals a[0 ... n-1]
+ * - the context must not use MCSAT, it must support multiple checks,
+ *   and its status must be IDLE (otherwise, the status is returned and
+ *   nothing else is done).
+ * - parameters = search and heuristic parameters (NULL means default)
+ * - each a[i] must be defined in ctx->core
+ *
+ * The search decides the projection variables first. For each model
+ * found, fun(aux, ctx) is called while ctx's status is SAT (so the model
+ * can be built), then the search resumes after adding the clause that
+ * blocks the projection decisions of the current assignment. Each
+ * assignment to a[0 ... n-1] is reported once.
+ * - fun may be NULL: then the models are just counted
+ * - if fun returns false, the enumeration stops
+ * - *count is set to the number of models found
+ *
+ * Return status:
+ * - STATUS_SAT if the enumeration is complete and at least one model
+ *   was found, STATUS_UNSAT if there's no model
+ * - STATUS_INTERRUPTED if fun returned false or the search was
+ *   interrupted, STATUS_UNKNOWN if the search returned unknown.
+ *
+ * The blocking clauses are added to the core: call this after push
+ * and pop after the enumeration to remove them. On exit, the core's
+ * status is UNSAT if the enumeration is complete, SAT if fun stopped
+ * it, UNKNOWN or INTERRUPTED otherwise.
+ */
+typedef bool (*model_fun_t)(void *aux, context_t *ctx);
+
+extern smt_status_t enumerate_models(context_t *ctx, const param_t *parameters, uint32_t n, const literal_t *a,
+				     model_fun_t fun, void *aux, uint64_t *count);
+
+
 /*
  * Check satisfiability under model: check whether the assertions stored in ctx
  * conjoined with the assignment that the model gives to t is satisfiable.
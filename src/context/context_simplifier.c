@@ -1275,13 +1275,19 @@ static void try_pseudo_subst(context_t *ctx, pseudo_subst_t *subst, term_t x, te
  * - both t1 and t2 are root terms in the internalization table
  * - e is equivalent to (eq t1 t2))
  * - t1 and t2 are not boolean terms
+ *
+ * The substitution was sound in phase 1 but the class of X may have been
+ * merged with other classes since then, so its type may be smaller now.
+ * For example, after (= x r) then (= x i) where r is a real term,
+ * x is a real variable, and i is an integer variable, the class {x, i}
+ * has type int and x := r is no longer sound.
  */
 static void check_candidate_subst(context_t *ctx, pseudo_subst_t *subst, term_t t1, term_t t2, term_t e) {
   assert(is_pos_term(t1) && is_pos_term(t2) && term_is_true(ctx, e));
 
-  if (intern_tbl_root_is_free(&ctx->intern, t1)) {
+  if (intern_tbl_sound_subst(&ctx->intern, t1, t2)) {
     try_pseudo_subst(ctx, subst, t1, t2, e);
-  } else if (intern_tbl_root_is_free(&ctx->intern, t2)) {
+  } else if (intern_tbl_sound_subst(&ctx->intern, t2, t1)) {
     try_pseudo_subst(ctx, subst, t2, t1, e);
   } else {
     ivector_push(&ctx->top_eqs, e);
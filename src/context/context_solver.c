@@ -28,14 +28,19 @@
 #include <stdint.h>
 #include <inttypes.h>
 #include <stdio.h>
+#include <string.h>
 
 #include "context/context.h"
+#include "context/context_telemetry.h"
 #include "context/internalization_codes.h"
 #include "model/models.h"
 #include "solvers/bv/dimacs_printer.h"
 #include "solvers/cdcl/delegate.h"
 #include "solvers/funs/fun_solver.h"
 #include "solvers/simplex/simplex.h"
+#include "utils/cputime.h"
+#include "utils/int_hash_sets.h"
+#include "utils/memalloc.h"
 
 #include "api/yices_globals.h"
 #include "mt/thread_macros.h"
@@ -103,6 +108,15 @@ static void trace_done(smt_core_t *core) {
 }
 
 
+/*
+ * After core minimization
+ */
+static void trace_core_min(smt_core_t *core, uint32_t initial, uint32_t final, uint32_t checks, bool complete) {
+  trace_printf(core->trace, 2, "(core minimization: %"PRIu32" -> %"PRIu32" assumptions, %"PRIu32" checks%s)\n",
+               initial, final, checks, complete ? "" : ", incomplete");
+}
+
+
 
 /*
  * PROCESS AN ASSUMPTION
@@ -360,18 +374,30 @@ static literal_t theory_or_pos_branch(smt_core_t *core, literal_t l) {
  * CORE SOLVER
  */
 
+/*
+ * Telemetry samples
+ */
+static inline void sample_telemetry(context_t *ctx, telemetry_event_t event) {
+  if (ctx->telemetry != NULL) {
+    context_telemetry_sample(ctx, event);
+  }
+}
+
+
 /*
  * Full solver:
  * - params: heuristic parameters.
  * - n = number of assumptions
  * - a = array of n assumptions: a[0 ... n-1] must all be literals
  */
-static void solve(smt_core_t *core, const param_t *params, uint32_t n, const literal_t *a) {
+static void solve(context_t *ctx, const param_t *params, uint32_t n, const literal_t *a, double deadline) {
+  smt_core_t *core;
   bool luby;
   uint32_t c_threshold, d_threshold; // Picosat-style
   uint32_t u, v, period;             // for Luby-style
   uint32_t reduce_threshold;
 
+  core = ctx->core;
   c_threshold = params->c_threshold;
   d_threshold = c_threshold; // required by trace_start in slow_restart mode
   luby = false;
@@ -394,6 +420,7 @@ static void solve(smt_core_t *core, const param_t *params, uint32_t n, const lit
   // initialize then do a propagation + simplification step.
   start_search(core, n, a);
   trace_start(core);
+  sample_telemetry(ctx, TELEMETRY_START);
   if (smt_status(core) == STATUS_SEARCHING) {
     // loop
     for (;;) {
@@ -426,6 +453,13 @@ static void solve(smt_core_t *core, const param_t *params, uint32_t n, const lit
 
       smt_restart(core);
       //      smt_partial_restart_var(core);
+      sample_telemetry(ctx, TELEMETRY_RESTART);
+
+      if (deadline > 0.0 && get_cpu_time() >= deadline) {
+        // out of time (in core minimization)
+        end_search_unknown(core);
+        break;
+      }
 
       if (luby) {
 	// Luby-style restart
@@ -461,6 +495,7 @@ static void solve(smt_core_t *core, const param_t *params, uint32_t n, const lit
   }
 
   trace_done(core);
+  sample_telemetry(ctx, TELEMETRY_DONE);
 }
 
 
@@ -556,6 +591,176 @@ static smt_status_t call_mcsat_solver(context_t *ctx, const param_t *params) {
   MT_PROTECT(smt_status_t, __yices_globals.lock, _o_call_mcsat_solver(ctx, params));
 }
 
+/*
+ * UNSAT CORE MINIMIZATION
+ */
+
+/*
+ * Restore ctx to IDLE after a check with assumptions
+ */
+static void clear_assumptions(context_t *ctx) {
+  switch (smt_status(ctx->core)) {
+  case STATUS_UNSAT:
+    context_clear_unsat(ctx);
+    break;
+
+  case STATUS_SAT:
+  case STATUS_UNKNOWN:
+    context_clear(ctx);
+    break;
+
+  default:
+    break;
+  }
+}
+
+
+/*
+ * Remove v->data[i] from core, and all literals that are not in
+ * the new core w (clause-set refinement).
+ * - the order of the remaining literals is preserved
+ * - return the new index of the first literal after i
+ */
+static uint32_t refine_core(ivector_t *v, uint32_t i, ivector_t *w) {
+  int_hset_t keep;
+  uint32_t j, k, n, next;
+
+  init_int_hset(&keep, 0);
+  n = w->size;
+  for (j=0; j<n; j++) {
+    int_hset_add(&keep, w->data[j]);
+  }
+
+  next = 0;
+  k = 0;
+  n = v->size;
+  for (j=0; j<n; j++) {
+    if (j != i && int_hset_member(&keep, v->data[j])) {
+      v->data[k] = v->data[j];
+      k ++;
+    }
+    if (j == i) next = k;
+  }
+  ivector_shrink(v, k);
+
+  delete_int_hset(&keep);
+
+  return next;
+}
+
+
+/*
+ * Deletion-based minimization of the unsat core after a check with
+ * assumptions a[0 ... n-1] returned UNSAT.
+ *
+ * Let C be the current core. For each literal l in C, we check C - {l}:
+ * - if that's SAT, l is necessary and it stays in C
+ * - if that's UNSAT, C is replaced by the unsat core of this check
+ *   (which is a subset of C - {l}). This can remove several literals
+ *   at once.
+ * All checks are done in the same context, so the learned clauses
+ * are kept from one check to the next (unless clean-interrupt is
+ * enabled).
+ *
+ * When the CPU-time budget params->core_min_timeout is exhausted,
+ * the current core is kept. On exit, ctx's status is UNSAT and
+ * its unsat core is the minimized core, unless an inner check is
+ * interrupted (then the status is INTERRUPTED).
+ */
+static void minimize_unsat_core(context_t *ctx, const param_t *params, uint32_t n, const literal_t *a) {
+  smt_core_t *core;
+  ivector_t mus, cand, aux;
+  double deadline;
+  uint32_t i, j, initial, checks;
+  smt_status_t stat;
+  bool current, complete;
+
+  core = ctx->core;
+  assert(smt_status(core) == STATUS_UNSAT);
+
+  init_ivector(&mus, 0);
+  build_unsat_core(core, &mus);
+  if (mus.size <= 1) {
+    delete_ivector(&mus);
+    return;
+  }
+
+  init_ivector(&cand, mus.size);
+  init_ivector(&aux, mus.size);
+
+  deadline = 0.0;
+  if (params->core_min_timeout > 0.0) {
+    deadline = get_cpu_time() + params->core_min_timeout;
+  }
+
+  initial = mus.size;
+  checks = 0;
+  complete = false;
+  current = true; // true if ctx's status is UNSAT with core = mus
+  i = 0;
+  for (;;) {
+    if (i >= mus.size) {
+      complete = true;
+      break;
+    }
+    if (deadline > 0.0 && get_cpu_time() >= deadline) break;
+
+    // check mus - { mus[i] }
+    ivector_reset(&cand);
+    for (j=0; j<mus.size; j++) {
+      if (j != i) ivector_push(&cand, mus.data[j]);
+    }
+
+    clear_assumptions(ctx);
+    if (smt_status(core) != STATUS_IDLE) {
+      // the context is unsat without assumptions
+      assert(smt_status(core) == STATUS_UNSAT);
+      ivector_reset(&mus);
+      current = true;
+      complete = true;
+      break;
+    }
+    solve(ctx, params, cand.size, cand.data, deadline);
+    checks ++;
+
+    stat = smt_status(core);
+    if (stat == STATUS_UNSAT) {
+      build_unsat_core(core, &aux);
+      i = refine_core(&mus, i, &aux);
+      current = true;
+    } else if (stat == STATUS_INTERRUPTED) {
+      goto done;
+    } else {
+      current = false;
+      if (stat == STATUS_UNKNOWN && deadline > 0.0 && get_cpu_time() >= deadline) break;
+      // mus[i] is necessary (or we can't tell)
+      i ++;
+    }
+  }
+
+  if (! current) {
+    // recheck to set the context's unsat core to mus
+    clear_assumptions(ctx);
+    assert(smt_status(core) == STATUS_IDLE);
+    solve(ctx, params, mus.size, mus.data, 0.0);
+    checks ++;
+    if (smt_status(core) != STATUS_UNSAT) {
+      // this should not happen: fall back to the original assumptions
+      clear_assumptions(ctx);
+      solve(ctx, params, n, a, 0.0);
+      checks ++;
+    }
+  }
+
+  trace_core_min(core, initial, mus.size, checks, complete);
+
+ done:
+  delete_ivector(&aux);
+  delete_ivector(&cand);
+  delete_ivector(&mus);
+}
+
+
 /*
  * Initialize search parameters then call solve
  * - if ctx->status is not IDLE, return the status.
@@ -578,7 +783,7 @@ smt_status_t check_context(context_t *ctx, const param_t *params) {
   if (stat == STATUS_IDLE) {
     // clean state: the search can proceed
     context_set_search_parameters(ctx, params);
-    solve(core, params, 0, NULL);
+    solve(ctx, params, 0, NULL, 0.0);
     stat = smt_status(core);
   }
 
@@ -602,8 +807,12 @@ smt_status_t check_context_with_assumptions(context_t *ctx, const param_t *param
       params = get_default_params();
     }
     context_set_search_parameters(ctx, params);
-    solve(core, params, n, a);
+    solve(ctx, params, n, a, 0.0);
     stat = smt_status(core);
+    if (stat == STATUS_UNSAT && params->minimize_core && n > 0 && context_supports_multichecks(ctx)) {
+      minimize_unsat_core(ctx, params, n, a);
+      stat = smt_status(core);
+    }
   }
 
   return stat;
@@ -634,6 +843,279 @@ smt_status_t check_context_with_model(context_t *ctx, const param_t *params, mod
 }
 
 
+/*
+ * MODEL ENUMERATION
+ */
+
+/*
+ * Enumerator:
+ * - core = the context's core
+ * - proj = projection variables (distinct, not const_bvar)
+ * - mark[x] = 1 if x is a projection variable, for 0 <= x < nmarks
+ *   (the variables created during the search are not marked)
+ * - scan = stack of pairs (level, i) used to find the next unassigned
+ *   projection variable: (k, i) means that proj[0 ... i-1] are all
+ *   assigned at levels <= k.
+ * - clause = buffer for the blocking clauses
+ */
+typedef struct model_enum_s {
+  smt_core_t *core;
+  ivector_t proj;
+  uint8_t *mark;
+  uint32_t nmarks;
+  ivector_t scan;
+  ivector_t clause;
+} model_enum_t;
+
+
+/*
+ * Initialize e for projection literals a[0 ... n-1]
+ */
+static void init_model_enum(model_enum_t *e, smt_core_t *core, uint32_t n, const literal_t *a) {
+  uint32_t i;
+  bvar_t x;
+
+  e->core = core;
+  e->nmarks = num_vars(core);
+  e->mark = (uint8_t *) safe_malloc(e->nmarks * sizeof(uint8_t));
+  memset(e->mark, 0, e->nmarks * sizeof(uint8_t));
+  init_ivector(&e->proj, n);
+  for (i=0; i<n; i++) {
+    x = var_of(a[i]);
+    assert(x < e->nmarks);
+    if (x != const_bvar && !e->mark[x]) {
+      e->mark[x] = 1;
+      ivector_push(&e->proj, x);
+    }
+  }
+  init_ivector(&e->scan, 0);
+  init_ivector(&e->clause, 0);
+}
+
+static void delete_model_enum(model_enum_t *e) {
+  safe_free(e->mark);
+  delete_ivector(&e->proj);
+  delete_ivector(&e->scan);
+  delete_ivector(&e->clause);
+}
+
+
+/*
+ * Select the next decision literal:
+ * - the projection variables are decided first, using their preferred
+ *   polarity. Once they are all assigned, we use the core's heuristic
+ *   and the branching function (if branch is not NULL).
+ * - return null_literal if all variables are assigned
+ *
+ * This ensures that no decision on a non-projection variable precedes
+ * a decision on a projection variable. So the projection variables are
+ * all implied by the projection decisions.
+ */
+static literal_t enum_select_literal(model_enum_t *e, branching_fun_t branch) {
+  smt_core_t *core;
+  ivector_t *scan;
+  uint32_t i, n, level;
+  bvar_t x;
+  literal_t l;
+
+  core = e->core;
+  scan = &e->scan;
+  level = core->decision_level;
+
+  // remove the pairs invalidated by backtracking
+  while (scan->size > 0 && scan->data[scan->size - 2] > level) {
+    scan->size -= 2;
+  }
+
+  i = 0;
+  if (scan->size > 0) {
+    i = scan->data[scan->size - 1];
+  }
+  n = e->proj.size;
+  while (i < n && bvar_is_assigned(core, e->proj.data[i])) {
+    i ++;
+  }
+
+  if (scan->size > 0 && scan->data[scan->size - 2] == level) {
+    scan->data[scan->size - 1] = i;
+  } else {
+    ivector_push(scan, level);
+    ivector_push(scan, i);
+  }
+
+  if (i < n) {
+    x = e->proj.data[i];
+    return true_preferred(bvar_value(core, x)) ? pos_lit(x) : neg_lit(x);
+  }
+
+  l = select_unassigned_literal(core);
+  if (l != null_literal && branch != NULL) {
+    l = branch(core, l);
+  }
+  return l;
+}
+
+
+/*
+ * Block the projection of the current model then resume the search
+ * - the blocking clause is the negation of the projection decisions
+ * - it's added on the fly so the core backjumps to the appropriate
+ *   level (or detects that the search is over) instead of restarting
+ *   from the base level.
+ */
+static void block_projection(model_enum_t *e) {
+  smt_core_t *core;
+  ivector_t *v;
+  uint32_t i, j;
+  literal_t l;
+
+  core = e->core;
+  assert(smt_status(core) == STATUS_SAT);
+
+  v = &e->clause;
+  collect_decision_literals(core, v);
+  j = 0;
+  for (i=0; i<v->size; i++) {
+    l = v->data[i];
+    if (var_of(l) < e->nmarks && e->mark[var_of(l)]) {
+      v->data[j] = not(l);
+      j ++;
+    }
+  }
+  ivector_shrink(v, j);
+
+  set_smt_status(core, STATUS_SEARCHING);
+  add_clause(core, v->size, v->data);
+  smt_process(core);
+}
+
+
+/*
+ * Branching function for params->branching (NULL for the default)
+ */
+static branching_fun_t branching_function(branch_t b) {
+  switch (b) {
+  case BRANCHING_NEGATIVE:
+    return negative_branch;
+  case BRANCHING_POSITIVE:
+    return positive_branch;
+  case BRANCHING_THEORY:
+    return theory_branch;
+  case BRANCHING_TH_NEG:
+    return theory_or_neg_branch;
+  case BRANCHING_TH_POS:
+    return theory_or_pos_branch;
+  case BRANCHING_DEFAULT:
+  default:
+    return NULL;
+  }
+}
+
+
+/*
+ * Enumerate the models of ctx projected on a[0 ... n-1]
+ * - the search uses restarts with a geometric conflict bound
+ *   (params->c_threshold, params->c_factor) and the usual clause
+ *   database reduction.
+ */
+smt_status_t enumerate_models(context_t *ctx, const param_t *params, uint32_t n, const literal_t *a,
+			      model_fun_t fun, void *aux, uint64_t *count) {
+  smt_core_t *core;
+  model_enum_t e;
+  branching_fun_t branch;
+  uint64_t max_conflicts, deletions;
+  uint32_t c_threshold, r_threshold;
+  literal_t l;
+  smt_status_t stat;
+
+  assert(ctx->mcsat == NULL && context_supports_multichecks(ctx));
+
+  *count = 0;
+  core = ctx->core;
+  stat = smt_status(core);
+  if (stat != STATUS_IDLE) {
+    return stat;
+  }
+
+  if (params == NULL) {
+    params = get_default_params();
+  }
+  context_set_search_parameters(ctx, params);
+  branch = branching_function(params->branching);
+  c_threshold = params->c_threshold;
+  r_threshold = (uint32_t) (num_prob_clauses(core) * params->r_fraction);
+  if (r_threshold < params->r_threshold) {
+    r_threshold = params->r_threshold;
+  }
+
+  init_model_enum(&e, core, n, a);
+
+  start_search(core, 0, NULL);
+  trace_start(core);
+  sample_telemetry(ctx, TELEMETRY_START);
+
+  max_conflicts = num_conflicts(core) + c_threshold;
+  smt_process(core);
+  while (smt_status(core) == STATUS_SEARCHING) {
+    if (num_conflicts(core) > max_conflicts) {
+      smt_restart(core);
+      sample_telemetry(ctx, TELEMETRY_RESTART);
+      trace_restart(core);
+      if (params->c_factor > 1.0) {
+	c_threshold = (uint32_t) (c_threshold * params->c_factor);
+      }
+      max_conflicts = num_conflicts(core) + c_threshold;
+    }
+
+    // reduce heuristic
+    if (num_learned_clauses(core) >= r_threshold) {
+      deletions = core->stats.learned_clauses_deleted;
+      reduce_clause_database(core);
+      r_threshold = (uint32_t) (r_threshold * params->r_factor);
+      trace_reduce(core, core->stats.learned_clauses_deleted - deletions);
+    }
+
+    // decision
+    l = enum_select_literal(&e, branch);
+    if (l != null_literal) {
+      decide_literal(core, l);
+      smt_process(core);
+      continue;
+    }
+
+    // all variables assigned
+    smt_final_check(core);
+    if (smt_status(core) == STATUS_SAT) {
+      (*count) ++;
+      if (fun != NULL && !fun(aux, ctx)) break;
+      block_projection(&e);
+    }
+  }
+
+  trace_done(core);
+  sample_telemetry(ctx, TELEMETRY_DONE);
+  delete_model_enum(&e);
+
+  stat = smt_status(core);
+  switch (stat) {
+  case STATUS_UNSAT:
+    // all models are enumerated
+    if (*count > 0) stat = STATUS_SAT;
+    break;
+
+  case STATUS_SAT:
+    // stopped by fun
+    stat = STATUS_INTERRUPTED;
+    break;
+
+  default:
+    break;
+  }
+
+  return stat;
+}
+
+
 /*
  * Precheck: force generation of clauses and other stuff that's
  * constructed lazily by the solvers. For example, this
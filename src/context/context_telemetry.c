@@ -0,0 +1,231 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * TELEMETRY: PERIODIC SAMPLES OF A CONTEXT'S SEARCH STATISTICS
+ */
+
+#include <assert.h>
+#include <inttypes.h>
+
+#include "context/context.h"
+#include "context/context_telemetry.h"
+#include "solvers/bv/bvsolver.h"
+#include "solvers/simplex/simplex.h"
+#include "utils/cputime.h"
+#include "utils/memalloc.h"
+
+
+/*
+ * Enable/disable
+ */
+void context_enable_telemetry(context_t *ctx, FILE *file, telemetry_fun_t fun, void *aux, double period) {
+  telemetry_t *tel;
+
+  assert(period >= 0.0);
+
+  context_disable_telemetry(ctx);
+
+  tel = (telemetry_t *) safe_malloc(sizeof(telemetry_t));
+  tel->file = file;
+  tel->fun = fun;
+  tel->aux = aux;
+  tel->period = period;
+  tel->start = get_cpu_time();
+  tel->last = tel->start;
+  tel->checks = 0;
+  init_string_buffer(&tel->buffer, 1024);
+
+  ctx->telemetry = tel;
+}
+
+void context_disable_telemetry(context_t *ctx) {
+  telemetry_t *tel;
+
+  tel = ctx->telemetry;
+  if (tel != NULL) {
+    delete_string_buffer(&tel->buffer);
+    safe_free(tel);
+    ctx->telemetry = NULL;
+  }
+}
+
+
+/*
+ * JSON fields: all are written as ,"name":value
+ * except the first one.
+ */
+static void telemetry_key(string_buffer_t *b, const char *name) {
+  string_buffer_append_string(b, ",\"");
+  string_buffer_append_string(b, name);
+  string_buffer_append_string(b, "\":");
+}
+
+static void telemetry_string(string_buffer_t *b, const char *name, const char *s) {
+  telemetry_key(b, name);
+  string_buffer_append_char(b, '"');
+  string_buffer_append_string(b, s);
+  string_buffer_append_char(b, '"');
+}
+
+static void telemetry_uint64(string_buffer_t *b, const char *name, uint64_t x) {
+  char aux[24];
+
+  telemetry_key(b, name);
+  snprintf(aux, sizeof(aux), "%"PRIu64, x);
+  string_buffer_append_string(b, aux);
+}
+
+static void telemetry_uint32(string_buffer_t *b, const char *name, uint32_t x) {
+  telemetry_key(b, name);
+  string_buffer_append_uint32(b, x);
+}
+
+static void telemetry_time(string_buffer_t *b, const char *name, double t) {
+  char aux[32];
+
+  telemetry_key(b, name);
+  snprintf(aux, sizeof(aux), "%.3f", t);
+  string_buffer_append_string(b, aux);
+}
+
+
+/*
+ * Solver counters
+ */
+static void telemetry_core_stats(string_buffer_t *b, smt_core_t *core) {
+  dpll_stats_t *stat;
+  char aux[24];
+  uint32_t i;
+
+  stat = &core->stats;
+  telemetry_uint32(b, "restarts", stat->restarts);
+  telemetry_uint64(b, "decisions", stat->decisions);
+  telemetry_uint64(b, "propagations", stat->propagations);
+  telemetry_uint64(b, "conflicts", stat->conflicts);
+  telemetry_uint32(b, "th_props", stat->th_props);
+  telemetry_uint32(b, "th_conflicts", stat->th_conflicts);
+  telemetry_uint32(b, "reduce_calls", stat->reduce_calls);
+  telemetry_uint32(b, "learned_clauses", num_learned_clauses(core));
+  telemetry_uint64(b, "learned_literals", stat->learned_literals);
+
+  telemetry_key(b, "learned_size");
+  string_buffer_append_char(b, '[');
+  for (i=0; i<DPLL_SIZE_BUCKETS; i++) {
+    if (i > 0) string_buffer_append_char(b, ',');
+    snprintf(aux, sizeof(aux), "%"PRIu64, stat->learned_size[i]);
+    string_buffer_append_string(b, aux);
+  }
+  string_buffer_append_char(b, ']');
+}
+
+static void telemetry_egraph_stats(string_buffer_t *b, egraph_t *egraph) {
+  egraph_stats_t *stat;
+
+  stat = &egraph->stats;
+  telemetry_uint32(b, "egraph_props", stat->th_props);
+  telemetry_uint32(b, "egraph_conflicts", stat->th_conflicts);
+  telemetry_uint32(b, "egraph_final_checks", stat->final_checks);
+  telemetry_uint32(b, "egraph_ack_lemmas", stat->ack_lemmas + stat->boolack_lemmas);
+}
+
+static void telemetry_simplex_stats(string_buffer_t *b, simplex_solver_t *simplex) {
+  simplex_stats_t *stat;
+
+  simplex_collect_statistics(simplex);
+  stat = &simplex->stats;
+  telemetry_uint32(b, "simplex_make_feasible", stat->num_make_feasible);
+  telemetry_uint32(b, "simplex_pivots", stat->num_pivots);
+  telemetry_uint32(b, "simplex_props", stat->num_props);
+  telemetry_uint32(b, "simplex_conflicts", stat->num_conflicts);
+  telemetry_uint32(b, "simplex_branch_and_bound", stat->num_branch_atoms);
+}
+
+static void telemetry_bv_stats(string_buffer_t *b, bv_solver_t *solver) {
+  telemetry_uint32(b, "bv_atoms", bv_solver_num_atoms(solver));
+  telemetry_uint32(b, "bv_dyn_eq_atoms", solver->stats.on_the_fly_atoms);
+  telemetry_uint32(b, "bv_equiv_lemmas", solver->stats.equiv_lemmas);
+  telemetry_uint32(b, "bv_interface_lemmas", solver->stats.interface_lemmas);
+}
+
+
+/*
+ * Names of events and status
+ */
+static const char * const telemetry_event_name[3] = {
+  "start", "restart", "done",
+};
+
+static const char * const telemetry_status_name[7] = {
+  "idle", "searching", "unknown", "sat", "unsat", "interrupted", "error",
+};
+
+
+/*
+ * Sample
+ */
+void context_telemetry_sample(context_t *ctx, telemetry_event_t event) {
+  telemetry_t *tel;
+  string_buffer_t *b;
+  double now;
+
+  tel = ctx->telemetry;
+  assert(tel != NULL && ctx->core != NULL);
+
+  now = get_cpu_time();
+  if (event == TELEMETRY_RESTART && now - tel->last < tel->period) {
+    return;
+  }
+  tel->last = now;
+  if (event == TELEMETRY_START) {
+    tel->checks ++;
+  }
+
+  b = &tel->buffer;
+  string_buffer_reset(b);
+  string_buffer_append_string(b, "{\"event\":\"");
+  string_buffer_append_string(b, telemetry_event_name[event]);
+  string_buffer_append_char(b, '"');
+  telemetry_time(b, "time", now - tel->start);
+  telemetry_uint32(b, "checks", tel->checks);
+  if (event == TELEMETRY_DONE) {
+    telemetry_string(b, "status", telemetry_status_name[smt_status(ctx->core)]);
+  }
+
+  telemetry_core_stats(b, ctx->core);
+  if (ctx->egraph != NULL) {
+    telemetry_egraph_stats(b, ctx->egraph);
+  }
+  if (context_has_simplex_solver(ctx) && ctx->arith_solver != NULL) {
+    telemetry_simplex_stats(b, ctx->arith_solver);
+  }
+  if (context_has_bv_solver(ctx)) {
+    telemetry_bv_stats(b, ctx->bv_solver);
+  }
+  string_buffer_append_char(b, '}');
+  string_buffer_close(b);
+
+  if (tel->file != NULL) {
+    fputs(b->data, tel->file);
+    fputc('\n', tel->file);
+    fflush(tel->file);
+  }
+  if (tel->fun != NULL) {
+    tel->fun(tel->aux, b->data);
+  }
+}
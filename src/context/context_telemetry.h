@@ -0,0 +1,128 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * TELEMETRY: PERIODIC SAMPLES OF A CONTEXT'S SEARCH STATISTICS
+ */
+
+/*
+ * The tracer and yices_show_statistics produce text meant to be read
+ * by a person, and only at the end of a search (or at high verbosity).
+ * Telemetry is meant for monitoring long searches: when it's enabled,
+ * check_context emits a sample of the solver counters as a JSON object
+ * at the start of the search, at restarts, and at the end. Each sample
+ * is a single line. For example:
+ *
+ *  {"event":"restart","time":1.25,"checks":1,"restarts":12,...,
+ *   "learned_size":[3,40,112,206,380,410,201,18]}
+ *
+ * Fields:
+ * - event = "start", "restart", or "done"
+ * - time = CPU time in seconds since telemetry was enabled
+ * - checks = number of calls to check_context since then
+ * - the smt_core counters (decisions, propagations, conflicts, ...)
+ * - learned_size = histogram of learned clause sizes (cf. smt_core.h)
+ * - the counters of the egraph, simplex, and bitvector solvers if
+ *   these solvers exist.
+ * - status = the result of the search (in "done" samples only)
+ *
+ * Samples are either written to a file or passed to a callback. The
+ * sampling period controls the restart samples: there's at most one
+ * sample every period seconds (0.0 means one sample per restart).
+ * The start and done samples are always emitted.
+ *
+ * The counters are read from the context's own solvers, so contexts
+ * used by different threads have independent telemetry. There's no
+ * cost in the search itself: samples are only taken between restarts.
+ */
+
+#ifndef __CONTEXT_TELEMETRY_H
+#define __CONTEXT_TELEMETRY_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "context/context_types.h"
+#include "utils/string_buffers.h"
+
+
+/*
+ * Callback: aux = user-provided pointer, json = the sample
+ * (a '\0'-terminated string, without a newline). The string is
+ * overwritten by the next sample.
+ */
+typedef void (*telemetry_fun_t)(void *aux, const char *json);
+
+/*
+ * Telemetry descriptor:
+ * - file = output file (or NULL)
+ * - fun, aux = callback (fun may be NULL)
+ * - period = minimal delay between two restart samples (in seconds)
+ * - start = CPU time when telemetry was enabled
+ * - last = CPU time of the last sample
+ * - checks = number of searches so far
+ * - buffer = to build the samples
+ */
+typedef struct telemetry_s {
+  FILE *file;
+  telemetry_fun_t fun;
+  void *aux;
+  double period;
+  double start;
+  double last;
+  uint32_t checks;
+  string_buffer_t buffer;
+} telemetry_t;
+
+
+/*
+ * Sample events
+ */
+typedef enum telemetry_event {
+  TELEMETRY_START,
+  TELEMETRY_RESTART,
+  TELEMETRY_DONE,
+} telemetry_event_t;
+
+
+/*
+ * Enable telemetry for ctx
+ * - samples are written to file if file is non-NULL
+ *   and passed to fun if fun is non-NULL
+ * - period = sampling period for restarts (must be non-negative)
+ * - if telemetry is already enabled, the previous descriptor is
+ *   replaced (and the counters are reset).
+ * - the file is not closed by the context
+ */
+extern void context_enable_telemetry(context_t *ctx, FILE *file, telemetry_fun_t fun, void *aux, double period);
+
+/*
+ * Disable telemetry and free the descriptor
+ */
+extern void context_disable_telemetry(context_t *ctx);
+
+/*
+ * Emit a sample for the given event
+ * - ctx->telemetry must be non-NULL
+ * - restart samples are skipped if the last sample is too recent
+ */
+extern void context_telemetry_sample(context_t *ctx, telemetry_event_t event);
+
+
+#endif /* __CONTEXT_TELEMETRY_H */
@@ -725,6 +725,9 @@ struct context_s {
   // for verbose output (default NULL)
   tracer_t *trace;
 
+  // telemetry samples (default NULL)
+  struct telemetry_s *telemetry;
+
   // options for the mcsat solver
   mcsat_options_t mcsat_options;
 
@@ -0,0 +1,443 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * ENUMERATION OF MINIMAL UNSAT SUBSETS AND MINIMAL CORRECTION SETS
+ */
+
+#include <assert.h>
+
+#include "context/context.h"
+#include "context/mus_enumerator.h"
+#include "utils/int_array_sort.h"
+#include "utils/int_hash_map.h"
+#include "utils/int_vectors.h"
+#include "utils/memalloc.h"
+
+
+/*
+ * The map solver has no theory solver
+ */
+static void map_do_nothing(void *solver) {
+}
+
+static void map_backtrack(void *solver, uint32_t backlevel) {
+}
+
+static bool map_propagate(void *solver) {
+  return true;
+}
+
+static fcheck_code_t map_final_check(void *solver) {
+  return FCHECK_SAT;
+}
+
+static th_ctrl_interface_t map_ctrl = {
+  map_do_nothing,   // start_internalization
+  map_do_nothing,   // start_search
+  map_propagate,    // propagate
+  map_final_check,  // final check
+  map_do_nothing,   // increase_decision_level
+  map_backtrack,    // backtrack
+  map_do_nothing,   // push
+  map_do_nothing,   // pop
+  map_do_nothing,   // reset
+  map_do_nothing,   // clear
+};
+
+static th_smt_interface_t map_smt = {
+  NULL, NULL, NULL, NULL, NULL,
+};
+
+
+/*
+ * Enumerator:
+ * - ctx = context
+ * - plain = search parameters for the seed and grow checks
+ * - shrink = same parameters with minimize_core enabled
+ * - lit[0 ... nlits-1] = distinct assumption literals
+ * - first[k] = index of lit[k] in the original array
+ * - index maps lit[k] to k
+ * - map = map solver: variable k+1 stands for lit[k]
+ * - fun, aux = callback
+ * - seed, set, candidates, aux_vector: buffers
+ * - nmus = number of MUSes found
+ */
+typedef struct mus_enum_s {
+  context_t *ctx;
+  param_t plain;
+  param_t shrink;
+  literal_t *lit;
+  uint32_t *first;
+  uint32_t nlits;
+  int_hmap_t index;
+  smt_core_t map;
+  mus_mcs_fun_t fun;
+  void *aux;
+  ivector_t seed;
+  ivector_t set;
+  ivector_t candidates;
+  ivector_t aux_vector;
+  uint32_t nmus;
+} mus_enum_t;
+
+
+/*
+ * Initialize e for assumptions a[0 ... n-1]
+ */
+static void init_mus_enum(mus_enum_t *e, context_t *ctx, const param_t *params, uint32_t n, const literal_t *a,
+			  mus_mcs_fun_t fun, void *aux) {
+  int_hmap_pair_t *p;
+  uint32_t i, k;
+
+  e->ctx = ctx;
+  e->plain = *params;
+  e->plain.minimize_core = false;
+  e->shrink = *params;
+  e->shrink.minimize_core = true;
+  e->shrink.core_min_timeout = 0.0;
+
+  e->lit = (literal_t *) safe_malloc(n * sizeof(literal_t));
+  e->first = (uint32_t *) safe_malloc(n * sizeof(uint32_t));
+  init_int_hmap(&e->index, 0);
+  k = 0;
+  for (i=0; i<n; i++) {
+    p = int_hmap_get(&e->index, a[i]);
+    if (p->val < 0) {
+      p->val = k;
+      e->lit[k] = a[i];
+      e->first[k] = i;
+      k ++;
+    }
+  }
+  e->nlits = k;
+
+  init_smt_core(&e->map, k+1, NULL, &map_ctrl, &map_smt, SMT_MODE_BASIC);
+  add_boolean_variables(&e->map, k);
+
+  e->fun = fun;
+  e->aux = aux;
+  init_ivector(&e->seed, k);
+  init_ivector(&e->set, k);
+  init_ivector(&e->candidates, k);
+  init_ivector(&e->aux_vector, k);
+  e->nmus = 0;
+}
+
+static void delete_mus_enum(mus_enum_t *e) {
+  safe_free(e->lit);
+  safe_free(e->first);
+  delete_int_hmap(&e->index);
+  delete_smt_core(&e->map);
+  delete_ivector(&e->seed);
+  delete_ivector(&e->set);
+  delete_ivector(&e->candidates);
+  delete_ivector(&e->aux_vector);
+}
+
+
+/*
+ * Index of assumption literal l
+ */
+static uint32_t mus_enum_index(mus_enum_t *e, literal_t l) {
+  int_hmap_pair_t *p;
+
+  p = int_hmap_find(&e->index, l);
+  assert(p != NULL && 0 <= p->val && p->val < e->nlits);
+  return p->val;
+}
+
+
+/*
+ * Get the next seed from the map solver
+ * - all decisions are positive so that we get a large seed
+ * - the seed is stored in e->seed as a list of indices k in increasing order
+ * - return false if the map solver is unsat (i.e., all subsets are explored)
+ */
+static bool next_seed(mus_enum_t *e) {
+  smt_core_t *map;
+  bvar_t x;
+  uint32_t k;
+
+  map = &e->map;
+  assert(smt_status(map) == STATUS_IDLE);
+
+  // start_search clears the inconsistent flag set by add_empty_clause
+  if (map->inconsistent) return false;
+
+  start_search(map, 0, NULL);
+  smt_process(map);
+  while (smt_status(map) == STATUS_SEARCHING) {
+    x = select_most_active_bvar(map);
+    if (x == null_bvar) {
+      end_search_sat(map);
+      break;
+    }
+    decide_literal(map, pos_lit(x));
+    smt_process(map);
+  }
+
+  if (smt_status(map) != STATUS_SAT) {
+    assert(smt_status(map) == STATUS_UNSAT);
+    return false;
+  }
+
+  ivector_reset(&e->seed);
+  for (k=0; k<e->nlits; k++) {
+    if (bvar_value(map, k+1) == VAL_TRUE) {
+      ivector_push(&e->seed, k);
+    }
+  }
+  smt_clear(map);
+
+  return true;
+}
+
+
+/*
+ * Check the assumptions whose indices are in v
+ * - params = parameters to use
+ * - ctx's status must be IDLE
+ */
+static smt_status_t check_subset(mus_enum_t *e, const param_t *params, ivector_t *v) {
+  ivector_t *lits;
+  uint32_t i, n;
+
+  assert(context_status(e->ctx) == STATUS_IDLE);
+
+  lits = &e->aux_vector;
+  ivector_reset(lits);
+  n = v->size;
+  for (i=0; i<n; i++) {
+    ivector_push(lits, e->lit[v->data[i]]);
+  }
+  return check_context_with_assumptions(e->ctx, params, lits->size, lits->data);
+}
+
+
+/*
+ * Restore ctx's status to IDLE after a check
+ * - return false if ctx is unsat without assumptions
+ */
+static bool clear_check(mus_enum_t *e) {
+  switch (context_status(e->ctx)) {
+  case STATUS_UNSAT:
+    context_clear_unsat(e->ctx);
+    break;
+
+  case STATUS_SAT:
+  case STATUS_UNKNOWN:
+    context_clear(e->ctx);
+    break;
+
+  default:
+    break;
+  }
+  return context_status(e->ctx) == STATUS_IDLE;
+}
+
+
+/*
+ * Report the set of indices in v
+ * - return the callback's result
+ */
+static bool report_set(mus_enum_t *e, bool is_mus, ivector_t *v) {
+  uint32_t *idx;
+  uint32_t i, n;
+  bool result;
+
+  n = v->size;
+  idx = (uint32_t *) safe_malloc((n + 1) * sizeof(uint32_t));
+  for (i=0; i<n; i++) {
+    idx[i] = e->first[v->data[i]];
+  }
+  int_array_sort((int32_t *) idx, n);
+  result = e->fun(e->aux, is_mus, n, idx);
+  safe_free(idx);
+
+  return result;
+}
+
+
+/*
+ * Seed is unsat: the context's unsat core is an MUS
+ * (since the check was done with minimize_core).
+ * - block all its supersets: add clause (OR_{i in M} not x_i)
+ */
+static bool process_mus(mus_enum_t *e) {
+  ivector_t *v;
+  uint32_t i, n;
+
+  v = &e->set;
+  build_unsat_core(e->ctx->core, v);
+  ivector_reset(&e->aux_vector);
+  n = v->size;
+  for (i=0; i<n; i++) {
+    v->data[i] = mus_enum_index(e, v->data[i]);
+    ivector_push(&e->aux_vector, neg_lit(v->data[i] + 1));
+  }
+  add_clause(&e->map, n, e->aux_vector.data);
+  e->nmus ++;
+
+  return report_set(e, true, v);
+}
+
+
+/*
+ * Move the assumptions that are true in the context's model from
+ * the candidates to the mss (skipping the candidates before i)
+ * - then clear the context
+ */
+static void add_true_assumptions(mus_enum_t *e, uint32_t i) {
+  smt_core_t *core;
+  ivector_t *candidates;
+  uint32_t j, n;
+  int32_t k;
+
+  core = e->ctx->core;
+  assert(smt_status(core) == STATUS_SAT);
+
+  candidates = &e->candidates;
+  n = candidates->size;
+  for (j=i; j<n; j++) {
+    k = candidates->data[j];
+    if (k >= 0 && literal_value(core, e->lit[k]) == VAL_TRUE) {
+      ivector_push(&e->seed, k);
+      candidates->data[j] = -1;
+    }
+  }
+  context_clear(e->ctx);
+}
+
+
+/*
+ * Seed is sat: grow it into an MSS and store the complement in e->set
+ * - all the assumptions true in the context's model are added to the
+ *   seed, then we try to add the others one by one.
+ * - the assumptions that can't be added form an MCS. We block all
+ *   subsets of its complement: add clause (OR_{i in C} x_i).
+ * - on entry, ctx's status must be SAT
+ * - return the status of the last check: SAT if all is well.
+ */
+static smt_status_t grow_seed(mus_enum_t *e) {
+  ivector_t *mss, *mcs, *candidates;
+  uint32_t i, n;
+  int32_t k;
+  smt_status_t stat;
+
+  mss = &e->seed;
+  mcs = &e->set;
+  candidates = &e->candidates;
+
+  ivector_reset(mss);
+  ivector_reset(mcs);
+  ivector_reset(candidates);
+  n = e->nlits;
+  for (i=0; i<n; i++) {
+    ivector_push(candidates, i);
+  }
+  add_true_assumptions(e, 0);
+
+  for (i=0; i<n; i++) {
+    k = candidates->data[i];
+    if (k < 0) continue;
+
+    ivector_push(mss, k);
+    stat = check_subset(e, &e->plain, mss);
+    if (stat == STATUS_SAT) {
+      add_true_assumptions(e, i+1);
+    } else if (stat == STATUS_UNSAT) {
+      ivector_pop(mss);
+      ivector_push(mcs, k);
+      if (! clear_check(e)) return STATUS_UNSAT;
+    } else {
+      return stat;
+    }
+  }
+
+  ivector_reset(&e->aux_vector);
+  n = mcs->size;
+  for (i=0; i<n; i++) {
+    ivector_push(&e->aux_vector, pos_lit(mcs->data[i] + 1));
+  }
+  add_clause(&e->map, n, e->aux_vector.data);
+
+  return STATUS_SAT;
+}
+
+
+smt_status_t enumerate_mus_mcs(context_t *ctx, const param_t *params, uint32_t n, const literal_t *a,
+			       mus_mcs_fun_t fun, void *aux) {
+  mus_enum_t e;
+  smt_status_t stat;
+
+  assert(context_supports_multichecks(ctx) && context_status(ctx) == STATUS_IDLE);
+
+  init_mus_enum(&e, ctx, params, n, a, fun, aux);
+
+  for (;;) {
+    if (! next_seed(&e)) {
+      // all subsets are explored
+      stat = e.nmus > 0 ? STATUS_UNSAT : STATUS_SAT;
+      break;
+    }
+
+    stat = check_subset(&e, &e.shrink, &e.seed);
+    if (stat == STATUS_UNSAT) {
+      if (! process_mus(&e)) {
+	clear_check(&e);
+	stat = STATUS_INTERRUPTED;
+	break;
+      }
+      if (! clear_check(&e)) {
+	// ctx is unsat by itself: the only MUS is the empty set
+	assert(e.set.size == 0);
+	break;
+      }
+
+    } else if (stat == STATUS_SAT) {
+      stat = grow_seed(&e);
+      if (stat == STATUS_UNSAT) {
+	// ctx is unsat by itself: can't happen since the seed is sat
+	break;
+      }
+      if (stat != STATUS_SAT) {
+	clear_check(&e);
+	break;
+      }
+      if (e.set.size == 0) {
+	// the assumptions are satisfiable: nothing more to do
+	stat = STATUS_SAT;
+	break;
+      }
+      if (! report_set(&e, false, &e.set)) {
+	stat = STATUS_INTERRUPTED;
+	break;
+      }
+
+    } else {
+      // unknown or interrupted
+      if (stat == STATUS_UNKNOWN) clear_check(&e);
+      break;
+    }
+  }
+
+  delete_mus_enum(&e);
+
+  return stat;
+}
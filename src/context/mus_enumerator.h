@@ -0,0 +1,105 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * ENUMERATION OF MINIMAL UNSAT SUBSETS AND MINIMAL CORRECTION SETS
+ */
+
+/*
+ * Given a context ctx and assumptions a[0 ... n-1]:
+ * - an MUS is a subset of the assumptions that's inconsistent with ctx
+ *   and such that all its strict subsets are consistent with ctx.
+ * - an MCS is a subset of the assumptions whose complement is
+ *   consistent with ctx and such that removing any element of the MCS
+ *   from this complement makes it inconsistent. (The complement of an
+ *   MCS is a maximal satisfiable subset or MSS.)
+ *
+ * We use the MARCO algorithm (Liffiton et al., 2016). A map solver
+ * keeps track of the subsets that are already explored. It has one
+ * Boolean variable x_i per assumption and the following clauses:
+ * - for every MUS M found so far: (OR_{i in M} not x_i)
+ *   (i.e., don't explore supersets of M)
+ * - for every MCS C found so far: (OR_{i in C} x_i)
+ *   (i.e., don't explore subsets of the complement of C).
+ *
+ * Each iteration gets a seed S from the map solver (a model with as
+ * many variables true as the map solver can get), then checks the
+ * assumptions of S in ctx:
+ * - if S is unsat, the core is shrunk to an MUS (using check with
+ *   minimize_core), which is reported and blocked;
+ * - if S is sat, S is grown to an MSS (adding first all assumptions
+ *   true in the model, then checking the other ones one by one),
+ *   and the complement of the MSS is reported as an MCS and blocked.
+ * The enumeration is complete when the map solver is unsat.
+ *
+ * All the checks are done in ctx, so the clauses learned in one check
+ * are available in the next ones. The map solver is a separate
+ * smt_core with no theory solver.
+ *
+ * Results are passed to a callback as soon as they're found.
+ */
+
+#ifndef __MUS_ENUMERATOR_H
+#define __MUS_ENUMERATOR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "context/context_types.h"
+
+
+/*
+ * Callback:
+ * - aux = user-provided pointer
+ * - is_mus = true for an MUS, false for an MCS
+ * - idx = array of n indices in the assumption array a, in increasing
+ *   order. If a contains duplicate literals, only the first occurrence
+ *   is used.
+ * - the function must return true to continue the enumeration or
+ *   false to stop it.
+ */
+typedef bool (*mus_mcs_fun_t)(void *aux, bool is_mus, uint32_t n, const uint32_t *idx);
+
+
+/*
+ * Enumerate the MUSes and MCSes of assumptions a[0 ... n-1]
+ * - ctx must support multiple checks and its status must be IDLE
+ * - params = search parameters (must not be NULL)
+ * - fun, aux = callback
+ *
+ * Returned value:
+ * - STATUS_UNSAT if the enumeration is complete and at least one MUS
+ *   was found (i.e., the assumptions are inconsistent with ctx).
+ * - STATUS_SAT if the enumeration is complete and there's no MUS.
+ *   Then the only MCS is the empty set.
+ * - STATUS_UNKNOWN if a check returned UNKNOWN: the enumeration stops
+ *   there since we can't tell whether the seed is sat or unsat.
+ * - STATUS_INTERRUPTED if the callback returned false, or if a check
+ *   was interrupted (by context_stop_search).
+ *
+ * On exit, ctx's status is IDLE, unless a check was interrupted (then
+ * the status is INTERRUPTED) or ctx is unsat without assumptions.
+ *
+ * The MUSes are minimal provided the checks don't return UNKNOWN
+ * during minimization (cf. minimize_core in search_parameters.h).
+ */
+extern smt_status_t enumerate_mus_mcs(context_t *ctx, const param_t *params, uint32_t n, const literal_t *a,
+				      mus_mcs_fun_t fun, void *aux);
+
+
+#endif /* __MUS_ENUMERATOR_H */
@@ -42,6 +42,7 @@ static const char * const param_names[NUM_PARAMETERS] = {
   "c-threshold",
   "cache-tclauses",
   "clause-decay",
+  "core-min-timeout",
   "d-factor",
   "d-threshold",
   "dyn-ack",
@@ -82,13 +83,19 @@ static const char * const param_names[NUM_PARAMETERS] = {
   "max-extensionality",
   "max-interface-eqs",
   "max-update-conflicts",
+  "mcsat-bv-bdd-max-size",
   "mcsat-bv-var-size",
+  "mcsat-lemma-minimize",
   "mcsat-nra-bound",
   "mcsat-nra-bound-max",
   "mcsat-nra-bound-min",
+  "mcsat-nra-explain-threads",
+  "mcsat-nra-icp",
   "mcsat-nra-mgcd",
   "mcsat-nra-nlsat",
+  "mcsat-portfolio",
   "mcsat-var-order",
+  "minimize-core",
   "optimistic-fcheck",
   "prop-threshold",
   "r-factor",
@@ -115,6 +122,7 @@ static const yices_param_t param_code[NUM_PARAMETERS] = {
   PARAM_C_THRESHOLD,
   PARAM_CACHE_TCLAUSES,
   PARAM_CLAUSE_DECAY,
+  PARAM_CORE_MIN_TIMEOUT,
   PARAM_D_FACTOR,
   PARAM_D_THRESHOLD,
   PARAM_DYN_ACK,
@@ -155,13 +163,19 @@ static const yices_param_t param_code[NUM_PARAMETERS] = {
   PARAM_MAX_EXTENSIONALITY,
   PARAM_MAX_INTERFACE_EQS,
   PARAM_MAX_UPDATE_CONFLICTS,
+  PARAM_MCSAT_BV_BDD_MAX_SIZE,
   PARAM_MCSAT_BV_VAR_SIZE,
+  PARAM_MCSAT_LEMMA_MINIMIZE,
   PARAM_MCSAT_NRA_BOUND,
   PARAM_MCSAT_NRA_BOUND_MAX,
   PARAM_MCSAT_NRA_BOUND_MIN,
+  PARAM_MCSAT_NRA_EXPLAIN_THREADS,
+  PARAM_MCSAT_NRA_ICP,
   PARAM_MCSAT_NRA_MGCD,
   PARAM_MCSAT_NRA_NLSAT,
+  PARAM_MCSAT_PORTFOLIO,
   PARAM_MCSAT_VAR_ORDER,
+  PARAM_MINIMIZE_CORE,
   PARAM_OPTIMISTIC_FCHECK,
   PARAM_PROP_THRESHOLD,
   PARAM_R_FACTOR,
@@ -400,6 +414,14 @@ bool param_val_to_posfloat(const char *name, const param_val_t *v, double *value
   return false;
 }
 
+bool param_val_to_nonnegfloat(const char *name, const param_val_t *v, double *value, char **reason) {
+  if (param_val_to_float(name, v, value, reason)) {
+    if (*value >= 0.0) return true;
+    *reason = "must be non-negative";
+  }
+  return false;
+}
+
 // ratio: number between 0 and 1 (inclusive)
 bool param_val_to_ratio(const char *name, const param_val_t *v, double *value, char **reason) {
   if (param_val_to_float(name, v, value, reason)) {
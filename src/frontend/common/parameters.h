@@ -90,6 +90,9 @@ typedef enum yices_param {
   // array solver parameters
   PARAM_MAX_UPDATE_CONFLICTS,
   PARAM_MAX_EXTENSIONALITY,
+  // unsat cores
+  PARAM_MINIMIZE_CORE,
+  PARAM_CORE_MIN_TIMEOUT,
   // EF solver
   PARAM_EF_FLATTEN_IFF,
   PARAM_EF_FLATTEN_ITE,
@@ -121,6 +124,11 @@ typedef enum yices_param {
   PARAM_MCSAT_NRA_BOUND_MIN,
   PARAM_MCSAT_NRA_BOUND_MAX,
   PARAM_MCSAT_BV_VAR_SIZE,
+  PARAM_MCSAT_NRA_EXPLAIN_THREADS,
+  PARAM_MCSAT_NRA_ICP,
+  PARAM_MCSAT_BV_BDD_MAX_SIZE,
+  PARAM_MCSAT_LEMMA_MINIMIZE,
+  PARAM_MCSAT_PORTFOLIO,
   PARAM_MCSAT_VAR_ORDER,
   // error
   PARAM_UNKNOWN
@@ -196,6 +204,7 @@ extern bool param_val_to_pos16(const char *name, const param_val_t *v, int32_t *
 extern bool param_val_to_nonneg32(const char *name, const param_val_t *v, int32_t *value, char **reason);
 extern bool param_val_to_float(const char *name, const param_val_t *v, double *value, char **reason);
 extern bool param_val_to_posfloat(const char *name, const param_val_t *v, double *value, char **reason);
+extern bool param_val_to_nonnegfloat(const char *name, const param_val_t *v, double *value, char **reason);
 extern bool param_val_to_ratio(const char *name, const param_val_t *v, double *value, char **reason);
 extern bool param_val_to_factor(const char *name, const param_val_t *v, double *value, char **reason);
 extern bool param_val_to_terms(const char *name, const param_val_t *v, ivector_t **value, char **reason);
@@ -0,0 +1,190 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * SERVER MODE FOR THE FRONTENDS
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "frontend/common/session_server.h"
+
+#if defined(MINGW)
+
+int32_t serve_sessions(const char *path, const session_limits_t *limits) {
+  (void) path;
+  (void) limits;
+  errno = ENOSYS;
+  return -1;
+}
+
+#else
+
+#include <stdio.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <sys/resource.h>
+
+
+/*
+ * Open the socket and start listening
+ * - return the socket's file descriptor or -1 if there's an error
+ */
+static int open_server_socket(const char *path) {
+  struct sockaddr_un addr;
+  int fd;
+
+  if (strlen(path) >= sizeof(addr.sun_path)) {
+    errno = ENAMETOOLONG;
+    return -1;
+  }
+
+  fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd < 0) return -1;
+
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  strcpy(addr.sun_path, path);
+  (void) unlink(path);
+
+  if (bind(fd, (struct sockaddr *) &addr, sizeof(addr)) < 0 || listen(fd, SOMAXCONN) < 0) {
+    close(fd);
+    return -1;
+  }
+
+  return fd;
+}
+
+
+/*
+ * Set the resource limits in a session process
+ */
+static void set_session_limits(const session_limits_t *limits) {
+  struct rlimit r;
+
+  if (limits->cpu_limit > 0) {
+    r.rlim_cur = limits->cpu_limit;
+    r.rlim_max = limits->cpu_limit + 1; // SIGXCPU first, then SIGKILL
+    (void) setrlimit(RLIMIT_CPU, &r);
+  }
+  if (limits->mem_limit > 0) {
+    r.rlim_cur = ((rlim_t) limits->mem_limit) << 20;
+    r.rlim_max = r.rlim_cur;
+    (void) setrlimit(RLIMIT_AS, &r);
+  }
+}
+
+
+/*
+ * Wait for terminated sessions
+ * - n = number of running sessions
+ * - if block is true, wait until at least one session terminates
+ * - return the new number of running sessions
+ */
+static uint32_t reap_sessions(uint32_t n, bool block) {
+  pid_t pid;
+  int status;
+
+  while (n > 0) {
+    pid = waitpid(-1, &status, block ? 0 : WNOHANG);
+    if (pid > 0) {
+      n --;
+      block = false;
+    } else if (pid < 0 && errno == EINTR) {
+      continue;
+    } else {
+      break;
+    }
+  }
+
+  return n;
+}
+
+
+/*
+ * Session process: connect stdin/stdout to the client
+ */
+static int32_t start_session(int server, int client, int32_t id, const session_limits_t *limits) {
+  close(server);
+  if (dup2(client, STDIN_FILENO) < 0 || dup2(client, STDOUT_FILENO) < 0) {
+    return -1;
+  }
+  close(client);
+  set_session_limits(limits);
+
+  return id;
+}
+
+
+int32_t serve_sessions(const char *path, const session_limits_t *limits) {
+  uint32_t running, count;
+  int server, client, error;
+  pid_t pid;
+
+  server = open_server_socket(path);
+  if (server < 0) return -1;
+
+  // don't copy pending output into every session
+  fflush(stdout);
+  fflush(stderr);
+
+  running = 0;
+  count = 0;
+  for (;;) {
+    running = reap_sessions(running, limits->max_sessions > 0 && running >= limits->max_sessions);
+
+    client = accept(server, NULL, NULL);
+    if (client < 0) {
+      if (errno == EINTR || errno == ECONNABORTED) continue;
+      break;
+    }
+
+    count ++;
+    pid = fork();
+    if (pid == 0) {
+      // session ids are in [1, INT32_MAX]
+      return start_session(server, client, (int32_t) ((count - 1) % INT32_MAX) + 1, limits);
+    }
+    close(client);
+    if (pid < 0) {
+      /*
+       * Can't create the session (most likely out of processes or
+       * memory): drop this client but keep serving. Wait for a running
+       * session to terminate before accepting more.
+       */
+      perror("serve_sessions: fork");
+      fflush(stderr);
+      running = reap_sessions(running, true);
+      continue;
+    }
+    running ++;
+  }
+
+  // error
+  error = errno;
+  close(server);
+  errno = error;
+  return -1;
+}
+
+#endif
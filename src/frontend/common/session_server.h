@@ -0,0 +1,78 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * SERVER MODE FOR THE FRONTENDS
+ */
+
+/*
+ * The server listens on a Unix-domain socket. Every connection is a
+ * session. The server process is initialized once (yices_init and
+ * whatever else the frontend does before calling serve_sessions), then
+ * it forks a child process for every session. In the child, stdin and
+ * stdout are connected to the client and serve_sessions returns, so
+ * the frontend just runs its usual command loop.
+ *
+ * We use processes rather than threads because the global tables
+ * (terms, types, names) and the frontend's state are not thread-safe.
+ * Each session gets a private copy-on-write image of the initialized
+ * server. This is much cheaper than starting a new process with exec:
+ * there's no dynamic linking and no re-initialization.
+ *
+ * Limits:
+ * - max_sessions = maximal number of sessions running concurrently
+ *   (0 means no limit). When the limit is reached, the server waits
+ *   for a session to terminate before accepting new connections.
+ * - cpu_limit = CPU time limit per session in seconds (0 means none).
+ *   When the limit is reached, the session gets SIGXCPU.
+ * - mem_limit = limit on the size of a session's address space
+ *   in megabytes (0 means none). Allocations beyond this limit fail,
+ *   which terminates the session with an out-of-memory error.
+ *
+ * If a session process can't be created, the error is reported on
+ * stderr, the client's connection is closed, and the server keeps
+ * accepting connections.
+ *
+ * This is not supported on Windows.
+ */
+
+#ifndef __FRONTEND_COMMON_SESSION_SERVER_H
+#define __FRONTEND_COMMON_SESSION_SERVER_H
+
+#include <stdint.h>
+
+typedef struct session_limits_s {
+  uint32_t max_sessions;
+  uint32_t cpu_limit;
+  uint32_t mem_limit;
+} session_limits_t;
+
+
+/*
+ * Run the server on the socket of the given path
+ * - if the path exists, it's removed first
+ * - in the server process, this function returns only if there's an error:
+ *   the returned value is then -1 and errno is set
+ * - in a session process, this function returns the session id
+ *   (a positive integer). stdin and stdout are then the connection
+ *   to the client, and the limits are set.
+ */
+extern int32_t serve_sessions(const char *path, const session_limits_t *limits);
+
+
+#endif /* __FRONTEND_COMMON_SESSION_SERVER_H */
@@ -0,0 +1,806 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * BINARY FORMAT FOR SMT2 COMMANDS
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <string.h>
+
+#include "api/yices_globals.h"
+#include "frontend/smt2/smt2_binary.h"
+#include "utils/memalloc.h"
+
+#include "yices.h"
+#include "api/yices_extensions.h"
+
+
+/*
+ * CONVERTER
+ */
+
+static bin_writer_t writer;
+static FILE *output;
+
+int32_t smt2_open_binary_output(const char *filename) {
+  assert(__smt2_globals.bin_out == NULL);
+
+  output = fopen(filename, "wb");
+  if (output == NULL) {
+    return -1;
+  }
+  init_bin_writer(&writer, output, __yices_globals.terms);
+  __smt2_globals.bin_out = &writer;
+
+  return 0;
+}
+
+int32_t smt2_close_binary_output(void) {
+  int32_t code;
+  int err;
+
+  assert(__smt2_globals.bin_out == &writer);
+
+  delete_bin_writer(&writer);
+  __smt2_globals.bin_out = NULL;
+
+  code = 0;
+  err = 0;
+  if (writer.failed) {
+    code = -1;
+    err = writer.errcode;
+  }
+  if (fclose(output) == EOF && code == 0) {
+    code = -1;
+    err = errno;
+  }
+  output = NULL;
+  errno = err;
+
+  return code;
+}
+
+
+/*
+ * Attribute value v (may be AVAL_NULL)
+ */
+static void bin_write_aval(bin_writer_t *w, attr_vtbl_t *tbl, aval_t v) {
+  bvconst_attr_t *bv;
+  attr_list_t *list;
+  uint32_t i, n;
+
+  if (v == AVAL_NULL) {
+    bin_write_byte(w, ATTR_DELETED);
+    return;
+  }
+
+  bin_write_byte(w, aval_tag(tbl, v));
+  switch (aval_tag(tbl, v)) {
+  case ATTR_RATIONAL:
+    bin_write_rational(w, aval_rational(tbl, v));
+    break;
+
+  case ATTR_BV:
+    bv = aval_bvconst(tbl, v);
+    bin_write_uint(w, bv->nbits);
+    bin_write_bvconst(w, bv->nbits, bv->data);
+    break;
+
+  case ATTR_STRING:
+    bin_write_string(w, aval_string(tbl, v));
+    break;
+
+  case ATTR_SYMBOL:
+    bin_write_string(w, aval_symbol(tbl, v));
+    break;
+
+  case ATTR_LIST:
+    list = aval_list(tbl, v);
+    n = list->nelems;
+    bin_write_uint(w, n);
+    for (i=0; i<n; i++) {
+      bin_write_aval(w, tbl, list->data[i]);
+    }
+    break;
+
+  default:
+    assert(false);
+    break;
+  }
+}
+
+
+/*
+ * Commands
+ */
+void bin_write_smt2_cmd(bin_writer_t *w, bin_smt2_cmd_t cmd) {
+  bin_write_byte(w, cmd);
+}
+
+void bin_write_smt2_name_cmd(bin_writer_t *w, bin_smt2_cmd_t cmd, const char *name) {
+  bin_write_byte(w, cmd);
+  bin_write_string(w, name);
+}
+
+void bin_write_smt2_aval_cmd(bin_writer_t *w, bin_smt2_cmd_t cmd, const char *name, aval_t value) {
+  bin_write_byte(w, cmd);
+  bin_write_string(w, name);
+  bin_write_aval(w, __smt2_globals.avtbl, value);
+}
+
+void bin_write_smt2_uint_cmd(bin_writer_t *w, bin_smt2_cmd_t cmd, uint32_t n) {
+  bin_write_byte(w, cmd);
+  bin_write_uint(w, n);
+}
+
+/*
+ * Define all terms in a[0 ... n-1]
+ */
+static bool bin_write_term_defs(bin_writer_t *w, uint32_t n, const term_t *a) {
+  uint32_t i;
+
+  for (i=0; i<n; i++) {
+    if (! bin_write_term_def(w, a[i])) return false;
+  }
+  return true;
+}
+
+static void bin_write_term_refs(bin_writer_t *w, uint32_t n, const term_t *a) {
+  uint32_t i;
+
+  for (i=0; i<n; i++) {
+    bin_write_term_ref(w, a[i]);
+  }
+}
+
+bool bin_write_smt2_assert(bin_writer_t *w, term_t t, bool special) {
+  if (! bin_write_term_def(w, t)) return false;
+  bin_write_byte(w, BIN_CMD_ASSERT);
+  bin_write_term_ref(w, t);
+  bin_write_byte(w, special);
+  return true;
+}
+
+void bin_write_smt2_check_sat_assuming(bin_writer_t *w, uint32_t n, signed_symbol_t *a) {
+  uint32_t i;
+
+  bin_write_byte(w, BIN_CMD_CHECK_SAT_ASSUMING);
+  bin_write_uint(w, n);
+  for (i=0; i<n; i++) {
+    bin_write_string(w, a[i].name);
+    bin_write_byte(w, a[i].polarity);
+  }
+}
+
+bool bin_write_smt2_check_sat_assuming_model(bin_writer_t *w, uint32_t n, const term_t vars[], const term_t values[]) {
+  if (! bin_write_term_defs(w, n, vars) || ! bin_write_term_defs(w, n, values)) {
+    return false;
+  }
+  bin_write_byte(w, BIN_CMD_CHECK_SAT_ASSUMING_MODEL);
+  bin_write_uint(w, n);
+  bin_write_term_refs(w, n, vars);
+  bin_write_term_refs(w, n, values);
+  return true;
+}
+
+/*
+ * Declare-sort: id = the new type if arity is 0, the new type constructor otherwise
+ */
+void bin_write_smt2_declare_sort(bin_writer_t *w, const char *name, uint32_t arity, int32_t id) {
+  bin_write_byte(w, BIN_CMD_DECLARE_SORT);
+  bin_write_string(w, name);
+  bin_write_uint(w, arity);
+  if (arity == 0) {
+    bin_writer_register_type(w, id);
+  } else {
+    bin_writer_register_macro(w, id);
+  }
+}
+
+/*
+ * Define-sort: id = the new macro if n > 0 (ignored otherwise)
+ */
+bool bin_write_smt2_define_sort(bin_writer_t *w, const char *name, uint32_t n, type_t *var, type_t body, int32_t id) {
+  uint32_t i;
+
+  for (i=0; i<n; i++) {
+    if (! bin_write_type_def(w, var[i])) return false;
+  }
+  if (! bin_write_type_def(w, body)) return false;
+
+  bin_write_byte(w, BIN_CMD_DEFINE_SORT);
+  bin_write_string(w, name);
+  bin_write_uint(w, n);
+  for (i=0; i<n; i++) {
+    bin_write_type_ref(w, var[i]);
+  }
+  bin_write_type_ref(w, body);
+  if (n > 0) {
+    bin_writer_register_macro(w, id);
+  }
+  return true;
+}
+
+/*
+ * Declare-fun: t = the new term
+ */
+bool bin_write_smt2_declare_fun(bin_writer_t *w, const char *name, uint32_t n, type_t *tau, term_t t) {
+  uint32_t i;
+
+  for (i=0; i<n; i++) {
+    if (! bin_write_type_def(w, tau[i])) return false;
+  }
+  bin_write_byte(w, BIN_CMD_DECLARE_FUN);
+  bin_write_string(w, name);
+  bin_write_uint(w, n);
+  for (i=0; i<n; i++) {
+    bin_write_type_ref(w, tau[i]);
+  }
+  bin_writer_register_term(w, t);
+  return true;
+}
+
+bool bin_write_smt2_define_fun(bin_writer_t *w, const char *name, term_t t) {
+  if (! bin_write_term_def(w, t)) return false;
+  bin_write_byte(w, BIN_CMD_DEFINE_FUN);
+  bin_write_string(w, name);
+  bin_write_term_ref(w, t);
+  return true;
+}
+
+/*
+ * Get-value: we also write the tokens so that the reader can print
+ * the terms as they were given.
+ * - each token is written as 0 for '(', 1 for ')', or key + 2
+ *   followed by val, a flag (1 if the token has a string), and the string
+ */
+bool bin_write_smt2_get_value(bin_writer_t *w, term_t *a, uint32_t n, etk_queue_t *queue) {
+  etoken_t *tk;
+  uint32_t i;
+
+  if (! bin_write_term_defs(w, n, a)) return false;
+  bin_write_byte(w, BIN_CMD_GET_VALUE);
+  bin_write_uint(w, n);
+  bin_write_term_refs(w, n, a);
+
+  bin_write_uint(w, queue->top);
+  for (i=0; i<queue->top; i++) {
+    tk = queue->tk + i;
+    switch (tk->key) {
+    case ETK_OPEN:
+      bin_write_uint(w, 0);
+      break;
+
+    case ETK_CLOSE:
+      bin_write_uint(w, 1);
+      break;
+
+    default:
+      assert(tk->key >= 0);
+      bin_write_uint(w, (uint64_t) tk->key + 2);
+      bin_write_int(w, tk->val);
+      if (tk->ptr == NULL) {
+        bin_write_byte(w, 0);
+      } else {
+        bin_write_byte(w, 1);
+        bin_write_string(w, tk->ptr);
+      }
+      break;
+    }
+  }
+
+  return true;
+}
+
+bool bin_write_smt2_add_name(bin_writer_t *w, int32_t op, term_t t, const char *name) {
+  if (! bin_write_term_def(w, t)) return false;
+  bin_write_byte(w, BIN_CMD_ADD_NAME);
+  bin_write_int(w, op);
+  bin_write_term_ref(w, t);
+  bin_write_string(w, name);
+  return true;
+}
+
+bool bin_write_smt2_add_pattern(bin_writer_t *w, int32_t op, term_t t, term_t *p, uint32_t n) {
+  if (! bin_write_term_def(w, t) || ! bin_write_term_defs(w, n, p)) {
+    return false;
+  }
+  bin_write_byte(w, BIN_CMD_ADD_PATTERN);
+  bin_write_int(w, op);
+  bin_write_term_ref(w, t);
+  bin_write_uint(w, n);
+  bin_write_term_refs(w, n, p);
+  return true;
+}
+
+
+
+/*
+ * READER
+ */
+
+static bin_reader_t reader;
+
+/*
+ * Arguments of the current command
+ * - args = terms or types
+ * - aux = second array of terms
+ */
+static ivector_t args;
+static ivector_t aux;
+
+static const char * const bin_error_msg[] = {
+  "no error",
+  "read error",
+  "not a binary SMT2 file",
+  "unexpected end of file",
+  "invalid opcode",
+  "invalid reference",
+  "invalid value",
+};
+
+
+/*
+ * Read n term or type references into v
+ */
+static void read_term_refs(bin_reader_t *r, ivector_t *v, uint32_t n) {
+  uint32_t i;
+
+  ivector_reset(v);
+  for (i=0; i<n; i++) {
+    ivector_push(v, bin_read_term_ref(r));
+  }
+}
+
+static void read_type_refs(bin_reader_t *r, ivector_t *v, uint32_t n) {
+  uint32_t i;
+
+  ivector_reset(v);
+  for (i=0; i<n; i++) {
+    ivector_push(v, bin_read_type_ref(r));
+  }
+}
+
+
+/*
+ * Attribute value: the result has refcount 0
+ */
+static aval_t read_aval(bin_reader_t *r, attr_vtbl_t *tbl) {
+  aval_t *a;
+  aval_t v;
+  uint32_t i, n, tag;
+
+  tag = bin_read_byte(r);
+  switch (tag) {
+  case ATTR_DELETED:
+    v = AVAL_NULL;
+    break;
+
+  case ATTR_RATIONAL:
+    v = attr_vtbl_rational(tbl, bin_read_rational(r));
+    break;
+
+  case ATTR_BV:
+    n = bin_read_bitsize(r);
+    v = attr_vtbl_bv(tbl, n, bin_read_bvconst(r, n));
+    break;
+
+  case ATTR_STRING:
+  case ATTR_SYMBOL:
+    v = attr_vtbl_str(tbl, bin_read_string(r, NULL), tag);
+    break;
+
+  case ATTR_LIST:
+    n = bin_read_uint32(r);
+    if (n > MAX_ATTR_LIST_SIZE) {
+      bin_reader_error(r, BIN_BAD_VALUE);
+    }
+    a = (aval_t *) safe_malloc(n * sizeof(aval_t));
+    for (i=0; i<n; i++) {
+      a[i] = read_aval(r, tbl);
+      if (a[i] == AVAL_NULL) {
+        safe_free(a);
+        bin_reader_error(r, BIN_BAD_VALUE);
+      }
+    }
+    v = attr_vtbl_list(tbl, n, a);
+    safe_free(a);
+    break;
+
+  default:
+    bin_reader_error(r, BIN_BAD_VALUE);
+  }
+
+  return v;
+}
+
+static void read_set_option(bin_reader_t *r, bool info) {
+  attr_vtbl_t *tbl;
+  char *name;
+  aval_t v;
+
+  tbl = __smt2_globals.avtbl;
+  name = bin_read_string_copy(r);
+  v = read_aval(r, tbl);
+  if (v == AVAL_NULL) {
+    if (info) {
+      smt2_set_info(name, AVAL_NULL);
+    } else {
+      smt2_set_option(name, AVAL_NULL);
+    }
+  } else {
+    aval_incref(tbl, v);
+    if (info) {
+      smt2_set_info(name, v);
+    } else {
+      smt2_set_option(name, v);
+    }
+    aval_decref(tbl, v);
+  }
+  safe_free(name);
+}
+
+static void read_check_sat_assuming(bin_reader_t *r) {
+  signed_symbol_t *a;
+  uint32_t i, n;
+
+  n = bin_read_uint32(r);
+  if (n > YICES_MAX_ARITY) {
+    bin_reader_error(r, BIN_BAD_VALUE);
+  }
+  a = (signed_symbol_t *) safe_malloc(n * sizeof(signed_symbol_t));
+  for (i=0; i<n; i++) {
+    a[i].name = bin_read_string_copy(r);
+    a[i].polarity = bin_read_byte(r);
+  }
+  smt2_check_sat_assuming(n, a);
+  for (i=0; i<n; i++) {
+    safe_free((char *) a[i].name);
+  }
+  safe_free(a);
+}
+
+static void read_check_sat_assuming_model(bin_reader_t *r) {
+  uint32_t n;
+
+  n = bin_read_uint32(r);
+  read_term_refs(r, &args, n);
+  read_term_refs(r, &aux, n);
+  smt2_check_sat_assuming_model(n, args.data, aux.data);
+}
+
+static void read_declare_sort(bin_reader_t *r) {
+  const char *name;
+  type_t tau;
+  int32_t macro;
+  uint32_t arity;
+
+  name = bin_read_string(r, NULL);
+  arity = bin_read_uint32(r);
+  smt2_declare_sort(name, arity);
+  if (arity == 0) {
+    tau = yices_get_type_by_name(name);
+    if (tau == NULL_TYPE) bin_reader_error(r, BIN_BAD_VALUE);
+    bin_reader_register_type(r, tau);
+  } else {
+    macro = yices_get_macro_by_name(name);
+    if (macro < 0) bin_reader_error(r, BIN_BAD_VALUE);
+    bin_reader_register_macro(r, macro);
+  }
+}
+
+static void read_define_sort(bin_reader_t *r) {
+  char *name;
+  type_t body;
+  int32_t macro;
+  uint32_t n;
+
+  name = bin_read_string_copy(r);
+  n = bin_read_uint32(r);
+  read_type_refs(r, &args, n);
+  body = bin_read_type_ref(r);
+  smt2_define_sort(name, n, args.data, body);
+  if (n > 0) {
+    macro = yices_get_macro_by_name(name);
+    if (macro < 0) {
+      safe_free(name);
+      bin_reader_error(r, BIN_BAD_VALUE);
+    }
+    bin_reader_register_macro(r, macro);
+  }
+  safe_free(name);
+}
+
+static void read_declare_fun(bin_reader_t *r) {
+  char *name;
+  term_t t;
+  uint32_t n;
+
+  name = bin_read_string_copy(r);
+  n = bin_read_uint32(r);
+  if (n == 0 || n > YICES_MAX_ARITY + 1) {
+    safe_free(name);
+    bin_reader_error(r, BIN_BAD_VALUE);
+  }
+  read_type_refs(r, &args, n);
+  smt2_declare_fun(name, n, args.data);
+  t = yices_get_term_by_name(name);
+  safe_free(name);
+  if (t == NULL_TERM) {
+    bin_reader_error(r, BIN_BAD_VALUE);
+  }
+  bin_reader_register_term(r, t);
+}
+
+static void read_define_fun(bin_reader_t *r) {
+  char *name;
+  term_t t;
+
+  name = bin_read_string_copy(r);
+  t = bin_read_term_ref(r);
+  smt2_define_fun(name, 0, NULL, t, term_type(r->terms, t));
+  safe_free(name);
+}
+
+/*
+ * Get-value: rebuild the token queue then check that it's consistent
+ * with the n terms (as smt2_get_value expects).
+ */
+static void read_get_value(bin_reader_t *r) {
+  etk_queue_t *queue;
+  const char *s;
+  uint64_t key;
+  uint32_t i, n, ntokens, len;
+  int32_t val;
+  bool ok;
+
+  n = bin_read_uint32(r);
+  read_term_refs(r, &args, n);
+
+  queue = smt2_token_queue();
+  reset_etk_queue(queue);
+  ntokens = bin_read_uint32(r);
+  for (i=0; i<ntokens; i++) {
+    key = bin_read_uint(r);
+    if (key == 0) {
+      etk_queue_open_scope(queue);
+    } else if (key == 1) {
+      if (! etk_queue_is_open(queue)) goto bad_tokens;
+      etk_queue_close_scope(queue);
+    } else {
+      if (key - 2 > INT32_MAX) goto bad_tokens;
+      val = bin_read_int(r);
+      s = NULL;
+      len = 0;
+      if (bin_read_byte(r)) {
+        s = bin_read_string(r, &len);
+      }
+      etk_queue_push_token(queue, (int32_t) (key - 2), val, s, len);
+    }
+  }
+
+  ok = n > 0 && good_token(queue, 2) && start_token(queue, 2);
+  if (ok) {
+    ivector_reset(&aux);
+    collect_subexpr(queue, 2, &aux);
+    ok = aux.size == n;
+  }
+  if (! ok) goto bad_tokens;
+
+  smt2_get_value(args.data, n);
+  reset_etk_queue(queue);
+  return;
+
+ bad_tokens:
+  reset_etk_queue(queue);
+  bin_reader_error(r, BIN_BAD_VALUE);
+}
+
+static void read_add_pattern(bin_reader_t *r) {
+  term_t t;
+  int32_t op;
+  uint32_t n;
+
+  op = bin_read_int(r);
+  t = bin_read_term_ref(r);
+  n = bin_read_uint32(r);
+  read_term_refs(r, &args, n);
+  smt2_add_pattern(op, t, args.data, n);
+}
+
+
+/*
+ * Read and execute one command
+ */
+static void read_command(bin_reader_t *r, uint32_t op) {
+  term_t t;
+  int32_t k;
+  bool special;
+
+  switch (op) {
+  case BIN_CMD_SET_LOGIC:
+    smt2_set_logic(bin_read_string(r, NULL));
+    break;
+
+  case BIN_CMD_SET_OPTION:
+    read_set_option(r, false);
+    break;
+
+  case BIN_CMD_SET_INFO:
+    read_set_option(r, true);
+    break;
+
+  case BIN_CMD_GET_OPTION:
+    smt2_get_option(bin_read_string(r, NULL));
+    break;
+
+  case BIN_CMD_GET_INFO:
+    smt2_get_info(bin_read_string(r, NULL));
+    break;
+
+  case BIN_CMD_PUSH:
+    smt2_push(bin_read_uint32(r));
+    break;
+
+  case BIN_CMD_POP:
+    smt2_pop(bin_read_uint32(r));
+    break;
+
+  case BIN_CMD_ASSERT:
+    t = bin_read_term_ref(r);
+    special = bin_read_byte(r);
+    smt2_assert(t, special);
+    break;
+
+  case BIN_CMD_CHECK_SAT:
+    smt2_check_sat();
+    break;
+
+  case BIN_CMD_CHECK_SAT_ASSUMING:
+    read_check_sat_assuming(r);
+    break;
+
+  case BIN_CMD_CHECK_SAT_ASSUMING_MODEL:
+    read_check_sat_assuming_model(r);
+    break;
+
+  case BIN_CMD_DECLARE_SORT:
+    read_declare_sort(r);
+    break;
+
+  case BIN_CMD_DEFINE_SORT:
+    read_define_sort(r);
+    break;
+
+  case BIN_CMD_DECLARE_FUN:
+    read_declare_fun(r);
+    break;
+
+  case BIN_CMD_DEFINE_FUN:
+    read_define_fun(r);
+    break;
+
+  case BIN_CMD_GET_VALUE:
+    read_get_value(r);
+    break;
+
+  case BIN_CMD_GET_MODEL:
+    smt2_get_model();
+    break;
+
+  case BIN_CMD_GET_ASSIGNMENT:
+    smt2_get_assignment();
+    break;
+
+  case BIN_CMD_GET_ASSERTIONS:
+    smt2_get_assertions();
+    break;
+
+  case BIN_CMD_GET_PROOF:
+    smt2_get_proof();
+    break;
+
+  case BIN_CMD_GET_UNSAT_CORE:
+    smt2_get_unsat_core();
+    break;
+
+  case BIN_CMD_GET_UNSAT_ASSUMPTIONS:
+    smt2_get_unsat_assumptions();
+    break;
+
+  case BIN_CMD_GET_UNSAT_MODEL_INTERPOLANT:
+    smt2_get_unsat_model_interpolant();
+    break;
+
+  case BIN_CMD_ECHO:
+    smt2_echo(bin_read_string(r, NULL));
+    break;
+
+  case BIN_CMD_RESET_ASSERTIONS:
+    smt2_reset_assertions();
+    break;
+
+  case BIN_CMD_RESET:
+    smt2_reset_all();
+    break;
+
+  case BIN_CMD_EXIT:
+    smt2_exit();
+    break;
+
+  case BIN_CMD_ADD_NAME:
+    k = bin_read_int(r);
+    t = bin_read_term_ref(r);
+    smt2_add_name(k, t, bin_read_string(r, NULL));
+    break;
+
+  case BIN_CMD_ADD_PATTERN:
+    read_add_pattern(r);
+    break;
+
+  default:
+    bin_reader_error(r, BIN_BAD_OPCODE);
+  }
+}
+
+
+int32_t smt2_run_binary(FILE *f, const char *name) {
+  volatile int32_t code;
+  bin_error_t error;
+  uint32_t op;
+
+  init_bin_reader(&reader, f, __yices_globals.manager);
+  init_ivector(&args, 10);
+  init_ivector(&aux, 10);
+  __smt2_globals.bin_in = &reader;
+
+  code = 0;
+  error = setjmp(reader.env);
+  if (error == BIN_NO_ERROR) {
+    bin_read_header(&reader);
+    while (smt2_active()) {
+      if (bin_reader_eof(&reader)) {
+        smt2_silent_exit();
+        break;
+      }
+      op = bin_read_byte(&reader);
+      if (op < BIN_CLIENT_OP) {
+        bin_read_def(&reader, op);
+      } else {
+        read_command(&reader, op);
+      }
+    }
+  } else {
+    if (error == BIN_READ_ERROR) {
+      fprintf(stderr, "%s: %s\n", name, strerror(reader.errcode));
+    } else {
+      fprintf(stderr, "%s: %s\n", name, bin_error_msg[error]);
+    }
+    fflush(stderr);
+    code = -1;
+  }
+
+  __smt2_globals.bin_in = NULL;
+  delete_ivector(&args);
+  delete_ivector(&aux);
+  delete_bin_reader(&reader);
+
+  return code;
+}
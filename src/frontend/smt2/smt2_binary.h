@@ -0,0 +1,150 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * BINARY FORMAT FOR SMT2 COMMANDS
+ */
+
+/*
+ * A binary SMT2 file is a stream in the format of io/binary_terms.h.
+ * Each command is a record with an opcode from the client range.
+ * The terms and types a command refers to are defined just before it.
+ *
+ * Binary files are produced by yices_smt2 --write-binary=<file>:
+ * the SMT2 input is parsed as usual and the commands are written
+ * instead of being executed. Declarations, definitions, push/pop,
+ * and resets are still executed so that names are resolved, but
+ * assertions are not processed and check-sat doesn't solve anything.
+ *
+ * The reader (yices_smt2 --binary-input) replays the commands by
+ * calling the functions of smt2_commands.h so the output is the same
+ * as for the original SMT2 input. Commands that fail in the converter
+ * (e.g., declarations with an undefined sort) are reported there.
+ * They're not written to the binary file.
+ *
+ * Declared terms, sorts, and type constructors are not defined in
+ * the stream: they're registered by the declare-fun, declare-sort,
+ * and define-sort records on both sides.
+ */
+
+#ifndef __SMT2_BINARY_H
+#define __SMT2_BINARY_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "frontend/smt2/attribute_values.h"
+#include "frontend/smt2/smt2_commands.h"
+#include "io/binary_terms.h"
+
+
+/*
+ * Command opcodes and their arguments
+ */
+typedef enum bin_smt2_cmd {
+  BIN_CMD_SET_LOGIC = BIN_CLIENT_OP,   // name
+  BIN_CMD_SET_OPTION,                  // name + attribute value
+  BIN_CMD_SET_INFO,                    // name + attribute value
+  BIN_CMD_GET_OPTION,                  // name
+  BIN_CMD_GET_INFO,                    // name
+  BIN_CMD_PUSH,                        // n
+  BIN_CMD_POP,                         // n
+  BIN_CMD_ASSERT,                      // term + special flag
+  BIN_CMD_CHECK_SAT,
+  BIN_CMD_CHECK_SAT_ASSUMING,          // n + n pairs (name, polarity)
+  BIN_CMD_CHECK_SAT_ASSUMING_MODEL,    // n + n variables + n values
+  BIN_CMD_DECLARE_SORT,                // name + arity
+  BIN_CMD_DEFINE_SORT,                 // name + n + n type variables + body
+  BIN_CMD_DECLARE_FUN,                 // name + n + n types
+  BIN_CMD_DEFINE_FUN,                  // name + term
+  BIN_CMD_GET_VALUE,                   // n + n terms + expression tokens
+  BIN_CMD_GET_MODEL,
+  BIN_CMD_GET_ASSIGNMENT,
+  BIN_CMD_GET_ASSERTIONS,
+  BIN_CMD_GET_PROOF,
+  BIN_CMD_GET_UNSAT_CORE,
+  BIN_CMD_GET_UNSAT_ASSUMPTIONS,
+  BIN_CMD_GET_UNSAT_MODEL_INTERPOLANT,
+  BIN_CMD_ECHO,                        // string
+  BIN_CMD_RESET_ASSERTIONS,
+  BIN_CMD_RESET,
+  BIN_CMD_EXIT,
+  BIN_CMD_ADD_NAME,                    // op + term + name
+  BIN_CMD_ADD_PATTERN,                 // op + term + n + n terms
+} bin_smt2_cmd_t;
+
+#define BIN_CMD_LAST BIN_CMD_ADD_PATTERN
+
+
+/*
+ * CONVERTER
+ */
+
+/*
+ * Open filename and start converting: the SMT2 commands are written to
+ * this file from now on (see smt2_commands.c).
+ * - return 0 if the file was opened, -1 otherwise (errno is set)
+ */
+extern int32_t smt2_open_binary_output(const char *filename);
+
+/*
+ * Flush and close the binary output
+ * - return 0 if everything was written, -1 otherwise (errno is set)
+ */
+extern int32_t smt2_close_binary_output(void);
+
+
+/*
+ * Write a command to w.
+ * - the functions that take terms or types return false if one of
+ *   them can't be written (e.g., an algebraic root atom)
+ * - for the declarations, id/t is the new type, macro, or term:
+ *   it's registered in w
+ */
+extern void bin_write_smt2_cmd(bin_writer_t *w, bin_smt2_cmd_t cmd);
+extern void bin_write_smt2_name_cmd(bin_writer_t *w, bin_smt2_cmd_t cmd, const char *name);
+extern void bin_write_smt2_aval_cmd(bin_writer_t *w, bin_smt2_cmd_t cmd, const char *name, aval_t value);
+extern void bin_write_smt2_uint_cmd(bin_writer_t *w, bin_smt2_cmd_t cmd, uint32_t n);
+extern bool bin_write_smt2_assert(bin_writer_t *w, term_t t, bool special);
+extern void bin_write_smt2_check_sat_assuming(bin_writer_t *w, uint32_t n, signed_symbol_t *a);
+extern bool bin_write_smt2_check_sat_assuming_model(bin_writer_t *w, uint32_t n, const term_t vars[], const term_t values[]);
+extern void bin_write_smt2_declare_sort(bin_writer_t *w, const char *name, uint32_t arity, int32_t id);
+extern bool bin_write_smt2_define_sort(bin_writer_t *w, const char *name, uint32_t n, type_t *var, type_t body, int32_t id);
+extern bool bin_write_smt2_declare_fun(bin_writer_t *w, const char *name, uint32_t n, type_t *tau, term_t t);
+extern bool bin_write_smt2_define_fun(bin_writer_t *w, const char *name, term_t t);
+extern bool bin_write_smt2_get_value(bin_writer_t *w, term_t *a, uint32_t n, etk_queue_t *queue);
+extern bool bin_write_smt2_add_name(bin_writer_t *w, int32_t op, term_t t, const char *name);
+extern bool bin_write_smt2_add_pattern(bin_writer_t *w, int32_t op, term_t t, term_t *p, uint32_t n);
+
+
+/*
+ * READER
+ */
+
+/*
+ * Read and execute all the commands from f
+ * - name = file name for error messages
+ * - stop on exit, at the end of the file, or on the first error
+ * - return 0 if the file was read without error, -1 otherwise
+ *   (the error is reported on stderr)
+ */
+extern int32_t smt2_run_binary(FILE *f, const char *name);
+
+
+#endif /* __SMT2_BINARY_H */
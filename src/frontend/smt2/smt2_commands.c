@@ -41,13 +41,16 @@
 #include "api/yices_globals.h"
 #include "api/yices_mutex.h"
 #include "context/context.h"
+#include "context/context_telemetry.h"
 #include "frontend/common/bug_report.h"
 #include "frontend/common/parameters.h"
 #include "frontend/common/tables.h"
 #include "frontend/smt2/attribute_values.h"
+#include "frontend/smt2/smt2_binary.h"
 #include "frontend/smt2/smt2_commands.h"
 #include "frontend/smt2/smt2_model_printer.h"
 #include "frontend/smt2/smt2_printer.h"
+#include "frontend/smt2/smt2_stream_printer.h"
 #include "io/term_printer.h"
 #include "frontend/smt2/smt2_symbol_printer.h"
 #include "mcsat/options.h"
@@ -2377,7 +2380,7 @@ static void print_terms_value(smt2_globals_t *g, const ivector_t* order) {
   pp_open_block(&printer.pp, PP_OPEN_VPAR); // open '('
   if (order != NULL) {
     for (uint32_t i = 0; i < order->size; ++ i) {
-      pp_term_full(&printer.pp, __yices_globals.terms, order->data[i]);
+      pp_term_dag(&printer.pp, __yices_globals.terms, order->data[i]);
     }
   } else {
     pp_string(&printer.pp,"null");
@@ -2617,6 +2620,9 @@ static void init_smt2_context(smt2_globals_t *g) {
   if (g->verbosity > 0 || g->tracer != NULL) {
     context_set_trace(g->ctx, get_tracer(g));
   }
+  if (g->telemetry != NULL && arch != CTX_ARCH_MCSAT) {
+    context_enable_telemetry(g->ctx, g->telemetry, NULL, NULL, g->telemetry_period);
+  }
 
   // Set the mcsat options
   g->ctx->mcsat_options = g->mcsat_options;
@@ -2638,6 +2644,8 @@ static void init_smt2_context(smt2_globals_t *g) {
 static void init_search_parameters(smt2_globals_t *g) {
   assert(g->ctx != NULL);
   yices_default_params_for_context(g->ctx, &g->parameters);
+  g->parameters.minimize_core = g->minimize_core;
+  g->parameters.core_min_timeout = g->core_min_timeout;
 }
 
 
@@ -3826,6 +3834,111 @@ static void print_term_value_list(smt2_pp_t *printer, value_table_t *vtbl, etk_q
 }
 
 
+/*
+ * Large outputs: if there are at least SMT2_STREAM_THRESHOLD values
+ * to print, and all of them are scalar, we bypass the pretty printer
+ * and write them with smt2_stream_printer. Each pair or definition is
+ * then printed on a single line.
+ *
+ * The pretty printer keeps a pair or definition on one line if the line
+ * fits in g->pp_area.width, including the indentation and the closing
+ * parentheses of the list. Otherwise it breaks the line. To keep the
+ * same layout, the streaming functions measure every line first and
+ * print nothing if one of them is too long: the caller then uses the
+ * pretty printer.
+ */
+#define SMT2_STREAM_THRESHOLD 1000
+
+/*
+ * Check whether all values in v[0 ... n-1] can be streamed
+ * - negative values are skipped (they are printed as ??? in get-value
+ *   and ignored in get-model).
+ */
+static bool values_can_stream(value_table_t *vtbl, value_t *v, uint32_t n) {
+  uint32_t i;
+
+  if (n < SMT2_STREAM_THRESHOLD) return false;
+
+  for (i=0; i<n; i++) {
+    if (v[i] >= 0 && !smt2_stream_supports(vtbl, v[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/*
+ * Pair (expr value) of a value list
+ */
+static void stream_term_value(smt2_globals_t *g, smt2_stream_t *stream, value_table_t *vtbl, etk_queue_t *token_queue,
+                              int32_t expr, value_t x, type_t tau) {
+  smt2_stream_char(stream, '(');
+  smt2_stream_expr(stream, token_queue, expr);
+  smt2_stream_char(stream, ' ');
+  smt2_stream_object(stream, vtbl, x, g->clean_model_format ? NULL_TYPE : tau);
+  smt2_stream_char(stream, ')');
+}
+
+/*
+ * Check whether all lines of the list fit in the width: each line is
+ * '(' or ' ' followed by a pair, and the last line ends with ')'.
+ */
+static bool term_value_list_fits(smt2_globals_t *g, value_table_t *vtbl, etk_queue_t *token_queue,
+                                 int32_t *expr, value_t *v, type_t *tau, uint32_t n) {
+  smt2_stream_t stream;
+  uint32_t i, len;
+  value_t x, u;
+  bool fits;
+
+  u = vtbl_mk_unknown(vtbl);
+
+  fits = true;
+  init_smt2_stream(&stream, NULL, g->bvconst_in_decimal);
+  for (i=0; i<n && fits; i++) {
+    x = v[i];
+    if (x < 0) x = u;
+    smt2_stream_discard(&stream);
+    stream_term_value(g, &stream, vtbl, token_queue, expr[i], x, tau[i]);
+    len = 1 + smt2_stream_length(&stream) + (i == n-1);
+    fits = len <= g->pp_area.width;
+  }
+  delete_smt2_stream(&stream);
+
+  return fits;
+}
+
+/*
+ * Streaming version of print_term_value_list
+ * - same layout as the pretty printer in vertical mode
+ * - return false and print nothing if a line is too long
+ */
+static bool stream_term_value_list(smt2_globals_t *g, value_table_t *vtbl, etk_queue_t *token_queue,
+                                   int32_t *expr, value_t *v, type_t *tau, uint32_t n) {
+  smt2_stream_t stream;
+  uint32_t i;
+  value_t x, u;
+
+  if (! term_value_list_fits(g, vtbl, token_queue, expr, v, tau, n)) {
+    return false;
+  }
+
+  u = vtbl_mk_unknown(vtbl);
+
+  init_smt2_stream(&stream, g->out, g->bvconst_in_decimal);
+  smt2_stream_char(&stream, '(');
+  for (i=0; i<n; i++) {
+    x = v[i];
+    if (x < 0) x = u;
+    if (i > 0) smt2_stream_string(&stream, "\n ");
+    stream_term_value(g, &stream, vtbl, token_queue, expr[i], x, tau[i]);
+  }
+  smt2_stream_string(&stream, ")\n");
+  delete_smt2_stream(&stream);
+
+  return true;
+}
+
+
 /*
  * Evaluate the value of an array of terms in mdl
  * - n = size of array t
@@ -3836,8 +3949,6 @@ static void print_term_value_list(smt2_pp_t *printer, value_table_t *vtbl, etk_q
  */
 static void evaluate_term_values(model_t *mdl, term_t *t, uint32_t n, ivector_t *v) {
   evaluator_t evaluator;
-  uint32_t i;
-  value_t x;
 
   /*
    * We store all values (even the error codes)
@@ -3846,10 +3957,8 @@ static void evaluate_term_values(model_t *mdl, term_t *t, uint32_t n, ivector_t
   ivector_reset(v);
   resize_ivector(v, n);
   init_evaluator(&evaluator, mdl);
-  for (i=0; i<n; i++) {
-    x = eval_in_model(&evaluator, t[i]);
-    ivector_push(v, x);
-  }
+  eval_term_values_in_model(&evaluator, t, n, v->data);
+  v->size = n;
   delete_evaluator(&evaluator);
 }
 
@@ -3964,6 +4073,77 @@ static void print_smt2_model(smt2_pp_t *printer, smt2_model_t *sm) {
 }
 
 
+/*
+ * Check whether all definitions fit in the width: each line is two
+ * spaces followed by a definition, and the last line ends with ')'.
+ */
+static bool smt2_model_fits(smt2_globals_t *g, smt2_model_t *sm) {
+  smt2_stream_t stream;
+  value_table_t *vtbl;
+  term_table_t *terms;
+  uint32_t i, n, len;
+  value_t v;
+
+  terms = __yices_globals.terms;
+  vtbl = model_get_vtbl(sm->model);
+
+  len = 0;
+  init_smt2_stream(&stream, NULL, g->bvconst_in_decimal);
+  n = sm->names.size;
+  for (i=0; i<n && len <= g->pp_area.width; i++) {
+    v = sm->values.data[i];
+    if (good_object(vtbl, v)) {
+      smt2_stream_discard(&stream);
+      smt2_stream_def(&stream, vtbl, sm->names.data[i], term_type(terms, sm->terms.data[i]), v);
+      len = 2 + smt2_stream_length(&stream);
+    }
+  }
+  delete_smt2_stream(&stream);
+
+  // len = length of the last line without the closing ')' (or of the first line too long)
+  return len + 1 <= g->pp_area.width;
+}
+
+/*
+ * Streaming version of print_smt2_model
+ * - all values must be scalar (cf. values_can_stream)
+ * - return false and print nothing if a line is too long
+ */
+static bool stream_smt2_model(smt2_globals_t *g, smt2_model_t *sm) {
+  smt2_stream_t stream;
+  value_table_t *vtbl;
+  term_table_t *terms;
+  uint32_t i, n;
+  term_t t;
+  value_t v;
+
+  assert(sm->names.size == sm->terms.size && sm->names.size == sm->values.size);
+
+  if (! smt2_model_fits(g, sm)) {
+    return false;
+  }
+
+  terms = __yices_globals.terms;
+  vtbl = model_get_vtbl(sm->model);
+
+  init_smt2_stream(&stream, g->out, g->bvconst_in_decimal);
+  smt2_stream_string(&stream, "(model");
+  n = sm->names.size;
+  for (i=0; i<n; i++) {
+    t = sm->terms.data[i];
+    v = sm->values.data[i];
+    if (good_object(vtbl, v)) {
+      smt2_stream_string(&stream, "\n  ");
+      smt2_stream_def(&stream, vtbl, sm->names.data[i], term_type(terms, t), v);
+    }
+  }
+  smt2_stream_string(&stream, ")\n");
+  delete_smt2_stream(&stream);
+
+  return true;
+}
+
+
 /*
  * Check whether t is uninterpreted
  */
@@ -4307,7 +4487,7 @@ static void show_unsat_model_interpolant(smt2_globals_t *g) {
 	print_error("Call (check-sat-assuming-model) first");
       } else {
 	init_pretty_printer(&printer, g);
-	pp_term_full(&printer.pp, __yices_globals.terms, unsat_model_interpolant);
+	pp_term_dag(&printer.pp, __yices_globals.terms, unsat_model_interpolant);
 	delete_smt2_pp(&printer, true);
       }
       break;
@@ -4555,6 +4735,10 @@ static void init_smt2_globals(smt2_globals_t *g) {
   init_ef_client(&g->ef_client);
   g->export_to_dimacs = false;
   g->dimacs_file = NULL;
+  g->telemetry = NULL;
+  g->telemetry_period = 0.0;
+  g->bin_out = NULL;
+  g->bin_in = NULL;
   g->out = stdout;
   g->err = stderr;
   g->out_name = NULL;
@@ -4575,6 +4759,8 @@ static void init_smt2_globals(smt2_globals_t *g) {
   g->verbosity = 0;
   init_ctx_params(&g->ctx_parameters);
   init_params_to_defaults(&g->parameters);
+  g->minimize_core = false;
+  g->core_min_timeout = 0.0;
   g->nthreads = 0;
   g->timeout = 0;
   g->timeout_initialized = false;
@@ -4587,6 +4773,7 @@ static void init_smt2_globals(smt2_globals_t *g) {
 
   init_smt2_stack(&g->stack);
   init_smt2_name_stack(&g->term_names);
+  g->gc_live_terms = 0;
   init_smt2_name_stack(&g->type_names);
   init_smt2_name_stack(&g->macro_names);
 
@@ -4677,6 +4864,11 @@ static void delete_smt2_globals(smt2_globals_t *g) {
   delete_ivector(&g->val_vector);
   delete_ivector(&g->type_vector);
 
+  if (g->telemetry != NULL) {
+    fclose(g->telemetry);
+    g->telemetry = NULL;
+  }
+
   close_output_file(g);
   close_error_file(g);
   delete_tracer(g);
@@ -4761,6 +4953,24 @@ void smt2_export_to_dimacs(const char *filename) {
   __smt2_globals.dimacs_file = filename;
 }
 
+/*
+ * Telemetry file
+ */
+int32_t smt2_open_telemetry(const char *filename, double period) {
+  FILE *f;
+
+  assert(__smt2_globals.telemetry == NULL && period >= 0.0);
+
+  f = fopen(filename, "w");
+  if (f == NULL) {
+    return -1;
+  }
+  __smt2_globals.telemetry = f;
+  __smt2_globals.telemetry_period = period;
+
+  return 0;
+}
+
 /*
  * Display all statistics
  */
@@ -4825,10 +5035,39 @@ static void tprint_calls(const char *cmd, uint32_t calls) {
   }
 }
 
+/*
+ * Converter mode (see smt2_binary.h): the commands are written to
+ * the binary output instead of being executed.
+ * - bin_output() returns the writer or NULL
+ * - bin_output_error(cmd) is called if a term of command cmd can't
+ *   be written in the binary format
+ */
+static inline bin_writer_t *bin_output(void) {
+  return __smt2_globals.bin_out;
+}
+
+static void bin_output_error(const char *cmd) {
+  print_error("can't write %s in binary format", cmd);
+}
+
+/*
+ * Convert and don't execute: for commands with no arguments
+ * - return true if the command was written
+ */
+static bool bin_output_cmd(bin_smt2_cmd_t cmd) {
+  if (bin_output() != NULL) {
+    bin_write_smt2_cmd(bin_output(), cmd);
+    return true;
+  }
+  return false;
+}
+
+
 /*
  * Exit function
  */
 void smt2_exit(void) {
+  bin_output_cmd(BIN_CMD_EXIT);
   done = true;
   report_success();
 }
@@ -4846,6 +5085,8 @@ void smt2_silent_exit(void) {
  * Show all formulas asserted so far
  */
 void smt2_get_assertions(void) {
+  if (bin_output_cmd(BIN_CMD_GET_ASSERTIONS)) return;
+
   if (check_logic()) {
     print_error("get-assertions is not supported");
   }
@@ -4860,6 +5101,8 @@ void smt2_get_assertions(void) {
  * :produce-assignments is false. We ignore this requirement.
  */
 void smt2_get_assignment(void) {
+  if (bin_output_cmd(BIN_CMD_GET_ASSIGNMENT)) return;
+
   __smt2_globals.stats.num_get_assignment ++;
   __smt2_globals.stats.num_commands ++;
   tprint_calls("get-assignment", __smt2_globals.stats.num_get_assignment);
@@ -4878,6 +5121,8 @@ void smt2_get_assignment(void) {
  * Show a proof when context is unsat
  */
 void smt2_get_proof(void) {
+  if (bin_output_cmd(BIN_CMD_GET_PROOF)) return;
+
   if (check_logic()) {
     print_error("get-proof is not supported");
   }
@@ -4912,6 +5157,8 @@ static void print_named_assertions(named_term_stack_t *s) {
  * Get the unsat core: subset of :named assertions that form an unsat core
  */
 void smt2_get_unsat_core(void) {
+  if (bin_output_cmd(BIN_CMD_GET_UNSAT_CORE)) return;
+
   __smt2_globals.stats.num_get_unsat_core ++;
   __smt2_globals.stats.num_commands ++;
   tprint_calls("get-unsat-core", __smt2_globals.stats.num_get_unsat_core);
@@ -4930,6 +5177,8 @@ void smt2_get_unsat_core(void) {
  * Get the unsat assumptions: subset of :named assertions that form an unsat core
  */
 void smt2_get_unsat_assumptions(void) {
+  if (bin_output_cmd(BIN_CMD_GET_UNSAT_ASSUMPTIONS)) return;
+
   __smt2_globals.stats.num_get_unsat_assumptions ++;
   __smt2_globals.stats.num_commands ++;
   tprint_calls("get-unsat-assumptions", __smt2_globals.stats.num_get_unsat_assumptions);
@@ -4953,6 +5202,8 @@ static bool mcsat_enabled(smt2_globals_t *g) {
  * evaluates to false.
  */
 void smt2_get_unsat_model_interpolant(void) {
+  if (bin_output_cmd(BIN_CMD_GET_UNSAT_MODEL_INTERPOLANT)) return;
+
   __smt2_globals.stats.num_get_unsat_model_interpolant ++;
   __smt2_globals.stats.num_commands ++;
   tprint_calls("get-unsat-model-interpolant", __smt2_globals.stats.num_get_unsat_model_interpolant);
@@ -4983,6 +5234,13 @@ void smt2_get_value(term_t *a, uint32_t n) {
   ivector_t *types;
   model_t *mdl;
 
+  if (bin_output() != NULL) {
+    if (! bin_write_smt2_get_value(bin_output(), a, n, &__smt2_globals.token_queue)) {
+      bin_output_error("get-value");
+    }
+    return;
+  }
+
   __smt2_globals.stats.num_get_value ++;
   __smt2_globals.stats.num_commands ++;
   tprint_calls("get-value", __smt2_globals.stats.num_get_value);
@@ -5010,9 +5268,12 @@ void smt2_get_value(term_t *a, uint32_t n) {
     collect_subexpr(queue, 2, slices);
     assert(slices->size == n);
 
-    init_pretty_printer(&printer, &__smt2_globals);
-    print_term_value_list(&printer, &mdl->vtbl, queue, slices->data, values->data, types->data, n);
-    delete_smt2_pp(&printer, true);
+    if (! values_can_stream(&mdl->vtbl, values->data, n) ||
+        ! stream_term_value_list(&__smt2_globals, &mdl->vtbl, queue, slices->data, values->data, types->data, n)) {
+      init_pretty_printer(&printer, &__smt2_globals);
+      print_term_value_list(&printer, &mdl->vtbl, queue, slices->data, values->data, types->data, n);
+      delete_smt2_pp(&printer, true);
+    }
     vtbl_empty_queue(&mdl->vtbl); // cleanup the internal queue
     ivector_reset(slices);
     ivector_reset(values);
@@ -5230,6 +5491,14 @@ static bool yices_get_option(smt2_globals_t *g, yices_param_t p) {
     print_uint32_value(g->parameters.max_extensionality);
     break;
 
+  case PARAM_MINIMIZE_CORE:
+    print_boolean_value(g->parameters.minimize_core);
+    break;
+
+  case PARAM_CORE_MIN_TIMEOUT:
+    print_float_value(g->parameters.core_min_timeout);
+    break;
+
   case PARAM_EF_FLATTEN_IFF:
     print_boolean_value(g->ef_client.ef_parameters.flatten_iff);
     break;
@@ -5338,6 +5607,26 @@ static bool yices_get_option(smt2_globals_t *g, yices_param_t p) {
     print_boolean_value(g->mcsat_options.nra_nlsat);
     break;
 
+  case PARAM_MCSAT_NRA_EXPLAIN_THREADS:
+    print_int32_value(g->mcsat_options.nra_explain_threads);
+    break;
+
+  case PARAM_MCSAT_NRA_ICP:
+    print_boolean_value(g->mcsat_options.nra_icp);
+    break;
+
+  case PARAM_MCSAT_BV_BDD_MAX_SIZE:
+    print_int32_value(g->mcsat_options.bv_bdd_max_size);
+    break;
+
+  case PARAM_MCSAT_LEMMA_MINIMIZE:
+    print_boolean_value(g->mcsat_options.lemma_minimize);
+    break;
+
+  case PARAM_MCSAT_PORTFOLIO:
+    print_int32_value(g->mcsat_options.portfolio);
+    break;
+
   case PARAM_MCSAT_VAR_ORDER:
     print_terms_value(g,g->mcsat_options.var_order);
     break;
@@ -5363,6 +5652,11 @@ void smt2_get_option(const char *name) {
   const char* yices_option;
   yices_param_t p;
 
+  if (bin_output() != NULL) {
+    bin_write_smt2_name_cmd(bin_output(), BIN_CMD_GET_OPTION, name);
+    return;
+  }
+
   g = &__smt2_globals;
   n = kwlen(name);
   kw = smt2_string_to_keyword(name, n);
@@ -5485,6 +5779,11 @@ void smt2_get_info(const char *name) {
   uint32_t n;
   aval_t value;
 
+  if (bin_output() != NULL) {
+    bin_write_smt2_name_cmd(bin_output(), BIN_CMD_GET_INFO, name);
+    return;
+  }
+
   n = kwlen(name);
   kw = smt2_string_to_keyword(name, n);
   switch (kw) {
@@ -5927,6 +6226,20 @@ static void yices_set_option(smt2_globals_t *g, const char *param, const param_v
     }
     break;
 
+  case PARAM_MINIMIZE_CORE:
+    if (param_val_to_bool(param, val, &tt, &reason)) {
+      g->parameters.minimize_core = tt;
+      g->minimize_core = tt;
+    }
+    break;
+
+  case PARAM_CORE_MIN_TIMEOUT:
+    if (param_val_to_nonnegfloat(param, val, &x, &reason)) {
+      g->parameters.core_min_timeout = x;
+      g->core_min_timeout = x;
+    }
+    break;
+
   case PARAM_EF_FLATTEN_IFF:
     if (param_val_to_bool(param, val, &tt, &reason)) {
       g->ef_client.ef_parameters.flatten_iff = tt;
@@ -6119,6 +6432,56 @@ static void yices_set_option(smt2_globals_t *g, const char *param, const param_v
     }
     break;
 
+  case PARAM_MCSAT_NRA_EXPLAIN_THREADS:
+    if (param_val_to_nonneg32(param, val, &n, &reason)) {
+      g->mcsat_options.nra_explain_threads = n;
+      context = g->ctx;
+      if (context != NULL) {
+        context->mcsat_options.nra_explain_threads = n;
+      }
+    }
+    break;
+
+  case PARAM_MCSAT_NRA_ICP:
+    if (param_val_to_bool(param, val, &tt, &reason)) {
+      g->mcsat_options.nra_icp = tt;
+      context = g->ctx;
+      if (context != NULL) {
+        context->mcsat_options.nra_icp = tt;
+      }
+    }
+    break;
+
+  case PARAM_MCSAT_BV_BDD_MAX_SIZE:
+    if (param_val_to_nonneg32(param, val, &n, &reason)) {
+      g->mcsat_options.bv_bdd_max_size = n;
+      context = g->ctx;
+      if (context != NULL) {
+        context->mcsat_options.bv_bdd_max_size = n;
+      }
+    }
+    break;
+
+  case PARAM_MCSAT_LEMMA_MINIMIZE:
+    if (param_val_to_bool(param, val, &tt, &reason)) {
+      g->mcsat_options.lemma_minimize = tt;
+      context = g->ctx;
+      if (context != NULL) {
+        context->mcsat_options.lemma_minimize = tt;
+      }
+    }
+    break;
+
+  case PARAM_MCSAT_PORTFOLIO:
+    if (param_val_to_nonneg32(param, val, &n, &reason)) {
+      g->mcsat_options.portfolio = n;
+      context = g->ctx;
+      if (context != NULL) {
+        context->mcsat_options.portfolio = n;
+      }
+    }
+    break;
+
   case PARAM_MCSAT_VAR_ORDER:
     if (param_val_to_terms(param, val, &terms, &reason)) {
       g->mcsat_options.var_order = terms;
@@ -6170,6 +6533,15 @@ void smt2_set_option(const char *name, aval_t value) {
   n = kwlen(name);
   kw = smt2_string_to_keyword(name, n);
 
+  /*
+   * Converter: :global-declarations changes how names are scoped
+   * so it must also be executed.
+   */
+  if (bin_output() != NULL) {
+    bin_write_smt2_aval_cmd(bin_output(), BIN_CMD_SET_OPTION, name, value);
+    if (kw != SMT2_KW_GLOBAL_DECLARATIONS) return;
+  }
+
   switch (kw) {
   case SMT2_KW_DIAGNOSTIC_OUTPUT:
     // required
@@ -6269,6 +6641,11 @@ void smt2_set_info(const char *name, aval_t value) {
   smt2_keyword_t kw;
   uint32_t n, version;
 
+  if (bin_output() != NULL) {
+    bin_write_smt2_aval_cmd(bin_output(), BIN_CMD_SET_INFO, name, value);
+    return;
+  }
+
   g = &__smt2_globals;
 
   n = kwlen(name);
@@ -6317,6 +6694,10 @@ void smt2_set_logic(const char *name) {
   smt_logic_t code;
   context_arch_t arch;
 
+  if (bin_output() != NULL) {
+    bin_write_smt2_name_cmd(bin_output(), BIN_CMD_SET_LOGIC, name);
+  }
+
   if (__smt2_globals.logic_code != SMT_UNKNOWN) {
     print_error("the logic is already set");
     return;
@@ -6422,6 +6803,10 @@ void smt2_set_logic(const char *name) {
 void smt2_push(uint32_t n) {
   smt2_globals_t *g;
 
+  if (bin_output() != NULL) {
+    bin_write_smt2_uint_cmd(bin_output(), BIN_CMD_PUSH, n);
+  }
+
   __smt2_globals.stats.num_push ++;
   __smt2_globals.stats.num_commands ++;
   tprint_calls("push", __smt2_globals.stats.num_push);
@@ -6448,6 +6833,22 @@ void smt2_push(uint32_t n) {
 }
 
 
+/*
+ * Check whether we should call the garbage collector after a pop
+ */
+static bool gc_after_pop_needed(smt2_globals_t *g) {
+  uint32_t live, new_terms;
+
+  if (g->term_names.deletions == 0) {
+    return false;
+  }
+
+  live = __yices_globals.terms->live_terms;
+  new_terms = (live > g->gc_live_terms) ? live - g->gc_live_terms : 0;
+  return new_terms >= SMT2_GC_MIN_TERMS && new_terms >= g->gc_live_terms/SMT2_GC_RATIO;
+}
+
+
 /*
  * Pop:
  * - n = number of scopes to remove
@@ -6462,6 +6863,10 @@ void smt2_pop(uint32_t n) {
 
   g = &__smt2_globals;
 
+  if (bin_output() != NULL) {
+    bin_write_smt2_uint_cmd(bin_output(), BIN_CMD_POP, n);
+  }
+
   g->stats.num_pop ++;
   g->stats.num_commands ++;
 
@@ -6512,9 +6917,11 @@ void smt2_pop(uint32_t n) {
         check_stack(g);
 
         // call the garbage collector
-        if (g->term_names.deletions > 1000) {
+        // (not in binary mode: the writer/reader keep term indices)
+        if (gc_after_pop_needed(g) && g->bin_out == NULL && g->bin_in == NULL) {
           yices_garbage_collect(NULL, 0, NULL, 0, true);
           g->term_names.deletions = 0;
+          g->gc_live_terms = __yices_globals.terms->live_terms;
         }
 
         report_success();
@@ -6533,6 +6940,13 @@ void smt2_assert(term_t t, bool special) {
 
   g = &__smt2_globals;
 
+  if (bin_output() != NULL) {
+    if (! bin_write_smt2_assert(bin_output(), t, special)) {
+      bin_output_error("assert");
+    }
+    return;
+  }
+
   g->stats.num_assert ++;
   g->stats.num_commands ++;
   tprint_calls("assert", g->stats.num_assert);
@@ -6661,6 +7075,8 @@ static void check_delayed_assertions_mt(smt2_globals_t *g) {
  * Check satisfiability of the current set of assertions
  */
 void smt2_check_sat(void) {
+  if (bin_output_cmd(BIN_CMD_CHECK_SAT)) return;
+
   __smt2_globals.stats.num_check_sat ++;
   __smt2_globals.stats.num_commands ++;
   tprint_calls("check-sat", __smt2_globals.stats.num_check_sat);
@@ -6709,6 +7125,11 @@ void smt2_check_sat(void) {
  * i.e., a pair symbol name/polarity.
  */
 void smt2_check_sat_assuming(uint32_t n, signed_symbol_t *a) {
+  if (bin_output() != NULL) {
+    bin_write_smt2_check_sat_assuming(bin_output(), n, a);
+    return;
+  }
+
   __smt2_globals.stats.num_check_sat_assuming ++;
   __smt2_globals.stats.num_commands ++;
   tprint_calls("check-sat-assuming", __smt2_globals.stats.num_check_sat_assuming);
@@ -6737,6 +7158,13 @@ void smt2_check_sat_assuming(uint32_t n, signed_symbol_t *a) {
  * - values = array of values
  */
 void smt2_check_sat_assuming_model(uint32_t n, const term_t vars[], const term_t values[]) {
+  if (bin_output() != NULL) {
+    if (! bin_write_smt2_check_sat_assuming_model(bin_output(), n, vars, values)) {
+      bin_output_error("check-sat-assuming-model");
+    }
+    return;
+  }
+
   __smt2_globals.stats.num_check_sat_assuming_model ++;
   __smt2_globals.stats.num_commands ++;
   tprint_calls("check-sat-assuming-model", __smt2_globals.stats.num_check_sat_assuming_model);
@@ -6780,6 +7208,9 @@ void smt2_declare_sort(const char *name, uint32_t arity) {
       tau = yices_new_uninterpreted_type();
       yices_set_type_name(tau, name);
       save_type_name(&__smt2_globals, name);
+      if (bin_output() != NULL) {
+        bin_write_smt2_declare_sort(bin_output(), name, 0, tau);
+      }
       report_success();
     } else {
       macro = yices_type_constructor(name, arity);
@@ -6788,6 +7219,9 @@ void smt2_declare_sort(const char *name, uint32_t arity) {
 	done = true;
       } else {
         save_macro_name(&__smt2_globals, name);
+        if (bin_output() != NULL) {
+          bin_write_smt2_declare_sort(bin_output(), name, arity, macro);
+        }
         report_success();
       }
     }
@@ -6814,6 +7248,10 @@ void smt2_define_sort(const char *name, uint32_t n, type_t *var, type_t body) {
     if (n == 0) {
       yices_set_type_name(body, name);
       save_type_name(&__smt2_globals, name);
+      if (bin_output() != NULL && !bin_write_smt2_define_sort(bin_output(), name, 0, NULL, body, -1)) {
+        bin_output_error("define-sort");
+        return;
+      }
       report_success();
     } else {
       macro = yices_type_macro(name, n, var, body);
@@ -6822,6 +7260,10 @@ void smt2_define_sort(const char *name, uint32_t n, type_t *var, type_t body) {
 	done = true;
       } else {
         save_macro_name(&__smt2_globals, name);
+        if (bin_output() != NULL && !bin_write_smt2_define_sort(bin_output(), name, n, var, body, macro)) {
+          bin_output_error("define-sort");
+          return;
+        }
         report_success();
       }
     }
@@ -6863,6 +7305,10 @@ void smt2_declare_fun(const char *name, uint32_t n, type_t *tau) {
     save_term_name(&__smt2_globals, name);
     save_name_for_model(&__smt2_globals, name);
 
+    if (bin_output() != NULL) {
+      bin_write_smt2_declare_fun(bin_output(), name, n+1, tau, t);
+    }
+
     report_success();
   }
 }
@@ -6922,6 +7368,11 @@ void smt2_define_fun(const char *name, uint32_t n, term_t *var, term_t body, typ
     yices_set_term_name(t, name);
     save_term_name(&__smt2_globals, name);
 
+    if (bin_output() != NULL && !bin_write_smt2_define_fun(bin_output(), name, t)) {
+      bin_output_error("define-fun");
+      return;
+    }
+
     report_success();
   }
 }
@@ -6935,6 +7386,8 @@ void smt2_get_model(void) {
   smt2_model_t smt2_mdl;
   model_t *mdl;
 
+  if (bin_output_cmd(BIN_CMD_GET_MODEL)) return;
+
   if (check_logic()) {
     if (__smt2_globals.efmode) {
       mdl = get_ef_model(&__smt2_globals);
@@ -6943,16 +7396,21 @@ void smt2_get_model(void) {
     }
     if (mdl == NULL) return;
 
-    init_pretty_printer(&printer, &__smt2_globals);
     if (__smt2_globals.clean_model_format) {
+      init_pretty_printer(&printer, &__smt2_globals);
       smt2_pp_full_model(&printer, mdl);
+      delete_smt2_pp(&printer, true);
     } else {
       init_smt2_model(&smt2_mdl, mdl);
       build_smt2_model(&__smt2_globals, &smt2_mdl);
-      print_smt2_model(&printer, &smt2_mdl);
+      if (! values_can_stream(&mdl->vtbl, smt2_mdl.values.data, smt2_mdl.values.size) ||
+          ! stream_smt2_model(&__smt2_globals, &smt2_mdl)) {
+        init_pretty_printer(&printer, &__smt2_globals);
+        print_smt2_model(&printer, &smt2_mdl);
+        delete_smt2_pp(&printer, true);
+      }
       delete_smt2_model(&smt2_mdl);
     }
-    delete_smt2_pp(&printer, true);
   }
 }
 
@@ -6960,6 +7418,10 @@ void smt2_get_model(void) {
  * Print s on the output channel
  */
 void smt2_echo(const char *s) {
+  if (bin_output() != NULL) {
+    bin_write_smt2_name_cmd(bin_output(), BIN_CMD_ECHO, s);
+    return;
+  }
   print_out("%s\n", s);
   flush_out();
 }
@@ -6976,6 +7438,8 @@ void smt2_reset_assertions(void) {
   smt2_globals_t *g;
 
   g = &__smt2_globals;
+  bin_output_cmd(BIN_CMD_RESET_ASSERTIONS);
+
   if (g->benchmark_mode) {
     print_error("reset-assertions is not allowed in non-incremental mode");
   } else {
@@ -7035,6 +7499,8 @@ void smt2_reset_assertions(void) {
        */
       if (!g->global_decls) {
         yices_reset_tables();
+        if (g->bin_out != NULL) bin_writer_reset(g->bin_out);
+        if (g->bin_in != NULL) bin_reader_reset(g->bin_in);
       }
 
       // build a fresh empty context
@@ -7053,7 +7519,13 @@ void smt2_reset_assertions(void) {
 void smt2_reset_all(void) {
   bool benchmark, print_success, clean_format, bvdecimal;
   uint32_t timeout, verbosity;
+  bin_writer_t *bin_out;
+  bin_reader_t *bin_in;
 
+  bin_output_cmd(BIN_CMD_RESET);
+
+  bin_out = __smt2_globals.bin_out;
+  bin_in = __smt2_globals.bin_in;
   benchmark = __smt2_globals.benchmark_mode;
   clean_format = __smt2_globals.clean_model_format;
   bvdecimal = __smt2_globals.bvconst_in_decimal;
@@ -7071,6 +7543,11 @@ void smt2_reset_all(void) {
   if (bvdecimal) smt2_force_bvdecimal_format();
   smt2_lexer_reset_logic();
 
+  __smt2_globals.bin_out = bin_out;
+  __smt2_globals.bin_in = bin_in;
+  if (bin_out != NULL) bin_writer_reset(bin_out);
+  if (bin_in != NULL) bin_reader_reset(bin_in);
+
   report_success();
 }
 
@@ -7093,6 +7570,10 @@ void smt2_add_name(int32_t op, term_t t, const char *name) {
   yices_set_term_name(t, name);
   save_term_name(&__smt2_globals, name);
 
+  if (bin_output() != NULL && !bin_write_smt2_add_name(bin_output(), op, t, name)) {
+    bin_output_error("a :named term");
+  }
+
   // special processing for Boolean terms
   if (yices_term_is_bool(t)) {
     // named booleans (for get-assignment)
@@ -7119,6 +7600,13 @@ void smt2_add_pattern(int32_t op, term_t t, term_t *p, uint32_t n) {
   ptr_hmap_pair_t *r;
   term_t x;
 
+  if (bin_output() != NULL) {
+    if (! bin_write_smt2_add_pattern(bin_output(), op, t, p, n)) {
+      bin_output_error("a :pattern");
+    }
+    return;
+  }
+
   r = ptr_hmap_get(&__smt2_globals.term_patterns, t);
   if (r->val == NULL) {
     r->val = safe_malloc(sizeof(ivector_t));
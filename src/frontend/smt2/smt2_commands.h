@@ -52,6 +52,7 @@
 #include "utils/string_hash_map.h"
 #include "parser_utils/lexer.h"
 #include "parser_utils/term_stack2.h"
+#include "io/binary_terms.h"
 #include "io/tracer.h"
 #include "frontend/common/assumptions_and_core.h"
 #include "frontend/common/named_term_stacks.h"
@@ -233,6 +234,22 @@ typedef struct smt2_name_stack_s {
 #define DEF_SMT2_NAME_STACK_SIZE 1024
 #define MAX_SMT2_NAME_STACK_SIZE (UINT32_MAX/sizeof(char *))
 
+/*
+ * Garbage collection after pop: we collect only if some term names were
+ * deleted and the number of terms created since the last collection is
+ * at least SMT2_GC_MIN_TERMS and at least (live terms after the last
+ * collection)/SMT2_GC_RATIO. A collection visits all live terms, and
+ * the garbage is bounded by the new terms. With this ratio, the cost of
+ * a collection (live terms) is at most SMT2_GC_RATIO times the number
+ * of new terms, so it is amortized over the terms created since the
+ * last collection.
+ *
+ * There's no collection with --write-binary or --binary-input: the
+ * binary writer and reader refer to terms by index.
+ */
+#define SMT2_GC_MIN_TERMS 5000
+#define SMT2_GC_RATIO 8
+
 // what we keep for each push
 typedef struct smt2_push_rec_s {
   uint32_t multiplicity;
@@ -364,6 +381,17 @@ typedef struct smt2_globals_s {
   bool export_to_dimacs;           // true to enable
   const char *dimacs_file;         // file name to store the dimacs result
 
+  // telemetry (see context_telemetry.h)
+  FILE *telemetry;                 // file for the samples (default = NULL: no telemetry)
+  double telemetry_period;         // sampling period (in seconds)
+
+  // binary format (see smt2_binary.h)
+  // - if bin_out is non-NULL, commands are written to it instead of being executed
+  // - bin_in is the reader when the input is in binary format
+  // - the garbage collector is not called if either is active
+  bin_writer_t *bin_out;           // default = NULL
+  bin_reader_t *bin_in;            // default = NULL
+
   // output/diagnostic channels
   FILE *out;                  // default = stdout
   FILE *err;                  // default = stderr
@@ -396,6 +424,11 @@ typedef struct smt2_globals_s {
   ctx_param_t ctx_parameters;  // preprocessing options
   param_t parameters;          // search options
 
+  // unsat-core minimization: kept here because the search
+  // parameters are reset to the defaults before every check
+  bool minimize_core;          // default = false
+  double core_min_timeout;     // default = 0.0 (no limit)
+
   // nthreads
   uint32_t nthreads;           // default = 0 (single threaded)
 
@@ -416,6 +449,7 @@ typedef struct smt2_globals_s {
   // push/pop support
   smt2_stack_t stack;
   smt2_name_stack_t term_names;
+  uint32_t gc_live_terms;    // number of live terms after the last garbage collection
   smt2_name_stack_t type_names;
   smt2_name_stack_t macro_names;
 
@@ -537,6 +571,14 @@ extern void smt2_set_delegate(const char *name);
  */
 extern void smt2_set_dimacs_file(const char *filename);
 
+/*
+ * Write telemetry samples to a file:
+ * - filename = name of the output file
+ * - period = sampling period in seconds (cf. context_telemetry.h)
+ * - return -1 if the file can't be opened (errno is set), 0 otherwise
+ */
+extern int32_t smt2_open_telemetry(const char *filename, double period);
+
 /*
  * Delete all internal structures (called after exit).
  */
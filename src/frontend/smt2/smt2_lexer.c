@@ -23,6 +23,7 @@
 
 #include <assert.h>
 #include <ctype.h>
+#include <string.h>
 
 // perfect hash functions generated by gperf
 #include "frontend/smt2/smt2_hash_tokens.h"
@@ -30,6 +31,7 @@
 #include "frontend/smt2/smt2_hash_symbols.h"
 
 #include "frontend/smt2/smt2_lexer.h"
+#include "frontend/smt2/smt2_prelexer.h"
 
 
 /*
@@ -448,22 +450,33 @@ void smt2_lexer_activate_two_dot_five(void) {
   two_dot_five_variant = true;
 }
 
+bool smt2_lexer_two_dot_five(void) {
+  return two_dot_five_variant;
+}
+
 
 /*
  * Lexer initialization
+ * - the character classes are set up here, before any prelexer
+ *   thread uses them
  */
+static void init_smt2_char_class(void);
+
 int32_t init_smt2_file_lexer(lexer_t *lex, const char *filename) {
   smt2_activate_default();
+  init_smt2_char_class();
   return init_file_lexer(lex, filename);
 }
 
 void init_smt2_stream_lexer(lexer_t *lex, FILE *f, const char *name) {
   smt2_activate_default();
+  init_smt2_char_class();
   init_stream_lexer(lex, f, name);
 }
 
 void init_smt2_string_lexer(lexer_t *lex, char *data, const char *name) {
   smt2_activate_default();
+  init_smt2_char_class();
   init_string_lexer(lex, data, name);
 }
 
@@ -504,6 +517,178 @@ const char *smt2_keyword_to_string(smt2_keyword_t kw) {
 }
 
 
+/*
+ * Characters that may appear in keywords and simple symbols:
+ * - digits + letters + ~ ! @ $ % ^ & * _ - + = < > . ? /
+ *
+ * NOTE: again, we don't really follow the standard (we can
+ * accept non-ASCII characters, depending on the locale and
+ * how isalnum(c) decides).
+ */
+static bool issimple(int c) {
+  if (isalnum(c)) {
+    return true;
+  }
+
+  switch (c) {
+  case '~':
+  case '!':
+  case '@':
+  case '$':
+  case '%':
+  case '^':
+  case '&':
+  case '*':
+  case '_':
+  case '-':
+  case '+':
+  case '=':
+  case '<':
+  case '>':
+  case '.':
+  case '?':
+  case '/':
+    return true;
+
+  default:
+    return false;
+  }
+}
+
+
+/*
+ * Character classes for scanning input that's in memory
+ * (cf. reader_in_memory). Only ASCII characters are classified:
+ * the others go through the character-by-character loops, so that
+ * we accept the same input in all cases.
+ */
+#define SMT2_CHAR_SIMPLE 1
+#define SMT2_CHAR_DIGIT  2
+#define SMT2_CHAR_SPACE  4
+
+static uint8_t smt2_char_class[256];
+static bool smt2_char_class_ready = false;
+
+static void init_smt2_char_class(void) {
+  int c;
+
+  for (c=0; c<128; c++) {
+    smt2_char_class[c] = 0;
+    if (issimple(c)) smt2_char_class[c] |= SMT2_CHAR_SIMPLE;
+    if (isdigit(c)) smt2_char_class[c] |= SMT2_CHAR_DIGIT;
+    if (isspace(c)) smt2_char_class[c] |= SMT2_CHAR_SPACE;
+  }
+  for (c=128; c<256; c++) {
+    smt2_char_class[c] = 0;
+  }
+  smt2_char_class_ready = true;
+}
+
+/*
+ * Number of lookahead characters in class cls (input in memory)
+ */
+static uint64_t smt2_span(reader_t *rd, uint8_t cls, const char **s) {
+  uint64_t i, n;
+
+  if (!smt2_char_class_ready) {
+    init_smt2_char_class();
+  }
+
+  *s = reader_lookahead(rd, &n);
+  if (n > UINT32_MAX) {
+    n = UINT32_MAX;
+  }
+  i = 0;
+  while (i < n && (smt2_char_class[(uint8_t) (*s)[i]] & cls)) {
+    i ++;
+  }
+  return i;
+}
+
+static inline bool smt2_in_class(int c, uint8_t cls) {
+  return cls == SMT2_CHAR_SIMPLE ? issimple(c) : isdigit(c);
+}
+
+/*
+ * Add the current character and all the characters that follow in class
+ * cls (SMT2_CHAR_SIMPLE or SMT2_CHAR_DIGIT) to the buffer.
+ * - the current character must be in cls
+ * - return the first character not in cls
+ * If the input is in memory, ASCII runs are copied as a block.
+ */
+static int smt2_scan_chars(lexer_t *lex, uint8_t cls) {
+  reader_t *rd;
+  string_buffer_t *buffer;
+  const char *s;
+  uint64_t n;
+  int c;
+
+  rd = &lex->reader;
+  buffer = lex->buffer;
+  c = reader_current_char(rd);
+
+  assert(smt2_in_class(c, cls));
+
+  do {
+    string_buffer_append_char(buffer, c);
+    if (reader_in_memory(rd)) {
+      n = smt2_span(rd, cls, &s);
+      string_buffer_append_chars(buffer, s, (uint32_t) n);
+      reader_advance(rd, n);
+    }
+    c = reader_next_char(rd);
+  } while (smt2_in_class(c, cls));
+
+  return c;
+}
+
+/*
+ * Skip spaces and return the first non-space character
+ */
+static int smt2_skip_spaces(reader_t *rd) {
+  const char *s;
+  int c;
+
+  c = reader_current_char(rd);
+  while (isspace(c)) {
+    if (reader_in_memory(rd)) {
+      reader_advance(rd, smt2_span(rd, SMT2_CHAR_SPACE, &s));
+    }
+    c = reader_next_char(rd);
+  }
+  return c;
+}
+
+/*
+ * Skip a comment: read until the end of the line or EOF
+ * - the current character must be ';'
+ * - return '\n' or EOF
+ */
+static int smt2_skip_comment(reader_t *rd) {
+  const char *s, *eol;
+  uint64_t n;
+  int c;
+
+  assert(reader_current_char(rd) == ';');
+
+  if (reader_in_memory(rd)) {
+    s = reader_lookahead(rd, &n);
+    eol = memchr(s, '\n', n);
+    if (eol != NULL) {
+      reader_advance(rd, (eol - s) + 1);
+      assert(reader_current_char(rd) == '\n');
+      return '\n';
+    }
+  }
+
+  do {
+    c = reader_next_char(rd);
+  } while (c != '\n' && c != EOF);
+
+  return c;
+}
+
+
 /*
  * Read a string literal
  * - current char is "
@@ -717,20 +902,18 @@ static smt2_token_t smt2_read_number(lexer_t *lex) {
   assert(string_buffer_length(buffer) == 0 && isdigit(c) && c != '0');
 
   // first sequence of digits
-  do {
-    string_buffer_append_char(buffer, c);
-    c = reader_next_char(rd);
-  } while (isdigit(c));
+  c = smt2_scan_chars(lex, SMT2_CHAR_DIGIT);
 
   tk = SMT2_TK_NUMERAL;
   if (c == '.') {
     i = string_buffer_length(buffer);
 
     // attempt to parse a DECIMAL
-    do {
-      string_buffer_append_char(buffer, c);
-      c = reader_next_char(rd);
-    } while (isdigit(c));
+    string_buffer_append_char(buffer, c);
+    c = reader_next_char(rd);
+    if (isdigit(c)) {
+      c = smt2_scan_chars(lex, SMT2_CHAR_DIGIT);
+    }
 
     tk = SMT2_TK_DECIMAL;
     if (string_buffer_length(buffer) <= i+1) {
@@ -769,10 +952,11 @@ static smt2_token_t smt2_read_number0(lexer_t *lex) {
 
   if (c == '.') {
     // parse a decimal '0.<digits>'
-    do {
-      string_buffer_append_char(buffer, c);
-      c = reader_next_char(rd);
-    } while (isdigit(c));
+    string_buffer_append_char(buffer, c);
+    c = reader_next_char(rd);
+    if (isdigit(c)) {
+      c = smt2_scan_chars(lex, SMT2_CHAR_DIGIT);
+    }
 
     tk = SMT2_TK_DECIMAL;
     if (string_buffer_length(buffer) <= 2) {
@@ -785,10 +969,7 @@ static smt2_token_t smt2_read_number0(lexer_t *lex) {
      * put all the digits that follow '0' in the buffer
      * to give a nicer error message
      */
-    do {
-      string_buffer_append_char(buffer, c);
-      c = reader_next_char(rd);
-    } while (isdigit(c));
+    c = smt2_scan_chars(lex, SMT2_CHAR_DIGIT);
 
     tk = SMT2_TK_INVALID_NUMERAL;
   }
@@ -799,45 +980,6 @@ static smt2_token_t smt2_read_number0(lexer_t *lex) {
 }
 
 
-/*
- * Characters that may appear in keywords and simple symbols:
- * - digits + letters + ~ ! @ $ % ^ & * _ - + = < > . ? /
- *
- * NOTE: again, we don't really follow the standard (we can
- * accept non-ASCII characters, depending on the locale and
- * how isalnum(c) decides).
- */
-static bool issimple(int c) {
-  if (isalnum(c)) {
-    return true;
-  }
-
-  switch (c) {
-  case '~':
-  case '!':
-  case '@':
-  case '$':
-  case '%':
-  case '^':
-  case '&':
-  case '*':
-  case '_':
-  case '-':
-  case '+':
-  case '=':
-  case '<':
-  case '>':
-  case '.':
-  case '?':
-  case '/':
-    return true;
-
-  default:
-    return false;
-  }
-}
-
-
 /*
  * Read a keyword:
  * - the buffer must be empty
@@ -859,10 +1001,11 @@ static smt2_token_t smt2_read_keyword(lexer_t *lex) {
 
   assert(string_buffer_length(buffer) == 0 && c == ':');
 
-  do {
-    string_buffer_append_char(buffer, c);
-    c = reader_next_char(rd);
-  } while (issimple(c));
+  string_buffer_append_char(buffer, c);
+  c = reader_next_char(rd);
+  if (issimple(c)) {
+    c = smt2_scan_chars(lex, SMT2_CHAR_SIMPLE);
+  }
   string_buffer_close(buffer);
 
   tk = SMT2_TK_KEYWORD;
@@ -885,22 +1028,15 @@ static smt2_token_t smt2_read_keyword(lexer_t *lex) {
  * token id. Otherwise, return SMT2_TK_SYMBOL.
  */
 static smt2_token_t smt2_read_symbol(lexer_t *lex) {
-  reader_t *rd;
   string_buffer_t *buffer;
   const keyword_t *kw;
-  int c;
   smt2_token_t tk;
 
-  rd = &lex->reader;
   buffer = lex->buffer;
-  c = reader_current_char(rd);
 
-  assert(string_buffer_length(buffer) == 0 && issimple(c));
+  assert(string_buffer_length(buffer) == 0 && issimple(reader_current_char(&lex->reader)));
 
-  do {
-    string_buffer_append_char(buffer, c);
-    c = reader_next_char(rd);
-  } while (issimple(c));
+  (void) smt2_scan_chars(lex, SMT2_CHAR_SIMPLE);
   string_buffer_close(buffer);
 
   tk = SMT2_TK_SYMBOL;
@@ -970,13 +1106,14 @@ static smt2_token_t smt2_read_quoted_symbol(lexer_t *lex) {
 
 
 /*
- * Read the next token and return its code tk
+ * Read the next token from the reader and return its code tk
  * - set lex->token to tk
  * - set lex->tk_pos
  * - if the token is not '(' or ')', then its value is in lex->buffer
  *   as a string
+ * - two_dot_five selects the 2.5 variant of string literals
  */
-smt2_token_t next_smt2_token(lexer_t *lex) {
+smt2_token_t smt2_scan_token(lexer_t *lex, bool two_dot_five) {
   reader_t *rd;
   string_buffer_t *buffer;
   int c;
@@ -989,12 +1126,10 @@ smt2_token_t next_smt2_token(lexer_t *lex) {
 
   // skip spaces and comments
   for (;;) {
-    while (isspace(c)) c = reader_next_char(rd);
+    c = smt2_skip_spaces(rd);
     if (c != ';') break;
     // comments: read everything until the end of the line or EOF
-    do {
-      c = reader_next_char(rd);
-    } while (c != '\n' && c != EOF);
+    c = smt2_skip_comment(rd);
   }
 
   // record start of token
@@ -1016,7 +1151,7 @@ smt2_token_t next_smt2_token(lexer_t *lex) {
     goto done;
 
   case '"':
-    if (two_dot_five_variant) {
+    if (two_dot_five) {
       tk = smt2_read_string_var(lex);
     } else {
       tk = smt2_read_string(lex);
@@ -1086,6 +1221,17 @@ smt2_token_t next_smt2_token(lexer_t *lex) {
 }
 
 
+/*
+ * Next token: from the pre-scanned tokens if any, or from the reader
+ */
+smt2_token_t next_smt2_token(lexer_t *lex) {
+  if (lex->tokens != NULL && smt2_prelexer_next_token(lex->tokens, lex)) {
+    return lex->token;
+  }
+  return smt2_scan_token(lex, two_dot_five_variant);
+}
+
+
 /*
  * Convert string to a built-in keyword index
  * - s = string, n = length of the string
@@ -328,6 +328,14 @@ static inline void init_smt2_wide_stdin_lexer(lexer_t *lex) {
  */
 extern smt2_token_t next_smt2_token(lexer_t *lex);
 
+/*
+ * Same thing but always read from lex's reader
+ * - two_dot_five: whether to use the SMT-LIB 2.5 string syntax
+ * - this doesn't change any global state so it can be used
+ *   on independent lexers in parallel (see smt2_prelexer.h)
+ */
+extern smt2_token_t smt2_scan_token(lexer_t *lex, bool two_dot_five);
+
 
 /*
  * Conversion of tokens/symbols/keywords to strings
@@ -360,6 +368,11 @@ extern smt2_keyword_t smt2_string_to_keyword(const char *s, uint32_t n);
  */
 extern void smt2_lexer_activate_two_dot_five(void);
 
+/*
+ * Check whether version 2.5 is active
+ */
+extern bool smt2_lexer_two_dot_five(void);
+
 
 /*
  * Select built-in symbols for logic:
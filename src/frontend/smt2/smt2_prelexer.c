@@ -0,0 +1,500 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * PARALLEL SCANNING OF SMT2 FILES
+ */
+
+#include <assert.h>
+#include <string.h>
+
+#include "frontend/smt2/smt2_lexer.h"
+#include "frontend/smt2/smt2_prelexer.h"
+#include "utils/memalloc.h"
+
+
+#if defined(THREAD_SAFE) && !defined(MINGW)
+
+#include <pthread.h>
+
+/*
+ * Target size of a chunk (in bytes) and number of chunks per thread
+ * that can be scanned ahead of the parser. This bounds the memory
+ * used for the token descriptors.
+ */
+#define SMT2_PRELEX_CHUNK_SIZE 262144
+#define SMT2_PRELEX_AHEAD 2
+
+
+/*
+ * Descriptor of a scanned token
+ * - token = token code
+ * - value = index of the token value in the chunk's values
+ * - length = length of the value
+ * - pos, line, column = start of the token
+ * - end_pos, end_line, end_column = reader position after the token
+ * Positions and line numbers are relative to the chunk.
+ */
+typedef struct smt2_token_desc_s {
+  int32_t token;
+  uint32_t value;
+  uint32_t length;
+  uint32_t line, column;
+  uint32_t end_line, end_column;
+  uint64_t pos, end_pos;
+} smt2_token_desc_t;
+
+
+/*
+ * Chunk = data[start ... end-1]
+ * - newlines = number of '\n' in the chunk
+ * - tokens = array of ntokens descriptors (size = its size)
+ *   the last one is always SMT2_TK_EOS
+ * - values = token values, concatenated
+ * - cut = true if the chunk ends with an unterminated string
+ *   or quoted symbol
+ * - ready = true once the chunk has been scanned
+ */
+typedef struct smt2_chunk_s {
+  uint64_t start, end;
+  uint32_t newlines;
+  uint32_t ntokens;
+  uint32_t size;
+  smt2_token_desc_t *tokens;
+  string_buffer_t values;
+  bool cut;
+  bool ready;
+} smt2_chunk_t;
+
+#define MAX_SMT2_CHUNK_TOKENS (UINT32_MAX/sizeof(smt2_token_desc_t))
+
+
+/*
+ * Prelexer:
+ * - lex = the lexer we're attached to
+ * - data = its input
+ * - two_dot_five = string syntax used by the scanners
+ *
+ * Parser side:
+ * - current = index of the chunk being read
+ * - index = index of the next token in that chunk
+ * - line = line number of the chunk's first character
+ *
+ * Scanner side:
+ * - next = index of the next chunk to scan
+ * - ahead = how many chunks can be scanned after current
+ * - stop = set to true to stop the threads
+ * - scanned: signaled when a chunk is ready
+ * - consumed: signaled when current increases or stop is set
+ * - lock protects next, current, stop and the ready flags
+ */
+struct smt2_prelexer_s {
+  lexer_t *lex;
+  const char *data;
+  bool two_dot_five;
+
+  smt2_chunk_t *chunk;
+  uint32_t nchunks;
+
+  uint32_t current;
+  uint32_t index;
+  uint32_t line;
+
+  uint32_t next;
+  uint32_t ahead;
+  bool stop;
+  pthread_mutex_t lock;
+  pthread_cond_t scanned;
+  pthread_cond_t consumed;
+
+  pthread_t *threads;
+  uint32_t nthreads;
+};
+
+
+/*
+ * Make room for one more token descriptor in c
+ */
+static void extend_smt2_chunk(smt2_chunk_t *c) {
+  uint32_t n;
+
+  n = c->size;
+  n += (n >> 1) + 1;
+  if (n > MAX_SMT2_CHUNK_TOKENS) {
+    out_of_memory();
+  }
+  c->tokens = (smt2_token_desc_t *) safe_realloc(c->tokens, n * sizeof(smt2_token_desc_t));
+  c->size = n;
+}
+
+
+/*
+ * Number of '\n' in s[0 ... n-1]
+ */
+static uint32_t count_newlines(const char *s, uint64_t n) {
+  const char *p, *end;
+  uint32_t k;
+
+  k = 0;
+  end = s + n;
+  p = memchr(s, '\n', n);
+  while (p != NULL) {
+    k ++;
+    p ++;
+    p = memchr(p, '\n', end - p);
+  }
+  return k;
+}
+
+
+/*
+ * Scan chunk c: this uses a lexer of its own so it can run
+ * in parallel with the parser and the other scanners.
+ */
+static void smt2_scan_chunk(smt2_prelexer_t *pre, smt2_chunk_t *c) {
+  lexer_t lex;
+  smt2_token_desc_t *d;
+  smt2_token_t tk;
+  uint32_t n;
+
+  init_memory_lexer(&lex, pre->data + c->start, c->end - c->start, pre->lex->reader.name);
+  init_string_buffer(&c->values, (c->end - c->start)/2 + 1);
+  c->size = (c->end - c->start)/8 + 1;
+  c->tokens = (smt2_token_desc_t *) safe_malloc(c->size * sizeof(smt2_token_desc_t));
+  c->ntokens = 0;
+
+  do {
+    tk = smt2_scan_token(&lex, pre->two_dot_five);
+    if (c->ntokens == c->size) {
+      extend_smt2_chunk(c);
+    }
+    d = c->tokens + c->ntokens;
+    c->ntokens ++;
+
+    n = current_token_length(&lex);
+    d->token = tk;
+    d->value = string_buffer_length(&c->values);
+    d->length = n;
+    string_buffer_append_chars(&c->values, current_token_value(&lex), n);
+    d->pos = lex.tk_pos;
+    d->line = lex.tk_line;
+    d->column = lex.tk_column;
+    d->end_pos = reader_position(&lex.reader);
+    d->end_line = reader_line(&lex.reader);
+    d->end_column = reader_column(&lex.reader);
+  } while (tk != SMT2_TK_EOS);
+
+  c->cut = false;
+  if (c->ntokens >= 2) {
+    tk = c->tokens[c->ntokens - 2].token;
+    c->cut = (tk == SMT2_TK_INVALID_STRING || tk == SMT2_TK_INVALID_SYMBOL);
+  }
+  c->newlines = count_newlines(pre->data + c->start, c->end - c->start);
+
+  close_lexer(&lex);
+}
+
+
+/*
+ * Free the tokens of chunk c
+ */
+static void smt2_free_chunk(smt2_chunk_t *c) {
+  safe_free(c->tokens);
+  c->tokens = NULL;
+  delete_string_buffer(&c->values);
+}
+
+
+/*
+ * Scanner thread: scan chunks in order until all are done,
+ * or stop is set.
+ */
+static void *smt2_prelexer_worker(void *arg) {
+  smt2_prelexer_t *pre;
+  smt2_chunk_t *c;
+
+  pre = (smt2_prelexer_t *) arg;
+
+  pthread_mutex_lock(&pre->lock);
+  while (!pre->stop && pre->next < pre->nchunks) {
+    if (pre->next >= pre->current + pre->ahead) {
+      // too far ahead of the parser
+      pthread_cond_wait(&pre->consumed, &pre->lock);
+    } else {
+      c = pre->chunk + pre->next;
+      pre->next ++;
+      pthread_mutex_unlock(&pre->lock);
+      smt2_scan_chunk(pre, c);
+      pthread_mutex_lock(&pre->lock);
+      c->ready = true;
+      pthread_cond_broadcast(&pre->scanned);
+    }
+  }
+  pthread_mutex_unlock(&pre->lock);
+
+  return NULL;
+}
+
+
+/*
+ * Cut the input into chunks that start at the beginning of a line
+ * - return the number of chunks
+ */
+static uint32_t smt2_prelexer_split(smt2_prelexer_t *pre, uint64_t size) {
+  const char *p;
+  uint64_t n, step, start, target, b;
+  uint32_t i, k;
+
+  n = size / SMT2_PRELEX_CHUNK_SIZE;
+  assert(n >= 2);
+  if (n > UINT32_MAX/sizeof(smt2_chunk_t)) {
+    n = UINT32_MAX/sizeof(smt2_chunk_t);
+  }
+  step = size / n;
+
+  pre->chunk = (smt2_chunk_t *) safe_malloc(n * sizeof(smt2_chunk_t));
+  k = 0;
+  start = 0;
+  for (i=1; i<n; i++) {
+    target = i * step;
+    if (target <= start) continue;
+    p = memchr(pre->data + target, '\n', size - target);
+    if (p == NULL) break;
+    b = (p - pre->data) + 1;
+    if (b >= size) break;
+    pre->chunk[k].start = start;
+    pre->chunk[k].end = b;
+    k ++;
+    start = b;
+  }
+  pre->chunk[k].start = start;
+  pre->chunk[k].end = size;
+  k ++;
+
+  for (i=0; i<k; i++) {
+    pre->chunk[i].tokens = NULL;
+    pre->chunk[i].ready = false;
+  }
+
+  return k;
+}
+
+
+/*
+ * Stop the threads
+ */
+static void smt2_prelexer_stop(smt2_prelexer_t *pre) {
+  pthread_mutex_lock(&pre->lock);
+  pre->stop = true;
+  pthread_cond_broadcast(&pre->consumed);
+  pthread_mutex_unlock(&pre->lock);
+}
+
+
+/*
+ * Start the prelexer
+ */
+smt2_prelexer_t *new_smt2_prelexer(lexer_t *lex, uint32_t nthreads) {
+  smt2_prelexer_t *pre;
+  reader_t *rd;
+  uint32_t i;
+
+  rd = &lex->reader;
+  if (nthreads <= 1 || !reader_in_memory(rd) || reader_position(rd) != 0 ||
+      rd->size < 2 * SMT2_PRELEX_CHUNK_SIZE) {
+    return NULL;
+  }
+
+  pre = (smt2_prelexer_t *) safe_malloc(sizeof(smt2_prelexer_t));
+  pre->lex = lex;
+  pre->data = rd->data;
+  pre->two_dot_five = smt2_lexer_two_dot_five();
+  pre->nchunks = smt2_prelexer_split(pre, rd->size);
+  if (pre->nchunks < 2) {
+    safe_free(pre->chunk);
+    safe_free(pre);
+    return NULL;
+  }
+
+  pre->current = 0;
+  pre->index = 0;
+  pre->line = 1;
+  pre->next = 0;
+  pre->ahead = SMT2_PRELEX_AHEAD * nthreads;
+  pre->stop = false;
+  pthread_mutex_init(&pre->lock, NULL);
+  pthread_cond_init(&pre->scanned, NULL);
+  pthread_cond_init(&pre->consumed, NULL);
+
+  pre->threads = (pthread_t *) safe_malloc(nthreads * sizeof(pthread_t));
+  for (i=0; i<nthreads; i++) {
+    if (pthread_create(pre->threads + i, NULL, smt2_prelexer_worker, pre) != 0) {
+      break;
+    }
+  }
+  pre->nthreads = i;
+
+  if (i == 0) {
+    // no thread
+    pthread_mutex_destroy(&pre->lock);
+    pthread_cond_destroy(&pre->scanned);
+    pthread_cond_destroy(&pre->consumed);
+    safe_free(pre->threads);
+    safe_free(pre->chunk);
+    safe_free(pre);
+    return NULL;
+  }
+
+  lex->tokens = pre;
+
+  return pre;
+}
+
+
+/*
+ * Stop and delete
+ */
+void delete_smt2_prelexer(smt2_prelexer_t *pre) {
+  uint32_t i;
+
+  smt2_prelexer_stop(pre);
+  for (i=0; i<pre->nthreads; i++) {
+    pthread_join(pre->threads[i], NULL);
+  }
+
+  // all the chunks before current are already freed
+  for (i=pre->current; i<pre->nchunks; i++) {
+    if (pre->chunk[i].ready) {
+      smt2_free_chunk(pre->chunk + i);
+    }
+  }
+
+  if (pre->lex->tokens == pre) {
+    pre->lex->tokens = NULL;
+  }
+
+  pthread_mutex_destroy(&pre->lock);
+  pthread_cond_destroy(&pre->scanned);
+  pthread_cond_destroy(&pre->consumed);
+  safe_free(pre->threads);
+  safe_free(pre->chunk);
+  safe_free(pre);
+}
+
+
+/*
+ * Wait until the current chunk is scanned
+ */
+static void smt2_prelexer_wait(smt2_prelexer_t *pre) {
+  smt2_chunk_t *c;
+
+  c = pre->chunk + pre->current;
+  pthread_mutex_lock(&pre->lock);
+  while (!c->ready) {
+    pthread_cond_wait(&pre->scanned, &pre->lock);
+  }
+  pthread_mutex_unlock(&pre->lock);
+}
+
+
+/*
+ * Done with the current chunk: move to the next one
+ */
+static void smt2_prelexer_next_chunk(smt2_prelexer_t *pre) {
+  smt2_chunk_t *c;
+
+  c = pre->chunk + pre->current;
+  assert(pre->current + 1 < pre->nchunks);
+
+  pre->line += c->newlines;
+  smt2_free_chunk(c);
+  pre->index = 0;
+
+  pthread_mutex_lock(&pre->lock);
+  pre->current ++;
+  pthread_cond_broadcast(&pre->consumed);
+  pthread_mutex_unlock(&pre->lock);
+}
+
+
+/*
+ * Next token
+ */
+bool smt2_prelexer_next_token(smt2_prelexer_t *pre, lexer_t *lex) {
+  smt2_chunk_t *c;
+  smt2_token_desc_t *d;
+
+  assert(lex->tokens == pre && pre->lex == lex);
+
+  for (;;) {
+    c = pre->chunk + pre->current;
+    if (pre->index == 0) {
+      smt2_prelexer_wait(pre);
+    }
+    d = c->tokens + pre->index;
+    if (d->token != SMT2_TK_EOS || pre->current + 1 == pre->nchunks) break;
+    smt2_prelexer_next_chunk(pre);
+  }
+
+  if (pre->two_dot_five != smt2_lexer_two_dot_five() ||
+      (c->cut && pre->index + 2 == c->ntokens)) {
+    /*
+     * The token may be wrong: continue without the prelexer
+     * from the start of this token.
+     */
+    reader_set_position(&lex->reader, c->start + d->pos, pre->line + d->line - 1, d->column);
+    lex->tokens = NULL;
+    smt2_prelexer_stop(pre);
+    return false;
+  }
+
+  lex->token = d->token;
+  lex->tk_pos = c->start + d->pos;
+  lex->tk_line = pre->line + d->line - 1;
+  lex->tk_column = d->column;
+  string_buffer_reset(lex->buffer);
+  string_buffer_append_chars(lex->buffer, c->values.data + d->value, d->length);
+  string_buffer_close(lex->buffer);
+  reader_set_position(&lex->reader, c->start + d->end_pos, pre->line + d->end_line - 1, d->end_column);
+
+  if (d->token != SMT2_TK_EOS) {
+    pre->index ++;
+  }
+
+  return true;
+}
+
+
+#else
+
+/*
+ * No thread support
+ */
+smt2_prelexer_t *new_smt2_prelexer(lexer_t *lex, uint32_t nthreads) {
+  return NULL;
+}
+
+void delete_smt2_prelexer(smt2_prelexer_t *pre) {
+}
+
+bool smt2_prelexer_next_token(smt2_prelexer_t *pre, lexer_t *lex) {
+  lex->tokens = NULL;
+  return false;
+}
+
+#endif
@@ -0,0 +1,76 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * PARALLEL SCANNING OF SMT2 FILES
+ *
+ * For large benchmarks, a good part of the parsing time is spent in
+ * the lexer. If the input file is in memory, we can cut it into
+ * chunks and convert each chunk into a sequence of tokens on a
+ * separate thread. The parser then reads the tokens from these
+ * sequences instead of scanning the input itself. Term construction
+ * (term stack + term tables) stays on the parser's thread.
+ *
+ * Chunks start at the beginning of a line. The lexer state at
+ * that point is not known in advance: the line could be inside a
+ * string literal or a quoted symbol. In this case, the scan of the
+ * previous chunk ends with an unterminated string or symbol. When
+ * the parser reaches such a token, or if the SMT-LIB 2.5 syntax is
+ * enabled while tokens are pending, the prelexer gives up: the
+ * lexer's reader is moved to the start of the next token and the
+ * rest of the input is read sequentially.
+ *
+ * Threads are used only if yices is compiled with THREAD_SAFE
+ * (and not on Windows). Otherwise new_smt2_prelexer returns NULL.
+ */
+
+#ifndef __SMT2_PRELEXER_H
+#define __SMT2_PRELEXER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "parser_utils/lexer.h"
+
+typedef struct smt2_prelexer_s smt2_prelexer_t;
+
+/*
+ * Start scanning lex's input on nthreads threads
+ * - lex must be an SMT2 lexer that hasn't read anything yet
+ * - the prelexer is attached to lex: next_smt2_token will
+ *   return the pre-scanned tokens
+ * - return NULL if this is not possible (input not in memory,
+ *   input too small, nthreads <= 1, or no thread support).
+ */
+extern smt2_prelexer_t *new_smt2_prelexer(lexer_t *lex, uint32_t nthreads);
+
+/*
+ * Stop the threads, detach the prelexer from its lexer and free memory
+ */
+extern void delete_smt2_prelexer(smt2_prelexer_t *pre);
+
+/*
+ * Get the next token for lex (called by next_smt2_token)
+ * - if there's one, store it in lex as the lexer would and return true
+ * - otherwise, detach pre from lex, move lex's reader to where the
+ *   lexer must continue, and return false
+ */
+extern bool smt2_prelexer_next_token(smt2_prelexer_t *pre, lexer_t *lex);
+
+
+#endif /* __SMT2_PRELEXER_H */
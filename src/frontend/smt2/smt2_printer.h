@@ -89,6 +89,13 @@ static inline void delete_smt2_pp(smt2_pp_t *printer, bool flush) {
 
 
 
+/*
+ * Convert a bitvector value b to an unsigned integer
+ * - the integer is stored in z
+ */
+extern void convert_bv_to_rational(mpz_t z, const value_bv_t *b);
+
+
 /*
  * Print object c using a pretty printer object
  * - c must be a valid object in table
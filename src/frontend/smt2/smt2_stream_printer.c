@@ -0,0 +1,394 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * STREAMING OUTPUT OF SMT2 VALUES
+ */
+
+#include <assert.h>
+
+#include "frontend/smt2/smt2_lexer.h"
+#include "frontend/smt2/smt2_printer.h"
+#include "frontend/smt2/smt2_stream_printer.h"
+
+
+/*
+ * Initialization
+ */
+void init_smt2_stream(smt2_stream_t *stream, FILE *file, bool dec) {
+  stream->file = file;
+  init_string_buffer(&stream->buffer, SMT2_STREAM_BLOCK + 256);
+  stream->bv_as_decimal = dec;
+  mpz_init(stream->aux);
+}
+
+/*
+ * Flush
+ */
+void flush_smt2_stream(smt2_stream_t *stream) {
+  string_buffer_t *b;
+
+  if (stream->file == NULL) return;
+
+  b = &stream->buffer;
+  if (b->index > 0) {
+    fwrite(b->data, 1, b->index, stream->file);
+    string_buffer_reset(b);
+  }
+  fflush(stream->file);
+}
+
+/*
+ * Deletion
+ */
+void delete_smt2_stream(smt2_stream_t *stream) {
+  flush_smt2_stream(stream);
+  delete_string_buffer(&stream->buffer);
+  mpz_clear(stream->aux);
+}
+
+
+/*
+ * Write the buffer if it's full enough. This is called after
+ * every definition or value so the output goes out incrementally.
+ */
+static void smt2_stream_check(smt2_stream_t *stream) {
+  string_buffer_t *b;
+
+  b = &stream->buffer;
+  if (b->index >= SMT2_STREAM_BLOCK && stream->file != NULL) {
+    fwrite(b->data, 1, b->index, stream->file);
+    string_buffer_reset(b);
+  }
+}
+
+
+/*
+ * Basic output
+ */
+void smt2_stream_string(smt2_stream_t *stream, const char *s) {
+  string_buffer_append_string(&stream->buffer, s);
+}
+
+void smt2_stream_char(smt2_stream_t *stream, char c) {
+  string_buffer_append_char(&stream->buffer, c);
+}
+
+/*
+ * Symbol: add quotes if needed
+ */
+static void smt2_stream_symbol(smt2_stream_t *stream, const char *name) {
+  if (symbol_needs_quotes(name)) {
+    smt2_stream_char(stream, '|');
+    smt2_stream_string(stream, name);
+    smt2_stream_char(stream, '|');
+  } else {
+    smt2_stream_string(stream, name);
+  }
+}
+
+
+/*
+ * Check whether c is supported
+ */
+bool smt2_stream_supports(value_table_t *table, value_t c) {
+  assert(0 <= c && c < table->nobjects);
+
+  switch (table->kind[c]) {
+  case UNKNOWN_VALUE:
+  case BOOLEAN_VALUE:
+  case RATIONAL_VALUE:
+  case BITVECTOR_VALUE:
+  case UNINTERPRETED_VALUE:
+    return true;
+
+  default:
+    return false;
+  }
+}
+
+
+/*
+ * SMT2 expressions: tokens are separated by spaces,
+ * except after '(' and before ')'.
+ */
+void smt2_stream_expr(smt2_stream_t *stream, etk_queue_t *queue, int32_t i) {
+  etoken_t *tk;
+  int32_t n;
+  bool space;
+
+  space = false;
+  n = token_sibling(queue, i);
+  while (i < n) {
+    tk = get_etoken(queue, i);
+    switch (tk->key) {
+    case ETK_OPEN:
+      if (space) smt2_stream_char(stream, ' ');
+      smt2_stream_char(stream, '(');
+      space = false;
+      break;
+
+    case ETK_CLOSE:
+      smt2_stream_char(stream, ')');
+      space = true;
+      break;
+
+    case SMT2_TK_QSYMBOL:
+      if (space) smt2_stream_char(stream, ' ');
+      smt2_stream_char(stream, '|');
+      smt2_stream_string(stream, tk->ptr);
+      smt2_stream_char(stream, '|');
+      space = true;
+      break;
+
+    case SMT2_TK_STRING:
+      if (space) smt2_stream_char(stream, ' ');
+      smt2_stream_char(stream, '"');
+      smt2_stream_string(stream, tk->ptr);
+      smt2_stream_char(stream, '"');
+      space = true;
+      break;
+
+    default:
+      if (space) smt2_stream_char(stream, ' ');
+      smt2_stream_string(stream, tk->ptr);
+      space = true;
+      break;
+    }
+    i ++;
+  }
+}
+
+
+/*
+ * Types: same output as smt2_pp_type
+ */
+static void smt2_stream_type_recur(smt2_stream_t *stream, type_table_t *tbl, type_t tau, int32_t level) {
+  char *name;
+  uint32_t i, n;
+
+  assert(good_type(tbl, tau));
+
+  name = type_name(tbl, tau);
+
+  switch (type_kind(tbl, tau)) {
+  case BOOL_TYPE:
+    smt2_stream_string(stream, "Bool");
+    break;
+
+  case INT_TYPE:
+    smt2_stream_string(stream, "Int");
+    break;
+
+  case REAL_TYPE:
+    smt2_stream_string(stream, "Real");
+    break;
+
+  case BITVECTOR_TYPE:
+    if (name != NULL && level <= 0) {
+      smt2_stream_symbol(stream, name);
+    } else {
+      smt2_stream_string(stream, "(_ BitVec ");
+      string_buffer_append_uint32(&stream->buffer, bv_type_size(tbl, tau));
+      smt2_stream_char(stream, ')');
+    }
+    break;
+
+  case INSTANCE_TYPE:
+    if (name != NULL && level <= 0) {
+      smt2_stream_symbol(stream, name);
+    } else {
+      assert(tbl->macro_tbl != NULL);
+      smt2_stream_char(stream, '(');
+      smt2_stream_symbol(stream, type_macro_name(tbl->macro_tbl, instance_type_cid(tbl, tau)));
+      n = instance_type_arity(tbl, tau);
+      for (i=0; i<n; i++) {
+        smt2_stream_char(stream, ' ');
+        smt2_stream_type_recur(stream, tbl, instance_type_param(tbl, tau, i), level - 1);
+      }
+      smt2_stream_char(stream, ')');
+    }
+    break;
+
+  case FUNCTION_TYPE:
+    if (name != NULL && level <= 0) {
+      smt2_stream_symbol(stream, name);
+    } else {
+      n = function_type_arity(tbl, tau);
+      if (n == 1) {
+        smt2_stream_string(stream, "(Array");
+      } else {
+        smt2_stream_string(stream, "(FunType");
+        string_buffer_append_uint32(&stream->buffer, n);
+      }
+      for (i=0; i<n; i++) {
+        smt2_stream_char(stream, ' ');
+        smt2_stream_type_recur(stream, tbl, function_type_domain(tbl, tau, i), level - 1);
+      }
+      smt2_stream_char(stream, ' ');
+      smt2_stream_type_recur(stream, tbl, function_type_range(tbl, tau), level - 1);
+      smt2_stream_char(stream, ')');
+    }
+    break;
+
+  case UNINTERPRETED_TYPE:
+    if (name != NULL) {
+      smt2_stream_symbol(stream, name);
+      break;
+    }
+    // fall through: anonymous type
+  default:
+    smt2_stream_string(stream, "|tau");
+    string_buffer_append_int32(&stream->buffer, tau);
+    smt2_stream_char(stream, '|');
+    break;
+  }
+}
+
+
+/*
+ * Integers: negative numbers are written (- n)
+ */
+static void smt2_stream_integer(smt2_stream_t *stream, rational_t *q, bool as_real) {
+  string_buffer_t *b;
+
+  assert(q_is_integer(q));
+
+  b = &stream->buffer;
+  if (q_is_neg(q)) {
+    q_neg(q);
+    smt2_stream_string(stream, "(- ");
+    string_buffer_append_rational(b, q);
+    if (as_real) smt2_stream_string(stream, ".0");
+    smt2_stream_char(stream, ')');
+    q_neg(q); // restore q
+  } else {
+    string_buffer_append_rational(b, q);
+    if (as_real) smt2_stream_string(stream, ".0");
+  }
+}
+
+/*
+ * Rationals: non-integers are written (/ num den)
+ */
+static void smt2_stream_rational(smt2_stream_t *stream, rational_t *q) {
+  rational_t num, den;
+
+  if (q_is_integer(q)) {
+    smt2_stream_integer(stream, q, false);
+  } else {
+    q_init(&num);
+    q_init(&den);
+    q_get_num(&num, q);
+    q_get_den(&den, q);
+    smt2_stream_string(stream, "(/ ");
+    smt2_stream_integer(stream, &num, false);
+    smt2_stream_char(stream, ' ');
+    string_buffer_append_rational(&stream->buffer, &den);
+    smt2_stream_char(stream, ')');
+    q_clear(&num);
+    q_clear(&den);
+  }
+}
+
+static void smt2_stream_bitvector(smt2_stream_t *stream, value_bv_t *b) {
+  if (stream->bv_as_decimal) {
+    convert_bv_to_rational(stream->aux, b);
+    smt2_stream_string(stream, "(_ bv");
+    string_buffer_append_mpz(&stream->buffer, stream->aux);
+    smt2_stream_char(stream, ' ');
+    string_buffer_append_uint32(&stream->buffer, b->nbits);
+    smt2_stream_char(stream, ')');
+  } else {
+    smt2_stream_string(stream, "#b");
+    string_buffer_append_bvconst(&stream->buffer, b->data, b->nbits);
+  }
+}
+
+static void smt2_stream_unint_name(smt2_stream_t *stream, value_t c) {
+  smt2_stream_string(stream, "@const_");
+  string_buffer_append_int32(&stream->buffer, c);
+}
+
+
+/*
+ * Print object c
+ */
+void smt2_stream_object(smt2_stream_t *stream, value_table_t *table, value_t c, type_t tau) {
+  assert(smt2_stream_supports(table, c));
+
+  switch (table->kind[c]) {
+  case UNKNOWN_VALUE:
+    smt2_stream_string(stream, "???");
+    break;
+
+  case BOOLEAN_VALUE:
+    smt2_stream_string(stream, table->desc[c].integer ? "true" : "false");
+    break;
+
+  case RATIONAL_VALUE:
+    if (tau != NULL_TYPE && is_real_type(tau) && q_is_integer(&table->desc[c].rational)) {
+      smt2_stream_integer(stream, &table->desc[c].rational, true);
+    } else {
+      smt2_stream_rational(stream, &table->desc[c].rational);
+    }
+    break;
+
+  case BITVECTOR_VALUE:
+    smt2_stream_bitvector(stream, table->desc[c].ptr);
+    break;
+
+  case UNINTERPRETED_VALUE:
+    smt2_stream_unint_name(stream, c);
+    break;
+
+  default:
+    assert(false);
+    break;
+  }
+  smt2_stream_check(stream);
+}
+
+
+/*
+ * Definition (define-fun name () tau c)
+ * - uninterpreted constants are written (as @const_c tau) as in smt2_pp_def
+ */
+void smt2_stream_def(smt2_stream_t *stream, value_table_t *table, const char *name, type_t tau, value_t c) {
+  type_table_t *types;
+
+  assert(smt2_stream_supports(table, c));
+
+  types = table->type_table;
+  smt2_stream_string(stream, "(define-fun ");
+  smt2_stream_symbol(stream, name);
+  smt2_stream_string(stream, " () ");
+  smt2_stream_type_recur(stream, types, tau, 0);
+  smt2_stream_char(stream, ' ');
+  if (object_is_unint(table, c)) {
+    smt2_stream_string(stream, "(as ");
+    smt2_stream_unint_name(stream, c);
+    smt2_stream_char(stream, ' ');
+    smt2_stream_type_recur(stream, types, tau, 0);
+    smt2_stream_char(stream, ')');
+  } else {
+    smt2_stream_object(stream, table, c, tau);
+  }
+  smt2_stream_char(stream, ')');
+  smt2_stream_check(stream);
+}
@@ -0,0 +1,140 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * STREAMING OUTPUT OF SMT2 VALUES
+ */
+
+/*
+ * The pretty printer (yices_pp) computes a layout for every block
+ * before printing anything. That's too expensive for large models
+ * (e.g., (get-model) with 10^6 variables). This module writes values
+ * directly in the SMT2 syntax: every definition or (term value) pair
+ * is printed on a single line, and the output is sent to the file
+ * as soon as the internal buffer is full.
+ *
+ * Only scalar values are supported (Booleans, rationals, bit-vectors,
+ * and uninterpreted constants). Functions and algebraic numbers must
+ * be printed with the pretty printer.
+ */
+
+#ifndef __SMT2_STREAM_PRINTER_H
+#define __SMT2_STREAM_PRINTER_H
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <gmp.h>
+
+#include "frontend/smt2/smt2_expressions.h"
+#include "model/concrete_values.h"
+#include "utils/string_buffers.h"
+
+
+/*
+ * Stream object:
+ * - file = output stream or NULL (then nothing is written: the stream
+ *   is used to measure the length of the output)
+ * - buffer = pending output
+ * - bv_as_decimal: same meaning as in smt2_pp_t
+ * - aux: to convert bitvector constants to integers
+ */
+typedef struct smt2_stream_s {
+  FILE *file;
+  string_buffer_t buffer;
+  bool bv_as_decimal;
+  mpz_t aux;
+} smt2_stream_t;
+
+
+/*
+ * The buffer is written to file when its length exceeds this bound
+ */
+#define SMT2_STREAM_BLOCK 4096
+
+
+/*
+ * Initialization:
+ * - file = output stream or NULL
+ * - dec = value for bv_as_decimal
+ */
+extern void init_smt2_stream(smt2_stream_t *stream, FILE *file, bool dec);
+
+/*
+ * If file is NULL: length of the output since the last call to
+ * smt2_stream_discard, and remove that output.
+ */
+static inline uint32_t smt2_stream_length(smt2_stream_t *stream) {
+  assert(stream->file == NULL);
+  return stream->buffer.index;
+}
+
+static inline void smt2_stream_discard(smt2_stream_t *stream) {
+  assert(stream->file == NULL);
+  string_buffer_reset(&stream->buffer);
+}
+
+/*
+ * Write all pending output to the file
+ */
+extern void flush_smt2_stream(smt2_stream_t *stream);
+
+/*
+ * Delete: flush then free memory
+ */
+extern void delete_smt2_stream(smt2_stream_t *stream);
+
+
+/*
+ * Check whether c can be printed by this module
+ * - c must be a valid object in table
+ */
+extern bool smt2_stream_supports(value_table_t *table, value_t c);
+
+/*
+ * Basic output
+ */
+extern void smt2_stream_string(smt2_stream_t *stream, const char *s);
+extern void smt2_stream_char(smt2_stream_t *stream, char c);
+
+/*
+ * Print the SMT2 expression that starts at index i of queue
+ * (all on one line).
+ */
+extern void smt2_stream_expr(smt2_stream_t *stream, etk_queue_t *queue, int32_t i);
+
+/*
+ * Print object c
+ * - c must be a valid object in table, and smt2_stream_supports(table, c)
+ *   must be true
+ * - tau = the type of the term whose value is c. If tau is real and c is
+ *   an integer, then c is printed as a real (e.g., 2.0).
+ * - tau may be NULL_TYPE
+ */
+extern void smt2_stream_object(smt2_stream_t *stream, value_table_t *table, value_t c, type_t tau);
+
+/*
+ * Print a definition: (define-fun name () tau c)
+ * - same conditions on c as for smt2_stream_object
+ * - this is the equivalent of smt2_pp_def for scalar values
+ */
+extern void smt2_stream_def(smt2_stream_t *stream, value_table_t *table, const char *name, type_t tau, value_t c);
+
+
+#endif /* __SMT2_STREAM_PRINTER_H */
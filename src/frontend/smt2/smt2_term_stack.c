@@ -1551,7 +1551,7 @@ static void check_named_attribute(tstack_t *stack, stack_elem_t *f, term_t t, co
   if (! yices_term_is_ground(t)) {
     raise_exception(stack, f, SMT2_NAMED_TERM_NOT_GROUND);
   }
-  if (yices_get_term_by_name(s) != NULL_TERM) {
+  if (tstack_get_term_by_name(stack, s) != NULL_TERM) {
     raise_exception(stack, f, SMT2_NAMED_SYMBOL_REUSED);
   }
 }
@@ -1398,6 +1398,14 @@ static void show_param(yices_param_t p, uint32_t n) {
     show_pos32_param(param2string[p], parameters.max_extensionality, n);
     break;
 
+  case PARAM_MINIMIZE_CORE:
+    show_bool_param(param2string[p], parameters.minimize_core, n);
+    break;
+
+  case PARAM_CORE_MIN_TIMEOUT:
+    show_float_param(param2string[p], parameters.core_min_timeout, n);
+    break;
+
   case PARAM_EF_FLATTEN_IFF:
     show_bool_param(param2string[p], ef_client_globals.ef_parameters.flatten_iff, n);
     break;
@@ -1889,6 +1897,20 @@ static void yices_setparam_cmd(const char *param, const param_val_t *val) {
     }
     break;
 
+  case PARAM_MINIMIZE_CORE:
+    if (param_val_to_bool(param, val, &tt, &reason)) {
+      parameters.minimize_core = tt;
+      print_ok();
+    }
+    break;
+
+  case PARAM_CORE_MIN_TIMEOUT:
+    if (param_val_to_nonnegfloat(param, val, &x, &reason)) {
+      parameters.core_min_timeout = x;
+      print_ok();
+    }
+    break;
+
   case PARAM_EF_FLATTEN_IFF:
     if (param_val_to_bool(param, val, &tt, &reason)) {
       ef_client_globals.ef_parameters.flatten_iff = tt;
@@ -33,6 +33,7 @@
 #include <errno.h>
 #include <unistd.h>
 #include <inttypes.h>
+#include <float.h>
 
 #if defined(MINGW)
 /*
@@ -60,8 +61,11 @@
 #endif
 
 #include "frontend/common/parameters.h"
+#include "frontend/common/session_server.h"
+#include "frontend/smt2/smt2_binary.h"
 #include "frontend/smt2/smt2_commands.h"
 #include "frontend/smt2/smt2_lexer.h"
+#include "frontend/smt2/smt2_prelexer.h"
 #include "frontend/smt2/smt2_parser.h"
 #include "frontend/smt2/smt2_term_stack.h"
 #include "io/simple_printf.h"
@@ -87,12 +91,21 @@ extern const char * const yices_rev;
  * - interactive: set option :print-success to true.
  *   and  print a prompt before parsing commands if stdin is a terminal.
  * - timeout: command-line option
+ * - lexer_threads: number of threads for scanning the input file
+ *   (prelexer = NULL if the input is scanned by the lexer itself)
  *
  * - filename = name of the input file (NULL means read stdin)
+ *
+ * - server_path = socket for the server mode (NULL means no server)
+ * - session_limits = limits on the server's sessions
+ *
+ * - telemetry_file = file for the telemetry samples (NULL means none)
+ * - telemetry_period = sampling period
  */
 static lexer_t lexer;
 static parser_t parser;
 static tstack_t stack;
+static smt2_prelexer_t *prelexer;
 
 static bool incremental;
 static bool interactive;
@@ -101,9 +114,16 @@ static bool bvdecimal;
 static bool show_stats;
 static int32_t verbosity;
 static uint32_t timeout;
+static uint32_t lexer_threads;
 static char *filename;
 static char *delegate;
 static char *dimacsfile;
+static bool binary_input;
+static char *binaryfile;
+static char *server_path;
+static session_limits_t session_limits;
+static char *telemetry_file;
+static double telemetry_period;
 
 // mcsat options
 static bool mcsat;
@@ -113,6 +133,11 @@ static bool mcsat_nra_bound;
 static int32_t mcsat_nra_bound_min;
 static int32_t mcsat_nra_bound_max;
 static int32_t mcsat_bv_var_size;
+static int32_t mcsat_portfolio;
+static bool mcsat_lemma_minimize;
+static int32_t mcsat_bv_bdd_max_size;
+static bool mcsat_nra_icp;
+static int32_t mcsat_nra_explain_threads;
 
 static pvector_t trace_tags;
 
@@ -156,8 +181,17 @@ typedef enum optid {
   yicesformat_opt,         // use the Yices model format for models
   bvdecimal_opt,           // use (_ bv<xxx> n) for bit-vector constants
   timeout_opt,             // give a timeout
+  lexer_threads_opt,       // scan the input file on several threads
   delegate_opt,            // use an external sat solver
   dimacs_opt,              // bitblast then export to DIMACS
+  binary_input_opt,        // the input is in binary format
+  write_binary_opt,        // convert the input to binary format
+  server_opt,              // run as a server
+  max_sessions_opt,        // max number of concurrent sessions in server mode
+  session_cpu_limit_opt,   // CPU time limit per session
+  session_mem_limit_opt,   // memory limit per session
+  telemetry_opt,           // write telemetry samples to a file
+  telemetry_period_opt,    // telemetry sampling period
   mcsat_opt,               // enable mcsat
   mcsat_nra_mgcd_opt,      // use the mgcd instead psc in projection
   mcsat_nra_nlsat_opt,     // use the nlsat projection instead of brown single-cell
@@ -165,6 +199,11 @@ typedef enum optid {
   mcsat_nra_bound_min_opt, // set initial bound
   mcsat_nra_bound_max_opt, // set maximal bound
   mcsat_bv_var_size_opt,   // set size of bitvector variables
+  mcsat_portfolio_opt, // mcsat portfolio size
+  mcsat_lemma_minimize_opt, // minimize learned lemmas
+  mcsat_bv_bdd_max_size_opt, // use word-level domains above this size
+  mcsat_nra_icp_opt, // use interval propagation before NRA explanations
+  mcsat_nra_explain_threads_opt, // threads used in NRA projection
   trace_opt,               // enable a trace tag
   show_ef_help_opt,        // print help about the ef options
   ematch_en_opt,                    // enable ematching
@@ -199,12 +238,21 @@ static option_desc_t options[NUM_OPTIONS] = {
   { "stats", 's', FLAG_OPTION, show_stats_opt },
   { "verbosity", 'v', MANDATORY_INT, verbosity_opt },
   { "timeout", 't', MANDATORY_INT, timeout_opt },
+  { "lexer-threads", '\0', MANDATORY_INT, lexer_threads_opt },
   { "incremental", '\0', FLAG_OPTION, incremental_opt },
   { "interactive", '\0', FLAG_OPTION, interactive_opt },
   { "yices-model-format", '\0', FLAG_OPTION, yicesformat_opt },
   { "bvconst-in-decimal", '\0', FLAG_OPTION, bvdecimal_opt },
   { "delegate", '\0', MANDATORY_STRING, delegate_opt },
   { "dimacs", '\0', MANDATORY_STRING, dimacs_opt },
+  { "binary-input", '\0', FLAG_OPTION, binary_input_opt },
+  { "write-binary", '\0', MANDATORY_STRING, write_binary_opt },
+  { "server", '\0', MANDATORY_STRING, server_opt },
+  { "max-sessions", '\0', MANDATORY_INT, max_sessions_opt },
+  { "session-cpu-limit", '\0', MANDATORY_INT, session_cpu_limit_opt },
+  { "session-mem-limit", '\0', MANDATORY_INT, session_mem_limit_opt },
+  { "telemetry", '\0', MANDATORY_STRING, telemetry_opt },
+  { "telemetry-period", '\0', MANDATORY_FLOAT, telemetry_period_opt },
   { "mcsat", '\0', FLAG_OPTION, mcsat_opt },
   { "mcsat-nra-mgcd", '\0', FLAG_OPTION, mcsat_nra_mgcd_opt },
   { "mcsat-nra-nlsat", '\0', FLAG_OPTION, mcsat_nra_nlsat_opt },
@@ -212,6 +260,11 @@ static option_desc_t options[NUM_OPTIONS] = {
   { "mcsat-nra-bound-min", '\0', MANDATORY_INT, mcsat_nra_bound_min_opt },
   { "mcsat-nra-bound-max", '\0', MANDATORY_INT, mcsat_nra_bound_max_opt },
   { "mcsat-bv-var-size", '\0', MANDATORY_INT, mcsat_bv_var_size_opt },
+  { "mcsat-portfolio", '\0', MANDATORY_INT, mcsat_portfolio_opt },
+  { "mcsat-lemma-minimize", '\0', FLAG_OPTION, mcsat_lemma_minimize_opt },
+  { "mcsat-bv-bdd-max-size", '\0', MANDATORY_INT, mcsat_bv_bdd_max_size_opt },
+  { "mcsat-nra-icp", '\0', FLAG_OPTION, mcsat_nra_icp_opt },
+  { "mcsat-nra-explain-threads", '\0', MANDATORY_INT, mcsat_nra_explain_threads_opt },
   { "trace", 't', MANDATORY_STRING, trace_opt },
   { "ef-help", '0', FLAG_OPTION, show_ef_help_opt },
   { "ematch", '\0', FLAG_OPTION, ematch_en_opt },
@@ -262,12 +315,21 @@ static void print_help(const char *progname) {
          "    --timeout=<timeout>       Set a timeout in seconds (default = no timeout)\n"
          "           -t <timeout>\n"
          "    --stats, -s               Print statistics once all commands have been processed\n"
+         "    --lexer-threads=<n>       Scan the input file on n threads (thread-safe builds only, default = 1)\n"
          "    --incremental             Enable support for push/pop\n"
          "    --interactive             Run in interactive mode (ignored if a filename is given)\n"
          "    --yices-model-format      Display models in the Yices model format (default = false)\n"
          "    --bvconst-in-decimal      Display bit-vector constants as decimal numbers (default = false)\n"
          "    --delegate=<satsolver>    Use an external SAT solver (can be cadical, cryptominisat, kissat, or y2sat)\n"
          "    --dimacs=<filename>       Bitblast and export to a file (in DIMACS format)\n"
+         "    --binary-input            The input is in binary format (produced by --write-binary)\n"
+         "    --write-binary=<filename> Convert the input to binary format and write it to a file\n"
+         "    --server=<socket>         Run as a server: every connection to the socket is a new session\n"
+         "    --max-sessions=<n>        Maximal number of concurrent sessions in server mode (default = no limit)\n"
+         "    --session-cpu-limit=<s>   CPU time limit per session in seconds (default = no limit)\n"
+         "    --session-mem-limit=<mb>  Memory limit per session in megabytes (default = no limit)\n"
+         "    --telemetry=<filename>    Write search statistics to a file as JSON lines\n"
+         "    --telemetry-period=<s>    Minimal delay between telemetry samples in seconds (default = 1.0)\n"
          "    --mcsat                   Use the MCSat solver\n"
          "    --mcsat-help              Show the MCSat options\n"
          "    --ef-help                 Show the EF options\n"
@@ -285,7 +347,12 @@ static void print_mcsat_help(const char *progname) {
          "    --mcsat-nra-bound         Search by increasing the bound on variable magnitude\n"
          "    --mcsat-nra-bound-min=<B> Set initial lower bound\n"
          "    --mcsat-nra-bound-max=<B> Set maximal bound for search\n"
-         "    --mcsat-bv-var-size=<B>   Set size of bit-vector variables in MCSAT search"
+         "    --mcsat-bv-var-size=<B>   Set size of bit-vector variables in MCSAT search\n"
+         "    --mcsat-nra-explain-threads=<N> Number of threads for projection in NRA explanations (thread-safe builds only)\n"
+         "    --mcsat-nra-icp           Refute NRA conflicts with interval propagation before projection\n"
+         "    --mcsat-bv-bdd-max-size=<N> Skip BDDs for simple constraints on wider bit-vectors\n"
+         "    --mcsat-lemma-minimize    Remove redundant literals from learned lemmas\n"
+         "    --mcsat-portfolio=<N>     Number of solvers in the MCSAT portfolio (with shared lemmas)\n"
          "\n");
   fflush(stdout);
 }
@@ -374,8 +441,17 @@ static void parse_command_line(int argc, char *argv[]) {
   show_stats = false;
   verbosity = 0;
   timeout = 0;
+  lexer_threads = 1;
   delegate = NULL;
   dimacsfile = NULL;
+  binary_input = false;
+  binaryfile = NULL;
+  server_path = NULL;
+  session_limits.max_sessions = 0;
+  session_limits.cpu_limit = 0;
+  session_limits.mem_limit = 0;
+  telemetry_file = NULL;
+  telemetry_period = 1.0;
 
   mcsat = false;
   mcsat_nra_mgcd = false;
@@ -384,6 +460,11 @@ static void parse_command_line(int argc, char *argv[]) {
   mcsat_nra_bound_min = -1;
   mcsat_nra_bound_max = -1;
   mcsat_bv_var_size = -1;
+  mcsat_portfolio = -1;
+  mcsat_lemma_minimize = false;
+  mcsat_bv_bdd_max_size = -1;
+  mcsat_nra_icp = false;
+  mcsat_nra_explain_threads = -1;
 
   init_pvector(&trace_tags, 5);
 
@@ -463,6 +544,21 @@ static void parse_command_line(int argc, char *argv[]) {
         timeout = v;
         break;
 
+      case lexer_threads_opt:
+        v = elem.i_value;
+        if (v < 1) {
+          fprintf(stderr, "%s: the number of lexer threads must be positive\n", parser.command_name);
+          goto bad_usage;
+        }
+#if !defined(THREAD_SAFE) || defined(MINGW)
+        if (v > 1) {
+          fprintf(stderr, "%s: unsupported option: this version was not compiled with thread support (--lexer-threads must be 1)\n", parser.command_name);
+          goto bad_usage;
+        }
+#endif
+        lexer_threads = v;
+        break;
+
       case incremental_opt:
         incremental = true;
         break;
@@ -505,6 +601,72 @@ static void parse_command_line(int argc, char *argv[]) {
         }
         break;
 
+      case binary_input_opt:
+        binary_input = true;
+        break;
+
+      case write_binary_opt:
+        if (binaryfile == NULL) {
+          binaryfile = copy_string(elem.s_value);
+          if (binaryfile == NULL) {
+            fprintf(stderr, "%s: file-name %s is too long\n", parser.command_name, elem.s_value);
+            code = YICES_EXIT_USAGE;
+            goto exit;
+          }
+        } else {
+          fprintf(stderr, "%s: can't give more than one binary output file\n", parser.command_name);
+          goto bad_usage;
+        }
+        break;
+
+      case server_opt:
+        if (server_path == NULL) {
+          server_path = copy_string(elem.s_value);
+          if (server_path == NULL) {
+            fprintf(stderr, "%s: file-name %s is too long\n", parser.command_name, elem.s_value);
+            code = YICES_EXIT_USAGE;
+            goto exit;
+          }
+        } else {
+          fprintf(stderr, "%s: can't give more than one server socket\n", parser.command_name);
+          goto bad_usage;
+        }
+        break;
+
+      case max_sessions_opt:
+        if (! validate_integer_option(&parser, &elem, 0, INT32_MAX)) goto bad_usage;
+        session_limits.max_sessions = elem.i_value;
+        break;
+
+      case session_cpu_limit_opt:
+        if (! validate_integer_option(&parser, &elem, 0, INT32_MAX)) goto bad_usage;
+        session_limits.cpu_limit = elem.i_value;
+        break;
+
+      case session_mem_limit_opt:
+        if (! validate_integer_option(&parser, &elem, 0, INT32_MAX)) goto bad_usage;
+        session_limits.mem_limit = elem.i_value;
+        break;
+
+      case telemetry_opt:
+        if (telemetry_file == NULL) {
+          telemetry_file = copy_string(elem.s_value);
+          if (telemetry_file == NULL) {
+            fprintf(stderr, "%s: file-name %s is too long\n", parser.command_name, elem.s_value);
+            code = YICES_EXIT_USAGE;
+            goto exit;
+          }
+        } else {
+          fprintf(stderr, "%s: can't give more than one telemetry file\n", parser.command_name);
+          goto bad_usage;
+        }
+        break;
+
+      case telemetry_period_opt:
+        if (! validate_double_option(&parser, &elem, 0.0, false, DBL_MAX, false)) goto bad_usage;
+        telemetry_period = elem.d_value;
+        break;
+
       case yicesformat_opt:
         smt2_model_format = false;
         break;
@@ -551,6 +713,40 @@ static void parse_command_line(int argc, char *argv[]) {
         mcsat_bv_var_size = elem.i_value;
         break;
 
+      case mcsat_portfolio_opt:
+        if (! yices_has_mcsat()) goto no_mcsat;
+        if (! validate_integer_option(&parser, &elem, 0, INT32_MAX)) goto bad_usage;
+        mcsat_portfolio = elem.i_value;
+        break;
+
+      case mcsat_lemma_minimize_opt:
+        if (! yices_has_mcsat()) goto no_mcsat;
+        mcsat_lemma_minimize = true;
+        break;
+
+      case mcsat_bv_bdd_max_size_opt:
+        if (! yices_has_mcsat()) goto no_mcsat;
+        if (! validate_integer_option(&parser, &elem, 0, INT32_MAX)) goto bad_usage;
+        mcsat_bv_bdd_max_size = elem.i_value;
+        break;
+
+      case mcsat_nra_icp_opt:
+        if (! yices_has_mcsat()) goto no_mcsat;
+        mcsat_nra_icp = true;
+        break;
+
+      case mcsat_nra_explain_threads_opt:
+        if (! yices_has_mcsat()) goto no_mcsat;
+        if (! validate_integer_option(&parser, &elem, 0, INT32_MAX)) goto bad_usage;
+#if !defined(THREAD_SAFE) || defined(MINGW)
+        if (elem.i_value > 1) {
+          fprintf(stderr, "%s: unsupported option: this version was not compiled with thread support (--mcsat-nra-explain-threads must be at most 1)\n", parser.command_name);
+          goto bad_usage;
+        }
+#endif
+        mcsat_nra_explain_threads = elem.i_value;
+        break;
+
       case show_ef_help_opt:
         print_ef_help(parser.command_name);
         code = YICES_EXIT_SUCCESS;
@@ -678,8 +874,20 @@ static void parse_command_line(int argc, char *argv[]) {
     goto exit;
   }
 
-  // force interactive to false if there's a filename
-  if (filename != NULL) {
+  if (binary_input && binaryfile != NULL) {
+    fprintf(stderr, "%s: --binary-input and --write-binary can't be used together\n", parser.command_name);
+    code = YICES_EXIT_USAGE;
+    goto exit;
+  }
+
+  if (server_path != NULL && (filename != NULL || binary_input || binaryfile != NULL || dimacsfile != NULL || telemetry_file != NULL)) {
+    fprintf(stderr, "%s: --server can't be used with an input file, binary input or output, --dimacs, or --telemetry\n", parser.command_name);
+    code = YICES_EXIT_USAGE;
+    goto exit;
+  }
+
+  // force interactive to false if there's a filename or the input is binary
+  if (filename != NULL || binary_input || binaryfile != NULL) {
     interactive = false;
   }
   return;
@@ -753,6 +961,44 @@ static void setup_mcsat(void) {
     smt2_set_option(":yices-mcsat-bv-var-size", aval_bv_var_size);
     q_clear(&q);
   }
+
+  if (mcsat_portfolio >= 0) {
+    aval_t aval_portfolio;
+    rational_t q;
+    q_init(&q);
+    q_set32(&q, mcsat_portfolio);
+    aval_portfolio = attr_vtbl_rational(__smt2_globals.avtbl, &q);
+    smt2_set_option(":yices-mcsat-portfolio", aval_portfolio);
+    q_clear(&q);
+  }
+
+  if (mcsat_lemma_minimize) {
+    smt2_set_option(":yices-mcsat-lemma-minimize", aval_true);
+  }
+
+  if (mcsat_bv_bdd_max_size >= 0) {
+    aval_t aval_bv_bdd_max_size;
+    rational_t q;
+    q_init(&q);
+    q_set32(&q, mcsat_bv_bdd_max_size);
+    aval_bv_bdd_max_size = attr_vtbl_rational(__smt2_globals.avtbl, &q);
+    smt2_set_option(":yices-mcsat-bv-bdd-max-size", aval_bv_bdd_max_size);
+    q_clear(&q);
+  }
+
+  if (mcsat_nra_icp) {
+    smt2_set_option(":yices-mcsat-nra-icp", aval_true);
+  }
+
+  if (mcsat_nra_explain_threads >= 0) {
+    aval_t aval_nra_explain_threads;
+    rational_t q;
+    q_init(&q);
+    q_set32(&q, mcsat_nra_explain_threads);
+    aval_nra_explain_threads = attr_vtbl_rational(__smt2_globals.avtbl, &q);
+    smt2_set_option(":yices-mcsat-nra-explain-threads", aval_nra_explain_threads);
+    q_clear(&q);
+  }
 }
 
 static void setup_ef(void) {
@@ -1036,15 +1282,40 @@ static void force_utf8(void) {
 
 
 int main(int argc, char *argv[]) {
+  FILE *binary;
   int32_t code;
   uint32_t i;
   bool prompt;
 
   prompt = false;
+  binary = NULL;
   parse_command_line(argc, argv);
   force_utf8();
 
-  if (filename != NULL) {
+  if (server_path != NULL) {
+    /*
+     * Server mode: initialize the global tables once. Then
+     * serve_sessions returns in the session processes only,
+     * with stdin and stdout connected to the client.
+     */
+    yices_init();
+    if (serve_sessions(server_path, &session_limits) < 0) {
+      perror(server_path);
+      exit(YICES_EXIT_SYSTEM_ERROR);
+    }
+  }
+
+  if (binary_input) {
+    // binary input: no lexer
+    binary = stdin;
+    if (filename != NULL) {
+      binary = fopen(filename, "rb");
+      if (binary == NULL) {
+        perror(filename);
+        exit(YICES_EXIT_FILE_NOT_FOUND);
+      }
+    }
+  } else if (filename != NULL) {
     // read from file
     if (init_smt2_file_lexer(&lexer, filename) < 0) {
       perror(filename);
@@ -1058,7 +1329,9 @@ int main(int argc, char *argv[]) {
 
   init_handlers();
 
-  yices_init();
+  if (server_path == NULL) {
+    yices_init();
+  }
   init_smt2(!incremental, timeout, interactive);
   if (smt2_model_format) smt2_force_smt2_model_format();
   if (bvdecimal) smt2_force_bvdecimal_format();
@@ -1067,10 +1340,23 @@ int main(int argc, char *argv[]) {
     smt2_set_delegate(delegate);
     if (dimacsfile != NULL) smt2_set_dimacs_file(dimacsfile);
   }
+  if (binaryfile != NULL && smt2_open_binary_output(binaryfile) < 0) {
+    perror(binaryfile);
+    exit(YICES_EXIT_FILE_NOT_FOUND);
+  }
+  if (telemetry_file != NULL && smt2_open_telemetry(telemetry_file, telemetry_period) < 0) {
+    perror(telemetry_file);
+    exit(YICES_EXIT_FILE_NOT_FOUND);
+  }
 
   init_smt2_tstack(&stack);
   init_parser(&parser, &lexer, &stack);
 
+  prelexer = NULL;
+  if (filename != NULL && lexer_threads > 1 && !binary_input) {
+    prelexer = new_smt2_prelexer(&lexer, lexer_threads);
+  }
+
   init_parameter_name_table();
 
   if (verbosity > 0) {
@@ -1085,6 +1371,17 @@ int main(int argc, char *argv[]) {
   setup_mcsat();
   setup_ef();
 
+  if (binary_input) {
+    code = smt2_run_binary(binary, filename != NULL ? filename : "stdin");
+    if (binary != stdin) {
+      fclose(binary);
+    }
+    if (code < 0) {
+      delete_smt2();
+      exit(YICES_EXIT_SYNTAX_ERROR);
+    }
+  }
+
   while (smt2_active()) {
     if (prompt) {
       // prompt
@@ -1106,6 +1403,15 @@ int main(int argc, char *argv[]) {
     smt2_show_stats();
   }
 
+  if (binaryfile != NULL) {
+    if (smt2_close_binary_output() < 0) {
+      perror(binaryfile);
+      exit(YICES_EXIT_SYSTEM_ERROR);
+    }
+    safe_free(binaryfile);
+    binaryfile = NULL;
+  }
+
   if (dimacsfile != NULL) {
     safe_free(dimacsfile);
     dimacsfile = NULL;
@@ -1114,10 +1420,23 @@ int main(int argc, char *argv[]) {
     safe_free(delegate);
     delegate = NULL;
   }
+  if (server_path != NULL) {
+    safe_free(server_path);
+    server_path = NULL;
+  }
+  if (telemetry_file != NULL) {
+    safe_free(telemetry_file);
+    telemetry_file = NULL;
+  }
 
   delete_pvector(&trace_tags);
   delete_parser(&parser);
-  close_lexer(&lexer);
+  if (prelexer != NULL) {
+    delete_smt2_prelexer(prelexer);
+  }
+  if (! binary_input) {
+    close_lexer(&lexer);
+  }
   delete_tstack(&stack);
   delete_smt2();
   yices_exit();
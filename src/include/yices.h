@@ -3278,6 +3278,38 @@ __YICES_DLLSPEC__ extern int32_t yices_assert_blocking_clause(context_t *ctx);
 __YICES_DLLSPEC__ extern void yices_stop_search(context_t *ctx);
 
 
+/*
+ * Telemetry: periodic samples of the search statistics
+ * - if callback is non-NULL, then every subsequent call to
+ *   yices_check_context (or its variants) on ctx will call
+ *   callback(aux, sample) at the start of the search, at restarts,
+ *   and at the end of the search.
+ * - sample is a JSON object on a single line: it gives the CPU time
+ *   since telemetry was enabled, the number of decisions, conflicts,
+ *   propagations, theory propagations and conflicts, a histogram of
+ *   learned clause sizes, and the counters of the theory solvers
+ *   (e.g., simplex pivots). The string is valid only while the callback
+ *   runs.
+ * - period = minimal delay (in seconds of CPU time) between two
+ *   restart samples. If period is 0.0, a sample is produced at every
+ *   restart. The start and end samples are always produced.
+ * - if callback is NULL, telemetry is disabled.
+ * - telemetry stays enabled after yices_reset_context(ctx).
+ *
+ * Return code: 0 if there's no error, -1 if there's an error.
+ *
+ * Error report:
+ * if period is negative
+ *    code = CTX_INVALID_PARAMETER_VALUE
+ * if ctx uses the MCSAT solver
+ *    code = CTX_OPERATION_NOT_SUPPORTED
+ *
+ * Since 2.6.4.
+ */
+__YICES_DLLSPEC__ extern int32_t yices_set_context_telemetry(context_t *ctx, void (*callback)(void *aux, const char *sample),
+                                                           void *aux, double period);
+
+
 
 
 /*
@@ -3363,6 +3395,124 @@ __YICES_DLLSPEC__ extern void yices_free_param_record(param_t *param);
 __YICES_DLLSPEC__ extern int32_t yices_get_unsat_core(context_t *ctx, term_vector_t *v);
 
 
+/*
+ * Enumerate the minimal unsat subsets (MUSes) and the minimal correction
+ * sets (MCSes) of assumptions t[0] ... t[n-1].
+ * - an MUS is a subset of the assumptions that's inconsistent with ctx,
+ *   and such that all its strict subsets are consistent with ctx.
+ * - an MCS is a subset of the assumptions whose complement is consistent
+ *   with ctx and such that removing any element of the MCS from this
+ *   complement makes it inconsistent.
+ * - params is an optional structure to store heuristic parameters
+ *   (if params is NULL, default parameter settings are used).
+ * - the assumptions t[0] ... t[n-1] must all be valid Boolean terms.
+ *
+ * Every MUS and every MCS is reported once, by calling
+ *   callback(aux, is_mus, k, s)
+ * as soon as it's found. is_mus is 1 for an MUS and 0 for an MCS, and
+ * s[0 ... k-1] are the elements of the set (in the same order as in t).
+ * The array s is valid only while the callback runs. The callback must
+ * return 0 to continue the enumeration; any other value stops it.
+ *
+ * The enumeration uses the MARCO algorithm. All the checks are done
+ * in ctx, so they can be expensive, but the first sets are reported
+ * quickly. The MUSes are minimized as with parameter minimize-core.
+ *
+ * The context must support multiple checks (mode = MULTICHECKS,
+ * PUSHPOP, or INTERACTIVE).
+ *
+ * Returned value:
+ * - STATUS_UNSAT if the enumeration is complete and the assumptions
+ *   are inconsistent with ctx (i.e., there's at least one MUS).
+ *   If ctx is unsat by itself, the only MUS is the empty set.
+ * - STATUS_SAT if the assumptions are consistent with ctx. Nothing is
+ *   reported in this case.
+ * - STATUS_INTERRUPTED if the callback stopped the enumeration or if
+ *   yices_stop_search was called.
+ * - STATUS_UNKNOWN if a check returned unknown.
+ * - STATUS_ERROR if there's an error.
+ *
+ * After the enumeration, the context's status is STATUS_IDLE, unless
+ * ctx is unsat by itself or the search was interrupted (then the
+ * status is STATUS_INTERRUPTED or STATUS_IDLE as in yices_check_context).
+ *
+ * Error report:
+ * - the same errors as yices_check_context_with_assumptions
+ * - CTX_OPERATION_NOT_SUPPORTED if ctx doesn't support multiple checks
+ *   or if it uses MCSAT.
+ *
+ * Since 2.6.4.
+ */
+__YICES_DLLSPEC__ extern smt_status_t yices_enumerate_mus_mcs(context_t *ctx, const param_t *params,
+                                                              uint32_t n, const term_t t[],
+                                                              int32_t (*callback)(void *aux, int32_t is_mus, uint32_t k, const term_t s[]),
+                                                              void *aux);
+
+
+/*
+ * Enumerate the models of ctx projected on terms t[0] ... t[n-1]
+ * (all-sat). Each distinct assignment of values to t[0] ... t[n-1]
+ * that's consistent with ctx is found once.
+ * - params is an optional structure to store heuristic parameters
+ *   (if params is NULL, default parameter settings are used).
+ * - t[0] ... t[n-1] must all be valid Boolean or bitvector terms.
+ *   They don't have to occur in the assertions.
+ *
+ * For every model found, the function calls callback(aux, mdl) where
+ * mdl is a model of ctx (as built by yices_get_model(ctx, 1)). The
+ * model is deleted when the callback returns so it must not be freed
+ * by the callback. The callback must return 0 to continue the
+ * enumeration; any other value stops it. If callback is NULL, the
+ * models are counted but not built.
+ *
+ * If count is not NULL, *count is set to the number of models found
+ * (including when the enumeration is stopped).
+ *
+ * This is more efficient than a loop that calls yices_check_context then
+ * yices_assert_blocking_clause: the search decides the projection terms
+ * first, each model is blocked by a clause on the projection decisions
+ * only (so the blocking clauses are short), and the search resumes from
+ * the current assignment after each model instead of starting again.
+ *
+ * The context must support push and pop (mode = PUSHPOP or INTERACTIVE).
+ * The enumeration is done between a push and a pop, so the assertions
+ * of ctx are unchanged on exit.
+ *
+ * Returned value:
+ * - STATUS_SAT if the enumeration is complete and there's at least one model
+ * - STATUS_UNSAT if ctx has no model
+ * - STATUS_INTERRUPTED if the callback stopped the enumeration or if
+ *   yices_stop_search was called.
+ * - STATUS_UNKNOWN if the search returned unknown.
+ * - STATUS_ERROR if there's an error.
+ *
+ * After the enumeration, the context's status is STATUS_IDLE unless ctx
+ * is unsat by itself (then the status is STATUS_UNSAT), or the search was
+ * interrupted by yices_stop_search and ctx doesn't support clean interrupts
+ * (then the status is STATUS_INTERRUPTED and ctx must be reset).
+ *
+ * Error report:
+ * - if t[i] is not valid
+ *     code = INVALID_TERM
+ *     term1 = t[i]
+ * - if t[i] is neither Boolean nor a bitvector
+ *     code = BITVECTOR_REQUIRED
+ *     term1 = t[i]
+ * - if ctx doesn't support push and pop or if it uses MCSAT
+ *     code = CTX_OPERATION_NOT_SUPPORTED
+ * - if ctx's status is STATUS_SEARCHING or STATUS_INTERRUPTED
+ *     code = CTX_INVALID_OPERATION
+ * - other error codes are possible if t[i] can't be processed by ctx
+ *   (as in yices_assert_formula).
+ *
+ * Since 2.6.4.
+ */
+__YICES_DLLSPEC__ extern smt_status_t yices_enumerate_models(context_t *ctx, const param_t *params,
+                                                             uint32_t n, const term_t t[],
+                                                             int32_t (*callback)(void *aux, model_t *mdl),
+                                                             void *aux, uint64_t *count);
+
+
 /*
  * Construct and return a model interpolant.
  *
@@ -4179,6 +4329,47 @@ __YICES_DLLSPEC__ extern int32_t yices_formula_true_in_model(model_t *mdl, term_
 __YICES_DLLSPEC__ extern int32_t yices_formulas_true_in_model(model_t *mdl, uint32_t n, const term_t f[]);
 
 
+/*
+ * Evaluation plans: to check the same formulas in many models
+ *
+ * A plan for formulas f[0 ... n-1] is built once. Then checking
+ * the formulas in a model with the plan is much cheaper than calling
+ * yices_formulas_true_in_model. The plan keeps the formulas and
+ * their subterms alive: they are not deleted by the garbage
+ * collector until the plan is freed.
+ *
+ * yices_new_eval_plan returns NULL if there's an error.
+ *
+ * Error report:
+ * if f[i] is not valid
+ *   code = INVALID_TERM
+ *   term1 = f[i]
+ * if f[i] is not Boolean
+ *   code = TYPE_MISMATCH
+ *   term1 = f[i]
+ *   type1 = bool
+ *
+ * Since 2.6.4.
+ */
+__YICES_DLLSPEC__ extern eval_plan_t *yices_new_eval_plan(uint32_t n, const term_t f[]);
+
+/*
+ * Delete a plan
+ *
+ * Since 2.6.4.
+ */
+__YICES_DLLSPEC__ extern void yices_free_eval_plan(eval_plan_t *plan);
+
+/*
+ * Check whether the formulas of plan are all true in mdl
+ * - the returned value and error codes are as in
+ *   yices_formulas_true_in_model
+ *
+ * Since 2.6.4.
+ */
+__YICES_DLLSPEC__ extern int32_t yices_eval_plan_true_in_model(model_t *mdl, eval_plan_t *plan);
+
+
 
 /*
  * CONVERSION OF VALUES TO CONSTANT TERMS
@@ -4442,6 +4633,8 @@ __YICES_DLLSPEC__ extern int32_t yices_generalize_model_array(model_t *mdl, uint
  * - width, height, offset define the print area
  * - f = output file to use.
  *   f must be open and writable.
+ * - large subterms that occur several times in t are printed once,
+ *   bound to a let variable (let!1, let!2, ...)
  *
  * - return -1 on error
  * - return 0 otherwise.
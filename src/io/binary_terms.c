@@ -0,0 +1,1640 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * BINARY FORMAT FOR TYPES AND TERMS
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include <gmp.h>
+
+#include "io/binary_terms.h"
+#include "terms/bv64_constants.h"
+#include "terms/bvarith64_buffer_terms.h"
+#include "terms/bvarith_buffer_terms.h"
+#include "terms/rba_buffer_terms.h"
+#include "utils/memalloc.h"
+
+
+
+/**************
+ *   WRITER   *
+ *************/
+
+/*
+ * Term number 0 is true
+ */
+static void bin_writer_init_maps(bin_writer_t *w) {
+  int_hmap_add(&w->term_map, bool_const, 0);
+  w->nterms = 1;
+  w->ntypes = 0;
+  w->nmacros = 0;
+}
+
+void init_bin_writer(bin_writer_t *w, FILE *f, term_table_t *terms) {
+  w->file = f;
+  w->buffer = (uint8_t *) safe_malloc(BIN_BUFFER_SIZE);
+  w->idx = 0;
+  w->terms = terms;
+  w->types = terms->types;
+  init_int_hmap(&w->term_map, 0);
+  init_int_hmap(&w->type_map, 0);
+  init_int_hmap(&w->macro_map, 0);
+  init_ivector(&w->stack, 0);
+  w->failed = false;
+  w->errcode = 0;
+  bin_writer_init_maps(w);
+
+  bin_write_bytes(w, BIN_MAGIC, BIN_MAGIC_LEN);
+  bin_write_byte(w, BIN_VERSION);
+}
+
+/*
+ * Write the buffer's content
+ */
+static void bin_writer_drain(bin_writer_t *w) {
+  size_t n;
+
+  if (w->idx > 0 && !w->failed) {
+    n = fwrite(w->buffer, 1, w->idx, w->file);
+    if (n < w->idx) {
+      w->failed = true;
+      w->errcode = errno;
+    }
+  }
+  w->idx = 0;
+}
+
+void bin_writer_flush(bin_writer_t *w) {
+  bin_writer_drain(w);
+  if (!w->failed && fflush(w->file) == EOF) {
+    w->failed = true;
+    w->errcode = errno;
+  }
+}
+
+void delete_bin_writer(bin_writer_t *w) {
+  bin_writer_flush(w);
+  safe_free(w->buffer);
+  w->buffer = NULL;
+  delete_int_hmap(&w->term_map);
+  delete_int_hmap(&w->type_map);
+  delete_int_hmap(&w->macro_map);
+  delete_ivector(&w->stack);
+}
+
+void bin_writer_reset(bin_writer_t *w) {
+  int_hmap_reset(&w->term_map);
+  int_hmap_reset(&w->type_map);
+  int_hmap_reset(&w->macro_map);
+  ivector_reset(&w->stack);
+  bin_writer_init_maps(w);
+}
+
+
+/*
+ * Basic output
+ */
+void bin_write_byte(bin_writer_t *w, uint8_t b) {
+  if (w->idx == BIN_BUFFER_SIZE) {
+    bin_writer_drain(w);
+  }
+  w->buffer[w->idx] = b;
+  w->idx ++;
+}
+
+void bin_write_uint(bin_writer_t *w, uint64_t x) {
+  while (x >= 0x80) {
+    bin_write_byte(w, (uint8_t) (x | 0x80));
+    x >>= 7;
+  }
+  bin_write_byte(w, (uint8_t) x);
+}
+
+void bin_write_int(bin_writer_t *w, int64_t x) {
+  bin_write_uint(w, ((uint64_t) x << 1) ^ (uint64_t) (x >> 63));
+}
+
+void bin_write_bytes(bin_writer_t *w, const char *s, uint32_t len) {
+  uint32_t i;
+
+  for (i=0; i<len; i++) {
+    bin_write_byte(w, (uint8_t) s[i]);
+  }
+}
+
+void bin_write_string(bin_writer_t *w, const char *s) {
+  uint32_t len;
+
+  len = strlen(s);
+  bin_write_uint(w, len);
+  bin_write_bytes(w, s, len);
+}
+
+
+/*
+ * Rational q
+ */
+void bin_write_rational(bin_writer_t *w, rational_t *q) {
+  mpq_t aux;
+  int64_t num;
+  uint64_t den;
+  size_t len;
+  char *s;
+
+  if (q_get_int64(q, &num, &den)) {
+    bin_write_byte(w, 0);
+    bin_write_int(w, num);
+    bin_write_uint(w, den);
+  } else {
+    mpq_init(aux);
+    q_get_mpq(q, aux);
+    len = mpz_sizeinbase(mpq_numref(aux), 10) + mpz_sizeinbase(mpq_denref(aux), 10) + 3;
+    s = (char *) safe_malloc(len);
+    mpq_get_str(s, 10, aux);
+    bin_write_byte(w, 1);
+    bin_write_string(w, s);
+    safe_free(s);
+    mpq_clear(aux);
+  }
+}
+
+/*
+ * Bitvector constant of n bits stored in a (as 32bit words)
+ */
+void bin_write_bvconst(bin_writer_t *w, uint32_t n, const uint32_t *a) {
+  uint32_t i, k;
+
+  k = (n + 31) >> 5;
+  for (i=0; i<k; i++) {
+    bin_write_uint(w, a[i]);
+  }
+}
+
+
+/*
+ * References
+ */
+void bin_write_type_ref(bin_writer_t *w, type_t tau) {
+  int_hmap_pair_t *p;
+
+  p = int_hmap_find(&w->type_map, tau);
+  assert(p != NULL);
+  bin_write_uint(w, p->val);
+}
+
+void bin_write_term_ref(bin_writer_t *w, term_t t) {
+  int_hmap_pair_t *p;
+
+  p = int_hmap_find(&w->term_map, index_of(t));
+  assert(p != NULL);
+  bin_write_uint(w, ((uint64_t) p->val << 1) | polarity_of(t));
+}
+
+void bin_write_macro_ref(bin_writer_t *w, int32_t id) {
+  int_hmap_pair_t *p;
+
+  p = int_hmap_find(&w->macro_map, id);
+  assert(p != NULL);
+  bin_write_uint(w, p->val);
+}
+
+
+/*
+ * Registration
+ */
+void bin_writer_register_type(bin_writer_t *w, type_t tau) {
+  int_hmap_add(&w->type_map, tau, w->ntypes);
+  w->ntypes ++;
+}
+
+void bin_writer_register_term(bin_writer_t *w, term_t t) {
+  assert(is_pos_term(t));
+  int_hmap_add(&w->term_map, index_of(t), w->nterms);
+  w->nterms ++;
+}
+
+void bin_writer_register_macro(bin_writer_t *w, int32_t id) {
+  int_hmap_add(&w->macro_map, id, w->nmacros);
+  w->nmacros ++;
+}
+
+
+/*
+ * TYPES
+ */
+bool bin_write_type_def(bin_writer_t *w, type_t tau) {
+  type_table_t *types;
+  tuple_type_t *tuple;
+  function_type_t *fun;
+  instance_type_t *inst;
+  uint32_t i, n;
+
+  if (int_hmap_find(&w->type_map, tau) != NULL) {
+    return true;
+  }
+
+  types = w->types;
+  switch (type_kind(types, tau)) {
+  case BOOL_TYPE:
+    bin_write_byte(w, BIN_BOOL_TYPE);
+    break;
+
+  case INT_TYPE:
+    bin_write_byte(w, BIN_INT_TYPE);
+    break;
+
+  case REAL_TYPE:
+    bin_write_byte(w, BIN_REAL_TYPE);
+    break;
+
+  case BITVECTOR_TYPE:
+    bin_write_byte(w, BIN_BV_TYPE);
+    bin_write_uint(w, bv_type_size(types, tau));
+    break;
+
+  case SCALAR_TYPE:
+    bin_write_byte(w, BIN_SCALAR_TYPE);
+    bin_write_uint(w, scalar_type_cardinal(types, tau));
+    break;
+
+  case UNINTERPRETED_TYPE:
+    bin_write_byte(w, BIN_UNINTERPRETED_TYPE);
+    break;
+
+  case VARIABLE_TYPE:
+    bin_write_byte(w, BIN_VARIABLE_TYPE);
+    bin_write_uint(w, type_variable_id(types, tau));
+    break;
+
+  case TUPLE_TYPE:
+    tuple = tuple_type_desc(types, tau);
+    n = tuple->nelem;
+    for (i=0; i<n; i++) {
+      if (! bin_write_type_def(w, tuple->elem[i])) return false;
+    }
+    bin_write_byte(w, BIN_TUPLE_TYPE);
+    bin_write_uint(w, n);
+    for (i=0; i<n; i++) {
+      bin_write_type_ref(w, tuple->elem[i]);
+    }
+    break;
+
+  case FUNCTION_TYPE:
+    fun = function_type_desc(types, tau);
+    n = fun->ndom;
+    for (i=0; i<n; i++) {
+      if (! bin_write_type_def(w, fun->domain[i])) return false;
+    }
+    if (! bin_write_type_def(w, fun->range)) return false;
+    bin_write_byte(w, BIN_FUNCTION_TYPE);
+    bin_write_uint(w, n);
+    for (i=0; i<n; i++) {
+      bin_write_type_ref(w, fun->domain[i]);
+    }
+    bin_write_type_ref(w, fun->range);
+    break;
+
+  case INSTANCE_TYPE:
+    inst = instance_type_desc(types, tau);
+    if (int_hmap_find(&w->macro_map, inst->cid) == NULL) {
+      return false;
+    }
+    n = inst->arity;
+    for (i=0; i<n; i++) {
+      if (! bin_write_type_def(w, inst->param[i])) return false;
+    }
+    bin_write_byte(w, BIN_INSTANCE_TYPE);
+    bin_write_macro_ref(w, inst->cid);
+    bin_write_uint(w, n);
+    for (i=0; i<n; i++) {
+      bin_write_type_ref(w, inst->param[i]);
+    }
+    break;
+
+  default:
+    assert(false);
+    return false;
+  }
+
+  bin_writer_register_type(w, tau);
+
+  return true;
+}
+
+
+/*
+ * TERMS
+ */
+
+/*
+ * Opcode for a composite term of kind k
+ */
+static bin_term_op_t composite_op(term_kind_t k) {
+  switch (k) {
+  case ITE_TERM:
+  case ITE_SPECIAL:        return BIN_ITE;
+  case APP_TERM:           return BIN_APP;
+  case UPDATE_TERM:        return BIN_UPDATE;
+  case TUPLE_TERM:         return BIN_TUPLE;
+  case EQ_TERM:            return BIN_EQ;
+  case DISTINCT_TERM:      return BIN_DISTINCT;
+  case FORALL_TERM:        return BIN_FORALL;
+  case LAMBDA_TERM:        return BIN_LAMBDA;
+  case OR_TERM:            return BIN_OR;
+  case XOR_TERM:           return BIN_XOR;
+  case ARITH_BINEQ_ATOM:   return BIN_ARITH_BINEQ_ATOM;
+  case ARITH_RDIV:         return BIN_ARITH_RDIV;
+  case ARITH_IDIV:         return BIN_ARITH_IDIV;
+  case ARITH_MOD:          return BIN_ARITH_MOD;
+  case ARITH_DIVIDES_ATOM: return BIN_ARITH_DIVIDES_ATOM;
+  case BV_ARRAY:           return BIN_BV_ARRAY;
+  case BV_DIV:             return BIN_BV_DIV;
+  case BV_REM:             return BIN_BV_REM;
+  case BV_SDIV:            return BIN_BV_SDIV;
+  case BV_SREM:            return BIN_BV_SREM;
+  case BV_SMOD:            return BIN_BV_SMOD;
+  case BV_SHL:             return BIN_BV_SHL;
+  case BV_LSHR:            return BIN_BV_LSHR;
+  case BV_ASHR:            return BIN_BV_ASHR;
+  case BV_EQ_ATOM:         return BIN_BV_EQ_ATOM;
+  case BV_GE_ATOM:         return BIN_BV_GE_ATOM;
+  case BV_SGE_ATOM:        return BIN_BV_SGE_ATOM;
+  default:
+    assert(false);
+    return BIN_ITE;
+  }
+}
+
+static bin_term_op_t unary_op(term_kind_t k) {
+  switch (k) {
+  case ARITH_EQ_ATOM:     return BIN_ARITH_EQ_ATOM;
+  case ARITH_GE_ATOM:     return BIN_ARITH_GE_ATOM;
+  case ARITH_IS_INT_ATOM: return BIN_ARITH_IS_INT_ATOM;
+  case ARITH_FLOOR:       return BIN_ARITH_FLOOR;
+  case ARITH_CEIL:        return BIN_ARITH_CEIL;
+  case ARITH_ABS:         return BIN_ARITH_ABS;
+  default:
+    assert(false);
+    return BIN_ARITH_EQ_ATOM;
+  }
+}
+
+
+/*
+ * Push t on the stack if it's not defined yet
+ * - return true if t was pushed
+ */
+static bool bin_push_subterm(bin_writer_t *w, term_t t) {
+  int32_t i;
+
+  i = index_of(t);
+  if (int_hmap_find(&w->term_map, i) == NULL) {
+    ivector_push(&w->stack, i);
+    return true;
+  }
+  return false;
+}
+
+/*
+ * Push all undefined children of term i
+ * - return true if something was pushed
+ */
+static bool bin_push_subterms(bin_writer_t *w, int32_t i) {
+  term_table_t *terms;
+  composite_term_t *d;
+  pprod_t *pp;
+  polynomial_t *p;
+  bvpoly64_t *p64;
+  bvpoly_t *pbv;
+  uint32_t j, n;
+  bool pushed;
+
+  terms = w->terms;
+  pushed = false;
+
+  switch (kind_for_idx(terms, i)) {
+  case ARITH_EQ_ATOM:
+  case ARITH_GE_ATOM:
+  case ARITH_IS_INT_ATOM:
+  case ARITH_FLOOR:
+  case ARITH_CEIL:
+  case ARITH_ABS:
+    pushed = bin_push_subterm(w, integer_value_for_idx(terms, i));
+    break;
+
+  case ITE_TERM:
+  case ITE_SPECIAL:
+  case APP_TERM:
+  case UPDATE_TERM:
+  case TUPLE_TERM:
+  case EQ_TERM:
+  case DISTINCT_TERM:
+  case FORALL_TERM:
+  case LAMBDA_TERM:
+  case OR_TERM:
+  case XOR_TERM:
+  case ARITH_BINEQ_ATOM:
+  case ARITH_RDIV:
+  case ARITH_IDIV:
+  case ARITH_MOD:
+  case ARITH_DIVIDES_ATOM:
+  case BV_ARRAY:
+  case BV_DIV:
+  case BV_REM:
+  case BV_SDIV:
+  case BV_SREM:
+  case BV_SMOD:
+  case BV_SHL:
+  case BV_LSHR:
+  case BV_ASHR:
+  case BV_EQ_ATOM:
+  case BV_GE_ATOM:
+  case BV_SGE_ATOM:
+    d = composite_for_idx(terms, i);
+    n = d->arity;
+    for (j=0; j<n; j++) {
+      pushed |= bin_push_subterm(w, d->arg[j]);
+    }
+    break;
+
+  case SELECT_TERM:
+  case BIT_TERM:
+    pushed = bin_push_subterm(w, select_for_idx(terms, i)->arg);
+    break;
+
+  case POWER_PRODUCT:
+    pp = pprod_for_idx(terms, i);
+    n = pp->len;
+    for (j=0; j<n; j++) {
+      pushed |= bin_push_subterm(w, pp->prod[j].var);
+    }
+    break;
+
+  case ARITH_POLY:
+    p = polynomial_for_idx(terms, i);
+    n = p->nterms;
+    for (j=0; j<n; j++) {
+      if (p->mono[j].var != const_idx) {
+        pushed |= bin_push_subterm(w, p->mono[j].var);
+      }
+    }
+    break;
+
+  case BV64_POLY:
+    p64 = bvpoly64_for_idx(terms, i);
+    n = p64->nterms;
+    for (j=0; j<n; j++) {
+      if (p64->mono[j].var != const_idx) {
+        pushed |= bin_push_subterm(w, p64->mono[j].var);
+      }
+    }
+    break;
+
+  case BV_POLY:
+    pbv = bvpoly_for_idx(terms, i);
+    n = pbv->nterms;
+    for (j=0; j<n; j++) {
+      if (pbv->mono[j].var != const_idx) {
+        pushed |= bin_push_subterm(w, pbv->mono[j].var);
+      }
+    }
+    break;
+
+  default:
+    // atomic terms
+    break;
+  }
+
+  return pushed;
+}
+
+
+/*
+ * Write the definition of term i (all its children are defined)
+ * - return false if that's not possible
+ */
+static bool bin_write_term_record(bin_writer_t *w, int32_t i) {
+  term_table_t *terms;
+  composite_term_t *d;
+  select_term_t *s;
+  pprod_t *pp;
+  polynomial_t *p;
+  bvconst64_term_t *c64;
+  bvconst_term_t *c;
+  bvpoly64_t *p64;
+  bvpoly_t *pbv;
+  type_t tau;
+  term_kind_t kind;
+  uint32_t j, n, nbits;
+
+  terms = w->terms;
+  kind = kind_for_idx(terms, i);
+  switch (kind) {
+  case CONSTANT_TERM:
+    tau = type_for_idx(terms, i);
+    if (! bin_write_type_def(w, tau)) return false;
+    bin_write_byte(w, BIN_CONSTANT);
+    bin_write_type_ref(w, tau);
+    bin_write_uint(w, integer_value_for_idx(terms, i));
+    break;
+
+  case ARITH_CONSTANT:
+    bin_write_byte(w, BIN_ARITH_CONSTANT);
+    bin_write_rational(w, rational_for_idx(terms, i));
+    break;
+
+  case BV64_CONSTANT:
+    c64 = bvconst64_for_idx(terms, i);
+    bin_write_byte(w, BIN_BV_CONSTANT);
+    bin_write_uint(w, c64->bitsize);
+    bin_write_uint(w, (uint32_t) c64->value);
+    if (c64->bitsize > 32) {
+      bin_write_uint(w, (uint32_t) (c64->value >> 32));
+    }
+    break;
+
+  case BV_CONSTANT:
+    c = bvconst_for_idx(terms, i);
+    bin_write_byte(w, BIN_BV_CONSTANT);
+    bin_write_uint(w, c->bitsize);
+    bin_write_bvconst(w, c->bitsize, c->data);
+    break;
+
+  case VARIABLE:
+  case UNINTERPRETED_TERM:
+    tau = type_for_idx(terms, i);
+    if (! bin_write_type_def(w, tau)) return false;
+    bin_write_byte(w, kind == VARIABLE ? BIN_VARIABLE : BIN_UNINTERPRETED);
+    bin_write_type_ref(w, tau);
+    break;
+
+  case ARITH_EQ_ATOM:
+  case ARITH_GE_ATOM:
+  case ARITH_IS_INT_ATOM:
+  case ARITH_FLOOR:
+  case ARITH_CEIL:
+  case ARITH_ABS:
+    bin_write_byte(w, unary_op(kind));
+    bin_write_term_ref(w, integer_value_for_idx(terms, i));
+    break;
+
+  case ITE_TERM:
+  case ITE_SPECIAL:
+  case APP_TERM:
+  case UPDATE_TERM:
+  case TUPLE_TERM:
+  case EQ_TERM:
+  case DISTINCT_TERM:
+  case FORALL_TERM:
+  case LAMBDA_TERM:
+  case OR_TERM:
+  case XOR_TERM:
+  case ARITH_BINEQ_ATOM:
+  case ARITH_RDIV:
+  case ARITH_IDIV:
+  case ARITH_MOD:
+  case ARITH_DIVIDES_ATOM:
+  case BV_ARRAY:
+  case BV_DIV:
+  case BV_REM:
+  case BV_SDIV:
+  case BV_SREM:
+  case BV_SMOD:
+  case BV_SHL:
+  case BV_LSHR:
+  case BV_ASHR:
+  case BV_EQ_ATOM:
+  case BV_GE_ATOM:
+  case BV_SGE_ATOM:
+    d = composite_for_idx(terms, i);
+    n = d->arity;
+    bin_write_byte(w, composite_op(kind));
+    bin_write_uint(w, n);
+    for (j=0; j<n; j++) {
+      bin_write_term_ref(w, d->arg[j]);
+    }
+    break;
+
+  case SELECT_TERM:
+  case BIT_TERM:
+    s = select_for_idx(terms, i);
+    bin_write_byte(w, kind == SELECT_TERM ? BIN_SELECT : BIN_BIT);
+    bin_write_uint(w, s->idx);
+    bin_write_term_ref(w, s->arg);
+    break;
+
+  case POWER_PRODUCT:
+    pp = pprod_for_idx(terms, i);
+    n = pp->len;
+    bin_write_byte(w, BIN_POWER_PRODUCT);
+    bin_write_uint(w, n);
+    for (j=0; j<n; j++) {
+      bin_write_term_ref(w, pp->prod[j].var);
+      bin_write_uint(w, pp->prod[j].exp);
+    }
+    break;
+
+  case ARITH_POLY:
+    p = polynomial_for_idx(terms, i);
+    n = p->nterms;
+    j = 0;
+    bin_write_byte(w, BIN_ARITH_POLY);
+    if (p->mono[0].var == const_idx) {
+      bin_write_byte(w, 1);
+      bin_write_rational(w, &p->mono[0].coeff);
+      j = 1;
+    } else {
+      bin_write_byte(w, 0);
+    }
+    bin_write_uint(w, n - j);
+    while (j < n) {
+      bin_write_rational(w, &p->mono[j].coeff);
+      bin_write_term_ref(w, p->mono[j].var);
+      j ++;
+    }
+    break;
+
+  case BV64_POLY:
+    p64 = bvpoly64_for_idx(terms, i);
+    n = p64->nterms;
+    j = 0;
+    bin_write_byte(w, BIN_BV64_POLY);
+    bin_write_uint(w, p64->bitsize);
+    if (p64->mono[0].var == const_idx) {
+      bin_write_byte(w, 1);
+      bin_write_uint(w, p64->mono[0].coeff);
+      j = 1;
+    } else {
+      bin_write_byte(w, 0);
+    }
+    bin_write_uint(w, n - j);
+    while (j < n) {
+      bin_write_uint(w, p64->mono[j].coeff);
+      bin_write_term_ref(w, p64->mono[j].var);
+      j ++;
+    }
+    break;
+
+  case BV_POLY:
+    pbv = bvpoly_for_idx(terms, i);
+    n = pbv->nterms;
+    nbits = pbv->bitsize;
+    j = 0;
+    bin_write_byte(w, BIN_BV_POLY);
+    bin_write_uint(w, nbits);
+    if (pbv->mono[0].var == const_idx) {
+      bin_write_byte(w, 1);
+      bin_write_bvconst(w, nbits, pbv->mono[0].coeff);
+      j = 1;
+    } else {
+      bin_write_byte(w, 0);
+    }
+    bin_write_uint(w, n - j);
+    while (j < n) {
+      bin_write_bvconst(w, nbits, pbv->mono[j].coeff);
+      bin_write_term_ref(w, pbv->mono[j].var);
+      j ++;
+    }
+    break;
+
+  case ARITH_ROOT_ATOM:
+  default:
+    return false;
+  }
+
+  bin_writer_register_term(w, pos_term(i));
+
+  return true;
+}
+
+
+bool bin_write_term_def(bin_writer_t *w, term_t t) {
+  ivector_t *v;
+  int32_t i;
+
+  i = index_of(t);
+  if (int_hmap_find(&w->term_map, i) != NULL) {
+    return true;
+  }
+
+  v = &w->stack;
+  assert(v->size == 0);
+  ivector_push(v, i);
+  while (v->size > 0) {
+    i = ivector_last(v);
+    if (int_hmap_find(&w->term_map, i) != NULL) {
+      ivector_pop(v);
+    } else if (! bin_push_subterms(w, i)) {
+      if (! bin_write_term_record(w, i)) {
+        ivector_reset(v);
+        return false;
+      }
+      ivector_pop(v);
+    }
+  }
+
+  return true;
+}
+
+
+
+/**************
+ *   READER   *
+ *************/
+
+#define DEF_BIN_STRING_SIZE 64
+
+static void bin_reader_init_maps(bin_reader_t *r) {
+  ivector_push(&r->term_map, true_term);
+}
+
+void init_bin_reader(bin_reader_t *r, FILE *f, term_manager_t *manager) {
+  r->file = f;
+  r->buffer = (uint8_t *) safe_malloc(BIN_BUFFER_SIZE);
+  r->idx = 0;
+  r->end = 0;
+  r->manager = manager;
+  r->terms = term_manager_get_terms(manager);
+  r->types = term_manager_get_types(manager);
+  init_ivector(&r->term_map, 0);
+  init_ivector(&r->type_map, 0);
+  init_ivector(&r->macro_map, 0);
+  init_ivector(&r->aux, 0);
+  q_init(&r->q);
+  init_bvconstant(&r->bv);
+  r->string = (char *) safe_malloc(DEF_BIN_STRING_SIZE);
+  r->string_size = DEF_BIN_STRING_SIZE;
+  r->errcode = 0;
+  bin_reader_init_maps(r);
+}
+
+void delete_bin_reader(bin_reader_t *r) {
+  safe_free(r->buffer);
+  r->buffer = NULL;
+  delete_ivector(&r->term_map);
+  delete_ivector(&r->type_map);
+  delete_ivector(&r->macro_map);
+  delete_ivector(&r->aux);
+  q_clear(&r->q);
+  delete_bvconstant(&r->bv);
+  safe_free(r->string);
+  r->string = NULL;
+}
+
+void bin_reader_reset(bin_reader_t *r) {
+  ivector_reset(&r->term_map);
+  ivector_reset(&r->type_map);
+  ivector_reset(&r->macro_map);
+  bin_reader_init_maps(r);
+}
+
+void bin_reader_error(bin_reader_t *r, bin_error_t code) {
+  longjmp(r->env, code);
+}
+
+
+/*
+ * Refill the buffer
+ * - we use read rather than fread so that we don't block
+ *   if the input is a pipe and fewer bytes are available
+ */
+static void bin_reader_fill(bin_reader_t *r) {
+  ssize_t n;
+
+  assert(r->idx == r->end);
+
+  do {
+    n = read(fileno(r->file), r->buffer, BIN_BUFFER_SIZE);
+  } while (n < 0 && errno == EINTR);
+
+  if (n < 0) {
+    r->errcode = errno;
+    bin_reader_error(r, BIN_READ_ERROR);
+  }
+  r->idx = 0;
+  r->end = n;
+}
+
+bool bin_reader_eof(bin_reader_t *r) {
+  if (r->idx == r->end) {
+    bin_reader_fill(r);
+  }
+  return r->end == 0;
+}
+
+
+/*
+ * Basic input
+ */
+uint8_t bin_read_byte(bin_reader_t *r) {
+  if (r->idx == r->end) {
+    bin_reader_fill(r);
+    if (r->end == 0) {
+      bin_reader_error(r, BIN_TRUNCATED);
+    }
+  }
+  return r->buffer[r->idx ++];
+}
+
+uint64_t bin_read_uint(bin_reader_t *r) {
+  uint64_t x;
+  uint32_t shift;
+  uint8_t b;
+
+  x = 0;
+  shift = 0;
+  do {
+    if (shift >= 64) {
+      bin_reader_error(r, BIN_BAD_VALUE);
+    }
+    b = bin_read_byte(r);
+    x |= ((uint64_t) (b & 0x7F)) << shift;
+    shift += 7;
+  } while (b & 0x80);
+
+  return x;
+}
+
+int64_t bin_read_int(bin_reader_t *r) {
+  uint64_t x;
+
+  x = bin_read_uint(r);
+  return (int64_t) (x >> 1) ^ - (int64_t) (x & 1);
+}
+
+uint32_t bin_read_uint32(bin_reader_t *r) {
+  uint64_t x;
+
+  x = bin_read_uint(r);
+  if (x > UINT32_MAX) {
+    bin_reader_error(r, BIN_BAD_VALUE);
+  }
+  return (uint32_t) x;
+}
+
+const char *bin_read_string(bin_reader_t *r, uint32_t *len) {
+  uint32_t i, n;
+
+  n = bin_read_uint32(r);
+  if (n >= r->string_size) {
+    if (n == UINT32_MAX) {
+      bin_reader_error(r, BIN_BAD_VALUE);
+    }
+    safe_free(r->string);
+    r->string = (char *) safe_malloc(n + 1);
+    r->string_size = n + 1;
+  }
+  for (i=0; i<n; i++) {
+    r->string[i] = (char) bin_read_byte(r);
+  }
+  r->string[n] = '\0';
+  if (len != NULL) {
+    *len = n;
+  }
+
+  return r->string;
+}
+
+char *bin_read_string_copy(bin_reader_t *r) {
+  const char *s;
+  char *copy;
+  uint32_t n;
+
+  s = bin_read_string(r, &n);
+  copy = (char *) safe_malloc(n + 1);
+  memcpy(copy, s, n + 1);
+
+  return copy;
+}
+
+void bin_read_header(bin_reader_t *r) {
+  uint32_t i;
+
+  for (i=0; i<BIN_MAGIC_LEN; i++) {
+    if (bin_reader_eof(r) || bin_read_byte(r) != (uint8_t) BIN_MAGIC[i]) {
+      bin_reader_error(r, BIN_BAD_HEADER);
+    }
+  }
+  if (bin_reader_eof(r) || bin_read_byte(r) != BIN_VERSION) {
+    bin_reader_error(r, BIN_BAD_HEADER);
+  }
+}
+
+
+/*
+ * Read a rational into r->q
+ */
+rational_t *bin_read_rational(bin_reader_t *r) {
+  const char *s;
+  int64_t num;
+  uint64_t den;
+
+  switch (bin_read_byte(r)) {
+  case 0:
+    num = bin_read_int(r);
+    den = bin_read_uint(r);
+    if (den == 0) {
+      bin_reader_error(r, BIN_BAD_VALUE);
+    }
+    q_set_int64(&r->q, num, den);
+    break;
+
+  case 1:
+    s = bin_read_string(r, NULL);
+    if (q_set_from_string(&r->q, s) < 0) {
+      bin_reader_error(r, BIN_BAD_VALUE);
+    }
+    break;
+
+  default:
+    bin_reader_error(r, BIN_BAD_VALUE);
+  }
+
+  return &r->q;
+}
+
+/*
+ * Read a bitvector size
+ */
+uint32_t bin_read_bitsize(bin_reader_t *r) {
+  uint32_t n;
+
+  n = bin_read_uint32(r);
+  if (n == 0 || n > YICES_MAX_BVSIZE) {
+    bin_reader_error(r, BIN_BAD_VALUE);
+  }
+  return n;
+}
+
+/*
+ * Read a constant of n bits into r->bv
+ */
+uint32_t *bin_read_bvconst(bin_reader_t *r, uint32_t n) {
+  uint32_t i, k;
+
+  bvconstant_set_bitsize(&r->bv, n);
+  k = (n + 31) >> 5;
+  for (i=0; i<k; i++) {
+    r->bv.data[i] = bin_read_uint32(r);
+  }
+  bvconst_normalize(r->bv.data, n);
+
+  return r->bv.data;
+}
+
+
+/*
+ * References
+ */
+type_t bin_read_type_ref(bin_reader_t *r) {
+  uint64_t x;
+
+  x = bin_read_uint(r);
+  if (x >= r->type_map.size) {
+    bin_reader_error(r, BIN_BAD_REFERENCE);
+  }
+  return r->type_map.data[x];
+}
+
+term_t bin_read_term_ref(bin_reader_t *r) {
+  uint64_t x;
+
+  x = bin_read_uint(r);
+  if ((x >> 1) >= r->term_map.size) {
+    bin_reader_error(r, BIN_BAD_REFERENCE);
+  }
+  return r->term_map.data[x >> 1] ^ (term_t) (x & 1);
+}
+
+int32_t bin_read_macro_ref(bin_reader_t *r) {
+  uint64_t x;
+
+  x = bin_read_uint(r);
+  if (x >= r->macro_map.size) {
+    bin_reader_error(r, BIN_BAD_REFERENCE);
+  }
+  return r->macro_map.data[x];
+}
+
+
+/*
+ * Registration
+ */
+void bin_reader_register_type(bin_reader_t *r, type_t tau) {
+  ivector_push(&r->type_map, tau);
+}
+
+void bin_reader_register_term(bin_reader_t *r, term_t t) {
+  ivector_push(&r->term_map, t);
+}
+
+void bin_reader_register_macro(bin_reader_t *r, int32_t id) {
+  ivector_push(&r->macro_map, id);
+}
+
+
+/*
+ * TYPES
+ */
+
+/*
+ * Read n type references into r->aux
+ */
+static void bin_read_type_refs(bin_reader_t *r, uint32_t n) {
+  uint32_t i;
+
+  ivector_reset(&r->aux);
+  for (i=0; i<n; i++) {
+    ivector_push(&r->aux, bin_read_type_ref(r));
+  }
+}
+
+static void bin_read_type_def(bin_reader_t *r, uint32_t op) {
+  type_table_t *types;
+  type_t tau, range;
+  int32_t cid;
+  uint32_t n;
+
+  types = r->types;
+  switch (op) {
+  case BIN_BOOL_TYPE:
+    tau = bool_type(types);
+    break;
+
+  case BIN_INT_TYPE:
+    tau = int_type(types);
+    break;
+
+  case BIN_REAL_TYPE:
+    tau = real_type(types);
+    break;
+
+  case BIN_BV_TYPE:
+    tau = bv_type(types, bin_read_bitsize(r));
+    break;
+
+  case BIN_SCALAR_TYPE:
+    n = bin_read_uint32(r);
+    if (n == 0) {
+      bin_reader_error(r, BIN_BAD_VALUE);
+    }
+    tau = new_scalar_type(types, n);
+    break;
+
+  case BIN_UNINTERPRETED_TYPE:
+    tau = new_uninterpreted_type(types);
+    break;
+
+  case BIN_VARIABLE_TYPE:
+    tau = type_variable(types, bin_read_uint32(r));
+    break;
+
+  case BIN_TUPLE_TYPE:
+    n = bin_read_uint32(r);
+    if (n == 0 || n > YICES_MAX_ARITY) {
+      bin_reader_error(r, BIN_BAD_VALUE);
+    }
+    bin_read_type_refs(r, n);
+    tau = tuple_type(types, n, r->aux.data);
+    break;
+
+  case BIN_FUNCTION_TYPE:
+    n = bin_read_uint32(r);
+    if (n == 0 || n > YICES_MAX_ARITY) {
+      bin_reader_error(r, BIN_BAD_VALUE);
+    }
+    bin_read_type_refs(r, n);
+    range = bin_read_type_ref(r);
+    tau = function_type(types, range, n, r->aux.data);
+    break;
+
+  case BIN_INSTANCE_TYPE:
+    cid = bin_read_macro_ref(r);
+    n = bin_read_uint32(r);
+    if (types->macro_tbl == NULL || !good_type_macro(types->macro_tbl, cid) ||
+        n != type_macro_arity(types->macro_tbl, cid)) {
+      bin_reader_error(r, BIN_BAD_VALUE);
+    }
+    bin_read_type_refs(r, n);
+    tau = instance_type(types, cid, n, r->aux.data);
+    break;
+
+  default:
+    bin_reader_error(r, BIN_BAD_OPCODE);
+  }
+
+  bin_reader_register_type(r, tau);
+}
+
+
+/*
+ * TERMS
+ */
+
+/*
+ * Read n term references into r->aux
+ */
+static void bin_read_term_refs(bin_reader_t *r, uint32_t n) {
+  uint32_t i;
+
+  ivector_reset(&r->aux);
+  for (i=0; i<n; i++) {
+    ivector_push(&r->aux, bin_read_term_ref(r));
+  }
+}
+
+/*
+ * Read the arity of a composite term: it must be at least min
+ */
+static uint32_t bin_read_arity(bin_reader_t *r, uint32_t min) {
+  uint32_t n;
+
+  n = bin_read_uint32(r);
+  if (n < min || n > YICES_MAX_ARITY + 2) {
+    bin_reader_error(r, BIN_BAD_VALUE);
+  }
+  bin_read_term_refs(r, n);
+
+  return n;
+}
+
+/*
+ * Binary operation: read the arity (must be 2) and the arguments
+ * - return a pointer to the arguments (in r->aux)
+ */
+static term_t *bin_read_binary_args(bin_reader_t *r) {
+  if (bin_read_uint(r) != 2) {
+    bin_reader_error(r, BIN_BAD_VALUE);
+  }
+  bin_read_term_refs(r, 2);
+  return r->aux.data;
+}
+
+/*
+ * Type checks: the reader can't trust its input so it checks
+ * enough to guarantee that the term manager's preconditions hold.
+ */
+static void bin_check(bin_reader_t *r, bool ok) {
+  if (! ok) {
+    bin_reader_error(r, BIN_BAD_VALUE);
+  }
+}
+
+/*
+ * Power product: the factors have the type of the first one
+ */
+static term_t bin_read_pprod(bin_reader_t *r) {
+  term_manager_t *mngr;
+  rba_buffer_t *b;
+  bvarith64_buffer_t *b64;
+  bvarith_buffer_t *bbv;
+  term_t t;
+  type_t tau;
+  uint32_t i, n, nbits, d;
+
+  mngr = r->manager;
+  n = bin_read_uint32(r);
+  if (n == 0) {
+    bin_reader_error(r, BIN_BAD_VALUE);
+  }
+
+  t = bin_read_term_ref(r);
+  d = bin_read_uint32(r);
+  tau = term_type(r->terms, t);
+  if (is_arithmetic_type(tau)) {
+    b = term_manager_get_arith_buffer(mngr);
+    rba_buffer_set_one(b);
+    for (i=0; ; i++) {
+      rba_buffer_mul_term_power(b, r->terms, t, d);
+      if (i+1 == n) break;
+      t = bin_read_term_ref(r);
+      d = bin_read_uint32(r);
+      bin_check(r, is_arithmetic_term(r->terms, t));
+    }
+    return mk_arith_term(mngr, b);
+  }
+
+  bin_check(r, is_bv_type(r->types, tau));
+
+  nbits = bv_type_size(r->types, tau);
+  if (nbits <= 64) {
+    b64 = term_manager_get_bvarith64_buffer(mngr);
+    bvarith64_buffer_prepare(b64, nbits);
+    bvarith64_buffer_set_one(b64);
+    for (i=0; ; i++) {
+      bvarith64_buffer_mul_term_power(b64, r->terms, t, d);
+      if (i+1 == n) break;
+      t = bin_read_term_ref(r);
+      d = bin_read_uint32(r);
+      bin_check(r, term_type(r->terms, t) == tau);
+    }
+    return mk_bvarith64_term(mngr, b64);
+  }
+
+  bbv = term_manager_get_bvarith_buffer(mngr);
+  bvarith_buffer_prepare(bbv, nbits);
+  bvarith_buffer_set_one(bbv);
+  for (i=0; ; i++) {
+    bvarith_buffer_mul_term_power(bbv, r->terms, t, d);
+    if (i+1 == n) break;
+    t = bin_read_term_ref(r);
+    d = bin_read_uint32(r);
+    bin_check(r, term_type(r->terms, t) == tau);
+  }
+  return mk_bvarith_term(mngr, bbv);
+}
+
+/*
+ * Polynomials: the monomials are added to the term manager's
+ * buffers as they are read.
+ */
+static term_t bin_read_arith_poly(bin_reader_t *r) {
+  rba_buffer_t *b;
+  term_t t;
+  uint32_t i, n;
+  uint8_t has_const;
+
+  b = term_manager_get_arith_buffer(r->manager);
+  reset_rba_buffer(b);
+
+  has_const = bin_read_byte(r);
+  if (has_const) {
+    bin_read_rational(r);
+    rba_buffer_add_const(b, &r->q);
+  }
+  n = bin_read_uint32(r);
+  for (i=0; i<n; i++) {
+    bin_read_rational(r);
+    t = bin_read_term_ref(r);
+    bin_check(r, is_arithmetic_term(r->terms, t));
+    rba_buffer_add_const_times_term(b, r->terms, &r->q, t);
+  }
+
+  return mk_arith_term(r->manager, b);
+}
+
+static term_t bin_read_bv64_poly(bin_reader_t *r) {
+  bvarith64_buffer_t *b;
+  uint64_t c;
+  term_t t;
+  uint32_t i, n, nbits;
+  uint8_t has_const;
+
+  nbits = bin_read_bitsize(r);
+  if (nbits > 64) {
+    bin_reader_error(r, BIN_BAD_VALUE);
+  }
+  b = term_manager_get_bvarith64_buffer(r->manager);
+  bvarith64_buffer_prepare(b, nbits);
+
+  has_const = bin_read_byte(r);
+  if (has_const) {
+    c = bin_read_uint(r);
+    bvarith64_buffer_add_const(b, norm64(c, nbits));
+  }
+  n = bin_read_uint32(r);
+  for (i=0; i<n; i++) {
+    c = bin_read_uint(r);
+    t = bin_read_term_ref(r);
+    bin_check(r, is_bitvector_term(r->terms, t) && term_bitsize(r->terms, t) == nbits);
+    bvarith64_buffer_add_const_times_term(b, r->terms, norm64(c, nbits), t);
+  }
+
+  return mk_bvarith64_term(r->manager, b);
+}
+
+static term_t bin_read_bv_poly(bin_reader_t *r) {
+  bvarith_buffer_t *b;
+  term_t t;
+  uint32_t i, n, nbits;
+  uint8_t has_const;
+
+  nbits = bin_read_bitsize(r);
+  if (nbits <= 64) {
+    bin_reader_error(r, BIN_BAD_VALUE);
+  }
+  b = term_manager_get_bvarith_buffer(r->manager);
+  bvarith_buffer_prepare(b, nbits);
+
+  has_const = bin_read_byte(r);
+  if (has_const) {
+    bin_read_bvconst(r, nbits);
+    bvarith_buffer_add_const(b, r->bv.data);
+  }
+  n = bin_read_uint32(r);
+  for (i=0; i<n; i++) {
+    bin_read_bvconst(r, nbits);
+    t = bin_read_term_ref(r);
+    bin_check(r, is_bitvector_term(r->terms, t) && term_bitsize(r->terms, t) == nbits);
+    bvarith_buffer_add_const_times_term(b, r->terms, r->bv.data, t);
+  }
+
+  return mk_bvarith_term(r->manager, b);
+}
+
+
+static void bin_check_boolean_args(bin_reader_t *r, uint32_t n, const term_t *a) {
+  uint32_t i;
+
+  for (i=0; i<n; i++) {
+    bin_check(r, is_boolean_term(r->terms, a[i]));
+  }
+}
+
+static void bin_check_arith_args(bin_reader_t *r, uint32_t n, const term_t *a) {
+  uint32_t i;
+
+  for (i=0; i<n; i++) {
+    bin_check(r, is_arithmetic_term(r->terms, a[i]));
+  }
+}
+
+static void bin_check_bv_args(bin_reader_t *r, const term_t *a) {
+  bin_check(r, is_bitvector_term(r->terms, a[0]) &&
+            term_type(r->terms, a[0]) == term_type(r->terms, a[1]));
+}
+
+static void bin_check_variables(bin_reader_t *r, uint32_t n, const term_t *a) {
+  uint32_t i;
+
+  for (i=0; i<n; i++) {
+    bin_check(r, term_kind(r->terms, a[i]) == VARIABLE && is_pos_term(a[i]));
+  }
+}
+
+/*
+ * Check that a[0 ... n-1] are compatible arguments for a function
+ * of type tau
+ */
+static void bin_check_fun_args(bin_reader_t *r, type_t tau, uint32_t n, const term_t *a) {
+  function_type_t *fun;
+  uint32_t i;
+
+  fun = function_type_desc(r->types, tau);
+  bin_check(r, fun->ndom == n);
+  for (i=0; i<n; i++) {
+    bin_check(r, is_subtype(r->types, term_type(r->terms, a[i]), fun->domain[i]));
+  }
+}
+
+static term_t bin_read_composite(bin_reader_t *r, uint32_t op) {
+  term_manager_t *mngr;
+  term_table_t *terms;
+  term_t *a;
+  type_t tau;
+  uint32_t n;
+
+  mngr = r->manager;
+  terms = r->terms;
+
+  switch (op) {
+  case BIN_ITE:
+    n = bin_read_arity(r, 3);
+    a = r->aux.data;
+    bin_check(r, n == 3 && is_boolean_term(terms, a[0]));
+    tau = super_type(r->types, term_type(terms, a[1]), term_type(terms, a[2]));
+    bin_check(r, tau != NULL_TYPE);
+    return mk_ite(mngr, a[0], a[1], a[2], tau);
+
+  case BIN_APP:
+    n = bin_read_arity(r, 2);
+    a = r->aux.data;
+    bin_check(r, is_function_term(terms, a[0]));
+    bin_check_fun_args(r, term_type(terms, a[0]), n-1, a+1);
+    return mk_application(mngr, a[0], n-1, a+1);
+
+  case BIN_UPDATE:
+    n = bin_read_arity(r, 3);
+    a = r->aux.data;
+    bin_check(r, is_function_term(terms, a[0]));
+    tau = term_type(terms, a[0]);
+    bin_check_fun_args(r, tau, n-2, a+1);
+    bin_check(r, is_subtype(r->types, term_type(terms, a[n-1]), function_type_desc(r->types, tau)->range));
+    return mk_update(mngr, a[0], n-2, a+1, a[n-1]);
+
+  case BIN_TUPLE:
+    n = bin_read_arity(r, 1);
+    return mk_tuple(mngr, n, r->aux.data);
+
+  case BIN_EQ:
+    a = bin_read_binary_args(r);
+    bin_check(r, super_type(r->types, term_type(terms, a[0]), term_type(terms, a[1])) != NULL_TYPE);
+    return mk_eq(mngr, a[0], a[1]);
+
+  case BIN_DISTINCT:
+    n = bin_read_arity(r, 2);
+    a = r->aux.data;
+    tau = term_type(terms, a[0]);
+    while (n > 1) {
+      n --;
+      tau = super_type(r->types, tau, term_type(terms, a[n]));
+      bin_check(r, tau != NULL_TYPE);
+    }
+    return mk_distinct(mngr, r->aux.size, a);
+
+  case BIN_FORALL:
+    n = bin_read_arity(r, 2);
+    a = r->aux.data;
+    bin_check_variables(r, n-1, a);
+    bin_check(r, is_boolean_term(terms, a[n-1]));
+    return mk_forall(mngr, n-1, a, a[n-1]);
+
+  case BIN_LAMBDA:
+    n = bin_read_arity(r, 2);
+    a = r->aux.data;
+    bin_check_variables(r, n-1, a);
+    return mk_lambda(mngr, n-1, a, a[n-1]);
+
+  case BIN_OR:
+    n = bin_read_arity(r, 1);
+    bin_check_boolean_args(r, n, r->aux.data);
+    return mk_or(mngr, n, r->aux.data);
+
+  case BIN_XOR:
+    n = bin_read_arity(r, 1);
+    bin_check_boolean_args(r, n, r->aux.data);
+    return mk_xor(mngr, n, r->aux.data);
+
+  case BIN_ARITH_BINEQ_ATOM:
+    a = bin_read_binary_args(r);
+    bin_check_arith_args(r, 2, a);
+    return mk_arith_eq(mngr, a[0], a[1]);
+
+  case BIN_ARITH_RDIV:
+    a = bin_read_binary_args(r);
+    bin_check_arith_args(r, 2, a);
+    return mk_arith_rdiv(mngr, a[0], a[1]);
+
+  case BIN_ARITH_IDIV:
+    a = bin_read_binary_args(r);
+    bin_check_arith_args(r, 2, a);
+    return mk_arith_idiv(mngr, a[0], a[1]);
+
+  case BIN_ARITH_MOD:
+    a = bin_read_binary_args(r);
+    bin_check_arith_args(r, 2, a);
+    return mk_arith_mod(mngr, a[0], a[1]);
+
+  case BIN_ARITH_DIVIDES_ATOM:
+    a = bin_read_binary_args(r);
+    bin_check_arith_args(r, 2, a);
+    return mk_arith_divides(mngr, a[0], a[1]);
+
+  case BIN_BV_ARRAY:
+    n = bin_read_arity(r, 1);
+    bin_check(r, n <= YICES_MAX_BVSIZE);
+    bin_check_boolean_args(r, n, r->aux.data);
+    return mk_bvarray(mngr, n, r->aux.data);
+
+  default:
+    break;
+  }
+
+  // all the other composites are binary bitvector operations
+  a = bin_read_binary_args(r);
+  bin_check_bv_args(r, a);
+
+  switch (op) {
+  case BIN_BV_DIV:      return mk_bvdiv(mngr, a[0], a[1]);
+  case BIN_BV_REM:      return mk_bvrem(mngr, a[0], a[1]);
+  case BIN_BV_SDIV:     return mk_bvsdiv(mngr, a[0], a[1]);
+  case BIN_BV_SREM:     return mk_bvsrem(mngr, a[0], a[1]);
+  case BIN_BV_SMOD:     return mk_bvsmod(mngr, a[0], a[1]);
+  case BIN_BV_SHL:      return mk_bvshl(mngr, a[0], a[1]);
+  case BIN_BV_LSHR:     return mk_bvlshr(mngr, a[0], a[1]);
+  case BIN_BV_ASHR:     return mk_bvashr(mngr, a[0], a[1]);
+  case BIN_BV_EQ_ATOM:  return mk_bveq(mngr, a[0], a[1]);
+  case BIN_BV_GE_ATOM:  return mk_bvge(mngr, a[0], a[1]);
+  case BIN_BV_SGE_ATOM: return mk_bvsge(mngr, a[0], a[1]);
+  default:
+    assert(false);
+    bin_reader_error(r, BIN_BAD_OPCODE);
+  }
+}
+
+
+static void bin_read_term_def(bin_reader_t *r, uint32_t op) {
+  term_manager_t *mngr;
+  term_table_t *terms;
+  term_t t;
+  type_t tau;
+  uint32_t n, idx;
+
+  mngr = r->manager;
+  terms = r->terms;
+
+  switch (op) {
+  case BIN_CONSTANT:
+    tau = bin_read_type_ref(r);
+    idx = bin_read_uint32(r);
+    bin_check(r, idx <= INT32_MAX &&
+              (is_uninterpreted_type(r->types, tau) ||
+               (is_scalar_type(r->types, tau) && idx < scalar_type_cardinal(r->types, tau))));
+    t = mk_constant(mngr, tau, idx);
+    break;
+
+  case BIN_ARITH_CONSTANT:
+    bin_read_rational(r);
+    t = mk_arith_constant(mngr, &r->q);
+    break;
+
+  case BIN_BV_CONSTANT:
+    n = bin_read_bitsize(r);
+    bin_read_bvconst(r, n);
+    t = mk_bv_constant(mngr, &r->bv);
+    break;
+
+  case BIN_VARIABLE:
+    t = mk_variable(mngr, bin_read_type_ref(r));
+    break;
+
+  case BIN_UNINTERPRETED:
+    t = mk_uterm(mngr, bin_read_type_ref(r));
+    break;
+
+  case BIN_ARITH_EQ_ATOM:
+  case BIN_ARITH_GE_ATOM:
+  case BIN_ARITH_IS_INT_ATOM:
+  case BIN_ARITH_FLOOR:
+  case BIN_ARITH_CEIL:
+  case BIN_ARITH_ABS:
+    t = bin_read_term_ref(r);
+    bin_check(r, is_arithmetic_term(terms, t));
+    switch (op) {
+    case BIN_ARITH_EQ_ATOM:     t = mk_arith_term_eq0(mngr, t); break;
+    case BIN_ARITH_GE_ATOM:     t = mk_arith_term_geq0(mngr, t); break;
+    case BIN_ARITH_IS_INT_ATOM: t = mk_arith_is_int(mngr, t); break;
+    case BIN_ARITH_FLOOR:       t = mk_arith_floor(mngr, t); break;
+    case BIN_ARITH_CEIL:        t = mk_arith_ceil(mngr, t); break;
+    default:                    t = mk_arith_abs(mngr, t); break;
+    }
+    break;
+
+  case BIN_SELECT:
+    idx = bin_read_uint32(r);
+    t = bin_read_term_ref(r);
+    bin_check(r, is_tuple_term(terms, t) &&
+              idx < tuple_type_desc(r->types, term_type(terms, t))->nelem);
+    t = mk_select(mngr, idx, t);
+    break;
+
+  case BIN_BIT:
+    idx = bin_read_uint32(r);
+    t = bin_read_term_ref(r);
+    bin_check(r, is_bitvector_term(terms, t) && idx < term_bitsize(terms, t));
+    t = mk_bitextract(mngr, t, idx);
+    break;
+
+  case BIN_POWER_PRODUCT:
+    t = bin_read_pprod(r);
+    break;
+
+  case BIN_ARITH_POLY:
+    t = bin_read_arith_poly(r);
+    break;
+
+  case BIN_BV64_POLY:
+    t = bin_read_bv64_poly(r);
+    break;
+
+  case BIN_BV_POLY:
+    t = bin_read_bv_poly(r);
+    break;
+
+  default:
+    t = bin_read_composite(r, op);
+    break;
+  }
+
+  bin_reader_register_term(r, t);
+}
+
+
+void bin_read_def(bin_reader_t *r, uint32_t op) {
+  if (bin_op_is_type(op)) {
+    bin_read_type_def(r, op);
+  } else if (bin_op_is_term(op)) {
+    bin_read_term_def(r, op);
+  } else {
+    bin_reader_error(r, BIN_BAD_OPCODE);
+  }
+}
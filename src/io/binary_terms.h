@@ -0,0 +1,391 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * BINARY FORMAT FOR TYPES AND TERMS
+ *
+ * A binary stream is a header followed by a sequence of records.
+ * Each record starts with an opcode (one byte):
+ * - opcodes 0x00 to 0x3F define a term
+ * - opcodes 0x40 to 0x4F define a type
+ * - opcodes 0x80 to 0xFF are available to the client (e.g., for
+ *   SMT2 commands, see smt2_binary.h).
+ *
+ * Types and terms are numbered in the order they are defined (or
+ * registered, see below), starting from 0. A record refers to a type
+ * or term by this number, so a term shared by several formulas is
+ * written once. The definitions follow the internal representation
+ * of terms.h: a polynomial is written as a list of monomials, not as
+ * a tree of additions.
+ *
+ * Integers are written in LEB128 format (7 bits per byte, low-order
+ * bits first). Signed integers are zigzag-encoded first. Strings are
+ * written as a length followed by the characters.
+ *
+ * Encodings:
+ * - a type reference is the type number
+ * - a term reference is (2 * term number + polarity)
+ * - term number 0 is predefined: it's the Boolean constant true
+ * - a rational is either 0 + num (signed) + den (unsigned) if it fits
+ *   in 64 bits or 1 + string "num/den" in base 10.
+ *
+ * Some terms and types are created by the client (e.g., by a
+ * declare-fun command). They are not defined in the stream, but both
+ * the writer and the reader must register them in the same order to
+ * keep the numbering consistent.
+ *
+ * The reader builds terms directly with the term manager (no term
+ * stack). It checks opcodes, references, and the types of arguments
+ * so that a corrupted stream is reported as an error rather than
+ * breaking the term manager's invariants.
+ */
+
+#ifndef __BINARY_TERMS_H
+#define __BINARY_TERMS_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <setjmp.h>
+
+#include "terms/bv_constants.h"
+#include "terms/term_manager.h"
+#include "utils/int_hash_map.h"
+#include "utils/int_vectors.h"
+
+/*
+ * Header: magic string + version
+ */
+#define BIN_MAGIC "YBIN"
+#define BIN_MAGIC_LEN 4
+#define BIN_VERSION 1
+
+/*
+ * Term opcodes
+ */
+typedef enum bin_term_op {
+  BIN_CONSTANT,           // type + index
+  BIN_ARITH_CONSTANT,     // rational
+  BIN_BV_CONSTANT,        // bitsize + words (32 bits each)
+  BIN_VARIABLE,           // type
+  BIN_UNINTERPRETED,      // type
+  BIN_ARITH_EQ_ATOM,      // term
+  BIN_ARITH_GE_ATOM,      // term
+  BIN_ARITH_IS_INT_ATOM,  // term
+  BIN_ARITH_FLOOR,        // term
+  BIN_ARITH_CEIL,         // term
+  BIN_ARITH_ABS,          // term
+  BIN_ITE,                // arity + terms (same for all composites)
+  BIN_APP,
+  BIN_UPDATE,
+  BIN_TUPLE,
+  BIN_EQ,
+  BIN_DISTINCT,
+  BIN_FORALL,
+  BIN_LAMBDA,
+  BIN_OR,
+  BIN_XOR,
+  BIN_ARITH_BINEQ_ATOM,
+  BIN_ARITH_RDIV,
+  BIN_ARITH_IDIV,
+  BIN_ARITH_MOD,
+  BIN_ARITH_DIVIDES_ATOM,
+  BIN_BV_ARRAY,
+  BIN_BV_DIV,
+  BIN_BV_REM,
+  BIN_BV_SDIV,
+  BIN_BV_SREM,
+  BIN_BV_SMOD,
+  BIN_BV_SHL,
+  BIN_BV_LSHR,
+  BIN_BV_ASHR,
+  BIN_BV_EQ_ATOM,
+  BIN_BV_GE_ATOM,
+  BIN_BV_SGE_ATOM,
+  BIN_SELECT,             // index + term
+  BIN_BIT,                // index + term
+  BIN_POWER_PRODUCT,      // n + n pairs (term, exponent)
+  BIN_ARITH_POLY,         // has-constant flag [+ constant] + n + n pairs (rational, term)
+  BIN_BV64_POLY,          // bitsize + flag [+ constant] + n + n pairs (coeff, term)
+  BIN_BV_POLY,            // same with coefficients as word arrays
+} bin_term_op_t;
+
+#define BIN_NUM_TERM_OPS (BIN_BV_POLY+1)
+
+/*
+ * Type opcodes
+ */
+typedef enum bin_type_op {
+  BIN_BOOL_TYPE = 0x40,
+  BIN_INT_TYPE,
+  BIN_REAL_TYPE,
+  BIN_BV_TYPE,             // bitsize
+  BIN_SCALAR_TYPE,         // cardinality
+  BIN_UNINTERPRETED_TYPE,  // nothing
+  BIN_VARIABLE_TYPE,       // id
+  BIN_TUPLE_TYPE,          // n + n types
+  BIN_FUNCTION_TYPE,       // n + n domain types + range
+  BIN_INSTANCE_TYPE,       // macro + n + n types
+} bin_type_op_t;
+
+#define BIN_LAST_TYPE_OP BIN_INSTANCE_TYPE
+
+/*
+ * First opcode available to the client
+ */
+#define BIN_CLIENT_OP 0x80
+
+static inline bool bin_op_is_term(uint32_t op) {
+  return op < BIN_NUM_TERM_OPS;
+}
+
+static inline bool bin_op_is_type(uint32_t op) {
+  return BIN_BOOL_TYPE <= op && op <= BIN_LAST_TYPE_OP;
+}
+
+
+
+/*
+ * WRITER
+ */
+
+/*
+ * - file = output stream
+ * - buffer = output buffer of size BIN_BUFFER_SIZE, idx = number of
+ *   bytes in the buffer
+ * - terms = term table, types = type table
+ * - term_map: index of a (positive) term --> its number
+ * - type_map: type --> its number
+ * - macro_map: macro id --> its number
+ * - nterms, ntypes, nmacros = number of terms/types/macros defined
+ *   or registered so far
+ * - stack = for exploring terms
+ * - failed = true after a write error, errcode = errno then
+ */
+#define BIN_BUFFER_SIZE 65536
+
+typedef struct bin_writer_s {
+  FILE *file;
+  uint8_t *buffer;
+  uint32_t idx;
+  term_table_t *terms;
+  type_table_t *types;
+  int_hmap_t term_map;
+  int_hmap_t type_map;
+  int_hmap_t macro_map;
+  uint32_t nterms;
+  uint32_t ntypes;
+  uint32_t nmacros;
+  ivector_t stack;
+  bool failed;
+  int errcode;
+} bin_writer_t;
+
+
+/*
+ * Initialize writer w to write to f using the given term table
+ * - write the header
+ */
+extern void init_bin_writer(bin_writer_t *w, FILE *f, term_table_t *terms);
+
+/*
+ * Flush the buffer then delete w (f is not closed)
+ */
+extern void delete_bin_writer(bin_writer_t *w);
+
+/*
+ * Write the buffer content to the file (and fflush the file)
+ */
+extern void bin_writer_flush(bin_writer_t *w);
+
+/*
+ * Forget all terms, types, and macros (e.g., after the
+ * term table is reset)
+ */
+extern void bin_writer_reset(bin_writer_t *w);
+
+/*
+ * Basic output
+ */
+extern void bin_write_byte(bin_writer_t *w, uint8_t b);
+extern void bin_write_uint(bin_writer_t *w, uint64_t x);
+extern void bin_write_int(bin_writer_t *w, int64_t x);
+extern void bin_write_string(bin_writer_t *w, const char *s);
+extern void bin_write_bytes(bin_writer_t *w, const char *s, uint32_t len);
+
+/*
+ * Rational q and bitvector constant a of n bits
+ */
+extern void bin_write_rational(bin_writer_t *w, rational_t *q);
+extern void bin_write_bvconst(bin_writer_t *w, uint32_t n, const uint32_t *a);
+
+/*
+ * Make sure tau and all the types it depends on are defined
+ * - return false if tau can't be written (instance of a macro
+ *   that's not registered)
+ */
+extern bool bin_write_type_def(bin_writer_t *w, type_t tau);
+
+/*
+ * Make sure t and all its subterms are defined
+ * - return false if t can't be written (root atoms are not supported)
+ */
+extern bool bin_write_term_def(bin_writer_t *w, term_t t);
+
+/*
+ * References: tau/t must be defined
+ */
+extern void bin_write_type_ref(bin_writer_t *w, type_t tau);
+extern void bin_write_term_ref(bin_writer_t *w, term_t t);
+extern void bin_write_macro_ref(bin_writer_t *w, int32_t id);
+
+/*
+ * Register a type, term, or macro created by the client
+ * - it must not be registered already
+ */
+extern void bin_writer_register_type(bin_writer_t *w, type_t tau);
+extern void bin_writer_register_term(bin_writer_t *w, term_t t);
+extern void bin_writer_register_macro(bin_writer_t *w, int32_t id);
+
+
+
+/*
+ * READER
+ */
+
+/*
+ * Error codes
+ */
+typedef enum bin_error {
+  BIN_NO_ERROR,
+  BIN_READ_ERROR,     // error reported by the OS (errcode = errno)
+  BIN_BAD_HEADER,     // not a binary file, or wrong version
+  BIN_TRUNCATED,      // end of file inside a record
+  BIN_BAD_OPCODE,     // unknown opcode
+  BIN_BAD_REFERENCE,  // reference to an undefined term/type/macro
+  BIN_BAD_VALUE,      // other invalid data
+} bin_error_t;
+
+
+/*
+ * - file = input stream
+ * - buffer = input buffer: the unread bytes are in buffer[idx ... end-1]
+ * - manager = term manager, terms/types = its tables
+ * - term_map[i] = term number i, type_map[i] = type number i,
+ *   macro_map[i] = macro number i
+ * - aux = vector for term arguments
+ * - q = buffer for rational constants
+ * - bv = buffer for bitvector constants
+ * - string = buffer for strings (size = string_size)
+ * - env = jump buffer for errors (must be set by the client)
+ * - errcode = errno for BIN_READ_ERROR
+ */
+typedef struct bin_reader_s {
+  FILE *file;
+  uint8_t *buffer;
+  uint32_t idx;
+  uint32_t end;
+  term_manager_t *manager;
+  term_table_t *terms;
+  type_table_t *types;
+  ivector_t term_map;
+  ivector_t type_map;
+  ivector_t macro_map;
+  ivector_t aux;
+  rational_t q;
+  bvconstant_t bv;
+  char *string;
+  uint32_t string_size;
+  int errcode;
+  jmp_buf env;
+} bin_reader_t;
+
+
+/*
+ * Initialize r to read from f, and build terms using manager
+ */
+extern void init_bin_reader(bin_reader_t *r, FILE *f, term_manager_t *manager);
+
+/*
+ * Delete r (f is not closed)
+ */
+extern void delete_bin_reader(bin_reader_t *r);
+
+/*
+ * Forget all terms, types, and macros
+ */
+extern void bin_reader_reset(bin_reader_t *r);
+
+/*
+ * Error: longjmp to r->env with the given code
+ */
+extern void bin_reader_error(bin_reader_t *r, bin_error_t code) __attribute__ ((noreturn));
+
+/*
+ * Read and check the header
+ */
+extern void bin_read_header(bin_reader_t *r);
+
+/*
+ * Check whether there's nothing left to read
+ */
+extern bool bin_reader_eof(bin_reader_t *r);
+
+/*
+ * Basic input
+ * - bin_read_string returns a pointer to r->string, which is
+ *   overwritten by the next call
+ * - bin_read_string_copy returns a copy (to be freed with safe_free)
+ */
+extern uint8_t bin_read_byte(bin_reader_t *r);
+extern uint64_t bin_read_uint(bin_reader_t *r);
+extern int64_t bin_read_int(bin_reader_t *r);
+extern uint32_t bin_read_uint32(bin_reader_t *r);
+extern const char *bin_read_string(bin_reader_t *r, uint32_t *len);
+extern char *bin_read_string_copy(bin_reader_t *r);
+
+/*
+ * Rational and bitvector constants: the result is stored in r->q
+ * or r->bv and returned (valid until the next read)
+ */
+extern rational_t *bin_read_rational(bin_reader_t *r);
+extern uint32_t bin_read_bitsize(bin_reader_t *r);
+extern uint32_t *bin_read_bvconst(bin_reader_t *r, uint32_t n);
+
+/*
+ * Read a definition: op = opcode (already read)
+ * - op must be a term or type opcode
+ */
+extern void bin_read_def(bin_reader_t *r, uint32_t op);
+
+/*
+ * References
+ */
+extern type_t bin_read_type_ref(bin_reader_t *r);
+extern term_t bin_read_term_ref(bin_reader_t *r);
+extern int32_t bin_read_macro_ref(bin_reader_t *r);
+
+/*
+ * Register a type, term, or macro (must be in the same order as the writer)
+ */
+extern void bin_reader_register_type(bin_reader_t *r, type_t tau);
+extern void bin_reader_register_term(bin_reader_t *r, term_t t);
+extern void bin_reader_register_macro(bin_reader_t *r, int32_t id);
+
+
+#endif /* __BINARY_TERMS_H */
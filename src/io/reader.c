@@ -19,6 +19,8 @@
 /*
  * File reader: keeps track of filename, position, current character.
  * String reader: same thing but reads from a null-terminated string.
+ * Mapped file reader: same as string reader, but reads from the file
+ * mapped in memory.
  */
 
 #if 0
@@ -27,8 +29,14 @@
 #endif
 
 #include <stdbool.h>
+#include <string.h>
 #include <assert.h>
 
+#if !defined(MINGW)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
 #include "io/reader.h"
 
 
@@ -107,6 +115,132 @@ static int string_reader_next_char(reader_t *reader) {
 
 
 
+/*
+ * Read and return the next char from a mapped file reader
+ * or a memory reader
+ * - update pos, line, column
+ */
+static int memory_reader_next_char(reader_t *reader) {
+  assert(reader->data != NULL);
+
+  if (reader->current == EOF) {
+    return EOF;
+  }
+
+  if (reader->current == '\n') {
+    reader->line ++;
+    reader->column = 0;
+  }
+
+  if (reader->pos < reader->size) {
+    reader->current = (unsigned char) reader->data[reader->pos];
+  } else {
+    reader->current = EOF;
+  }
+  reader->pos ++;
+  reader->column ++;
+
+  return reader->current;
+}
+
+
+/*
+ * Advance by k characters (all in memory)
+ */
+void reader_advance(reader_t *reader, uint64_t k) {
+  const char *s;
+  uint64_t i, last_newline;
+
+  assert(reader_in_memory(reader) && reader->pos + k <= reader->size);
+
+  if (k == 0) {
+    return;
+  }
+
+  /*
+   * The characters we go past are the current one and the
+   * first k-1 lookahead characters. Each '\n' among them
+   * starts a new line.
+   */
+  s = reader->data + reader->pos;
+  last_newline = k;
+  if (reader->current == '\n') {
+    reader->line ++;
+    last_newline = 0;
+  }
+  for (i=0; i<k-1; i++) {
+    if (s[i] == '\n') {
+      reader->line ++;
+      last_newline = i+1;
+    }
+  }
+
+  if (last_newline < k) {
+    reader->column = k - last_newline;
+  } else {
+    reader->column += k;
+  }
+  reader->pos += k;
+  if (reader->read == string_reader_next_char) {
+    reader->current = s[k-1]; // same as string_reader_next_char
+  } else {
+    reader->current = (unsigned char) s[k-1];
+  }
+}
+
+
+/*
+ * Move to position pos (all in memory)
+ */
+void reader_set_position(reader_t *reader, uint64_t pos, uint32_t line, uint32_t column) {
+  assert(reader_in_memory(reader) && pos > 0);
+
+  reader->pos = pos;
+  reader->line = line;
+  reader->column = column;
+  if (pos > reader->size) {
+    reader->current = EOF;
+  } else if (reader->read == string_reader_next_char) {
+    reader->current = reader->data[pos-1];
+  } else {
+    reader->current = (unsigned char) reader->data[pos-1];
+  }
+}
+
+
+/*
+ * Try to map the file of reader in memory
+ * - the file must be a regular file, not read yet
+ * - if that works, switch to the mapped reader
+ */
+static void map_file_reader(reader_t *reader) {
+#if !defined(MINGW)
+  struct stat st;
+  void *data;
+  int fd;
+
+  fd = fileno(reader->input.stream);
+  if (fd < 0 || fstat(fd, &st) < 0 || !S_ISREG(st.st_mode) || st.st_size <= 0) {
+    return;
+  }
+  if ((uint64_t) st.st_size > (uint64_t) SIZE_MAX) {
+    return;
+  }
+  data = mmap(NULL, (size_t) st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  if (data == MAP_FAILED) {
+    return;
+  }
+#if defined(MADV_SEQUENTIAL)
+  madvise(data, (size_t) st.st_size, MADV_SEQUENTIAL);
+#endif
+  reader->data = data;
+  reader->size = st.st_size;
+  reader->mapped = true;
+  reader->read = memory_reader_next_char;
+#endif
+}
+
+
 /*
  * Initialize reader for file of the given name
  * - return -1 if the file could not be open
@@ -125,6 +259,9 @@ int32_t init_file_reader(reader_t *reader, const char *filename) {
   reader->column = 1;
   reader->is_stream = true;
   reader->read = file_reader_next_char;
+  reader->data = NULL;
+  reader->size = 0;
+  reader->mapped = false;
   reader->name = filename;
 
   if (f == NULL) {
@@ -132,6 +269,8 @@ int32_t init_file_reader(reader_t *reader, const char *filename) {
     return -1;
   }
 
+  map_file_reader(reader);
+
   reader->current = '\n';
   return 0;
 }
@@ -148,6 +287,9 @@ void init_stream_reader(reader_t *reader, FILE *f, const char *name) {
   reader->column = 1;
   reader->is_stream = true;
   reader->read = file_reader_next_char;
+  reader->data = NULL;
+  reader->size = 0;
+  reader->mapped = false;
   reader->name = name;
 }
 
@@ -163,6 +305,27 @@ void init_string_reader(reader_t *reader, const char *data, const char *name) {
   reader->column = 1;
   reader->is_stream = false;
   reader->read = string_reader_next_char;
+  reader->data = data;
+  reader->size = strlen(data);
+  reader->mapped = false;
+  reader->name = name;
+}
+
+
+/*
+ * Initialize reader for the first n characters of data
+ */
+void init_memory_reader(reader_t *reader, const char *data, uint64_t n, const char *name) {
+  reader->current = '\n';
+  reader->input.data = data;
+  reader->pos = 0;
+  reader->line = 0;
+  reader->column = 1;
+  reader->is_stream = false;
+  reader->read = memory_reader_next_char;
+  reader->data = data;
+  reader->size = n;
+  reader->mapped = false;
   reader->name = name;
 }
 
@@ -179,6 +342,8 @@ void reset_string_reader(reader_t *reader, const char *data) {
   reader->pos = 0;
   reader->line = 0;
   reader->column = 1;
+  reader->data = data;
+  reader->size = strlen(data);
 }
 
 
@@ -187,6 +352,13 @@ void reset_string_reader(reader_t *reader, const char *data) {
  * Close reader: return EOF on error, 0 otherwise
  */
 int close_reader(reader_t *reader) {
+#if !defined(MINGW)
+  if (reader->mapped) {
+    munmap((void *) reader->data, (size_t) reader->size);
+    reader->data = NULL;
+    reader->mapped = false;
+  }
+#endif
   if (reader->is_stream) {
     return fclose(reader->input.stream);
   } else {
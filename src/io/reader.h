@@ -19,11 +19,18 @@
 /*
  * File reader: keeps track of filename, position, and current character.
  * String reader: same thing but reads from a null-terminated string.
+ * Memory reader: reads from a block of characters of known size.
+ *
+ * If possible, the file reader maps the file in memory. It then reads
+ * from the mapped data as a string reader does, and the lexers can scan
+ * the input directly (see reader_in_memory).
  */
 
 #ifndef __READER_H
 #define __READER_H
 
+#include <assert.h>
+#include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
 
@@ -33,6 +40,9 @@
  * - pos, line, column = position in input stream
  * - for file reader, stream = input
  *   for string reader, data = null terminated string.
+ * - data = input data if it's in memory (string or mapped file), NULL otherwise
+ * - size = number of characters in data
+ * - mapped = true if data is a mapped file
  * - name = filename or whatever else is given at initialization.
  * - read = read function: get next character
  *   return EOF on last character
@@ -52,6 +62,9 @@ struct reader_s {
     FILE *stream;
     const char *data;
   } input;
+  const char *data;
+  uint64_t size;
+  bool mapped;
   const char *name;
 };
 
@@ -100,6 +113,12 @@ static inline void init_stdin_reader(reader_t *reader) {
  */
 extern void init_string_reader(reader_t *reader, const char *data, const char *name);
 
+/*
+ * Initialize reader for the first n characters of data
+ * - data doesn't need to be null terminated
+ */
+extern void init_memory_reader(reader_t *reader, const char *data, uint64_t n, const char *name);
+
 
 #if 0
 /*
@@ -161,4 +180,34 @@ static inline int reader_next_char(reader_t *reader) {
 }
 
 
+/*
+ * Direct access to the input for the lexers:
+ * - reader_in_memory(reader) is true if the input is in memory
+ *   (string reader or mapped file)
+ * - if so, reader_lookahead(reader, &n) returns a pointer to the
+ *   characters after the current one and stores their number in n
+ *   (the current character must not be EOF)
+ * - reader_advance(reader, k) is the same as k calls to reader_next_char
+ *   with k <= n. The new current character is the k-th lookahead character.
+ */
+static inline bool reader_in_memory(reader_t *reader) {
+  return reader->data != NULL;
+}
+
+static inline const char *reader_lookahead(reader_t *reader, uint64_t *n) {
+  assert(reader_in_memory(reader) && reader->current != EOF && reader->pos <= reader->size);
+  *n = reader->size - reader->pos;
+  return reader->data + reader->pos;
+}
+
+extern void reader_advance(reader_t *reader, uint64_t k);
+
+/*
+ * Move an in-memory reader to position pos (as returned by reader_position,
+ * so pos > 0) with the given line and column. The current character
+ * is the one at that position.
+ */
+extern void reader_set_position(reader_t *reader, uint64_t pos, uint32_t line, uint32_t column);
+
+
 #endif /* __READER_H */
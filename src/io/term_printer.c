@@ -2662,6 +2662,27 @@ static void pp_name_if_any(yices_pp_t *printer, term_table_t *tbl, term_t t) {
   }
 }
 
+/*
+ * If t's index is bound to a let variable, print the variable
+ * or (not <variable>) and return true. Return false otherwise.
+ */
+static bool pp_let_name(yices_pp_t *printer, term_t t) {
+  int_hmap_pair_t *r;
+
+  r = int_hmap_find(printer->let_names, index_of(t));
+  if (r == NULL) {
+    return false;
+  }
+  if (is_neg_term(t)) {
+    pp_open_block(printer, PP_OPEN_NOT);
+    pp_id(printer, "let!", r->val);
+    pp_close_block(printer, true);
+  } else {
+    pp_id(printer, "let!", r->val);
+  }
+  return true;
+}
+
 // term t or (not t)
 static void pp_term_recur(yices_pp_t *printer, term_table_t *tbl, term_t t, int32_t level, bool polarity) {
   int32_t i;
@@ -2675,7 +2696,9 @@ static void pp_term_recur(yices_pp_t *printer, term_table_t *tbl, term_t t, int3
 
   if (t <= false_term) {
     pp_string(printer, (char *) term2string[t]);
-  } else if (yices_pp_depth(printer) >= printer->pp.printer.area.width) {
+  } else if (printer->let_names != NULL && pp_let_name(printer, t)) {
+    // t is bound to a let variable (cf. pp_term_dag)
+  } else if (yices_pp_depth(printer) - printer->let_depth >= printer->pp.printer.area.width) {
     // heuristic to cut recursion for deep terms
     pp_name_if_any(printer, tbl, t);
   } else {
@@ -2709,6 +2732,414 @@ void pp_term_full(yices_pp_t *printer, term_table_t *tbl, term_t t) {
 }
 
 
+/*
+ * DAG PRINTING
+ */
+
+/*
+ * pp_term_dag explores the DAG rooted at t first:
+ * - map: term index --> node id (nodes are numbered 0, 1, ...)
+ * - for each node k:
+ *   idx[k] = the term index
+ *   count[k] = number of occurrences of k as a child in the DAG
+ *   size[k] = size of k's expanded tree (capped at PP_DAG_THRESHOLD)
+ *   flags[k] = exploration status + whether k contains a variable
+ *   level[k] = let level: a node bound to a let variable at level
+ *   l refers only to let variables of level < l. For a node that's
+ *   not bound, level[k] is the max level of the variables it refers to.
+ * - order = all nodes in post-order (children first)
+ * - stack, children = auxiliary vectors
+ *
+ * A node is bound to a let variable if it occurs more than once, its
+ * tree has at least PP_DAG_THRESHOLD nodes, and it doesn't contain
+ * any variable (so that it doesn't refer to the variables of an
+ * enclosing quantifier or lambda).
+ */
+typedef struct pp_dag_s {
+  int_hmap_t map;
+  ivector_t idx;
+  ivector_t count;
+  ivector_t size;
+  ivector_t flags;
+  ivector_t level;
+  ivector_t order;
+  ivector_t stack;
+  ivector_t children;
+} pp_dag_t;
+
+#define PP_DAG_EXPANDED 1
+#define PP_DAG_DONE     2
+#define PP_DAG_HAS_VAR  4
+#define PP_DAG_BOUND    8
+
+static void init_pp_dag(pp_dag_t *dag) {
+  init_int_hmap(&dag->map, 0);
+  init_ivector(&dag->idx, 64);
+  init_ivector(&dag->count, 64);
+  init_ivector(&dag->size, 64);
+  init_ivector(&dag->flags, 64);
+  init_ivector(&dag->level, 64);
+  init_ivector(&dag->order, 64);
+  init_ivector(&dag->stack, 64);
+  init_ivector(&dag->children, 16);
+}
+
+static void delete_pp_dag(pp_dag_t *dag) {
+  delete_int_hmap(&dag->map);
+  delete_ivector(&dag->idx);
+  delete_ivector(&dag->count);
+  delete_ivector(&dag->size);
+  delete_ivector(&dag->flags);
+  delete_ivector(&dag->level);
+  delete_ivector(&dag->order);
+  delete_ivector(&dag->stack);
+  delete_ivector(&dag->children);
+}
+
+/*
+ * Node id for term index i (create a new node if needed)
+ */
+static int32_t pp_dag_node(pp_dag_t *dag, int32_t i) {
+  int_hmap_pair_t *r;
+
+  r = int_hmap_get(&dag->map, i);
+  if (r->val < 0) {
+    r->val = dag->idx.size;
+    ivector_push(&dag->idx, i);
+    ivector_push(&dag->count, 0);
+    ivector_push(&dag->size, 0);
+    ivector_push(&dag->flags, 0);
+    ivector_push(&dag->level, 0);
+  }
+  return r->val;
+}
+
+/*
+ * Add the factors of power product p to v
+ */
+static void pp_dag_add_factors(pprod_t *p, ivector_t *v) {
+  uint32_t i, n;
+
+  n = p->len;
+  for (i=0; i<n; i++) {
+    ivector_push(v, p->prod[i].var);
+  }
+}
+
+/*
+ * Add x to v: if x is a power product with a non-trivial coefficient,
+ * it's printed inline so we add its factors instead (cf. pp_mono).
+ */
+static void pp_dag_add_mono(term_table_t *tbl, int32_t x, bool unit_coeff, ivector_t *v) {
+  if (x != const_idx) {
+    if (!unit_coeff && term_kind(tbl, x) == POWER_PRODUCT) {
+      pp_dag_add_factors(pprod_term_desc(tbl, x), v);
+    } else {
+      ivector_push(v, x);
+    }
+  }
+}
+
+/*
+ * Collect the subterms of term index i that the printer visits into v
+ * - v contains term indices on exit
+ */
+static void pp_dag_children(term_table_t *tbl, int32_t i, ivector_t *v) {
+  composite_term_t *d;
+  polynomial_t *p;
+  bvpoly64_t *p64;
+  bvpoly_t *bp;
+  root_atom_t *r;
+  uint32_t j, n, w, m;
+
+  ivector_reset(v);
+
+  switch (tbl->kind[i]) {
+  case ARITH_EQ_ATOM:
+  case ARITH_GE_ATOM:
+  case ARITH_IS_INT_ATOM:
+  case ARITH_FLOOR:
+  case ARITH_CEIL:
+  case ARITH_ABS:
+    ivector_push(v, tbl->desc[i].integer);
+    break;
+
+  case ARITH_ROOT_ATOM:
+    r = tbl->desc[i].ptr;
+    ivector_push(v, r->x);
+    ivector_push(v, r->p);
+    break;
+
+  case ITE_TERM:
+  case ITE_SPECIAL:
+  case APP_TERM:
+  case UPDATE_TERM:
+  case TUPLE_TERM:
+  case EQ_TERM:
+  case DISTINCT_TERM:
+  case FORALL_TERM:
+  case LAMBDA_TERM:
+  case OR_TERM:
+  case XOR_TERM:
+  case ARITH_BINEQ_ATOM:
+  case ARITH_RDIV:
+  case ARITH_IDIV:
+  case ARITH_MOD:
+  case ARITH_DIVIDES_ATOM:
+  case BV_ARRAY:
+  case BV_DIV:
+  case BV_REM:
+  case BV_SDIV:
+  case BV_SREM:
+  case BV_SMOD:
+  case BV_SHL:
+  case BV_LSHR:
+  case BV_ASHR:
+  case BV_EQ_ATOM:
+  case BV_GE_ATOM:
+  case BV_SGE_ATOM:
+    d = tbl->desc[i].ptr;
+    ivector_add(v, d->arg, d->arity);
+    break;
+
+  case SELECT_TERM:
+  case BIT_TERM:
+    ivector_push(v, tbl->desc[i].select.arg);
+    break;
+
+  case POWER_PRODUCT:
+    pp_dag_add_factors(tbl->desc[i].ptr, v);
+    break;
+
+  case ARITH_POLY:
+    p = tbl->desc[i].ptr;
+    n = p->nterms;
+    for (j=0; j<n; j++) {
+      pp_dag_add_mono(tbl, p->mono[j].var, q_is_one(&p->mono[j].coeff), v);
+    }
+    break;
+
+  case BV64_POLY:
+    p64 = tbl->desc[i].ptr;
+    n = p64->nterms;
+    for (j=0; j<n; j++) {
+      pp_dag_add_mono(tbl, p64->mono[j].var, p64->mono[j].coeff == 1, v);
+    }
+    break;
+
+  case BV_POLY:
+    bp = tbl->desc[i].ptr;
+    n = bp->nterms;
+    w = (bp->bitsize + 31) >> 5;
+    for (j=0; j<n; j++) {
+      pp_dag_add_mono(tbl, bp->mono[j].var, bvconst_is_one(bp->mono[j].coeff, w), v);
+    }
+    break;
+
+  default:
+    // atomic terms
+    break;
+  }
+
+  // keep the term indices, except true/false which are printed directly
+  m = 0;
+  for (j=0; j<v->size; j++) {
+    if (index_of(v->data[j]) != bool_const) {
+      v->data[m] = index_of(v->data[j]);
+      m ++;
+    }
+  }
+  ivector_shrink(v, m);
+}
+
+/*
+ * Explore the DAG rooted at term index i: compute count, size, and
+ * the HAS_VAR flag of all the nodes, and store them in post-order.
+ *
+ * A node can be pushed on the stack more than once: it's expanded
+ * the first time it's on top of the stack. It's done when it's on
+ * top again, after all its children.
+ */
+static void pp_dag_explore(pp_dag_t *dag, term_table_t *tbl, int32_t i) {
+  ivector_t *v;
+  int32_t k, c, size, flags;
+  uint32_t n;
+
+  v = &dag->children;
+  ivector_push(&dag->stack, pp_dag_node(dag, i));
+
+  while (dag->stack.size > 0) {
+    k = ivector_last(&dag->stack);
+    flags = dag->flags.data[k];
+    i = dag->idx.data[k];
+
+    if (flags & PP_DAG_DONE) {
+      ivector_pop(&dag->stack);
+
+    } else if (flags & PP_DAG_EXPANDED) {
+      ivector_pop(&dag->stack);
+      size = 1;
+      if (tbl->kind[i] == VARIABLE) {
+        flags |= PP_DAG_HAS_VAR;
+      }
+      pp_dag_children(tbl, i, v);
+      for (n=0; n<v->size; n++) {
+        c = int_hmap_find(&dag->map, v->data[n])->val;
+        assert(dag->flags.data[c] & PP_DAG_DONE);
+        size += dag->size.data[c];
+        if (size > PP_DAG_THRESHOLD) size = PP_DAG_THRESHOLD;
+        flags |= dag->flags.data[c] & PP_DAG_HAS_VAR;
+      }
+      dag->size.data[k] = size;
+      dag->flags.data[k] = flags | PP_DAG_DONE;
+      ivector_push(&dag->order, k);
+
+    } else {
+      dag->flags.data[k] = flags | PP_DAG_EXPANDED;
+      pp_dag_children(tbl, i, v);
+      for (n=0; n<v->size; n++) {
+        c = pp_dag_node(dag, v->data[n]);
+        dag->count.data[c] ++;
+        if ((dag->flags.data[c] & PP_DAG_DONE) == 0) {
+          ivector_push(&dag->stack, c);
+        }
+      }
+    }
+  }
+}
+
+/*
+ * Select the nodes to bind and compute their levels.
+ * - the bound nodes are numbered 1, 2, ... in increasing level order:
+ *   the map gives the let variable of their term index on return
+ * - the nodes that are not bound are removed from the map
+ * - return the max level
+ */
+static uint32_t pp_dag_bind(pp_dag_t *dag, term_table_t *tbl) {
+  ivector_t *v;
+  int32_t *first;
+  int32_t k, c, level, flags;
+  uint32_t i, n, max_level;
+
+  v = &dag->children;
+  max_level = 0;
+
+  for (i=0; i<dag->order.size; i++) {
+    k = dag->order.data[i];
+    flags = dag->flags.data[k];
+    level = 0;
+    pp_dag_children(tbl, dag->idx.data[k], v);
+    for (n=0; n<v->size; n++) {
+      c = int_hmap_find(&dag->map, v->data[n])->val;
+      if (dag->level.data[c] > level) level = dag->level.data[c];
+    }
+    if (dag->count.data[k] > 1 && dag->size.data[k] >= PP_DAG_THRESHOLD &&
+        (flags & PP_DAG_HAS_VAR) == 0) {
+      level ++;
+      dag->flags.data[k] = flags | PP_DAG_BOUND;
+      if (level > max_level) max_level = (uint32_t) level;
+    }
+    dag->level.data[k] = level;
+  }
+
+  if (max_level == 0) {
+    return 0;
+  }
+
+  /*
+   * Counting sort of the bound nodes by level: first[l] = number of
+   * bound nodes of level < l. The let variables are 1, 2, ...
+   */
+  first = (int32_t *) safe_malloc((max_level + 2) * sizeof(int32_t));
+  for (i=0; i<= max_level+1; i++) {
+    first[i] = 0;
+  }
+  for (i=0; i<dag->order.size; i++) {
+    k = dag->order.data[i];
+    if (dag->flags.data[k] & PP_DAG_BOUND) {
+      first[dag->level.data[k] + 1] ++;
+    }
+  }
+  for (i=1; i<=max_level+1; i++) {
+    first[i] += first[i-1];
+  }
+  for (i=0; i<dag->order.size; i++) {
+    k = dag->order.data[i];
+    if (dag->flags.data[k] & PP_DAG_BOUND) {
+      level = dag->level.data[k];
+      first[level] ++;
+      int_hmap_find(&dag->map, dag->idx.data[k])->val = first[level];
+    } else {
+      int_hmap_erase(&dag->map, int_hmap_find(&dag->map, dag->idx.data[k]));
+    }
+  }
+  safe_free(first);
+
+  return max_level;
+}
+
+/*
+ * Print the bindings of level l:
+ *   (let ((let!k term) ...)
+ * the let block is left open for the body.
+ */
+static void pp_dag_let(yices_pp_t *printer, term_table_t *tbl, pp_dag_t *dag, int32_t l) {
+  int32_t k, i;
+  uint32_t j;
+
+  pp_open_block(printer, PP_OPEN_LET);
+  pp_open_block(printer, PP_OPEN_VPAR);
+  for (j=0; j<dag->order.size; j++) {
+    k = dag->order.data[j];
+    if ((dag->flags.data[k] & PP_DAG_BOUND) && dag->level.data[k] == l) {
+      i = dag->idx.data[k];
+      pp_open_block(printer, PP_OPEN_PAR);
+      pp_id(printer, "let!", int_hmap_find(&dag->map, i)->val);
+      pp_term_idx(printer, tbl, i, INT32_MAX, true);
+      pp_close_block(printer, true);
+    }
+  }
+  pp_close_block(printer, true);
+  printer->let_depth ++;
+}
+
+/*
+ * Expand everything but introduce let variables for shared subterms
+ */
+void pp_term_dag(yices_pp_t *printer, term_table_t *tbl, term_t t) {
+  pp_dag_t dag;
+  uint32_t l, n;
+
+  assert(good_term(tbl, t));
+
+  if (t <= false_term || printer->let_names != NULL) {
+    pp_term_recur(printer, tbl, t, INT32_MAX, true);
+    return;
+  }
+
+  init_pp_dag(&dag);
+  pp_dag_explore(&dag, tbl, index_of(t));
+  n = pp_dag_bind(&dag, tbl);
+
+  if (n == 0) {
+    pp_term_recur(printer, tbl, t, INT32_MAX, true);
+  } else {
+    printer->let_names = &dag.map;
+    for (l=1; l<=n; l++) {
+      pp_dag_let(printer, tbl, &dag, l);
+    }
+    pp_term_recur(printer, tbl, t, INT32_MAX, true);
+    for (l=1; l<=n; l++) {
+      pp_close_block(printer, true);
+    }
+    printer->let_names = NULL;
+    printer->let_depth = 0;
+  }
+
+  delete_pp_dag(&dag);
+}
+
+
 /*
  * Term definition: same as pp_term_exp, except that uninterpreted constants,
  * variables, and constants of scalar types are treated differently.
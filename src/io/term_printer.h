@@ -109,6 +109,19 @@ extern void pp_term(yices_pp_t *printer, term_table_t *tbl, term_t t);
 extern void pp_term_full(yices_pp_t *printer, term_table_t *tbl, term_t t);
 
 
+/*
+ * Fully expanded term with let-introduction:
+ * - a subterm that occurs more than once in t and whose expanded tree
+ *   has at least PP_DAG_THRESHOLD nodes is bound to a let variable
+ *   (let!1, let!2, ...). Subterms that contain variables are not.
+ * - the output size is linear in the size of the DAG rooted at t.
+ * - if nothing is shared, this prints the same thing as pp_term_full.
+ */
+#define PP_DAG_THRESHOLD 16
+
+extern void pp_term_dag(yices_pp_t *printer, term_table_t *tbl, term_t t);
+
+
 /*
  * Pretty print a term table
  */
@@ -161,7 +161,7 @@ static const pp_standard_block_t standard_block[NUM_STANDARD_BLOCKS] = {
 /*
  * Table of non-standard blocks
  */
-#define NUM_NONSTANDARD_BLOCKS 15
+#define NUM_NONSTANDARD_BLOCKS 16
 
 static const pp_nonstandard_block_t nonstandard_block[NUM_NONSTANDARD_BLOCKS] = {
   { PP_OPEN, "", PP_HMT_LAYOUT, 0, 1, 1 },
@@ -174,6 +174,7 @@ static const pp_nonstandard_block_t nonstandard_block[NUM_NONSTANDARD_BLOCKS] =
   { PP_OPEN_FORALL, "forall ", PP_HMT_LAYOUT, 0, 7, 7 },
   { PP_OPEN_EXISTS, "exists ", PP_HMT_LAYOUT, 0, 7, 7 },
   { PP_OPEN_LAMBDA, "lambda ", PP_HMT_LAYOUT, 0, 7, 7 },
+  { PP_OPEN_LET, "let", PP_V_LAYOUT, PP_TOKEN_DEF_MASK, 0, 0 },
   { PP_OPEN_FUNCTION, "function ", PP_V_LAYOUT, PP_TOKEN_PAR_MASK, 1, 1 },
   { PP_OPEN_SMT2_BV_DEC, "_ bv", PP_H_LAYOUT, PP_TOKEN_PAR_MASK, 0, 0 },
   { PP_OPEN_SMT2_BV_TYPE, "_ BitVec", PP_H_LAYOUT, PP_TOKEN_DEF_MASK, 0, 0},
@@ -229,6 +230,12 @@ void init_yices_pp_tables(void) {
     open_desc[id].indent = d;
     open_desc[id].short_indent = s;
   }
+
+  /*
+   * The body of (let <bindings> <body>) is not indented so that
+   * nested lets don't drift to the right.
+   */
+  open_desc[PP_OPEN_LET].indent = 0;
 }
 
 
@@ -617,6 +624,8 @@ void init_yices_pp(yices_pp_t *printer, FILE *file, pp_area_t *area,
   printer->close[0] = init_close_token(&printer->close_nopar, false, PP_CLOSE);
   printer->close[1] = init_close_token(&printer->close_par, true, PP_CLOSE_PAR);
   init_string_buffer(&printer->buffer, 200);
+  printer->let_names = NULL;
+  printer->let_depth = 0;
 
   /*
    * initialize the converter structure
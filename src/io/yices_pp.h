@@ -30,6 +30,7 @@
 
 #include "io/pretty_printer.h"
 #include "terms/rationals.h"
+#include "utils/int_hash_map.h"
 #include "utils/object_stores.h"
 #include "utils/string_buffers.h"
 #include "model/concrete_values.h"
@@ -183,6 +184,7 @@ typedef enum {
   PP_OPEN_FORALL,
   PP_OPEN_EXISTS,
   PP_OPEN_LAMBDA,
+  PP_OPEN_LET,
   PP_OPEN_NOT,
   PP_OPEN_OR,
   PP_OPEN_AND,
@@ -276,6 +278,10 @@ typedef enum {
  * - atom_store: for allocation of atomic tokens
  * - two statically allocated close tokens
  * - a string buffer for conversion of atoms to strings
+ * - let_names: map from term indices to let variables when printing
+ *   terms with let-introduction (see pp_term_dag in term_printer.h).
+ *   NULL otherwise.
+ * - let_depth = number of enclosing let blocks
  */
 typedef struct yices_pp_s {
   pp_t pp;
@@ -285,6 +291,8 @@ typedef struct yices_pp_s {
   pp_close_token_t close_par;
   void *close[2];  // close[0] = nopar, close[1] = par
   string_buffer_t buffer;
+  int_hmap_t *let_names;
+  uint32_t let_depth;
 } yices_pp_t;
 
 
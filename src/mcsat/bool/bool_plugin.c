@@ -80,6 +80,12 @@ typedef struct {
   /** GC info for clause removal */
   gc_info_t gc_clauses;
 
+  /** Stamps of decision levels for LBD computation (level -> stamp) */
+  ivector_t lbd_levels;
+
+  /** Current LBD stamp */
+  uint32_t lbd_stamp;
+
   struct {
 
     /** Score increase per bump (multiplicative) */
@@ -94,6 +100,11 @@ typedef struct {
     /** Increase of the lemma limit after gc */
     float lemma_limit_factor;
 
+    /** Lemmas with LBD up to this are kept forever (core) */
+    uint32_t lemma_core_lbd;
+    /** Lemmas with LBD up to this are kept if used since last gc (tier2) */
+    uint32_t lemma_tier2_lbd;
+
   } heuristic_params;
 
   struct {
@@ -101,6 +112,7 @@ typedef struct {
     statistic_int_t* conflicts;
     statistic_int_t* clauses_attached;
     statistic_int_t* clauses_attached_binary;
+    statistic_int_t* lemmas_core;
   } stats;
 
   /** Exception handler */
@@ -114,6 +126,7 @@ void bool_plugin_stats_init(bool_plugin_t* bp) {
   bp->stats.conflicts = statistics_new_int(bp->ctx->stats, "mcsat::bool::conflicts");
   bp->stats.clauses_attached = statistics_new_int(bp->ctx->stats, "mcsat::bool::clauses_attached");
   bp->stats.clauses_attached_binary = statistics_new_int(bp->ctx->stats, "mcsat::bool::clauses_attached_binary");
+  bp->stats.lemmas_core = statistics_new_int(bp->ctx->stats, "mcsat::bool::lemmas_core");
 }
 
 static
@@ -126,6 +139,10 @@ void bool_plugin_heuristics_init(bool_plugin_t* bp) {
   // Clause database compact
   bp->heuristic_params.lemma_limit_init = 1000;
   bp->heuristic_params.lemma_limit_factor = 1.02;
+
+  // Lemma tiers
+  bp->heuristic_params.lemma_core_lbd = 2;
+  bp->heuristic_params.lemma_tier2_lbd = 6;
 }
 
 static
@@ -142,6 +159,8 @@ void bool_plugin_construct(plugin_t* plugin, plugin_context_t* ctx) {
   bcp_watch_manager_construct(&bp->wlm);
   init_ivector(&bp->reason, 0);
   init_ivector(&bp->propagated, 0);
+  init_ivector(&bp->lbd_levels, 0);
+  bp->lbd_stamp = 0;
 
   bp->trail_i = 0;
   bp->propagated_size = 0;
@@ -175,6 +194,7 @@ void bool_plugin_destruct(plugin_t* plugin) {
   delete_ivector(&bp->clauses_to_repropagate); // BD: fixed memory leak
   delete_ivector(&bp->reason);
   delete_ivector(&bp->propagated);
+  delete_ivector(&bp->lbd_levels);
   scope_holder_destruct(&bp->scope);
   // DESTRUCTED ON DEMAND: gc_info_destruct(&bp->gc_clauses);
 }
@@ -209,12 +229,54 @@ void bool_plugin_new_term_notify(plugin_t* plugin, term_t term, trail_token_t* p
 
 }
 
+/**
+ * Compute the LBD of the clause, i.e. the number of distinct decision levels
+ * of the literals. All unassigned literals count as one extra level.
+ */
+static
+uint32_t bool_plugin_compute_lbd(bool_plugin_t* bp, const mcsat_clause_t* clause) {
+  uint32_t i, level, lbd = 0;
+  bool unassigned = false;
+  variable_t x;
+  const mcsat_trail_t* trail = bp->ctx->trail;
+
+  // New stamp (reset on overflow)
+  bp->lbd_stamp ++;
+  if (bp->lbd_stamp == 0) {
+    ivector_reset(&bp->lbd_levels);
+    bp->lbd_stamp = 1;
+  }
+
+  for (i = 0; i < clause->size; ++ i) {
+    x = literal_get_variable(clause->literals[i]);
+    if (!trail_has_value(trail, x)) {
+      unassigned = true;
+      continue;
+    }
+    level = trail_get_level(trail, x);
+    while (bp->lbd_levels.size <= level) {
+      ivector_push(&bp->lbd_levels, 0);
+    }
+    if (bp->lbd_levels.data[level] != bp->lbd_stamp) {
+      bp->lbd_levels.data[level] = bp->lbd_stamp;
+      lbd ++;
+    }
+  }
+
+  if (unassigned) {
+    lbd ++;
+  }
+
+  return lbd;
+}
+
 static
 void bool_plugin_new_lemma_notify(plugin_t* plugin, ivector_t* lemma, trail_token_t* prop) {
   bool_plugin_t* bp = (bool_plugin_t*) plugin;
 
   uint32_t i;
   clause_ref_t clause_ref;
+  mcsat_tagged_clause_t* clause;
 
   // Convert to CNF
   i = bp->clauses_to_add.size;
@@ -225,6 +287,14 @@ void bool_plugin_new_lemma_notify(plugin_t* plugin, ivector_t* lemma, trail_toke
     clause_ref = bp->clauses_to_add.data[i];
     assert(clause_db_is_clause(&bp->clause_db, clause_ref, true));
     ivector_push(&bp->lemmas, clause_ref);
+    // Compute the LBD while the literals are still assigned
+    clause = clause_db_get_tagged_clause(&bp->clause_db, clause_ref);
+    if (clause->tag.type == CLAUSE_LEMMA) {
+      clause->tag.lbd = bool_plugin_compute_lbd(bp, &clause->clause);
+      if (clause->tag.lbd <= bp->heuristic_params.lemma_core_lbd) {
+        (*bp->stats.lemmas_core) ++;
+      }
+    }
   }
 }
 
@@ -404,6 +474,17 @@ void bool_plugin_bump_clause(bool_plugin_t* bp, const mcsat_clause_t* clause) {
 
   tag = clause_get_tag(clause);
   if (tag->type == CLAUSE_LEMMA) {
+    // Mark as used, and update the LBD (all literals are assigned here)
+    tag->used = true;
+    if (tag->lbd > bp->heuristic_params.lemma_core_lbd) {
+      uint32_t lbd = bool_plugin_compute_lbd(bp, clause);
+      if (lbd < tag->lbd) {
+        if (lbd <= bp->heuristic_params.lemma_core_lbd) {
+          (*bp->stats.lemmas_core) ++;
+        }
+        tag->lbd = lbd;
+      }
+    }
     // Bump
     tag->score += bp->heuristic_params.clause_score_bump_factor;
     // If over the limit, normalize
@@ -720,19 +801,16 @@ void bool_plugin_get_conflict(plugin_t* plugin, ivector_t* conflict) {
   }
 }
 
-term_t bool_plugin_explain_propagation(plugin_t* plugin, variable_t var, ivector_t* reasons) {
-  bool_plugin_t* bp = (bool_plugin_t*) plugin;
+/** Add the negations of the other literals in the reason clause of var to reasons */
+static
+const mcsat_clause_t* bool_plugin_add_reason_literals(bool_plugin_t* bp, variable_t var, ivector_t* reasons) {
 
   uint32_t i;
   mcsat_literal_t l_i;
   variable_t x_i;
   term_t t_i;
-  bool var_value;
   const mcsat_clause_t* clause;
 
-  // Add the other literals from the clause as explanations
-  assert(trail_has_value(bp->ctx->trail, var));
-  var_value = trail_get_value(bp->ctx->trail, var)->b;
   clause = bool_plugin_get_reason(bp, var);
   assert(clause->size == 2 || literal_get_variable(clause->literals[0]) == var);
   // Start from 0 to cover the binary clause case
@@ -748,9 +826,30 @@ term_t bool_plugin_explain_propagation(plugin_t* plugin, variable_t var, ivector
       t_i = opposite_term(t_i);
     }
     ivector_push(reasons, opposite_term(t_i));
+  }
+
+  return clause;
+}
+
+term_t bool_plugin_explain_propagation(plugin_t* plugin, variable_t var, ivector_t* reasons) {
+  bool_plugin_t* bp = (bool_plugin_t*) plugin;
+
+  uint32_t i;
+  variable_t x_i;
+  bool var_value;
+  const mcsat_clause_t* clause;
+
+  // Add the other literals from the clause as explanations
+  assert(trail_has_value(bp->ctx->trail, var));
+  var_value = trail_get_value(bp->ctx->trail, var)->b;
+  clause = bool_plugin_add_reason_literals(bp, var, reasons);
 
-    // Bump the reason variable
-    bp->ctx->bump_variable(bp->ctx, x_i);
+  // Bump the reason variables
+  for (i = 0; i < clause->size; ++ i) {
+    x_i = literal_get_variable(clause->literals[i]);
+    if (x_i != var) {
+      bp->ctx->bump_variable(bp->ctx, x_i);
+    }
   }
 
   // Bump the clause as useful
@@ -759,6 +858,12 @@ term_t bool_plugin_explain_propagation(plugin_t* plugin, variable_t var, ivector
   return bool2term(var_value);
 }
 
+void bool_plugin_get_reason_literals(plugin_t* plugin, variable_t var, ivector_t* reasons) {
+  bool_plugin_t* bp = (bool_plugin_t*) plugin;
+  assert(trail_has_value(bp->ctx->trail, var));
+  bool_plugin_add_reason_literals(bp, var, reasons);
+}
+
 bool bool_plugin_explain_evaluation(plugin_t* plugin, term_t t, int_mset_t* vars, mcsat_value_t* value) {
 
   bool_plugin_t* bp = (bool_plugin_t*) plugin;
@@ -863,21 +968,44 @@ void bool_plugin_gc_mark(plugin_t* plugin, gc_info_t* gc_vars) {
   uint32_t i;
   variable_t var;
   clause_ref_t clause_ref;
+  mcsat_clause_tag_t* tag;
+  ivector_t local;
 
   if (gc_vars->level == 0) {
 
     // Construct the gc info (destructed in collect())
     gc_info_construct(&bp->gc_clauses, clause_ref_null, false);
 
-    // Sort the lemmas based on scores
-    int_array_sort2(bp->lemmas.data, bp->lemmas.size, (void*) db, bool_plugin_clause_compare_for_removal);
-
-    // Mark all the variables in half of lemmas as used
-    for (i = 0; i < bp->lemmas.size / 2; ++ i) {
+    // Keep the core lemmas, and the tier2 lemmas that were used since last
+    // gc. The rest are local lemmas.
+    init_ivector(&local, 0);
+    for (i = 0; i < bp->lemmas.size; ++ i) {
       clause_ref = bp->lemmas.data[i];
       assert(clause_db_is_clause(db, clause_ref, true));
+      tag = clause_db_get_tag(db, clause_ref);
+      if (tag->type != CLAUSE_LEMMA) {
+        gc_info_mark(&bp->gc_clauses, clause_ref);
+        continue;
+      }
+      if (tag->lbd <= bp->heuristic_params.lemma_core_lbd) {
+        gc_info_mark(&bp->gc_clauses, clause_ref);
+      } else if (tag->lbd <= bp->heuristic_params.lemma_tier2_lbd && tag->used) {
+        gc_info_mark(&bp->gc_clauses, clause_ref);
+      } else {
+        ivector_push(&local, clause_ref);
+      }
+      tag->used = false;
+    }
+
+    // Sort the local lemmas based on scores
+    int_array_sort2(local.data, local.size, (void*) db, bool_plugin_clause_compare_for_removal);
+
+    // Mark all the variables in half of local lemmas as used
+    for (i = 0; i < local.size / 2; ++ i) {
+      clause_ref = local.data[i];
       gc_info_mark(&bp->gc_clauses, clause_ref);
     }
+    delete_ivector(&local);
 
     // We also keep the clauses of any propagated literals
     for (i = 0; i < bp->propagated.size; ++ i) {
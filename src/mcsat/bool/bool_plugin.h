@@ -24,4 +24,11 @@
 /** Allocate a new bool plugin and setup the plugin-interface method */
 plugin_t* bool_plugin_allocator(void);
 
+/**
+ * Get the reasons of a variable propagated by the bool plugin, i.e. the
+ * negations of the other literals of the propagating clause. Unlike
+ * explain_propagation, this does not bump the clause and the variables.
+ */
+void bool_plugin_get_reason_literals(plugin_t* plugin, variable_t var, ivector_t* reasons);
+
 #endif /* BOOL_PLUGIN_H_ */
@@ -51,8 +51,15 @@ typedef struct {
   union {
     /** The variable that is defined */
     variable_t var;
-    /** The score of the variable */
-    float score;
+    /** Lemma information */
+    struct {
+      /** The score of the lemma */
+      float score;
+      /** Number of distinct decision levels in the lemma (LBD) */
+      uint32_t lbd;
+      /** Whether the lemma was used since the last gc */
+      uint32_t used;
+    };
   };
 
 } mcsat_clause_tag_t;
@@ -60,7 +67,7 @@ typedef struct {
 /**
  * A tagged clause is a clause with additional information. For definitional
  * clauses we keep the variable that is being defined, and for the lemma
- * clauses we keep the score of the clause.
+ * clauses we keep the score and the LBD of the clause.
  */
 typedef struct {
 
@@ -86,6 +86,10 @@ CUDD* bdds_new() {
   return cudd;
 }
 
+uint32_t bdds_peak_node_count(CUDD* cudd) {
+  return Cudd_ReadPeakNodeCount(cudd->cudd);
+}
+
 void bdds_delete(CUDD* cudd) {
   int leaks = Cudd_CheckZeroRef(cudd->cudd);
   (void) leaks;
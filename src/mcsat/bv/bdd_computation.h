@@ -65,6 +65,9 @@ void bdds_copy(BDD** out, BDD** a, uint32_t n);
 /** Compare the two BDD vectors. */
 bool bdds_eq(BDD** a, BDD** b, uint32_t n);
 
+/** Get the peak number of BDD nodes in the manager. */
+uint32_t bdds_peak_node_count(CUDD* cudd);
+
 /** Print the BDDs to out. */
 void bdds_print(CUDD* cudd, BDD** a, uint32_t n, FILE* out);
 
@@ -1155,6 +1155,10 @@ bool bv_bdd_manager_is_model(bv_bdd_manager_t* bddm, term_t x, bdd_t bdd, const
   return bdds_is_model(bddm->cudd, x_bdds, (BDD*) bdd.bdd[0], x_value);
 }
 
+uint32_t bv_bdd_manager_peak_node_count(const bv_bdd_manager_t* bddm) {
+  return bdds_peak_node_count(bddm->cudd);
+}
+
 void bv_bdd_manager_mark_terms(bv_bdd_manager_t* bddm) {
   uint32_t i;
   for (i = 0; i < bddm->term_list.size; ++ i) {
@@ -132,5 +132,8 @@ bool bv_bdd_manager_bdd_is_point(const bv_bdd_manager_t* bddm, bdd_t bdd, uint32
 /** Intersect the two BDDs (result attached) */
 bdd_t bv_bdd_manager_bdd_intersect(bv_bdd_manager_t* bddm, bdd_t bdd1, bdd_t bdd2);
 
+/** Get the peak number of BDD nodes */
+uint32_t bv_bdd_manager_peak_node_count(const bv_bdd_manager_t* bddm);
+
 /** Mark all the terms in the term manager */
 void bv_bdd_manager_mark_terms(bv_bdd_manager_t* bddm);
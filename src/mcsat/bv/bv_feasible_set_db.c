@@ -497,6 +497,64 @@ void bv_feasible_set_quickxplain(const bv_feasible_set_db_t* db, bdd_t current,
   bv_bdd_manager_bdd_detach(bddm, feasible_B);
 }
 
+/**
+ * Greedy cover of the conflict: pick reasons until the intersection is empty
+ * (or excludes the value). At each step we take a witness from the current
+ * intersection (or the value) and add the first reason that excludes it. Not
+ * used for singletons, since there a single witness doesn't tell us anything.
+ */
+static
+void bv_feasible_set_greedy_cover(const bv_feasible_set_db_t* db, const ivector_t* reasons, ivector_t* out, bv_feasible_explain_mode_t mode, term_t x, const bvconstant_t* x_value, uint32_t bitsize) {
+
+  uint32_t i;
+  bv_bdd_manager_t* bddm = db->bddm;
+
+  assert(mode == EXPLAIN_EMPTY || mode == EXPLAIN_ASSUMPTION);
+
+  bdd_t S = bv_bdd_manager_true(bddm);
+  bv_bdd_manager_bdd_attach(bddm, S);
+
+  bvconstant_t witness;
+  init_bvconstant(&witness);
+  bvconstant_set_all_zero(&witness, bitsize);
+
+  for (;;) {
+    // Check if we're done and get the witness
+    if (mode == EXPLAIN_EMPTY) {
+      if (bv_bdd_manager_bdd_is_empty(bddm, S)) {
+        break;
+      }
+      bv_bdd_manager_pick_value(bddm, x, S, &witness);
+    } else {
+      if (!bv_bdd_manager_is_model(bddm, x, S, x_value)) {
+        break;
+      }
+      bvconstant_copy(&witness, bitsize, x_value->data);
+    }
+    // First reason that excludes it
+    for (i = 0; i < reasons->size; ++ i) {
+      bdd_t feasible_i = db->memory[reasons->data[i]].reason_feasible_set;
+      if (!bv_bdd_manager_is_model(bddm, x, feasible_i, &witness)) {
+        break;
+      }
+    }
+    if (i == reasons->size) {
+      // Not a conflict, shouldn't happen, but keep all reasons to be safe
+      assert(false);
+      ivector_reset(out);
+      ivector_add(out, reasons->data, reasons->size);
+      break;
+    }
+    ivector_push(out, reasons->data[i]);
+    bdd_t intersect = bv_bdd_manager_bdd_intersect(bddm, S, db->memory[reasons->data[i]].reason_feasible_set);
+    bdd_swap(&intersect, &S);
+    bv_bdd_manager_bdd_detach(bddm, intersect);
+  }
+
+  delete_bvconstant(&witness);
+  bv_bdd_manager_bdd_detach(bddm, S);
+}
+
 /** Compare variables for picking the best explanation */
 static
 bool bv_feasible_set_compare_reasons(void *bv_feasible_set_db_ptr, int32_t r1, int32_t r2) {
@@ -591,9 +649,14 @@ void bv_feasible_set_filter_reason_indices(const bv_feasible_set_db_t* db, ivect
     }
   }
 
-  // Minimize the core
+  // Minimize the core (get a small one greedily first, if possible)
   ivector_t out;
   init_ivector(&out, 0);
+  if (mode != EXPLAIN_SINGLETON) {
+    bv_feasible_set_greedy_cover(db, reasons_indices, &out, mode, x_term, x_value, bitsize);
+    ivector_swap(reasons_indices, &out);
+    ivector_reset(&out);
+  }
   bdd_t bdd_true = bv_bdd_manager_true(db->bddm);
   bv_feasible_set_quickxplain(db, bdd_true, reasons_indices, 0, reasons_indices->size, &out, mode, x_term, x_value, bitsize);
   ivector_swap(reasons_indices, &out);
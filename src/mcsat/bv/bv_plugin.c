@@ -23,6 +23,7 @@
 #include "bv_evaluator.h"
 #include "bv_explainer.h"
 #include "bv_utils.h"
+#include "bv_word_domain.h"
 
 #include "mcsat/trail.h"
 #include "mcsat/tracing.h"
@@ -116,11 +117,32 @@ typedef struct {
   /** Heap for term traversal order */
   generic_heap_t visit_heap;
 
+  /**
+   * Unit constraints on wide variables that were not turned into BDDs, kept
+   * as triples (constraint, variable, previous). These are simple constraints
+   * that are taken into account by word-level domains when deciding. The
+   * triples of a variable form a list through previous (index of the previous
+   * triple of the same variable, or -1).
+   */
+  ivector_t word_constraints;
+
+  /** Map from variables to the index of their last word constraint triple */
+  int_hmap_t word_constraints_last;
+
+  /** Size of word constraints (for backtracking) */
+  uint32_t word_constraints_size;
+
+  /** Value picked by the word-level domains */
+  mcsat_value_t word_value;
+
   struct {
     statistic_int_t* conflicts;
     statistic_int_t* propagations;
     statistic_int_t* evaluations;
     statistic_int_t* constraints_attached;
+    statistic_int_t* word_constraints;
+    statistic_int_t* word_decisions;
+    statistic_int_t* bdd_peak_nodes;
   } stats;
 
 } bv_plugin_t;
@@ -167,6 +189,11 @@ void bv_plugin_construct(plugin_t* plugin, plugin_context_t* ctx) {
   init_int_hmap(&bv->visited_cache, 0);
   init_generic_heap(&bv->visit_heap, 0, 0, term_visit_cmp, NULL);
 
+  init_ivector(&bv->word_constraints, 0);
+  init_int_hmap(&bv->word_constraints_last, 0);
+  bv->word_constraints_size = 0;
+  mcsat_value_construct_default(&bv->word_value);
+
   // Terms
   ctx->request_term_notification_by_kind(ctx, BV_ARRAY, false);
   ctx->request_term_notification_by_kind(ctx, BV_DIV, false);
@@ -198,6 +225,9 @@ void bv_plugin_construct(plugin_t* plugin, plugin_context_t* ctx) {
   bv->stats.propagations = statistics_new_int(bv->ctx->stats, "mcsat::bv::propagations");
   bv->stats.evaluations = statistics_new_int(bv->ctx->stats, "mcsat::bv::evaluations");
   bv->stats.constraints_attached = statistics_new_int(bv->ctx->stats, "mcsat::bv::constraints_attached");
+  bv->stats.word_constraints = statistics_new_int(bv->ctx->stats, "mcsat::bv::word_constraints");
+  bv->stats.word_decisions = statistics_new_int(bv->ctx->stats, "mcsat::bv::word_decisions");
+  bv->stats.bdd_peak_nodes = statistics_new_int(bv->ctx->stats, "mcsat::bv::bdd_peak_nodes");
 }
 
 static
@@ -220,6 +250,9 @@ void bv_plugin_destruct(plugin_t* plugin) {
   delete_ivector(&bv->processed_variables);
   delete_int_hmap(&bv->visited_cache);
   delete_generic_heap(&bv->visit_heap);
+  delete_ivector(&bv->word_constraints);
+  delete_int_hmap(&bv->word_constraints_last);
+  mcsat_value_destruct(&bv->word_value);
 }
 
 
@@ -233,6 +266,13 @@ bool bv_plugin_has_assignment(const bv_plugin_t* bv, variable_t x) {
   return trail_has_value(bv->ctx->trail, x) && trail_get_index(bv->ctx->trail, x) < bv->trail_i;
 }
 
+/** Check if the unit constraints on variables of this size go to BDDs */
+static inline
+bool bv_plugin_use_bdd(const bv_plugin_t* bv, uint32_t bitsize) {
+  int32_t max_size = bv->ctx->options->bv_bdd_max_size;
+  return max_size < 0 || bitsize <= (uint32_t) max_size;
+}
+
 /**
  * Setting status of constraint: if value is CONSTRAINT_UNIT, then unit_var is the variable in which constraint is unit;
  * otherwise unit_var is variable_null
@@ -693,9 +733,22 @@ void bv_plugin_process_unit_constraint(bv_plugin_t* bv, trail_token_t* prop, var
   if (!constraint_value) { cstr_term = opposite_term(cstr_term); }
   term_t x_term = variable_db_get_term(var_db, x);
 
+  // Simple constraints on wide variables are left to the word-level domains
+  if (!bv_plugin_use_bdd(bv, bv_term_bitsize(ctx->terms, x_term)) && bv_word_domain_supports(ctx, cstr_term, x_term)) {
+    int_hmap_pair_t* last = int_hmap_get(&bv->word_constraints_last, x);
+    ivector_push(&bv->word_constraints, cstr);
+    ivector_push(&bv->word_constraints, x);
+    ivector_push(&bv->word_constraints, last->val);
+    last->val = bv->word_constraints_size;
+    bv->word_constraints_size += 3;
+    (*bv->stats.word_constraints) ++;
+    return;
+  }
+
   // Get the BDD of the constraint
   bdd_t cstr_bdd = bv_bdd_manager_get_bdd(bddm, cstr_term, x_term);
   assert(cstr_bdd.bdd[0] != NULL);
+  *bv->stats.bdd_peak_nodes = bv_bdd_manager_peak_node_count(bddm);
 
   // Update the feasible intervals
   bool feasible = bv_feasible_set_db_update(bv->feasible, x, cstr_bdd, &cstr, 1);
@@ -1001,6 +1054,7 @@ void bv_plugin_push(plugin_t* plugin) {
   scope_holder_push(&bv->scope,
       &bv->trail_i,
       &bv->processed_variables_size,
+      &bv->word_constraints_size,
       NULL);
 
   // Push the feasibility information
@@ -1022,8 +1076,22 @@ void bv_plugin_pop(plugin_t* plugin) {
   scope_holder_pop(&bv->scope,
       &bv->trail_i,
       &bv->processed_variables_size,
+      &bv->word_constraints_size,
       NULL);
 
+  // Undo the word constraints (last first, so each one is the last of its variable)
+  while (bv->word_constraints.size > bv->word_constraints_size) {
+    uint32_t i = bv->word_constraints.size - 3;
+    int_hmap_pair_t* last = int_hmap_find(&bv->word_constraints_last, bv->word_constraints.data[i + 1]);
+    assert(last != NULL && last->val == (int32_t) i);
+    if (bv->word_constraints.data[i + 2] < 0) {
+      int_hmap_erase(&bv->word_constraints_last, last);
+    } else {
+      last->val = bv->word_constraints.data[i + 2];
+    }
+    ivector_shrink(&bv->word_constraints, i);
+  }
+
   // Undo the processed variables
   while (bv->processed_variables.size > bv->processed_variables_size) {
     // The variable to undo
@@ -1065,12 +1133,130 @@ void bv_plugin_pop(plugin_t* plugin) {
 }
 
 
+/** Index of the last word constraint triple on x, or -1 if there are none */
+static
+int32_t bv_plugin_word_constraints_last(const bv_plugin_t* bv, variable_t x) {
+  int_hmap_pair_t* last = int_hmap_find(&bv->word_constraints_last, x);
+  return last == NULL ? -1 : last->val;
+}
+
+/** Check if there are any word constraints on x */
+static
+bool bv_plugin_has_word_constraints(const bv_plugin_t* bv, variable_t x) {
+  return bv_plugin_word_constraints_last(bv, x) >= 0;
+}
+
+/**
+ * Pick a value for x from its word-level domain, that is also in the feasible
+ * set of x. Returns NULL if no such value was found.
+ */
+static
+const mcsat_value_t* bv_plugin_word_pick_value(bv_plugin_t* bv, variable_t x) {
+
+  int32_t i;
+  plugin_context_t* ctx = bv->ctx;
+  const mcsat_trail_t* trail = ctx->trail;
+
+  term_t x_term = variable_db_get_term(ctx->var_db, x);
+  uint32_t x_bitsize = bv_term_bitsize(ctx->terms, x_term);
+
+  // Construct the domain
+  bv_word_domain_t domain;
+  bv_word_domain_construct(&domain, x_bitsize);
+  for (i = bv_plugin_word_constraints_last(bv, x); i >= 0; i = bv->word_constraints.data[i + 2]) {
+    variable_t cstr = bv->word_constraints.data[i];
+    assert(bv->word_constraints.data[i + 1] == x);
+    term_t cstr_term = variable_db_get_term(ctx->var_db, cstr);
+    if (!trail_get_boolean_value(trail, cstr)) { cstr_term = opposite_term(cstr_term); }
+    if (!bv_word_domain_add(&domain, ctx, cstr_term, x_term)) {
+      break;
+    }
+  }
+
+  // Use the cached value as a hint
+  const bvconstant_t* hint = NULL;
+  if (trail_has_cached_value(trail, x)) {
+    const mcsat_value_t* cached_value = trail_get_cached_value(trail, x);
+    if (cached_value->type == VALUE_BV && cached_value->bv_value.bitsize == x_bitsize) {
+      hint = &cached_value->bv_value;
+    }
+  }
+
+  // Pick the value and check the feasible set
+  const mcsat_value_t* result = NULL;
+  bvconstant_t value;
+  init_bvconstant(&value);
+  bvconstant_set_all_zero(&value, x_bitsize);
+  if (bv_word_domain_pick(&domain, hint, &value)) {
+    bdd_t feasible = bv_feasible_set_db_get(bv->feasible, x);
+    if (feasible.bdd[0] == NULL || bv_bdd_manager_is_model(bv->bddm, x_term, feasible, &value)) {
+      mcsat_value_destruct(&bv->word_value);
+      mcsat_value_construct_bv_value(&bv->word_value, &value);
+      result = &bv->word_value;
+    }
+  }
+  delete_bvconstant(&value);
+  bv_word_domain_destruct(&domain);
+
+  return result;
+}
+
+/**
+ * Add the BDDs of the word constraints on x to the feasible set. Returns false
+ * if the feasible set becomes empty.
+ */
+static
+bool bv_plugin_word_add_to_feasible(bv_plugin_t* bv, variable_t x) {
+
+  int32_t i;
+  plugin_context_t* ctx = bv->ctx;
+
+  term_t x_term = variable_db_get_term(ctx->var_db, x);
+  for (i = bv_plugin_word_constraints_last(bv, x); i >= 0; i = bv->word_constraints.data[i + 2]) {
+    variable_t cstr = bv->word_constraints.data[i];
+    assert(bv->word_constraints.data[i + 1] == x);
+    term_t cstr_term = variable_db_get_term(ctx->var_db, cstr);
+    if (!trail_get_boolean_value(ctx->trail, cstr)) { cstr_term = opposite_term(cstr_term); }
+    bdd_t cstr_bdd = bv_bdd_manager_get_bdd(bv->bddm, cstr_term, x_term);
+    if (!bv_feasible_set_db_update(bv->feasible, x, cstr_bdd, &cstr, 1)) {
+      return false;
+    }
+  }
+  *bv->stats.bdd_peak_nodes = bv_bdd_manager_peak_node_count(bv->bddm);
+
+  return true;
+}
+
 static
 void bv_plugin_decide(plugin_t* plugin, variable_t x, trail_token_t* decide, bool must) {
   bv_plugin_t* bv = (bv_plugin_t*) plugin;
 
   assert(!trail_has_value(bv->ctx->trail, x));
-  const mcsat_value_t* v = bv_feasible_set_db_pick_value(bv->feasible, x);;
+
+  // Try the word-level domain first, and if that fails, use the BDDs
+  const mcsat_value_t* v = NULL;
+  if (bv_plugin_has_word_constraints(bv, x)) {
+    v = bv_plugin_word_pick_value(bv, x);
+    if (v != NULL) {
+      (*bv->stats.word_decisions) ++;
+    } else if (!bv_plugin_word_add_to_feasible(bv, x)) {
+      // Empty feasible set: decide anything, and report the conflict
+      term_t x_term = variable_db_get_term(bv->ctx->var_db, x);
+      bvconstant_t zero;
+      init_bvconstant(&zero);
+      bvconstant_set_all_zero(&zero, bv_term_bitsize(bv->ctx->terms, x_term));
+      mcsat_value_destruct(&bv->word_value);
+      mcsat_value_construct_bv_value(&bv->word_value, &zero);
+      delete_bvconstant(&zero);
+      decide->add(decide, x, &bv->word_value);
+      bv->last_decided_and_unprocessed = x;
+      bv_plugin_report_conflict(bv, decide, x, BV_CONFLICT_UNIT);
+      return;
+    }
+  }
+  if (v == NULL) {
+    v = bv_feasible_set_db_pick_value(bv->feasible, x);
+  }
 
   if (ctx_trace_enabled(bv->ctx, "mcsat::bv::decide")) {
     ctx_trace_printf(bv->ctx, "bv_plugin_decide: ");
@@ -1332,6 +1518,13 @@ void bv_plugin_gc_mark(plugin_t* plugin, gc_info_t* gc_vars) {
   // - all the bitvector variables that are in use (bv->wlm)
   bv_feasible_set_db_gc_mark(bv->feasible, gc_vars);
   watch_list_manager_gc_mark(&bv->wlm, gc_vars);
+  if (gc_vars->level == 0) {
+    uint32_t i;
+    for (i = 0; i < bv->word_constraints.size; i += 3) {
+      gc_info_mark(gc_vars, bv->word_constraints.data[i]);
+      gc_info_mark(gc_vars, bv->word_constraints.data[i + 1]);
+    }
+  }
 }
 
 static
@@ -1381,6 +1574,12 @@ void bv_plugin_decide_assignment(plugin_t* plugin, variable_t x, const mcsat_val
   bv->last_decided_and_unprocessed = x;
   decide->add(decide, x, value);
 
+  // Word constraints are checked with the feasible set
+  if (bv_plugin_has_word_constraints(bv, x) && !bv_plugin_word_add_to_feasible(bv, x)) {
+    bv_plugin_report_conflict(bv, decide, x, BV_CONFLICT_UNIT);
+    return;
+  }
+
   // Get the feasibility set and check
   bdd_t feasible = bv_feasible_set_db_get(bv->feasible, x);
   term_t x_term = variable_db_get_term(bv->ctx->var_db, x);
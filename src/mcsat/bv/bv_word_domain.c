@@ -0,0 +1,334 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2019 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "bv_word_domain.h"
+
+#include "mcsat/trail.h"
+#include "mcsat/variable_db.h"
+#include "terms/terms.h"
+#include "utils/memalloc.h"
+
+/** Number of values to try when picking from the interval */
+#define BV_WORD_DOMAIN_PICK_TRIES 32
+
+typedef enum {
+  WORD_NONE,
+  WORD_EQ,    // x = c
+  WORD_NEQ,   // x != c
+  WORD_GE,    // x >= c
+  WORD_LT,    // x < c
+  WORD_LE,    // x <= c
+  WORD_GT,    // x > c
+  WORD_BIT,   // bit c of x is true
+  WORD_NBIT,  // bit c of x is false
+} word_constraint_kind_t;
+
+/** Get the value of a constant or an assigned variable */
+static
+bool bv_word_domain_get_value(const plugin_context_t* ctx, term_t t, bvconstant_t* out) {
+  term_table_t* terms = ctx->terms;
+  switch (term_kind(terms, t)) {
+  case BV64_CONSTANT: {
+    bvconst64_term_t* c = bvconst64_term_desc(terms, t);
+    bvconstant_copy64(out, c->bitsize, c->value);
+    return true;
+  }
+  case BV_CONSTANT: {
+    bvconst_term_t* c = bvconst_term_desc(terms, t);
+    bvconstant_copy(out, c->bitsize, c->data);
+    return true;
+  }
+  default: {
+    variable_t t_var = variable_db_get_variable_if_exists(ctx->var_db, t);
+    if (t_var != variable_null && trail_has_value(ctx->trail, t_var)) {
+      const mcsat_value_t* t_value = trail_get_value(ctx->trail, t_var);
+      if (t_value->type == VALUE_BV) {
+        bvconstant_copy(out, t_value->bv_value.bitsize, t_value->bv_value.data);
+        return true;
+      }
+    }
+    return false;
+  }
+  }
+}
+
+/**
+ * Get the kind of the constraint on x, and the value of the other side. For bit
+ * constraints the value is not touched and the index is returned in bit.
+ */
+static
+word_constraint_kind_t bv_word_domain_get_kind(const plugin_context_t* ctx, term_t cstr, term_t x, bvconstant_t* value, uint32_t* bit) {
+
+  term_table_t* terms = ctx->terms;
+  bool negated = is_neg_term(cstr);
+  term_t atom = unsigned_term(cstr);
+
+  switch (term_kind(terms, atom)) {
+  case BIT_TERM:
+    if (bit_term_arg(terms, atom) == x) {
+      *bit = bit_term_index(terms, atom);
+      return negated ? WORD_NBIT : WORD_BIT;
+    }
+    break;
+  case BV_EQ_ATOM: {
+    composite_term_t* eq = bveq_atom_desc(terms, atom);
+    term_t other = NULL_TERM;
+    if (eq->arg[0] == x && eq->arg[1] != x) {
+      other = eq->arg[1];
+    } else if (eq->arg[1] == x && eq->arg[0] != x) {
+      other = eq->arg[0];
+    }
+    if (other != NULL_TERM && bv_word_domain_get_value(ctx, other, value)) {
+      return negated ? WORD_NEQ : WORD_EQ;
+    }
+    break;
+  }
+  case BV_GE_ATOM: {
+    composite_term_t* ge = bvge_atom_desc(terms, atom);
+    if (ge->arg[0] == x && ge->arg[1] != x) {
+      // x >= c
+      if (bv_word_domain_get_value(ctx, ge->arg[1], value)) {
+        return negated ? WORD_LT : WORD_GE;
+      }
+    } else if (ge->arg[1] == x && ge->arg[0] != x) {
+      // c >= x
+      if (bv_word_domain_get_value(ctx, ge->arg[0], value)) {
+        return negated ? WORD_GT : WORD_LE;
+      }
+    }
+    break;
+  }
+  default:
+    break;
+  }
+
+  return WORD_NONE;
+}
+
+void bv_word_domain_construct(bv_word_domain_t* d, uint32_t bitsize) {
+  d->bitsize = bitsize;
+  init_bvconstant(&d->lo);
+  init_bvconstant(&d->hi);
+  init_bvconstant(&d->mask);
+  init_bvconstant(&d->bits);
+  bvconstant_set_all_zero(&d->lo, bitsize);
+  bvconstant_set_all_one(&d->hi, bitsize);
+  bvconstant_set_all_zero(&d->mask, bitsize);
+  bvconstant_set_all_zero(&d->bits, bitsize);
+  init_pvector(&d->forbidden, 0);
+  d->empty = false;
+}
+
+void bv_word_domain_destruct(bv_word_domain_t* d) {
+  uint32_t i;
+  for (i = 0; i < d->forbidden.size; ++ i) {
+    bvconstant_t* v = d->forbidden.data[i];
+    delete_bvconstant(v);
+    safe_free(v);
+  }
+  delete_pvector(&d->forbidden);
+  delete_bvconstant(&d->lo);
+  delete_bvconstant(&d->hi);
+  delete_bvconstant(&d->mask);
+  delete_bvconstant(&d->bits);
+}
+
+bool bv_word_domain_supports(const plugin_context_t* ctx, term_t cstr, term_t x) {
+  bvconstant_t value;
+  uint32_t bit;
+  init_bvconstant(&value);
+  word_constraint_kind_t kind = bv_word_domain_get_kind(ctx, cstr, x, &value, &bit);
+  delete_bvconstant(&value);
+  return kind != WORD_NONE;
+}
+
+/** Set the known bit, returns false if it conflicts with the known bits */
+static
+bool bv_word_domain_set_bit(bv_word_domain_t* d, uint32_t i, bool b) {
+  if (bvconst_tst_bit(d->mask.data, i)) {
+    return bvconst_tst_bit(d->bits.data, i) == b;
+  }
+  bvconst_set_bit(d->mask.data, i);
+  bvconst_assign_bit(d->bits.data, i, b);
+  return true;
+}
+
+bool bv_word_domain_add(bv_word_domain_t* d, const plugin_context_t* ctx, term_t cstr, term_t x) {
+
+  uint32_t i, bit = 0;
+  bvconstant_t value;
+  init_bvconstant(&value);
+
+  word_constraint_kind_t kind = bv_word_domain_get_kind(ctx, cstr, x, &value, &bit);
+  assert(kind != WORD_NONE);
+  assert(kind == WORD_BIT || kind == WORD_NBIT || value.bitsize == d->bitsize);
+
+  switch (kind) {
+  case WORD_EQ:
+    // Value is both bounds, and all bits are known
+    if (bvconstant_lt(&value, &d->lo) || bvconstant_lt(&d->hi, &value)) {
+      d->empty = true;
+    } else {
+      bvconstant_copy(&d->lo, d->bitsize, value.data);
+      bvconstant_copy(&d->hi, d->bitsize, value.data);
+      for (i = 0; !d->empty && i < d->bitsize; ++ i) {
+        if (!bv_word_domain_set_bit(d, i, bvconst_tst_bit(value.data, i))) {
+          d->empty = true;
+        }
+      }
+    }
+    break;
+  case WORD_NEQ: {
+    bvconstant_t* forbidden = safe_malloc(sizeof(bvconstant_t));
+    init_bvconstant(forbidden);
+    bvconstant_copy(forbidden, d->bitsize, value.data);
+    pvector_push(&d->forbidden, forbidden);
+    break;
+  }
+  case WORD_GE:
+    if (bvconstant_lt(&d->lo, &value)) {
+      bvconstant_copy(&d->lo, d->bitsize, value.data);
+    }
+    break;
+  case WORD_GT:
+    if (bvconstant_is_minus_one(&value)) {
+      d->empty = true;
+    } else {
+      bvconstant_add_one(&value);
+      if (bvconstant_lt(&d->lo, &value)) {
+        bvconstant_copy(&d->lo, d->bitsize, value.data);
+      }
+    }
+    break;
+  case WORD_LE:
+    if (bvconstant_lt(&value, &d->hi)) {
+      bvconstant_copy(&d->hi, d->bitsize, value.data);
+    }
+    break;
+  case WORD_LT:
+    if (bvconstant_is_zero(&value)) {
+      d->empty = true;
+    } else {
+      bvconstant_sub_one(&value);
+      if (bvconstant_lt(&value, &d->hi)) {
+        bvconstant_copy(&d->hi, d->bitsize, value.data);
+      }
+    }
+    break;
+  case WORD_BIT:
+  case WORD_NBIT:
+    if (!bv_word_domain_set_bit(d, bit, kind == WORD_BIT)) {
+      d->empty = true;
+    }
+    break;
+  default:
+    assert(false);
+  }
+
+  if (bvconstant_lt(&d->hi, &d->lo)) {
+    d->empty = true;
+  }
+
+  delete_bvconstant(&value);
+
+  return !d->empty;
+}
+
+bool bv_word_domain_contains(const bv_word_domain_t* d, const bvconstant_t* v) {
+  uint32_t i, w;
+
+  assert(v->bitsize == d->bitsize);
+
+  if (d->empty) {
+    return false;
+  }
+  if (bvconstant_lt(v, &d->lo) || bvconstant_lt(&d->hi, v)) {
+    return false;
+  }
+  w = d->mask.width;
+  for (i = 0; i < w; ++ i) {
+    if ((v->data[i] & d->mask.data[i]) != d->bits.data[i]) {
+      return false;
+    }
+  }
+  for (i = 0; i < d->forbidden.size; ++ i) {
+    if (bvconstant_eq(v, d->forbidden.data[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/** Overwrite the known bits of v */
+static
+void bv_word_domain_apply_bits(const bv_word_domain_t* d, bvconstant_t* v) {
+  uint32_t i, w;
+  w = d->mask.width;
+  for (i = 0; i < w; ++ i) {
+    v->data[i] = (v->data[i] & ~d->mask.data[i]) | d->bits.data[i];
+  }
+  bvconstant_normalize(v);
+}
+
+/** Try v and a few values after it, returns true if one is in the domain */
+static
+bool bv_word_domain_try_from(const bv_word_domain_t* d, bvconstant_t* v) {
+  uint32_t i;
+  for (i = 0; i < BV_WORD_DOMAIN_PICK_TRIES; ++ i) {
+    bv_word_domain_apply_bits(d, v);
+    if (bv_word_domain_contains(d, v)) {
+      return true;
+    }
+    if (bvconstant_is_minus_one(v)) {
+      return false;
+    }
+    bvconstant_add_one(v);
+  }
+  return false;
+}
+
+bool bv_word_domain_pick(const bv_word_domain_t* d, const bvconstant_t* hint, bvconstant_t* out) {
+
+  if (d->empty) {
+    return false;
+  }
+
+  // Try the hint as is
+  if (hint != NULL) {
+    assert(hint->bitsize == d->bitsize);
+    if (bv_word_domain_contains(d, hint)) {
+      bvconstant_copy(out, d->bitsize, hint->data);
+      return true;
+    }
+  }
+
+  // Try from the lower bound
+  bvconstant_copy(out, d->bitsize, d->lo.data);
+  if (bv_word_domain_try_from(d, out)) {
+    return true;
+  }
+
+  // Try the upper bound
+  bvconstant_copy(out, d->bitsize, d->hi.data);
+  bv_word_domain_apply_bits(d, out);
+  if (bv_word_domain_contains(d, out)) {
+    return true;
+  }
+
+  return false;
+}
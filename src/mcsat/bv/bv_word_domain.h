@@ -0,0 +1,79 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2019 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "mcsat/plugin.h"
+
+#include "terms/bv_constants.h"
+#include "utils/ptr_vectors.h"
+
+/**
+ * Word-level domain of a bit-vector variable x. It is the intersection of
+ * - an unsigned interval [lo, hi],
+ * - the known bits of x (bits set in mask have the value in bits), and
+ * - the complement of a set of forbidden values.
+ *
+ * The domain is built from simple constraints where one side is x and the
+ * other one is a constant or an assigned variable, i.e. x = c, x != c,
+ * x >= c, x < c, c >= x, c < x, and (bit x i). For these constraints the
+ * domain is exact, so any value in the domain satisfies all the constraints.
+ */
+typedef struct {
+  /** Size of x */
+  uint32_t bitsize;
+  /** Lower bound (unsigned, inclusive) */
+  bvconstant_t lo;
+  /** Upper bound (unsigned, inclusive) */
+  bvconstant_t hi;
+  /** Bits of x that are known */
+  bvconstant_t mask;
+  /** Values of the known bits (0 outside of the mask) */
+  bvconstant_t bits;
+  /** Values that x can't take (bvconstant_t*) */
+  pvector_t forbidden;
+  /** True if the domain is known to be empty */
+  bool empty;
+} bv_word_domain_t;
+
+/** Construct the full domain of given size */
+void bv_word_domain_construct(bv_word_domain_t* d, uint32_t bitsize);
+
+/** Destruct the domain */
+void bv_word_domain_destruct(bv_word_domain_t* d);
+
+/**
+ * Check if the (possibly negated) atom is a constraint that the domain can
+ * represent exactly for x, in the current trail.
+ */
+bool bv_word_domain_supports(const plugin_context_t* ctx, term_t cstr, term_t x);
+
+/**
+ * Restrict the domain with the (possibly negated) atom. The constraint must
+ * be supported (see above). Returns false if the domain becomes empty.
+ */
+bool bv_word_domain_add(bv_word_domain_t* d, const plugin_context_t* ctx, term_t cstr, term_t x);
+
+/** Check if the value is in the domain */
+bool bv_word_domain_contains(const bv_word_domain_t* d, const bvconstant_t* v);
+
+/**
+ * Pick a value in the domain, trying the hint first (if not NULL). This is
+ * not complete: returns false if no value was found.
+ */
+bool bv_word_domain_pick(const bv_word_domain_t* d, const bvconstant_t* hint, bvconstant_t* out);
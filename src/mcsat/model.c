@@ -18,12 +18,15 @@
  
 #include "mcsat/model.h"
 
+#include "terms/bv64_constants.h"
 #include "utils/memalloc.h"
 
 static inline
 void mcsat_model_ensure_capacity(mcsat_model_t* m, uint32_t capacity) {
   if (capacity > m->capacity) {
     m->values = (mcsat_value_t*) safe_realloc(m->values, sizeof(mcsat_value_t)*capacity);
+    m->kinds = (uint8_t*) safe_realloc(m->kinds, sizeof(uint8_t)*capacity);
+    m->small = (uint64_t*) safe_realloc(m->small, sizeof(uint64_t)*capacity);
     m->timestamps = (uint32_t*) safe_realloc(m->timestamps, sizeof(uint32_t)*capacity);
     m->capacity = capacity;
   }
@@ -41,6 +44,8 @@ void mcsat_model_resize(mcsat_model_t* m, uint32_t size) {
     mcsat_model_ensure_capacity(m, size + size / 2);
     for (i = m->size; i < size; ++ i) {
       mcsat_value_construct_default(m->values + i);
+      m->kinds[i] = VALUE_NONE | MCSAT_MODEL_INLINE;
+      m->small[i] = 0;
       m->timestamps[i] = 0;
     }
   }
@@ -54,6 +59,8 @@ void mcsat_model_construct(mcsat_model_t* m) {
   m->size = 0;
   m->capacity = 0;
   m->values = NULL;
+  m->kinds = NULL;
+  m->small = NULL;
   m->timestamps = NULL;
   m->timestamp = 0;
   mcsat_model_ensure_capacity(m, MCSAT_MODEL_INITIAL_CAPACITY);
@@ -62,10 +69,14 @@ void mcsat_model_construct(mcsat_model_t* m) {
 void mcsat_model_construct_copy(mcsat_model_t* m, const mcsat_model_t* from) {
   m->capacity = 0;
   m->values = NULL;
+  m->kinds = NULL;
+  m->small = NULL;
   m->timestamps = NULL;
   mcsat_model_ensure_capacity(m, from->capacity);
   m->size = from->size;
   mcsat_value_construct_copy_n(m->values, from->values, m->size);
+  memcpy(m->kinds, from->kinds, m->size * sizeof(uint8_t));
+  memcpy(m->small, from->small, m->size * sizeof(uint64_t));
   memcpy(m->timestamps, from->timestamps, m->capacity * sizeof(uint32_t));
   m->timestamp = from->timestamp;
 }
@@ -76,6 +87,8 @@ void mcsat_model_destruct(mcsat_model_t* m) {
     mcsat_value_destruct(m->values + i);
   }
   safe_free(m->values);
+  safe_free(m->kinds);
+  safe_free(m->small);
   safe_free(m->timestamps);
 }
 
@@ -85,40 +98,70 @@ void mcsat_model_new_variable_notify(mcsat_model_t* m, variable_t x) {
   }
 }
 
-bool mcsat_model_has_value(const mcsat_model_t* m, variable_t x) {
-  // Make sure enough space
-  if (x >= m->size) {
-    return false;
-  }
-  return (m->values[x].type != VALUE_NONE);
-}
-
-const mcsat_value_t* mcsat_model_get_value(const mcsat_model_t* m, variable_t x) {
-  if (x >= m->size) {
-    return &mcsat_value_none;
-  } else {
-    return m->values + x;
+/**
+ * Kind of a value for the flat arrays. If the value is small, its encoding
+ * is stored in *small and the kind has MCSAT_MODEL_INLINE set.
+ */
+static inline
+uint8_t mcsat_model_value_kind(const mcsat_value_t* value, uint64_t* small) {
+  uint32_t n;
+
+  switch (value->type) {
+  case VALUE_NONE:
+    *small = 0;
+    return VALUE_NONE | MCSAT_MODEL_INLINE;
+  case VALUE_BOOLEAN:
+    *small = value->b;
+    return VALUE_BOOLEAN | MCSAT_MODEL_INLINE;
+  case VALUE_RATIONAL:
+    if (is_rat32(&value->q)) {
+      *small = ((uint64_t) value->q.s.den) | (((uint64_t) (uint32_t) value->q.s.num) << 32);
+      return VALUE_RATIONAL | MCSAT_MODEL_INLINE;
+    }
+    break;
+  case VALUE_BV:
+    n = value->bv_value.bitsize;
+    if (n <= 64) {
+      // the low bits identify the value, the bitsize is fixed by the variable type
+      *small = (n <= 32) ? bvconst_get32(value->bv_value.data) : bvconst_get64(value->bv_value.data);
+      *small = norm64(*small, n);
+      return VALUE_BV | MCSAT_MODEL_INLINE;
+    }
+    break;
+  default:
+    break;
   }
-}
 
-uint32_t mcsat_model_get_value_timestamp(const mcsat_model_t* m, variable_t x) {
-  if (x >= m->size) {
-    return 0;
-  } else {
-    return m->timestamps[x];
-  }
+  *small = 0;
+  return value->type;
 }
 
 void mcsat_model_set_value(mcsat_model_t* m, variable_t x, const mcsat_value_t* value) {
+  mcsat_value_t* x_value;
+  uint64_t small;
+  uint8_t kind;
+
   // Make sure enough space
   if (x >= m->size) {
     mcsat_model_resize(m, x + 1);
   }
-  mcsat_value_t* x_value = m->values + x;
-  if ((x_value->type != value->type) || (!mcsat_value_eq(x_value, value))) {
-    mcsat_value_assign(x_value, value);
-    m->timestamps[x] = ++ m->timestamp;
+
+  // Small values are compared on the flat arrays, others on the union
+  kind = mcsat_model_value_kind(value, &small);
+  x_value = m->values + x;
+  if (kind == m->kinds[x]) {
+    if (kind & MCSAT_MODEL_INLINE) {
+      if (small == m->small[x]) return;
+    } else if (mcsat_value_eq(x_value, value)) {
+      return;
+    }
   }
+
+  // Same type: mcsat_value_assign reuses the storage
+  mcsat_value_assign(x_value, value);
+  m->kinds[x] = kind;
+  m->small[x] = small;
+  m->timestamps[x] = ++ m->timestamp;
 }
 
 void mcsat_model_unset_value(mcsat_model_t* m, variable_t x) {
@@ -126,6 +169,8 @@ void mcsat_model_unset_value(mcsat_model_t* m, variable_t x) {
     assert(m->values[x].type != VALUE_NONE);
     mcsat_value_destruct(m->values + x);
     mcsat_value_construct_default(m->values + x);
+    m->kinds[x] = VALUE_NONE | MCSAT_MODEL_INLINE;
+    m->small[x] = 0;
     m->timestamps[x] = ++ m->timestamp;
   }
 }
@@ -23,6 +23,10 @@
 #include "mcsat/variable_db.h"
 #include "mcsat/mcsat_types.h"
 
+/** Flags of the kinds array */
+#define MCSAT_MODEL_TYPE_MASK 0x0f
+#define MCSAT_MODEL_INLINE    0x10
+
 /** The model */
 struct mcsat_model_s {
   /** Size of the model */
@@ -31,6 +35,16 @@ struct mcsat_model_s {
   uint32_t capacity;
   /** Map from variables to values */
   mcsat_value_t* values;
+  /**
+   * Flat copy of the values, for the queries of the search loop. The type of
+   * values[x] is kinds[x] & MCSAT_MODEL_TYPE_MASK. If MCSAT_MODEL_INLINE is
+   * set in kinds[x], the value is also encoded in small[x]: Booleans,
+   * rationals with 32-bit numerator and denominator, and bit-vectors of at
+   * most 64 bits. Algebraic numbers, big rationals, and wide bit-vectors are
+   * only in values[x] (plugins get pointers to values[x]).
+   */
+  uint8_t* kinds;
+  uint64_t* small;
   /** Timestamps */
   uint32_t* timestamps;
   /** Global timestamp */
@@ -49,14 +63,47 @@ void mcsat_model_destruct(mcsat_model_t* m);
 /** Notification of new variables */
 void mcsat_model_new_variable_notify(mcsat_model_t* m, variable_t x);
 
+/** Get the type of the value of the variable (VALUE_NONE if no value) */
+static inline
+mcsat_value_type_t mcsat_model_get_type(const mcsat_model_t* m, variable_t x) {
+  if (x >= m->size) {
+    return VALUE_NONE;
+  }
+  return (mcsat_value_type_t) (m->kinds[x] & MCSAT_MODEL_TYPE_MASK);
+}
+
 /** Does the variable have a value */
-bool mcsat_model_has_value(const mcsat_model_t* m, variable_t x);
+static inline
+bool mcsat_model_has_value(const mcsat_model_t* m, variable_t x) {
+  return mcsat_model_get_type(m, x) != VALUE_NONE;
+}
+
+/** Get the value of a variable that has a Boolean value */
+static inline
+bool mcsat_model_get_boolean(const mcsat_model_t* m, variable_t x) {
+  assert(mcsat_model_get_type(m, x) == VALUE_BOOLEAN);
+  return m->small[x] != 0;
+}
 
 /** Get the timestamp of the variable */
-uint32_t mcsat_model_get_value_timestamp(const mcsat_model_t* m, variable_t x);
+static inline
+uint32_t mcsat_model_get_value_timestamp(const mcsat_model_t* m, variable_t x) {
+  if (x >= m->size) {
+    return 0;
+  } else {
+    return m->timestamps[x];
+  }
+}
 
 /** Get the value of the variable */
-const mcsat_value_t* mcsat_model_get_value(const mcsat_model_t* m, variable_t x);
+static inline
+const mcsat_value_t* mcsat_model_get_value(const mcsat_model_t* m, variable_t x) {
+  if (x >= m->size) {
+    return &mcsat_value_none;
+  } else {
+    return m->values + x;
+  }
+}
 
 /** Set x -> value. */
 void mcsat_model_set_value(mcsat_model_t* m, variable_t x, const mcsat_value_t* value);
@@ -422,6 +422,66 @@ void feasible_set_quickxplain(const feasible_set_db_t* db, const lp_feasibility_
   lp_feasibility_set_delete(feasible_B);
 }
 
+/**
+ * Greedy cover of the conflict: pick reasons until the intersection is empty
+ * (or excludes the value). At each step we take a witness from the current
+ * intersection (or the value) and add the first reason that excludes it, so
+ * each step removes the witness and no reason is picked twice. The result is
+ * usually much smaller than the input, so it's a good start for quickxplain.
+ */
+static
+void feasible_set_greedy_cover(const feasible_set_db_t* db, const mcsat_value_t* value, const ivector_t* reasons, ivector_t* out) {
+
+  uint32_t i;
+
+  lp_feasibility_set_t* S = lp_feasibility_set_new_full();
+  lp_value_t witness;
+  lp_value_construct_none(&witness);
+
+  const lp_value_t* x_value = NULL;
+  if (value != NULL) {
+    assert(value->type == VALUE_LIBPOLY);
+    x_value = &value->lp_value;
+  }
+
+  for (;;) {
+    // Check if we're done
+    if (lp_feasibility_set_is_empty(S)) {
+      break;
+    }
+    if (x_value != NULL && !lp_feasibility_set_contains(S, x_value)) {
+      break;
+    }
+    // Get the witness
+    if (x_value == NULL) {
+      lp_feasibility_set_pick_value(S, &witness);
+    } else {
+      lp_value_assign(&witness, x_value);
+    }
+    // First reason that excludes it
+    for (i = 0; i < reasons->size; ++ i) {
+      const lp_feasibility_set_t* feasible_i = db->memory[reasons->data[i]].reason_feasible_set;
+      if (!lp_feasibility_set_contains(feasible_i, &witness)) {
+        break;
+      }
+    }
+    if (i == reasons->size) {
+      // Not a conflict, shouldn't happen, but keep all reasons to be safe
+      assert(false);
+      ivector_reset(out);
+      ivector_add(out, reasons->data, reasons->size);
+      break;
+    }
+    ivector_push(out, reasons->data[i]);
+    lp_feasibility_set_t* intersect = lp_feasibility_set_intersect(S, db->memory[reasons->data[i]].reason_feasible_set);
+    lp_feasibility_set_swap(intersect, S);
+    lp_feasibility_set_delete(intersect);
+  }
+
+  lp_value_destruct(&witness);
+  lp_feasibility_set_delete(S);
+}
+
 /** Compare variables first by degree, then by level, prefer non root constraints */
 static
 bool compare_reasons(void *nra_plugin, int32_t r1, int32_t r2) {
@@ -511,9 +571,12 @@ void feasible_set_filter_reason_indices(feasible_set_db_t* db, nra_plugin_t* nra
     print_conflict_reasons(ctx_trace_out(db->ctx), db, nra, reasons_indices);
   }                           
 
-  // Minimize the core
+  // Get a small core greedily, then minimize it
   ivector_t out;
   init_ivector(&out, 0);
+  feasible_set_greedy_cover(db, x_value, reasons_indices, &out);
+  ivector_swap(reasons_indices, &out);
+  ivector_reset(&out);
   feasible_set_quickxplain(db, S, x_value, reasons_indices, 0, reasons_indices->size, &out);
   ivector_swap(reasons_indices, &out);
   delete_ivector(&out);
@@ -43,6 +43,7 @@
 #include "mcsat/watch_list_manager.h"
 #include "mcsat/nra/poly_constraint.h"
 #include "mcsat/nra/nra_plugin_explain.h"
+#include "mcsat/nra/projection_cache.h"
 
 #include "terms/terms.h"
 #include "utils/int_array_sort2.h"
@@ -51,11 +52,6 @@
 
 #include "api/yices_api_lock_free.h"
 
-static inline
-bool nra_plugin_has_assignment(const nra_plugin_t* nra, variable_t x) {
-  return trail_has_value(nra->ctx->trail, x) && trail_get_index(nra->ctx->trail, x) < nra->trail_i;
-}
-
 static
 void nra_plugin_stats_init(nra_plugin_t* nra) {
   // Add statistics
@@ -67,6 +63,7 @@ void nra_plugin_stats_init(nra_plugin_t* nra) {
   nra->stats.evaluations = statistics_new_int(nra->ctx->stats, "mcsat::nra::evaluations");
   nra->stats.constraint_regular = statistics_new_int(nra->ctx->stats, "mcsat::nra::constraints_regular");
   nra->stats.constraint_root = statistics_new_int(nra->ctx->stats, "mcsat::nra::constraints_root");
+  nra->stats.icp_conflicts = statistics_new_int(nra->ctx->stats, "mcsat::nra::icp_conflicts");
 }
 
 static
@@ -113,6 +110,9 @@ void nra_plugin_construct(plugin_t* plugin, plugin_context_t* ctx) {
   // Feasible sets
   nra->feasible_set_db = feasible_set_db_new(ctx);
 
+  // Projection cache
+  nra->projection_cache = projection_cache_new(nra);
+
   // lipoly init
   nra->lp_data.lp_var_db = lp_variable_db_new();
   nra->lp_data.lp_var_order = lp_variable_order_new();
@@ -207,6 +207,8 @@ void nra_plugin_destruct(plugin_t* plugin) {
 
   feasible_set_db_delete(nra->feasible_set_db);
 
+  projection_cache_delete(nra->projection_cache);
+
   lp_polynomial_context_detach(nra->lp_data.lp_ctx);
   lp_variable_order_detach(nra->lp_data.lp_var_order);
   lp_variable_db_detach(nra->lp_data.lp_var_db);
@@ -20,9 +20,11 @@
 #include "nra_plugin_internal.h"
 #include "poly_constraint.h"
 #include "libpoly_utils.h"
+#include "projection_cache.h"
 
 #include "utils/int_hash_map.h"
 #include "utils/pointer_vectors.h"
+#include "utils/ptr_vectors.h"
 #include "utils/int_hash_sets.h"
 #include "mcsat/tracing.h"
 #include "terms/term_manager.h"
@@ -33,6 +35,10 @@
 #include <stdlib.h>
 #include <stdio.h>
 
+#if defined(THREAD_SAFE) && !defined(MINGW)
+#include <pthread.h>
+#endif
+
 #include <poly/poly.h>
 #include <poly/polynomial_hash_set.h>
 #include <poly/polynomial_vector.h>
@@ -122,6 +128,15 @@ struct lp_projection_map_struct {
   /** Map from lp variables to terms (if available) */
   int_hmap_t* lp_to_term_map;
 
+  /** Cache of projection results (if available) */
+  projection_cache_t* cache;
+
+  /** Number of threads for the PSC computation (only used with a cache) */
+  uint32_t psc_threads;
+
+  /** PSC computations delayed to the end of the current level (psc_job_t) */
+  pvector_t psc_jobs;
+
   /// Projection options
 
   /** Whether to use model-based GCD */
@@ -156,6 +171,9 @@ void lp_projection_map_construct(lp_projection_map_t* map,
   map->nra = nra;
   map->lp_to_term_map = lp_to_term_map;
   map->plugin_ctx = (nra == NULL ? NULL : nra->ctx);
+  map->cache = (nra == NULL ? NULL : nra->projection_cache);
+  map->psc_threads = 1;
+  init_pvector(&map->psc_jobs, 0);
   map->use_mgcd = use_mgcd;
   map->use_nlsat = use_nlsat;
 
@@ -175,6 +193,9 @@ void lp_projection_map_construct_from_nra(lp_projection_map_t* map, nra_plugin_t
       nra->ctx->tm, nra,
       NULL,
       nra->ctx->options->nra_mgcd, nra->ctx->options->nra_nlsat);
+  if (nra->ctx->options->nra_explain_threads > 1) {
+    map->psc_threads = nra->ctx->options->nra_explain_threads;
+  }
 }
 
 void lp_projection_map_destruct(lp_projection_map_t* map) {
@@ -187,6 +208,8 @@ void lp_projection_map_destruct(lp_projection_map_t* map) {
   delete_int_hmap(&map->var_to_index_map);
   lp_variable_list_destruct(&map->all_vars);
   lp_variable_list_destruct(&map->unprojected_vars);
+  assert(map->psc_jobs.size == 0);
+  delete_pvector(&map->psc_jobs);
   if (map->nra == NULL) {
     delete_rba_buffer(&map->buffer);
   }
@@ -599,11 +622,18 @@ void lp_projection_map_construct_cell(lp_projection_map_t* map, lp_variable_t x,
       ctx_trace_printf(ctx, "p_deg = %zu\n", p_deg);
     }
 
-    // Isolate the roots
+    // Isolate the roots (the cache owns the roots if we have one)
     assert(p_deg > 0);
-    lp_value_t* p_roots = safe_malloc(sizeof(lp_value_t)*p_deg);
+    lp_value_t* p_roots_buffer = NULL;
+    const lp_value_t* p_roots = NULL;
     size_t p_roots_size = 0;
-    lp_polynomial_roots_isolate(p, map->m, p_roots, &p_roots_size);
+    if (map->cache != NULL) {
+      p_roots = projection_cache_get_roots(map->cache, x, p, map->m, &p_roots_size);
+    } else {
+      p_roots_buffer = safe_malloc(sizeof(lp_value_t)*p_deg);
+      lp_polynomial_roots_isolate(p, map->m, p_roots_buffer, &p_roots_size);
+      p_roots = p_roots_buffer;
+    }
 
     if (ctx_trace_enabled(ctx, "nra::explain::projection")) {
       ctx_trace_printf(ctx, "roots = ");
@@ -714,11 +744,13 @@ void lp_projection_map_construct_cell(lp_projection_map_t* map, lp_variable_t x,
     }
 
     // Remove the roots
-    size_t p_roots_i;
-    for (p_roots_i = 0; p_roots_i < p_roots_size; ++ p_roots_i) {
-      lp_value_destruct(p_roots + p_roots_i);
+    if (p_roots_buffer != NULL) {
+      size_t p_roots_i;
+      for (p_roots_i = 0; p_roots_i < p_roots_size; ++ p_roots_i) {
+        lp_value_destruct(p_roots_buffer + p_roots_i);
+      }
+      safe_free(p_roots_buffer);
     }
-    safe_free(p_roots);
   }
 
   if (ctx_trace_enabled(ctx, "nra::explain::projection")) {
@@ -750,30 +782,266 @@ void lp_projection_map_construct_cell(lp_projection_map_t* map, lp_variable_t x,
   lp_interval_destruct(&x_cell);
 }
 
+/** Add the initial sequence of the psc, up to the first non-vanishing one */
+static
+void lp_projection_map_add_psc_sequence(lp_projection_map_t* map, lp_polynomial_t** psc, uint32_t psc_size) {
+  uint32_t psc_i;
+  for (psc_i = 0; psc_i < psc_size; ++ psc_i) {
+    // Add it
+    lp_projection_map_add(map, psc[psc_i]);
+    // If it doesn't vanish we're done
+    if (lp_polynomial_sgn(psc[psc_i], map->m)) {
+      break;
+    }
+  }
+}
+
+/**
+ * PSC computation delayed to the end of the level. The polynomials p and q are
+ * copies. If computed in a worker, p_w and q_w are copies of p and q in the
+ * context of the worker, and psc is the result.
+ */
+typedef struct {
+  lp_variable_t x;
+  lp_polynomial_t* p;
+  lp_polynomial_t* q;
+  lp_polynomial_t* p_w;
+  lp_polynomial_t* q_w;
+  lp_polynomial_t** psc;
+  uint32_t psc_size;
+} psc_job_t;
+
+static
+void lp_projection_map_delay_psc(lp_projection_map_t* map, lp_variable_t x, const lp_polynomial_t* p, const lp_polynomial_t* q) {
+  psc_job_t* job = safe_malloc(sizeof(psc_job_t));
+  job->x = x;
+  job->p = lp_polynomial_new_copy(p);
+  job->q = lp_polynomial_new_copy(q);
+  job->p_w = NULL;
+  job->q_w = NULL;
+  job->psc = NULL;
+  job->psc_size = 0;
+  pvector_push(&map->psc_jobs, job);
+}
+
+#if defined(THREAD_SAFE) && !defined(MINGW)
+
+/**
+ * Worker for the PSC computation. Libpoly contexts are not thread-safe (they
+ * are reference counted and have temporary buffers), so each worker has its own
+ * context. All polynomials the worker uses are created in its context before
+ * the worker starts, and moved back to the context of the map after all the
+ * workers are done.
+ *
+ * The worker contexts share the variable database, the variable order, and the
+ * ring lp_Z with the context of the map. These are not locked: their reference
+ * counts only change when a worker context is created or detached, which is
+ * done by the calling thread while no worker runs. While the workers run, the
+ * variable database and order are only read, and the calling thread doesn't
+ * modify them since it only runs worker 0.
+ */
+typedef struct {
+  lp_polynomial_context_t* ctx;
+  psc_job_t** jobs;
+  uint32_t jobs_size;
+  uint32_t jobs_step;
+} psc_worker_t;
+
+static
+void* psc_worker_run(void* arg) {
+  psc_worker_t* worker = arg;
+  uint32_t i;
+  for (i = 0; i < worker->jobs_size; i += worker->jobs_step) {
+    psc_job_t* job = worker->jobs[i];
+    if (job->psc != NULL) {
+      lp_polynomial_psc(job->psc, job->p_w, job->q_w);
+    }
+  }
+  return NULL;
+}
+
+/** Check if the two jobs compute the same PSC */
+static
+bool psc_job_eq(const psc_job_t* job1, const psc_job_t* job2) {
+  return job1->x == job2->x && lp_polynomial_eq(job1->p, job2->p) && lp_polynomial_eq(job1->q, job2->q);
+}
+
+/**
+ * Compute the PSCs of the delayed jobs in parallel. Only the jobs that are not in
+ * the cache are computed, and each distinct job only once: the duplicates get
+ * the result from the cache when the results are merged. The i-th job to compute
+ * goes to worker i % n, and the results are moved back to the context of the map.
+ */
+static
+void lp_projection_map_compute_psc_parallel(lp_projection_map_t* map) {
+  psc_job_t** jobs = (psc_job_t**) map->psc_jobs.data;
+  uint32_t jobs_size = map->psc_jobs.size;
+  pvector_t todo;
+  uint32_t i, j;
+
+  // Jobs to do: not cached and not already in the batch
+  init_pvector(&todo, 0);
+  for (i = 0; i < jobs_size; ++ i) {
+    psc_job_t* job = jobs[i];
+    if (projection_cache_has_psc(map->cache, job->x, job->p, job->q)) {
+      continue;
+    }
+    for (j = 0; j < todo.size; ++ j) {
+      if (psc_job_eq(job, todo.data[j])) {
+        break;
+      }
+    }
+    if (j == todo.size) {
+      pvector_push(&todo, job);
+    }
+  }
+
+  uint32_t n = map->psc_threads < todo.size ? map->psc_threads : todo.size;
+  if (n <= 1) {
+    // Sequential is fine, done in the merge
+    delete_pvector(&todo);
+    return;
+  }
+
+  // Setup the workers (must be done here, contexts are not thread-safe)
+  psc_worker_t* workers = safe_malloc(sizeof(psc_worker_t)*n);
+  for (i = 0; i < n; ++ i) {
+    workers[i].ctx = lp_polynomial_context_new(lp_Z, map->ctx->var_db, map->ctx->var_order);
+    workers[i].jobs = ((psc_job_t**) todo.data) + i;
+    workers[i].jobs_size = todo.size - i;
+    workers[i].jobs_step = n;
+  }
+  for (i = 0; i < todo.size; ++ i) {
+    psc_job_t* job = todo.data[i];
+    const lp_polynomial_context_t* ctx = workers[i % n].ctx;
+    job->p_w = lp_polynomial_new_copy(job->p);
+    job->q_w = lp_polynomial_new_copy(job->q);
+    lp_polynomial_set_context(job->p_w, ctx);
+    lp_polynomial_set_context(job->q_w, ctx);
+    size_t p_deg = lp_polynomial_degree(job->p);
+    size_t q_deg = lp_polynomial_degree(job->q);
+    job->psc_size = p_deg > q_deg ? q_deg + 1 : p_deg + 1;
+    job->psc = safe_malloc(sizeof(lp_polynomial_t*)*job->psc_size);
+    for (j = 0; j < job->psc_size; ++ j) {
+      job->psc[j] = lp_polynomial_new(ctx);
+    }
+  }
+
+  // Run: worker 0 in this thread, others in new threads
+  pthread_t* threads = safe_malloc(sizeof(pthread_t)*n);
+  bool* started = safe_malloc(sizeof(bool)*n);
+  for (i = 1; i < n; ++ i) {
+    started[i] = (pthread_create(threads + i, NULL, psc_worker_run, workers + i) == 0);
+  }
+  psc_worker_run(workers);
+  for (i = 1; i < n; ++ i) {
+    if (started[i]) {
+      pthread_join(threads[i], NULL);
+    } else {
+      // Couldn't start the thread, do it here
+      psc_worker_run(workers + i);
+    }
+  }
+  safe_free(started);
+  safe_free(threads);
+
+  // Move the results back to our context
+  for (i = 0; i < jobs_size; ++ i) {
+    psc_job_t* job = jobs[i];
+    if (job->psc != NULL) {
+      for (j = 0; j < job->psc_size; ++ j) {
+        lp_polynomial_set_context(job->psc[j], map->ctx);
+      }
+      lp_polynomial_delete(job->p_w);
+      lp_polynomial_delete(job->q_w);
+      job->p_w = NULL;
+      job->q_w = NULL;
+    }
+  }
+
+  // Remove the workers
+  for (i = 0; i < n; ++ i) {
+    lp_polynomial_context_detach(workers[i].ctx);
+  }
+  safe_free(workers);
+  delete_pvector(&todo);
+}
+
+#endif
+
+/**
+ * Process all the delayed PSC computations. The results are added to the map in
+ * the order the computations were requested, so the projection doesn't depend
+ * on the number of threads (with one thread, the PSCs are computed here).
+ */
+static
+void lp_projection_map_run_delayed_psc(lp_projection_map_t* map) {
+
+  if (map->psc_jobs.size == 0) {
+    return;
+  }
+
+#if defined(THREAD_SAFE) && !defined(MINGW)
+  lp_projection_map_compute_psc_parallel(map);
+#endif
+
+  uint32_t i, j;
+  for (i = 0; i < map->psc_jobs.size; ++ i) {
+    psc_job_t* job = map->psc_jobs.data[i];
+    uint32_t psc_size;
+    lp_polynomial_t** psc = projection_cache_find_psc(map->cache, job->x, job->p, job->q, &psc_size);
+    if (psc == NULL) {
+      if (job->psc != NULL) {
+        psc_size = job->psc_size;
+        psc = projection_cache_add_psc(map->cache, job->x, job->p, job->q, job->psc, job->psc_size);
+        job->psc = NULL;
+      } else {
+        psc = projection_cache_get_psc(map->cache, job->x, job->p, job->q, &psc_size);
+      }
+    }
+    if (job->psc != NULL) {
+      // Same pair computed twice
+      for (j = 0; j < job->psc_size; ++ j) {
+        lp_polynomial_delete(job->psc[j]);
+      }
+      safe_free(job->psc);
+    }
+    lp_projection_map_add_psc_sequence(map, psc, psc_size);
+    lp_polynomial_delete(job->p);
+    lp_polynomial_delete(job->q);
+    safe_free(job);
+  }
+
+  pvector_reset(&map->psc_jobs);
+}
+
 /** Add the model based PSC of the two polynomials to the projection map */
 void lp_projection_map_add_psc(lp_projection_map_t* map, lp_polynomial_t*** polynomial_buffer, uint32_t* polynomial_buffer_size, lp_variable_t x, const lp_polynomial_t* p, const lp_polynomial_t* q) {
   // Ensure buffer size min(deg(p_r_d), deg(p_r)) + 1 = p_r_deg
   assert(lp_polynomial_top_variable(p) == x);
   assert(lp_polynomial_top_variable(q) == x);
 
+  // With the projection cache, the PSC is computed at the end of the level
+  // (with any number of threads, so that the polynomials are added to the
+  // map in the same order). The results go to the cache, so PSCs are
+  // computed in parallel only when the cache is enabled.
+  if (map->cache != NULL) {
+    lp_projection_map_delay_psc(map, x, p, q);
+    return;
+  }
+
+  // No cache: compute the psc now, on this thread
+  uint32_t psc_size;
+  lp_polynomial_t** psc;
   size_t p_deg = lp_polynomial_degree(p);
   size_t q_deg = lp_polynomial_degree(q);
-
-  uint32_t psc_size = p_deg > q_deg ? q_deg + 1 : p_deg + 1;
+  psc_size = p_deg > q_deg ? q_deg + 1 : p_deg + 1;
   polynomial_buffer_ensure_size(polynomial_buffer, polynomial_buffer_size, psc_size, map->ctx);
-
-  // Get the psc
   lp_polynomial_psc(*polynomial_buffer, p, q);
+  psc = *polynomial_buffer;
+
   // Add the initial sequence of the psc
-  uint32_t psc_i;
-  for (psc_i = 0; psc_i < psc_size; ++ psc_i) {
-    // Add it
-    lp_projection_map_add(map, (*polynomial_buffer)[psc_i]);
-    // If it doesn't vanish we're done
-    if (lp_polynomial_sgn((*polynomial_buffer)[psc_i], map->m)) {
-      break;
-    }
-  }
+  lp_projection_map_add_psc_sequence(map, psc, psc_size);
 }
 
 /** Add the model-based gcd of the two polynomials to the projection map */
@@ -1032,6 +1300,9 @@ void lp_projection_map_project(lp_projection_map_t* map, ivector_t* out, int_hse
         }
       }
     }
+
+    // Finish the delayed projections of this level
+    lp_projection_map_run_delayed_psc(map);
   }
 
   // Free the temps
@@ -1078,6 +1349,72 @@ bool constraint_get_value(const mcsat_trail_t* trail, const int_mset_t* pos, con
   return false;
 }
 
+/** Maximal number of rounds of interval propagation over the core */
+#define NRA_ICP_MAX_ROUNDS 10
+
+/**
+ * Try to refute the core with interval constraint propagation. The intervals are
+ * derived from the core constraints only (not from the model), so if the
+ * propagation reaches an empty interval, the core itself is inconsistent and
+ * the conflict is just the core. Returns true if refuted, and the conflict is
+ * added to the conflict vector.
+ */
+static
+bool nra_plugin_explain_conflict_icp(nra_plugin_t* nra, const int_mset_t* pos, const int_mset_t* neg,
+    const ivector_t* core, ivector_t* conflict) {
+
+  uint32_t round, core_i;
+  bool refuted = false;
+
+  lp_interval_assignment_t* m = nra->lp_data.lp_interval_assignment;
+  lp_interval_assignment_reset(m);
+
+  ivector_t inferred_vars;
+  init_ivector(&inferred_vars, 0);
+
+  for (round = 0; !refuted && round < NRA_ICP_MAX_ROUNDS; ++ round) {
+    bool inferred = false;
+    for (core_i = 0; !refuted && core_i < core->size; ++ core_i) {
+      variable_t constraint_var = core->data[core_i];
+      const poly_constraint_t* constraint = poly_constraint_db_get(nra->constraint_db, constraint_var);
+      bool constraint_value = constraint_get_value(nra->ctx->trail, pos, neg, constraint_var);
+      ivector_reset(&inferred_vars);
+      refuted = poly_constraint_infer_bounds(constraint, !constraint_value, m, &inferred_vars);
+      if (inferred_vars.size > 0) {
+        inferred = true;
+      }
+    }
+    if (!inferred) {
+      // Nothing changed, we're at a fixpoint
+      break;
+    }
+  }
+
+  delete_ivector(&inferred_vars);
+
+  if (ctx_trace_enabled(nra->ctx, "nra::explain")) {
+    ctx_trace_printf(nra->ctx, "nra_plugin_explain_conflict_icp(): %s after %u rounds\n", refuted ? "refuted" : "not refuted", round);
+    lp_interval_assignment_print(m, ctx_trace_out(nra->ctx));
+    ctx_trace_printf(nra->ctx, "\n");
+  }
+
+  lp_interval_assignment_reset(m);
+
+  if (refuted) {
+    (*nra->stats.icp_conflicts) ++;
+    for (core_i = 0; core_i < core->size; ++ core_i) {
+      variable_t constraint_var = core->data[core_i];
+      term_t constraint_term = variable_db_get_term(nra->ctx->var_db, constraint_var);
+      if (!constraint_get_value(nra->ctx->trail, pos, neg, constraint_var)) {
+        constraint_term = opposite_term(constraint_term);
+      }
+      ivector_push(conflict, constraint_term);
+    }
+  }
+
+  return refuted;
+}
+
 void nra_plugin_explain_conflict(nra_plugin_t* nra, const int_mset_t* pos, const int_mset_t* neg,
     const ivector_t* core, const ivector_t* lemma_reasons, ivector_t* conflict) {
 
@@ -1127,6 +1464,13 @@ void nra_plugin_explain_conflict(nra_plugin_t* nra, const int_mset_t* pos, const
     }
   }
 
+  // Check if interval propagation refutes the core
+  if (nra->ctx->options->nra_icp && lemma_reasons->size == 0) {
+    if (nra_plugin_explain_conflict_icp(nra, pos, neg, core, conflict)) {
+      return;
+    }
+  }
+
   // Create the map from variables to
   lp_projection_map_t projection_map;
   lp_projection_map_construct_from_nra(&projection_map, nra);
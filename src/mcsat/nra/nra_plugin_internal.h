@@ -31,6 +31,7 @@
 
 typedef struct poly_constraint_db_struct poly_constraint_db_t;
 typedef struct poly_constraint_struct poly_constraint_t;
+typedef struct projection_cache_struct projection_cache_t;
 
 struct nra_plugin_s {
 
@@ -88,6 +89,7 @@ struct nra_plugin_s {
     statistic_int_t* evaluations;
     statistic_int_t* constraint_regular;
     statistic_int_t* constraint_root;
+    statistic_int_t* icp_conflicts;
   } stats;
 
   /** Database of polynomial constraints */
@@ -96,6 +98,9 @@ struct nra_plugin_s {
   /** Map from variables to their feasible sets */
   feasible_set_db_t* feasible_set_db;
 
+  /** Cache of projection results for explanations */
+  projection_cache_t* projection_cache;
+
   /** Data related to libpoly */
   struct {
 
@@ -136,6 +141,12 @@ struct nra_plugin_s {
 
 };
 
+/** Check if the variable is assigned, and the assignment has been processed by the plugin */
+static inline
+bool nra_plugin_has_assignment(const nra_plugin_t* nra, variable_t x) {
+  return trail_has_value(nra->ctx->trail, x) && trail_get_index(nra->ctx->trail, x) < nra->trail_i;
+}
+
 /**
  * Gets all the arithmetic variables from a non-atom t and adds their corresponding
  * mcsat variable to vars_out.
@@ -250,6 +250,12 @@ lp_feasibility_set_t* poly_constraint_get_feasible_set(const poly_constraint_t*
   return feasible;
 }
 
+/** Check if interval I is strictly tighter than interval J (I is a subset of J) */
+static
+bool interval_is_tighter(const lp_interval_t* I, const lp_interval_t* J) {
+  return lp_interval_cmp_lower_bounds(I, J) > 0 || lp_interval_cmp_upper_bounds(I, J) < 0;
+}
+
 bool poly_constraint_infer_bounds(const poly_constraint_t* cstr, bool negated, lp_interval_assignment_t* m, ivector_t* inferred_vars) {
 
   // TODO: is it possible to support root constraints
@@ -257,30 +263,43 @@ bool poly_constraint_infer_bounds(const poly_constraint_t* cstr, bool negated, l
     return false;
   }
 
-  // Infer some bounds
-  int inference_result = lp_polynomial_constraint_infer_bounds(cstr->polynomial, cstr->sgn_condition, negated, m);
-  if (inference_result == 0) {
-    return false;
-  }
-  if (inference_result == -1) {
-    return true;
-  }
-
   lp_variable_list_t vars;
   lp_variable_list_construct(&vars);
   lp_polynomial_get_variables(cstr->polynomial, &vars);
+
+  // Remember the current intervals (no interval means the full interval)
   uint32_t var_i;
+  lp_interval_t* old_intervals = safe_malloc(sizeof(lp_interval_t) * vars.list_size);
   for (var_i = 0; var_i < vars.list_size; ++ var_i) {
-    lp_variable_t x_lp = vars.list[var_i];
-    const lp_interval_t* x_interval = lp_interval_assignment_get_interval(m, x_lp);
+    const lp_interval_t* x_interval = lp_interval_assignment_get_interval(m, vars.list[var_i]);
     if (x_interval != NULL) {
-      // something is inferred
-      ivector_push(inferred_vars, x_lp);
+      lp_interval_construct_copy(old_intervals + var_i, x_interval);
+    } else {
+      lp_interval_construct_full(old_intervals + var_i);
     }
   }
+
+  // Infer some bounds
+  int inference_result = lp_polynomial_constraint_infer_bounds(cstr->polynomial, cstr->sgn_condition, negated, m);
+
+  // Report the variables whose interval got strictly tighter
+  if (inference_result == 1) {
+    for (var_i = 0; var_i < vars.list_size; ++ var_i) {
+      lp_variable_t x_lp = vars.list[var_i];
+      const lp_interval_t* x_interval = lp_interval_assignment_get_interval(m, x_lp);
+      if (x_interval != NULL && interval_is_tighter(x_interval, old_intervals + var_i)) {
+        ivector_push(inferred_vars, x_lp);
+      }
+    }
+  }
+
+  for (var_i = 0; var_i < vars.list_size; ++ var_i) {
+    lp_interval_destruct(old_intervals + var_i);
+  }
+  safe_free(old_intervals);
   lp_variable_list_destruct(&vars);
 
-  return false;
+  return inference_result == -1;
 }
 
 bool poly_constraint_resolve_fm(const poly_constraint_t* c0, bool c0_negated, const poly_constraint_t* c1, bool c1_negated, nra_plugin_t* nra, ivector_t* out) {
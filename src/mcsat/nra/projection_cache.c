@@ -0,0 +1,371 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mcsat/nra/projection_cache.h"
+#include "mcsat/nra/nra_plugin_internal.h"
+
+#include "utils/memalloc.h"
+#include "utils/ptr_hash_map.h"
+
+#include <poly/polynomial.h>
+#include <poly/variable_list.h>
+#include <poly/value.h>
+
+/** Maximal number of entries in each of the caches before we reset */
+#define PROJECTION_CACHE_MAX_ENTRIES 10000
+
+/** Cached PSC of (p, q) in x */
+typedef struct psc_cache_entry_s {
+  lp_variable_t x;
+  lp_polynomial_t* p;
+  lp_polynomial_t* q;
+  lp_polynomial_t** psc;
+  uint32_t psc_size;
+  struct psc_cache_entry_s* next;
+} psc_cache_entry_t;
+
+/** Cached roots of p in x, valid for the given timestamp */
+typedef struct roots_cache_entry_s {
+  lp_variable_t x;
+  lp_polynomial_t* p;
+  bool valid;
+  uint32_t timestamp;
+  lp_value_t* roots;
+  size_t roots_size;
+  struct roots_cache_entry_s* next;
+} roots_cache_entry_t;
+
+struct projection_cache_struct {
+
+  /** Map from hashes to lists of PSC entries */
+  ptr_hmap_t psc_cache;
+
+  /** Number of PSC entries */
+  uint32_t psc_cache_size;
+
+  /** Map from hashes to lists of roots entries */
+  ptr_hmap_t roots_cache;
+
+  /** Number of roots entries */
+  uint32_t roots_cache_size;
+
+  /** Temp list of variables */
+  lp_variable_list_t vars;
+
+  /** The plugin */
+  nra_plugin_t* nra;
+
+  /** Statistics */
+  struct {
+    statistic_int_t* psc_hits;
+    statistic_int_t* psc_misses;
+    statistic_int_t* roots_hits;
+    statistic_int_t* roots_misses;
+  } stats;
+};
+
+projection_cache_t* projection_cache_new(nra_plugin_t* nra) {
+  projection_cache_t* cache = safe_malloc(sizeof(projection_cache_t));
+
+  init_ptr_hmap(&cache->psc_cache, 0);
+  cache->psc_cache_size = 0;
+  init_ptr_hmap(&cache->roots_cache, 0);
+  cache->roots_cache_size = 0;
+  lp_variable_list_construct(&cache->vars);
+  cache->nra = nra;
+
+  statistics_t* stats = nra->ctx->stats;
+  cache->stats.psc_hits = statistics_new_int(stats, "mcsat::nra::projection_cache::psc_hits");
+  cache->stats.psc_misses = statistics_new_int(stats, "mcsat::nra::projection_cache::psc_misses");
+  cache->stats.roots_hits = statistics_new_int(stats, "mcsat::nra::projection_cache::roots_hits");
+  cache->stats.roots_misses = statistics_new_int(stats, "mcsat::nra::projection_cache::roots_misses");
+
+  return cache;
+}
+
+static
+void psc_cache_entry_delete(psc_cache_entry_t* entry) {
+  uint32_t i;
+  for (i = 0; i < entry->psc_size; ++ i) {
+    lp_polynomial_delete(entry->psc[i]);
+  }
+  safe_free(entry->psc);
+  lp_polynomial_delete(entry->p);
+  lp_polynomial_delete(entry->q);
+  safe_free(entry);
+}
+
+static
+void roots_cache_entry_delete(roots_cache_entry_t* entry) {
+  size_t i;
+  for (i = 0; i < entry->roots_size; ++ i) {
+    lp_value_destruct(entry->roots + i);
+  }
+  safe_free(entry->roots);
+  lp_polynomial_delete(entry->p);
+  safe_free(entry);
+}
+
+static
+void psc_cache_clear(projection_cache_t* cache) {
+  ptr_hmap_pair_t* it = ptr_hmap_first_record(&cache->psc_cache);
+  for (; it != NULL; it = ptr_hmap_next_record(&cache->psc_cache, it)) {
+    psc_cache_entry_t* entry = it->val;
+    while (entry != NULL) {
+      psc_cache_entry_t* next = entry->next;
+      psc_cache_entry_delete(entry);
+      entry = next;
+    }
+  }
+  ptr_hmap_reset(&cache->psc_cache);
+  cache->psc_cache_size = 0;
+}
+
+static
+void roots_cache_clear(projection_cache_t* cache) {
+  ptr_hmap_pair_t* it = ptr_hmap_first_record(&cache->roots_cache);
+  for (; it != NULL; it = ptr_hmap_next_record(&cache->roots_cache, it)) {
+    roots_cache_entry_t* entry = it->val;
+    while (entry != NULL) {
+      roots_cache_entry_t* next = entry->next;
+      roots_cache_entry_delete(entry);
+      entry = next;
+    }
+  }
+  ptr_hmap_reset(&cache->roots_cache);
+  cache->roots_cache_size = 0;
+}
+
+void projection_cache_reset(projection_cache_t* cache) {
+  psc_cache_clear(cache);
+  roots_cache_clear(cache);
+}
+
+void projection_cache_delete(projection_cache_t* cache) {
+  projection_cache_reset(cache);
+  delete_ptr_hmap(&cache->psc_cache);
+  delete_ptr_hmap(&cache->roots_cache);
+  lp_variable_list_destruct(&cache->vars);
+  safe_free(cache);
+}
+
+/** Hash of the key (non-negative) */
+static inline
+int32_t projection_cache_key(lp_variable_t x, const lp_polynomial_t* p, const lp_polynomial_t* q) {
+  size_t hash = lp_polynomial_hash(p);
+  if (q != NULL) {
+    hash = hash * 31 + lp_polynomial_hash(q);
+  }
+  hash = hash * 31 + x;
+  return (int32_t) (hash & INT32_MAX);
+}
+
+lp_polynomial_t** projection_cache_find_psc(projection_cache_t* cache, lp_variable_t x,
+    const lp_polynomial_t* p, const lp_polynomial_t* q, uint32_t* psc_size) {
+
+  int32_t key = projection_cache_key(x, p, q);
+  ptr_hmap_pair_t* find = ptr_hmap_find(&cache->psc_cache, key);
+  if (find != NULL) {
+    psc_cache_entry_t* entry = find->val;
+    for (; entry != NULL; entry = entry->next) {
+      if (entry->x == x && lp_polynomial_eq(entry->p, p) && lp_polynomial_eq(entry->q, q)) {
+        (*cache->stats.psc_hits) ++;
+        *psc_size = entry->psc_size;
+        return entry->psc;
+      }
+    }
+  }
+
+  return NULL;
+}
+
+bool projection_cache_has_psc(const projection_cache_t* cache, lp_variable_t x,
+    const lp_polynomial_t* p, const lp_polynomial_t* q) {
+
+  int32_t key = projection_cache_key(x, p, q);
+  ptr_hmap_pair_t* find = ptr_hmap_find(&cache->psc_cache, key);
+  if (find != NULL) {
+    psc_cache_entry_t* entry = find->val;
+    for (; entry != NULL; entry = entry->next) {
+      if (entry->x == x && lp_polynomial_eq(entry->p, p) && lp_polynomial_eq(entry->q, q)) {
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
+lp_polynomial_t** projection_cache_add_psc(projection_cache_t* cache, lp_variable_t x,
+    const lp_polynomial_t* p, const lp_polynomial_t* q, lp_polynomial_t** psc, uint32_t psc_size) {
+
+  (*cache->stats.psc_misses) ++;
+
+  // Make space if needed
+  if (cache->psc_cache_size >= PROJECTION_CACHE_MAX_ENTRIES) {
+    psc_cache_clear(cache);
+  }
+
+  psc_cache_entry_t* entry = safe_malloc(sizeof(psc_cache_entry_t));
+  entry->x = x;
+  entry->p = lp_polynomial_new_copy(p);
+  entry->q = lp_polynomial_new_copy(q);
+  entry->psc = psc;
+  entry->psc_size = psc_size;
+
+  // Add to the cache (front of the list)
+  int32_t key = projection_cache_key(x, p, q);
+  ptr_hmap_pair_t* find = ptr_hmap_get(&cache->psc_cache, key);
+  entry->next = find->val;
+  find->val = entry;
+  cache->psc_cache_size ++;
+
+  return entry->psc;
+}
+
+lp_polynomial_t** projection_cache_get_psc(projection_cache_t* cache, lp_variable_t x,
+    const lp_polynomial_t* p, const lp_polynomial_t* q, uint32_t* psc_size) {
+
+  assert(lp_polynomial_top_variable(p) == x);
+  assert(lp_polynomial_top_variable(q) == x);
+
+  // Look it up
+  lp_polynomial_t** psc = projection_cache_find_psc(cache, x, p, q, psc_size);
+  if (psc != NULL) {
+    return psc;
+  }
+
+  // Compute the psc
+  const lp_polynomial_context_t* ctx = cache->nra->lp_data.lp_ctx;
+  size_t p_deg = lp_polynomial_degree(p);
+  size_t q_deg = lp_polynomial_degree(q);
+  uint32_t size = p_deg > q_deg ? q_deg + 1 : p_deg + 1;
+  psc = safe_malloc(sizeof(lp_polynomial_t*)*size);
+  uint32_t i;
+  for (i = 0; i < size; ++ i) {
+    psc[i] = lp_polynomial_new(ctx);
+  }
+  lp_polynomial_psc(psc, p, q);
+
+  *psc_size = size;
+  return projection_cache_add_psc(cache, x, p, q, psc, size);
+}
+
+/**
+ * Get the timestamp of the region of p below x, i.e., the largest timestamp of
+ * the values of all variables of p other than x. Returns false if any of the
+ * variables is not assigned on the trail (e.g. a temporary assignment used in
+ * explanations), in which case the roots can't be cached.
+ */
+static
+bool projection_cache_get_timestamp(projection_cache_t* cache, lp_variable_t x, const lp_polynomial_t* p, uint32_t* timestamp) {
+  nra_plugin_t* nra = cache->nra;
+  const mcsat_trail_t* trail = nra->ctx->trail;
+
+  *timestamp = 0;
+
+  lp_variable_list_t* vars = &cache->vars;
+  lp_variable_list_clear(vars);
+  lp_polynomial_get_variables(p, vars);
+
+  uint32_t i;
+  for (i = 0; i < vars->list_size; ++ i) {
+    lp_variable_t y = vars->list[i];
+    if (y == x) {
+      continue;
+    }
+    variable_t y_var = nra_plugin_get_variable_from_lp_variable(nra, y);
+    if (!nra_plugin_has_assignment(nra, y_var)) {
+      return false;
+    }
+    uint32_t y_timestamp = trail_get_value_timestamp(trail, y_var);
+    assert(y_timestamp > 0);
+    if (y_timestamp > *timestamp) {
+      *timestamp = y_timestamp;
+    }
+  }
+
+  return true;
+}
+
+/** Isolate the roots of p into the entry */
+static
+void roots_cache_entry_isolate(roots_cache_entry_t* entry, const lp_polynomial_t* p, const lp_assignment_t* m) {
+  size_t p_deg = lp_polynomial_degree(p);
+  entry->roots = safe_malloc(sizeof(lp_value_t)*p_deg);
+  entry->roots_size = 0;
+  lp_polynomial_roots_isolate(p, m, entry->roots, &entry->roots_size);
+}
+
+const lp_value_t* projection_cache_get_roots(projection_cache_t* cache, lp_variable_t x,
+    const lp_polynomial_t* p, const lp_assignment_t* m, size_t* roots_size) {
+
+  assert(lp_polynomial_top_variable(p) == x);
+
+  uint32_t timestamp;
+  bool valid = projection_cache_get_timestamp(cache, x, p, &timestamp);
+  int32_t key = projection_cache_key(x, p, NULL);
+
+  // Look it up
+  roots_cache_entry_t* entry = NULL;
+  ptr_hmap_pair_t* find = ptr_hmap_find(&cache->roots_cache, key);
+  if (find != NULL) {
+    for (entry = find->val; entry != NULL; entry = entry->next) {
+      if (entry->x == x && lp_polynomial_eq(entry->p, p)) {
+        break;
+      }
+    }
+  }
+
+  if (entry != NULL) {
+    if (valid && entry->valid && entry->timestamp == timestamp) {
+      // Same region, reuse
+      (*cache->stats.roots_hits) ++;
+      *roots_size = entry->roots_size;
+      return entry->roots;
+    }
+    // Different region, recompute in place
+    size_t i;
+    for (i = 0; i < entry->roots_size; ++ i) {
+      lp_value_destruct(entry->roots + i);
+    }
+    safe_free(entry->roots);
+  } else {
+    // Make space if needed
+    if (cache->roots_cache_size >= PROJECTION_CACHE_MAX_ENTRIES) {
+      roots_cache_clear(cache);
+    }
+    entry = safe_malloc(sizeof(roots_cache_entry_t));
+    entry->x = x;
+    entry->p = lp_polynomial_new_copy(p);
+    // Add to the cache (front of the list)
+    find = ptr_hmap_get(&cache->roots_cache, key);
+    entry->next = find->val;
+    find->val = entry;
+    cache->roots_cache_size ++;
+  }
+
+  (*cache->stats.roots_misses) ++;
+
+  entry->valid = valid;
+  entry->timestamp = timestamp;
+  roots_cache_entry_isolate(entry, p, m);
+
+  *roots_size = entry->roots_size;
+  return entry->roots;
+}
@@ -0,0 +1,88 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <poly/poly.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef struct nra_plugin_s nra_plugin_t;
+
+/**
+ * Cache of projection work for the NRA explanations. The cache survives across
+ * conflicts and keeps two kinds of results:
+ *
+ * - PSC cache: the principal subresultant coefficients of (p, q) with respect
+ *   to variable x. These only depend on the polynomials, so they can be reused
+ *   in any model.
+ *
+ * - Cell cache: the isolated roots of p in x under the current model. These
+ *   depend on the values of the variables of p below x, so the entries are
+ *   keyed by the largest trail timestamp of these variables. Since values can
+ *   only get fresh (larger) timestamps, an entry with the same timestamp was
+ *   computed in the same sample-point region.
+ *
+ * Both caches are bounded, and are cleared when full.
+ */
+typedef struct projection_cache_struct projection_cache_t;
+
+/** Create a new cache */
+projection_cache_t* projection_cache_new(nra_plugin_t* nra);
+
+/** Delete the cache */
+void projection_cache_delete(projection_cache_t* cache);
+
+/** Remove all the cached data */
+void projection_cache_reset(projection_cache_t* cache);
+
+/**
+ * Get the PSC of p and q with respect to x (both must have x as top variable).
+ * The returned array has min(deg(p), deg(q)) + 1 polynomials that are owned by
+ * the cache and remain valid until the next call of this function.
+ */
+lp_polynomial_t** projection_cache_get_psc(projection_cache_t* cache, lp_variable_t x,
+    const lp_polynomial_t* p, const lp_polynomial_t* q, uint32_t* psc_size);
+
+/**
+ * Find the PSC of p and q with respect to x in the cache. Returns NULL if not
+ * cached, otherwise the array is owned by the cache (same as above).
+ */
+lp_polynomial_t** projection_cache_find_psc(projection_cache_t* cache, lp_variable_t x,
+    const lp_polynomial_t* p, const lp_polynomial_t* q, uint32_t* psc_size);
+
+/** Check if the PSC of p and q with respect to x is in the cache */
+bool projection_cache_has_psc(const projection_cache_t* cache, lp_variable_t x,
+    const lp_polynomial_t* p, const lp_polynomial_t* q);
+
+/**
+ * Add the PSC of p and q with respect to x to the cache. The cache takes over
+ * the psc array (allocated with safe_malloc) and the polynomials in it. Returns
+ * the cached array.
+ */
+lp_polynomial_t** projection_cache_add_psc(projection_cache_t* cache, lp_variable_t x,
+    const lp_polynomial_t* p, const lp_polynomial_t* q, lp_polynomial_t** psc, uint32_t psc_size);
+
+/**
+ * Get the roots of p in x in the current model. The polynomial p must have x as
+ * top variable, and all other variables of p must be assigned. The returned roots
+ * are owned by the cache and remain valid until the next call of this function.
+ */
+const lp_value_t* projection_cache_get_roots(projection_cache_t* cache, lp_variable_t x,
+    const lp_polynomial_t* p, const lp_assignment_t* m, size_t* roots_size);
@@ -27,6 +27,11 @@ extern void init_mcsat_options(mcsat_options_t *opts) {
   opts->nra_bound_min = -1;
   opts->nra_bound_max = -1;
   opts->bv_var_size = -1;
+  opts->nra_explain_threads = 1;
+  opts->nra_icp = false;
+  opts->bv_bdd_max_size = -1;
+  opts->lemma_minimize = false;
+  opts->portfolio = 0;
   opts->var_order = NULL;
   opts->model_interpolation = false;
 }
@@ -35,6 +35,11 @@ typedef struct mcsat_options_s {
   int32_t nra_bound_max;
   int32_t bv_var_size;
   bool model_interpolation;
+  int32_t nra_explain_threads;
+  bool nra_icp;
+  int32_t bv_bdd_max_size;
+  bool lemma_minimize;
+  int32_t portfolio;
   // ordering for forcing assignment order
   ivector_t* var_order;
 } mcsat_options_t;
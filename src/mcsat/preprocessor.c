@@ -31,11 +31,13 @@
 
 #include "model/models.h"
 
+#include "utils/int_hash_sets.h"
+
 #include "context/context_types.h"
 
 #include "yices.h"
 
-void preprocessor_construct(preprocessor_t* pre, term_table_t* terms, jmp_buf* handler, const mcsat_options_t* options) {
+void preprocessor_construct(preprocessor_t* pre, term_table_t* terms, jmp_buf* handler, const mcsat_options_t* options, statistics_t* stats) {
   pre->terms = terms;
   init_term_manager(&pre->tm, terms);
   init_int_hmap(&pre->preprocess_map, 0);
@@ -49,6 +51,11 @@ void preprocessor_construct(preprocessor_t* pre, term_table_t* terms, jmp_buf* h
   pre->exception = handler;
   pre->options = options;
   scope_holder_construct(&pre->scope);
+  pre->stats.cache_hits = statistics_new_int(stats, "mcsat::preprocessor::cache_hits");
+  pre->stats.cache_kept = statistics_new_int(stats, "mcsat::preprocessor::cache_kept");
+  pre->stats.cache_size = statistics_new_int(stats, "mcsat::preprocessor::cache_size");
+  pre->stats.cache_memory = statistics_new_int(stats, "mcsat::preprocessor::cache_memory");
+  pre->stats.assertions_removed = statistics_new_int(stats, "mcsat::preprocessor::assertions_removed");
 }
 
 void preprocessor_set_tracer(preprocessor_t* pre, tracer_t* tracer) {
@@ -77,6 +84,17 @@ term_t preprocessor_get(preprocessor_t* pre, term_t t) {
   }
 }
 
+/** Update the size statistics of the cache */
+static
+void preprocessor_update_cache_stats(preprocessor_t* pre) {
+  *pre->stats.cache_size = pre->preprocess_map.nelems;
+  *pre->stats.cache_memory =
+      pre->preprocess_map.size * sizeof(int_hmap_pair_t) +
+      pre->preprocess_map_list.capacity * sizeof(term_t) +
+      pre->purification_map.size * sizeof(int_hmap_pair_t) +
+      pre->purification_map_list.capacity * sizeof(term_t);
+}
+
 static
 void preprocessor_set(preprocessor_t* pre, term_t t, term_t t_pre) {
   assert(preprocessor_get(pre, t) == NULL_TERM);
@@ -362,6 +380,7 @@ term_t preprocessor_apply(preprocessor_t* pre, term_t t, ivector_t* out, bool is
   // Check if already preprocessed;
   term_t t_pre = preprocessor_get(pre, t);
   if (t_pre != NULL_TERM) {
+    (*pre->stats.cache_hits) ++;
     return t_pre;
   }
 
@@ -1066,10 +1085,34 @@ term_t preprocessor_apply(preprocessor_t* pre, term_t t, ivector_t* out, bool is
 
   ivector_reset(pre_stack);
 
+  preprocessor_update_cache_stats(pre);
+
   assert(t_pre != NULL_TERM);
   return t_pre;
 }
 
+void preprocessor_apply_assertions(preprocessor_t* pre, ivector_t* assertions) {
+  uint32_t i, keep;
+  int_hset_t asserted;
+  term_t f_pre;
+
+  init_int_hset(&asserted, 0);
+
+  // New assertions are added at the end, so the loop also goes over these
+  keep = 0;
+  for (i = 0; i < assertions->size; ++ i) {
+    f_pre = preprocessor_apply(pre, assertions->data[i], assertions, true);
+    if (f_pre == true_term || !int_hset_add(&asserted, f_pre)) {
+      (*pre->stats.assertions_removed) ++;
+    } else {
+      assertions->data[keep ++] = f_pre;
+    }
+  }
+  ivector_shrink(assertions, keep);
+
+  delete_int_hset(&asserted);
+}
+
 void preprocessor_set_exception_handler(preprocessor_t* pre, jmp_buf* handler) {
   pre->exception = handler;
 }
@@ -1094,13 +1137,21 @@ void preprocessor_pop(preprocessor_t* pre) {
       &equalities_list_size,
       NULL);
 
-  while (pre->preprocess_map_list.size > preprocess_map_list_size) {
-    term_t t = ivector_last(&pre->preprocess_map_list);
-    ivector_pop(&pre->preprocess_map_list);
+  // Keep the terms that preprocess to themselves. Their subterms also
+  // preprocess to themselves, so these are kept too.
+  uint32_t i, keep = preprocess_map_list_size;
+  for (i = preprocess_map_list_size; i < pre->preprocess_map_list.size; ++ i) {
+    term_t t = pre->preprocess_map_list.data[i];
     int_hmap_pair_t* find = int_hmap_find(&pre->preprocess_map, t);
     assert(find != NULL);
-    int_hmap_erase(&pre->preprocess_map, find);
+    if (find->val == t) {
+      pre->preprocess_map_list.data[keep ++] = t;
+      (*pre->stats.cache_kept) ++;
+    } else {
+      int_hmap_erase(&pre->preprocess_map, find);
+    }
   }
+  ivector_shrink(&pre->preprocess_map_list, keep);
 
   while (pre->purification_map_list.size > purification_map_list_size) {
     term_t t = ivector_last(&pre->purification_map_list);
@@ -1117,6 +1168,8 @@ void preprocessor_pop(preprocessor_t* pre) {
     assert(find != NULL);
     int_hmap_erase(&pre->equalities, find);
   }
+
+  preprocessor_update_cache_stats(pre);
 }
 
 void preprocessor_build_model(preprocessor_t* pre, model_t* model) {
@@ -23,6 +23,7 @@
 #include "io/tracer.h"
 #include "options.h"
 #include "mcsat/utils/scope_holder.h"
+#include "mcsat/utils/statistics.h"
 
 #include <setjmp.h>
 
@@ -70,10 +71,24 @@ typedef struct {
   /** Scope for backtracking */
   scope_holder_t scope;
 
+  /** Statistics */
+  struct {
+    // Terms found in the preprocessing cache
+    statistic_int_t* cache_hits;
+    // Entries of the cache kept on pop
+    statistic_int_t* cache_kept;
+    // Number of entries in the cache
+    statistic_int_t* cache_size;
+    // Memory used by the cache (bytes)
+    statistic_int_t* cache_memory;
+    // Assertions removed by batch preprocessing (duplicate or true)
+    statistic_int_t* assertions_removed;
+  } stats;
+
 } preprocessor_t;
 
 /** Construct the preprocessor */
-void preprocessor_construct(preprocessor_t* pre, term_table_t* terms, jmp_buf* handler, const mcsat_options_t* options);
+void preprocessor_construct(preprocessor_t* pre, term_table_t* terms, jmp_buf* handler, const mcsat_options_t* options, statistics_t* stats);
 
 /** Destruct the preprocessor */
 void preprocessor_destruct(preprocessor_t* pre);
@@ -81,6 +96,13 @@ void preprocessor_destruct(preprocessor_t* pre);
 /** Preprocess the term, add any additional assertions to output vector. */
 term_t preprocessor_apply(preprocessor_t* pre, term_t t, ivector_t* out, bool is_assertion);
 
+/**
+ * Preprocess a batch of assertions in place. Additional assertions are added
+ * at the end and preprocessed too. Assertions that preprocess to true or to an
+ * assertion already in the batch are removed.
+ */
+void preprocessor_apply_assertions(preprocessor_t* pre, ivector_t* assertions);
+
 /** Set tracer */
 void preprocessor_set_tracer(preprocessor_t* pre, tracer_t* tracer);
 
@@ -90,7 +112,11 @@ void preprocessor_set_exception_handler(preprocessor_t* pre, jmp_buf* handler);
 /** Push the preprocessor */
 void preprocessor_push(preprocessor_t* pre);
 
-/** Pop the preprocessor */
+/**
+ * Pop the preprocessor. The cached terms that preprocess to themselves are
+ * kept, since they don't depend on the substitutions or purification
+ * variables of the popped scope.
+ */
 void preprocessor_pop(preprocessor_t* pre);
 
 /** Add any variable substitutions to the model */
@@ -51,6 +51,8 @@
 
 #include "mcsat/utils/statistics.h"
 
+#include "terms/term_explorer.h"
+
 #include "utils/dprng.h"
 #include "model/model_queries.h"
 #include "io/model_printer.h"
@@ -119,6 +121,9 @@ struct mcsat_solver_s {
   /** Context of the solver */
   const context_t* ctx;
 
+  /** Options of the solver (the context options, or a variant in the portfolio) */
+  const mcsat_options_t* options;
+
   /** Flag to stop the search */
   bool stop_search;
 
@@ -277,6 +282,10 @@ struct mcsat_solver_s {
     statistic_avg_t* avg_conflict_size;
     // GC calls
     statistic_int_t* gc_calls;
+    // Literals removed by lemma minimization
+    statistic_int_t* lemma_literals_removed;
+    // Lemmas imported from the other solvers in the portfolio
+    statistic_int_t* portfolio_lemmas;
   } solver_stats;
 
   struct {
@@ -299,6 +308,29 @@ struct mcsat_solver_s {
   uint32_t ite_plugin_id;
   uint32_t nra_plugin_id;
   uint32_t bv_plugin_id;
+
+  /** Portfolio of solvers (see mcsat_portfolio_solve) */
+  struct {
+    // Solver that owns this one (NULL if not a portfolio solver)
+    mcsat_solver_t* parent;
+    // Index of the solver in the portfolio (0 for the main solver)
+    uint32_t id;
+    // Whether to export the short lemmas
+    bool sharing;
+    // The options of this solver (if parent != NULL)
+    mcsat_options_t options;
+    // Short lemmas learned since the last exchange (as terms)
+    ivector_t shared;
+    // Lemmas imported from the other solvers (kept apart from the assertions)
+    int_hset_t imported;
+    // Terms with index above this bound were created during the portfolio search
+    uint32_t terms_bound;
+    // Solvers of the running portfolio search (solvers[0] is this solver),
+    // kept here so that they are deleted if the search is interrupted by an
+    // exception (cf. mcsat_portfolio_delete_solvers)
+    mcsat_solver_t** solvers;
+    uint32_t solvers_count;
+  } portfolio;
 };
 
 static
@@ -321,6 +353,8 @@ void mcsat_stats_init(mcsat_solver_t* mcsat) {
   mcsat->solver_stats.gc_calls = statistics_new_int(&mcsat->stats, "mcsat::gc_calls");
   mcsat->solver_stats.lemmas = statistics_new_int(&mcsat->stats, "mcsat::lemmas");
   mcsat->solver_stats.restarts = statistics_new_int(&mcsat->stats, "mcsat::restarts");
+  mcsat->solver_stats.lemma_literals_removed = statistics_new_int(&mcsat->stats, "mcsat::lemma_literals_removed");
+  mcsat->solver_stats.portfolio_lemmas = statistics_new_int(&mcsat->stats, "mcsat::portfolio_lemmas");
 }
 
 static
@@ -329,6 +363,14 @@ void mcsat_heuristics_init(mcsat_solver_t* mcsat) {
   mcsat->heuristic_params.lemma_restart_weight_type = LEMMA_WEIGHT_SIZE;
   mcsat->heuristic_params.random_decision_freq = 0;
   mcsat->heuristic_params.random_decision_seed = 0;
+  if (mcsat->portfolio.parent != NULL) {
+    // Portfolio solvers get some randomness to diversify the search
+    mcsat->heuristic_params.random_decision_freq = 0.02 * mcsat->portfolio.id;
+    if (mcsat->heuristic_params.random_decision_freq > 1.0) {
+      mcsat->heuristic_params.random_decision_freq = 1.0;
+    }
+    mcsat->heuristic_params.random_decision_seed = mcsat->portfolio.id;
+  }
 }
 
 static
@@ -704,7 +746,7 @@ void mcsat_plugin_context_construct(mcsat_plugin_context_t* ctx, mcsat_solver_t*
   ctx->ctx.terms = mcsat->terms;
   ctx->ctx.types = mcsat->types;
   ctx->ctx.exception = mcsat->exception;
-  ctx->ctx.options = &mcsat->ctx->mcsat_options;
+  ctx->ctx.options = mcsat->options;
   ctx->ctx.trail = mcsat->trail;
   ctx->ctx.stats = &mcsat->stats;
   ctx->ctx.tracer = mcsat->ctx->trace;
@@ -786,17 +828,49 @@ void mcsat_add_plugins(mcsat_solver_t* mcsat) {
   mcsat->bv_plugin_id = mcsat_add_plugin(mcsat, bv_plugin_allocator, "bv_plugin");
 }
 
+/**
+ * Construct the solver. If parent is not NULL, the solver is part of the
+ * portfolio of the parent, with index id > 0, and the options of the parent
+ * are varied depending on id.
+ */
 static
-void mcsat_construct(mcsat_solver_t* mcsat, const context_t* ctx) {
+void mcsat_construct(mcsat_solver_t* mcsat, const context_t* ctx, mcsat_solver_t* parent, uint32_t id) {
   uint32_t i;
 
   assert(ctx != NULL);
   assert(ctx->arch == CTX_ARCH_MCSAT);
   assert(ctx->terms != NULL);
   assert(ctx->types != NULL);
+  assert((parent == NULL) == (id == 0));
 
   mcsat->stop_search = false;
   mcsat->ctx = ctx;
+  mcsat->options = &ctx->mcsat_options;
+
+  // Portfolio
+  mcsat->portfolio.parent = parent;
+  mcsat->portfolio.id = id;
+  mcsat->portfolio.sharing = false;
+  mcsat->portfolio.terms_bound = 0;
+  mcsat->portfolio.solvers = NULL;
+  mcsat->portfolio.solvers_count = 0;
+  init_ivector(&mcsat->portfolio.shared, 0);
+  init_int_hset(&mcsat->portfolio.imported, 0);
+  if (parent != NULL) {
+    // Flip the NRA options with the bits of the id
+    mcsat->portfolio.options = *parent->options;
+    if (id & 1) {
+      mcsat->portfolio.options.nra_mgcd = !mcsat->portfolio.options.nra_mgcd;
+    }
+    if (id & 2) {
+      mcsat->portfolio.options.nra_nlsat = !mcsat->portfolio.options.nra_nlsat;
+    }
+    if (id & 4) {
+      mcsat->portfolio.options.nra_bound = !mcsat->portfolio.options.nra_bound;
+    }
+    mcsat->portfolio.options.portfolio = 0;
+    mcsat->options = &mcsat->portfolio.options;
+  }
   mcsat->exception = (jmp_buf*) &ctx->env;
   mcsat->types = ctx->types;
   mcsat->terms = ctx->terms;
@@ -856,8 +930,12 @@ void mcsat_construct(mcsat_solver_t* mcsat, const context_t* ctx) {
   // Construct the evaluator
   mcsat_evaluator_construct(&mcsat->evaluator, mcsat);
 
+  // Construct stats
+  statistics_construct(&mcsat->stats);
+  mcsat_stats_init(mcsat);
+
   // Construct the preprocessor
-  preprocessor_construct(&mcsat->preprocessor, mcsat->terms, mcsat->exception, &mcsat->ctx->mcsat_options);
+  preprocessor_construct(&mcsat->preprocessor, mcsat->terms, mcsat->exception, mcsat->options, &mcsat->stats);
 
   // The variable queue
   mcsat->top_decision_var = variable_null;
@@ -881,10 +959,6 @@ void mcsat_construct(mcsat_solver_t* mcsat, const context_t* ctx) {
   init_ivector(&mcsat->plugin_definition_vars, 0);
   mcsat->plugin_definition_lemmas_i = 0;
 
-  // Construct stats
-  statistics_construct(&mcsat->stats);
-  mcsat_stats_init(mcsat);
-
   // Scope for backtracking
   scope_holder_construct(&mcsat->scope);
 
@@ -892,10 +966,16 @@ void mcsat_construct(mcsat_solver_t* mcsat, const context_t* ctx) {
   mcsat_add_plugins(mcsat);
 }
 
+static
+void mcsat_portfolio_delete_solvers(mcsat_solver_t* mcsat);
+
 void mcsat_destruct(mcsat_solver_t* mcsat) {
   uint32_t i;
   plugin_t* plugin;
 
+  // Portfolio solvers left by an interrupted search
+  mcsat_portfolio_delete_solvers(mcsat);
+
   // Delete the plugin data
   for (i = 0; i < mcsat->plugins_count; ++ i) {
     // Plugin
@@ -927,11 +1007,13 @@ void mcsat_destruct(mcsat_solver_t* mcsat) {
   scope_holder_destruct(&mcsat->scope);
   delete_ivector(&mcsat->assumption_vars);
   delete_int_hset(&mcsat->internal_kinds);
+  delete_ivector(&mcsat->portfolio.shared);
+  delete_int_hset(&mcsat->portfolio.imported);
 }
 
 mcsat_solver_t* mcsat_new(const context_t* ctx) {
   mcsat_solver_t* mcsat = (mcsat_solver_t*) safe_malloc(sizeof(mcsat_solver_t));
-  mcsat_construct(mcsat, ctx);
+  mcsat_construct(mcsat, ctx, NULL, 0);
   return mcsat;
 }
 
@@ -957,7 +1039,7 @@ void mcsat_reset(mcsat_solver_t* mcsat) {
   // Reset everything
   const context_t* ctx = mcsat->ctx;
   mcsat_destruct(mcsat);
-  mcsat_construct(mcsat, ctx);
+  mcsat_construct(mcsat, ctx, NULL, 0);
 }
 
 static
@@ -1114,7 +1196,9 @@ void mcsat_pop(mcsat_solver_t* mcsat) {
 
 void mcsat_clear(mcsat_solver_t* mcsat) {
   // Clear to be ready for more assertions:
+  // - Delete the portfolio solvers if the search was interrupted
   // - Pop internal to base level
+  mcsat_portfolio_delete_solvers(mcsat);
   mcsat->assumption_i = 0;
   mcsat->assumptions_decided_level = -1;
   mcsat_backtrack_to(mcsat, mcsat->trail->decision_level_base);
@@ -1588,6 +1672,114 @@ bool mcsat_decide_one_of(mcsat_solver_t* mcsat, ivector_t* literals, term_t boun
   }
 }
 
+/** Lemmas up to this size are shared with the other solvers in the portfolio */
+#define MCSAT_PORTFOLIO_LEMMA_SIZE 3
+
+/**
+ * Check if the term can be sent to the other solvers in the portfolio. This is
+ * the case if it doesn't contain any variables created during the portfolio
+ * search (e.g. by the preprocessor), since these are local to the solver.
+ */
+static
+bool mcsat_portfolio_term_is_shareable(mcsat_solver_t* mcsat, term_t t) {
+  term_table_t* terms = mcsat->terms;
+  ivector_t todo;
+  int_hset_t visited;
+  bool shareable;
+  uint32_t i, n;
+
+  init_ivector(&todo, 0);
+  init_int_hset(&visited, 0);
+  ivector_push(&todo, unsigned_term(t));
+  shareable = true;
+
+  while (shareable && todo.size > 0) {
+    t = ivector_pop2(&todo);
+    // Subterms are created before the terms that contain them, so old terms are fine
+    if (index_of(t) < mcsat->portfolio.terms_bound || !int_hset_add(&visited, t)) {
+      continue;
+    }
+    switch (term_kind(terms, t)) {
+    case UNINTERPRETED_TERM:
+    case VARIABLE:
+      shareable = false;
+      break;
+    case ARITH_POLY: {
+      polynomial_t* p = poly_term_desc(terms, t);
+      for (i = 0; i < p->nterms; ++ i) {
+        if (p->mono[i].var != const_idx) {
+          ivector_push(&todo, p->mono[i].var);
+        }
+      }
+      break;
+    }
+    case BV64_POLY: {
+      bvpoly64_t* p = bvpoly64_term_desc(terms, t);
+      for (i = 0; i < p->nterms; ++ i) {
+        if (p->mono[i].var != const_idx) {
+          ivector_push(&todo, p->mono[i].var);
+        }
+      }
+      break;
+    }
+    case BV_POLY: {
+      bvpoly_t* p = bvpoly_term_desc(terms, t);
+      for (i = 0; i < p->nterms; ++ i) {
+        if (p->mono[i].var != const_idx) {
+          ivector_push(&todo, p->mono[i].var);
+        }
+      }
+      break;
+    }
+    case POWER_PRODUCT: {
+      pprod_t* pp = pprod_term_desc(terms, t);
+      for (i = 0; i < pp->len; ++ i) {
+        ivector_push(&todo, pp->prod[i].var);
+      }
+      break;
+    }
+    default:
+      if (term_is_projection(terms, t)) {
+        ivector_push(&todo, unsigned_term(proj_term_arg(terms, t)));
+      } else if (term_is_composite(terms, t)) {
+        n = term_num_children(terms, t);
+        for (i = 0; i < n; ++ i) {
+          ivector_push(&todo, unsigned_term(term_child(terms, t, i)));
+        }
+      }
+      break;
+    }
+  }
+
+  delete_int_hset(&visited);
+  delete_ivector(&todo);
+
+  return shareable;
+}
+
+/** Remember the lemma for the other solvers in the portfolio, if short enough */
+static
+void mcsat_portfolio_export_lemma(mcsat_solver_t* mcsat, const ivector_t* lemma) {
+  term_t disjuncts[MCSAT_PORTFOLIO_LEMMA_SIZE];
+  uint32_t i;
+
+  if (lemma->size > MCSAT_PORTFOLIO_LEMMA_SIZE) {
+    return;
+  }
+  for (i = 0; i < lemma->size; ++ i) {
+    if (!mcsat_portfolio_term_is_shareable(mcsat, lemma->data[i])) {
+      return;
+    }
+    disjuncts[i] = lemma->data[i];
+  }
+
+  if (lemma->size == 1) {
+    ivector_push(&mcsat->portfolio.shared, disjuncts[0]);
+  } else {
+    ivector_push(&mcsat->portfolio.shared, mk_or(&mcsat->tm, lemma->size, disjuncts));
+  }
+}
+
 /**
  * Add a lemma (a disjunction). Each lemma needs to lead to some progress. This
  * means that:
@@ -1607,6 +1799,11 @@ void mcsat_add_lemma(mcsat_solver_t* mcsat, ivector_t* lemma, term_t decision_bo
 
   (*mcsat->solver_stats.lemmas)++;
 
+  // Share with the portfolio
+  if (mcsat->portfolio.sharing) {
+    mcsat_portfolio_export_lemma(mcsat, lemma);
+  }
+
   // assert(int_queue_is_empty(&mcsat->registration_queue));
   // TODO: revisit this. it's done in integer solver to do splitting in
   // conflict analysis
@@ -1765,6 +1962,113 @@ void propagation_check(const ivector_t* reasons, term_t x, term_t subst) {
    yices_free_config(config);
 }
 
+/** Max depth of the redundancy check in lemma minimization */
+#define MCSAT_MINIMIZE_MAX_DEPTH 64
+
+static
+bool mcsat_lemma_literal_is_redundant(mcsat_solver_t* mcsat, term_t t, const int_hset_t* lemma_literals, int_hmap_t* cache, uint32_t depth);
+
+/**
+ * Check if the true literal t is implied by the negated lemma literals through
+ * Boolean propagations. Literals at base level are implied. Decisions and
+ * semantic propagations (by theory plugins) are not expanded, since their
+ * reasons are not clauses in the database.
+ */
+static
+bool mcsat_lemma_literal_is_implied(mcsat_solver_t* mcsat, term_t t, const int_hset_t* lemma_literals, int_hmap_t* cache, uint32_t depth) {
+  uint32_t i;
+  bool implied;
+  ivector_t reasons;
+  const mcsat_trail_t* trail = mcsat->trail;
+
+  variable_t t_var = variable_db_get_variable_if_exists(mcsat->var_db, unsigned_term(t));
+  if (t_var == variable_null || !trail_has_value(trail, t_var)) {
+    return false;
+  }
+  if (trail_get_level(trail, t_var) <= trail->decision_level_base) {
+    return true;
+  }
+  if (depth >= MCSAT_MINIMIZE_MAX_DEPTH) {
+    return false;
+  }
+  if (trail_get_assignment_type(trail, t_var) != PROPAGATION) {
+    return false;
+  }
+  if (trail_get_source_id(trail, t_var) != mcsat->bool_plugin_id) {
+    return false;
+  }
+
+  // Propagated by a clause, check the reasons
+  init_ivector(&reasons, 0);
+  bool_plugin_get_reason_literals(mcsat->plugins[mcsat->bool_plugin_id].plugin, t_var, &reasons);
+  implied = true;
+  for (i = 0; implied && i < reasons.size; ++ i) {
+    implied = mcsat_lemma_literal_is_redundant(mcsat, reasons.data[i], lemma_literals, cache, depth + 1);
+  }
+  delete_ivector(&reasons);
+
+  return implied;
+}
+
+/** Check if the true literal t is implied by the negated lemma literals (cached) */
+static
+bool mcsat_lemma_literal_is_redundant(mcsat_solver_t* mcsat, term_t t, const int_hset_t* lemma_literals, int_hmap_t* cache, uint32_t depth) {
+  int_hmap_pair_t* find;
+  bool redundant;
+
+  // In the lemma as a literal
+  if (int_hset_member((int_hset_t*) lemma_literals, opposite_term(t))) {
+    return true;
+  }
+
+  find = int_hmap_find(cache, t);
+  if (find != NULL) {
+    return find->val;
+  }
+
+  redundant = mcsat_lemma_literal_is_implied(mcsat, t, lemma_literals, cache, depth);
+  int_hmap_add(cache, t, redundant);
+
+  return redundant;
+}
+
+/**
+ * Remove the lemma literals that are implied by the other literals, through
+ * Boolean propagations (recursive clause minimization). The lemma literals
+ * are false in the trail, except for the ones at the conflict level.
+ */
+static
+void mcsat_minimize_lemma(mcsat_solver_t* mcsat, ivector_t* lemma) {
+  uint32_t i, to_keep;
+  term_t lit;
+  int_hset_t lemma_literals;
+  int_hmap_t cache;
+
+  init_int_hset(&lemma_literals, 0);
+  init_int_hmap(&cache, 0);
+
+  for (i = 0; i < lemma->size; ++ i) {
+    int_hset_add(&lemma_literals, lemma->data[i]);
+  }
+
+  for (i = 0, to_keep = 0; i < lemma->size; ++ i) {
+    lit = lemma->data[i];
+    if (mcsat_lemma_literal_is_implied(mcsat, opposite_term(lit), &lemma_literals, &cache, 0)) {
+      (*mcsat->solver_stats.lemma_literals_removed) ++;
+      if (trace_enabled(mcsat->ctx->trace, "mcsat::lemma")) {
+        mcsat_trace_printf(mcsat->ctx->trace, "minimize: removing ");
+        trace_term_ln(mcsat->ctx->trace, mcsat->ctx->terms, lit);
+      }
+    } else {
+      lemma->data[to_keep++] = lit;
+    }
+  }
+  ivector_shrink(lemma, to_keep);
+
+  delete_int_hmap(&cache);
+  delete_int_hset(&lemma_literals);
+}
+
 static
 uint32_t mcsat_compute_backtrack_level(mcsat_solver_t* mcsat, uint32_t level) {
   uint32_t backtrack_level = mcsat->trail->decision_level_base;
@@ -1976,6 +2280,7 @@ void mcsat_analyze_conflicts(mcsat_solver_t* mcsat, uint32_t* restart_resource)
   term_t substitution;
 
   ivector_t* conflict_disjuncts;
+  ivector_t lemma;
 
   init_ivector(&reason, 0);
   trace = mcsat->ctx->trace;
@@ -2000,7 +2305,7 @@ void mcsat_analyze_conflicts(mcsat_solver_t* mcsat, uint32_t* restart_resource)
   if (mcsat->variable_in_conflict != variable_null) {
     // This conflict happened because an assumption conflicts with an already
     // propagated value. We're unsat here, but we need to produce a clause
-    if (mcsat->ctx->mcsat_options.model_interpolation) {
+    if (mcsat->options->model_interpolation) {
       if (plugin) {
         term_t t = plugin->explain_propagation(plugin, mcsat->variable_in_conflict, &reason);
         term_t x = variable_db_get_term(mcsat->var_db, mcsat->variable_in_conflict);
@@ -2178,7 +2483,7 @@ void mcsat_analyze_conflicts(mcsat_solver_t* mcsat, uint32_t* restart_resource)
 
   if (mcsat_conflict_with_assumptions(mcsat, conflict_level)) {
     mcsat->status = STATUS_UNSAT;
-    if (mcsat->ctx->mcsat_options.model_interpolation) {
+    if (mcsat->options->model_interpolation) {
       mcsat->interpolant = mcsat_analyze_final(mcsat, &conflict);
     }
     mcsat->assumptions_decided_level = -1;
@@ -2191,24 +2496,30 @@ void mcsat_analyze_conflicts(mcsat_solver_t* mcsat, uint32_t* restart_resource)
     assert(conflict.level == mcsat->trail->decision_level);
     mcsat_backtrack_to(mcsat, mcsat->trail->decision_level - 1);
 
-    // Get the literals
+    // Get the literals (minimize a copy, the list belongs to the conflict's multiset)
     conflict_disjuncts = conflict_get_literals(&conflict);
+    init_ivector(&lemma, conflict_disjuncts->size);
+    ivector_copy(&lemma, conflict_disjuncts->data, conflict_disjuncts->size);
+    if (mcsat->options->lemma_minimize) {
+      mcsat_minimize_lemma(mcsat, &lemma);
+    }
 
     if (trace_enabled(trace, "mcsat::conflict")) {
       mcsat_trace_printf(trace, "conflict_disjuncts:\n");
       uint32_t i;
-      for (i = 0; i < conflict_disjuncts->size; ++i) {
+      for (i = 0; i < lemma.size; ++i) {
         mcsat_trace_printf(trace, "[%u]: ", i);
-        trace_term_ln(trace, mcsat->ctx->terms, conflict_disjuncts->data[i]);
+        trace_term_ln(trace, mcsat->ctx->terms, lemma.data[i]);
       }
     }
 
     // Now add the lemma
-    mcsat_add_lemma(mcsat, conflict_disjuncts, decision_bound);
+    mcsat_add_lemma(mcsat, &lemma, decision_bound);
 
     // Use resources based on conflict size
-    *restart_resource += mcsat_get_lemma_weight(mcsat, conflict_disjuncts,
+    *restart_resource += mcsat_get_lemma_weight(mcsat, &lemma,
         mcsat->heuristic_params.lemma_restart_weight_type);
+    delete_ivector(&lemma);
 
     // Bump the variables
     mcsat_bump_variables_mset(mcsat, conflict_get_variables_all(&conflict));
@@ -2342,7 +2653,7 @@ bool mcsat_decide(mcsat_solver_t* mcsat) {
 
     // If there is an order that was passed in, try that
     if (var == variable_null) {
-      const ivector_t* order = mcsat->ctx->mcsat_options.var_order;
+      const ivector_t* order = mcsat->options->var_order;
       if (order != NULL) {
         uint32_t i;
         if (trace_enabled(mcsat->ctx->trace, "mcsat::decide")) {
@@ -2522,66 +2833,30 @@ void mcsat_check_model(mcsat_solver_t* mcsat, bool assert) {
 static
 void mcsat_assert_formulas_internal(mcsat_solver_t* mcsat, uint32_t n, const term_t *f, bool preprocess);
 
-void mcsat_solve(mcsat_solver_t* mcsat, const param_t *params, model_t* mdl, uint32_t n_assumptions, const term_t assumptions[]) {
-
-  uint32_t restart_resource;
-  luby_t luby;
-
-  // Make sure we have variables for all the assumptions
-  if (n_assumptions > 0) {
-    if (trace_enabled(mcsat->ctx->trace, "mcsat")) {
-      mcsat_trace_printf(mcsat->ctx->trace, "solving with assumptions\n");
-    }
-    assert(mcsat->assumption_vars.size == 0);
-    uint32_t i;
-    for (i = 0; i < n_assumptions; ++ i) {
-      // Apply the pre-processor. If the variable is substituted, we
-      // need to add the equality x = t
-      term_t x = assumptions[i];
-      assert(term_kind(mcsat->terms, x) == UNINTERPRETED_TERM || term_kind(mcsat->terms, x) == VARIABLE);
-      assert(is_pos_term(x));
-      term_t x_pre = preprocessor_apply(&mcsat->preprocessor, x, NULL, true);
-      if (x != x_pre) {
-        // Assert x = t although we solved it already :(
-        term_t eq = mk_eq(&mcsat->tm, x, x_pre);
-        mcsat_assert_formulas_internal(mcsat, 1, &eq, false);
-      }
-      // Make sure the variable is registered (maybe it doesn't appear in assertions)
-      variable_t x_var = variable_db_get_variable(mcsat->var_db, unsigned_term(x));
-      ivector_push(&mcsat->assumption_vars, x_var);
-      mcsat_process_registeration_queue(mcsat);
-    }
-  }
-
-  // Initialize assumption info
-  mcsat->interpolant = NULL_TERM;
-  mcsat->variable_in_conflict = variable_null;
-  mcsat->assumption_i = 0;
-  mcsat->assumptions_decided_level = -1;
-  mcsat->assumptions_model = mdl;
+static
+void mcsat_add_formulas(mcsat_solver_t* mcsat, uint32_t n, const term_t *f, bool preprocess);
 
-  // Start the search
-  mcsat->status = STATUS_SEARCHING;
+/** Check if the search should stop (in the portfolio, the parent can stop it) */
+static inline
+bool mcsat_search_stopped(const mcsat_solver_t* mcsat) {
+  return mcsat->stop_search || (mcsat->portfolio.parent != NULL && mcsat->portfolio.parent->stop_search);
+}
 
-  // If we're already unsat, just return
-  if (!mcsat_is_consistent(mcsat)) {
-    mcsat->interpolant = false_term;
-    mcsat->status = STATUS_UNSAT;
-    assert(int_queue_is_empty(&mcsat->registration_queue));
-    goto solve_done;
-  }
+/**
+ * Run the search until SAT, UNSAT, stop, or until conflict_budget conflicts
+ * have been analyzed (if conflict_budget > 0). The status remains
+ * STATUS_SEARCHING if the search is not finished.
+ */
+static
+void mcsat_search(mcsat_solver_t* mcsat, model_t* mdl, uint32_t n_assumptions, const term_t assumptions[], uint32_t conflict_budget) {
 
-  if (trace_enabled(mcsat->ctx->trace, "mcsat::solve")) {
-    static int count = 0;
-    mcsat_trace_printf(mcsat->ctx->trace, "solve %d\n", count ++);
-  }
+  uint32_t restart_resource;
+  uint32_t conflicts;
+  luby_t luby;
 
-  // Remember existing terms
-  mcsat->terms_size_on_solver_entry = mcsat->terms->nelems;
+  assert(mcsat->status == STATUS_SEARCHING);
 
-  // Initialize for search
-  mcsat_heuristics_init(mcsat);
-  mcsat_notify_plugins(mcsat, MCSAT_SOLVER_START);
+  conflicts = 0;
 
   // Initialize the Luby sequence with interval 10
   restart_resource = 0;
@@ -2590,7 +2865,12 @@ void mcsat_solve(mcsat_solver_t* mcsat, const param_t *params, model_t* mdl, uin
   // Whether to run learning
   bool learning = true;
 
-  while (!mcsat->stop_search) {
+  while (!mcsat_search_stopped(mcsat)) {
+
+    // Stop if out of budget
+    if (conflict_budget > 0 && conflicts >= conflict_budget && mcsat_is_consistent(mcsat)) {
+      break;
+    }
 
     // Do we restart
     if (mcsat_is_consistent(mcsat) && restart_resource > luby.restart_threshold) {
@@ -2642,6 +2922,7 @@ void mcsat_solve(mcsat_solver_t* mcsat, const param_t *params, model_t* mdl, uin
 
     // Nothing to decide, we're satisfiable
     mcsat->status = STATUS_SAT;
+    trail_save_values(mcsat->trail);
     if (trace_enabled(mcsat->ctx->trace, "mcsat::model::check")) {
       mcsat_check_model(mcsat, true);
     }
@@ -2651,6 +2932,7 @@ void mcsat_solve(mcsat_solver_t* mcsat, const param_t *params, model_t* mdl, uin
   conflict:
 
     (*mcsat->solver_stats.conflicts)++;
+    conflicts ++;
     mcsat_notify_plugins(mcsat, MCSAT_SOLVER_CONFLICT);
 
     // If at level 0 we're unsat
@@ -2670,6 +2952,262 @@ void mcsat_solve(mcsat_solver_t* mcsat, const param_t *params, model_t* mdl, uin
 
     var_queue_decay_activities(&mcsat->var_queue);
   }
+}
+
+/** Initial number of conflicts per solver in a portfolio round (doubled each round) */
+#define MCSAT_PORTFOLIO_BUDGET 100
+
+/**
+ * Add the lemmas in shared to the solver. The lemmas are added as clauses at
+ * the base level, but not as assertions: they are not in assertion_terms_original
+ * so they are not checked in the model, and not used in interpolants and cores.
+ * Lemmas that were already imported are skipped.
+ */
+static
+void mcsat_portfolio_import_lemmas(mcsat_solver_t* mcsat, const ivector_t* shared) {
+  ivector_t lemmas;
+  uint32_t i;
+
+  assert(trail_is_at_base_level(mcsat->trail));
+
+  init_ivector(&lemmas, 0);
+  for (i = 0; i < shared->size; ++ i) {
+    if (int_hset_add(&mcsat->portfolio.imported, shared->data[i])) {
+      ivector_push(&lemmas, shared->data[i]);
+    }
+  }
+  if (lemmas.size > 0) {
+    mcsat_add_formulas(mcsat, lemmas.size, lemmas.data, true);
+    (*mcsat->solver_stats.portfolio_lemmas) += lemmas.size;
+  }
+  delete_ivector(&lemmas);
+}
+
+/** Send the lemmas shared by solvers[from] to all the other solvers */
+static
+void mcsat_portfolio_exchange(mcsat_solver_t** solvers, uint32_t n, uint32_t from) {
+  ivector_t* shared = &solvers[from]->portfolio.shared;
+  uint32_t i;
+
+  if (shared->size > 0) {
+    for (i = 0; i < n; ++ i) {
+      if (i != from && mcsat_is_consistent(solvers[i])) {
+        mcsat_portfolio_import_lemmas(solvers[i], shared);
+      }
+    }
+    ivector_reset(shared);
+  }
+}
+
+/** Use the model of the solver that found SAT as the preferred values of the main solver */
+static
+void mcsat_portfolio_import_model(mcsat_solver_t* mcsat, mcsat_solver_t* winner) {
+  ivector_t* trail_elements = &winner->trail->elements;
+  variable_t x, y;
+  term_t x_term;
+  uint32_t i;
+
+  for (i = 0; i < trail_elements->size; ++ i) {
+    x = trail_elements->data[i];
+    x_term = variable_db_get_term(winner->var_db, x);
+    y = variable_db_get_variable_if_exists(mcsat->var_db, x_term);
+    if (y != variable_null && !trail_has_value(mcsat->trail, y)) {
+      trail_set_cached_value(mcsat->trail, y, trail_get_value(winner->trail, x));
+    }
+  }
+}
+
+/**
+ * Delete the other solvers of the portfolio search and stop sharing. This is
+ * called at the end of the search, and when the solver is cleared or deleted
+ * after a search interrupted by an exception.
+ */
+static
+void mcsat_portfolio_delete_solvers(mcsat_solver_t* mcsat) {
+  uint32_t i;
+
+  if (mcsat->portfolio.solvers == NULL) {
+    return;
+  }
+
+  assert(mcsat->portfolio.solvers[0] == mcsat);
+  for (i = 1; i < mcsat->portfolio.solvers_count; ++ i) {
+    mcsat_destruct(mcsat->portfolio.solvers[i]);
+    safe_free(mcsat->portfolio.solvers[i]);
+  }
+  safe_free(mcsat->portfolio.solvers);
+  mcsat->portfolio.solvers = NULL;
+  mcsat->portfolio.solvers_count = 0;
+
+  mcsat->portfolio.sharing = false;
+  ivector_reset(&mcsat->portfolio.shared);
+  int_hset_reset(&mcsat->portfolio.imported);
+}
+
+/**
+ * Portfolio search: run the main solver together with options->portfolio - 1
+ * solvers that use different options, random decisions and initial variable
+ * order. This is a sequential scheduler: the solvers run one after the other in
+ * round-robin with a conflict budget, and after each run the short lemmas
+ * learned by the solver are added to the others as clauses (sent as terms,
+ * since the variables are local). The solvers can't run in separate threads
+ * since the search creates new terms in the shared term table.
+ *
+ * If one of the solvers shows unsat, the main solver is marked unsat. If one of
+ * them finds a model, the main solver continues with that model as the
+ * preferred values, so that the main solver finds the model itself.
+ */
+static
+void mcsat_portfolio_solve(mcsat_solver_t* mcsat) {
+  mcsat_solver_t** solvers;
+  mcsat_solver_t* solver;
+  mcsat_solver_t* winner;
+  uint32_t i, j, n, budget;
+  variable_t x;
+  double seed;
+
+  assert(mcsat->portfolio.parent == NULL);
+  assert(trail_is_at_base_level(mcsat->trail));
+
+  n = mcsat->options->portfolio;
+  solvers = (mcsat_solver_t**) safe_malloc(n * sizeof(mcsat_solver_t*));
+  solvers[0] = mcsat;
+  mcsat->portfolio.solvers = solvers;
+  mcsat->portfolio.solvers_count = 1;
+
+  // Terms created from now on are local to the solvers
+  mcsat->portfolio.terms_bound = mcsat->terms->nelems;
+  mcsat->portfolio.sharing = true;
+
+  // Construct the other solvers with all the assertions
+  for (i = 1; i < n; ++ i) {
+    solver = (mcsat_solver_t*) safe_malloc(sizeof(mcsat_solver_t));
+    mcsat_construct(solver, mcsat->ctx, mcsat, i);
+    mcsat_set_exception_handler(solver, mcsat->exception);
+    for (j = 0; j < solver->plugins_count; ++ j) {
+      solver->plugins[j].plugin_ctx->ctx.stop_search = &mcsat->stop_search;
+    }
+    solvers[i] = solver;
+    mcsat->portfolio.solvers_count = i + 1;
+    mcsat_assert_formulas_internal(solver, mcsat->assertion_terms_original.size, mcsat->assertion_terms_original.data, true);
+    solver->portfolio.terms_bound = mcsat->portfolio.terms_bound;
+    solver->portfolio.sharing = true;
+    solver->terms_size_on_solver_entry = mcsat->terms_size_on_solver_entry;
+    solver->interpolant = NULL_TERM;
+    solver->status = STATUS_SEARCHING;
+    mcsat_heuristics_init(solver);
+    mcsat_notify_plugins(solver, MCSAT_SOLVER_START);
+    // Shuffle the initial variable order
+    seed = i;
+    for (x = 1; x < solver->var_queue.size; ++ x) {
+      if (solver->var_queue.heap_index[x] >= 0) {
+        var_queue_bump_variable(&solver->var_queue, x, 1 + irand(&seed, 8));
+      }
+    }
+  }
+
+  // Round-robin until someone is done
+  winner = NULL;
+  budget = MCSAT_PORTFOLIO_BUDGET;
+  while (winner == NULL && !mcsat->stop_search) {
+    for (i = 0; i < n && winner == NULL; ++ i) {
+      solver = solvers[i];
+      mcsat_search(solver, NULL, 0, NULL, budget);
+      if (solver->status != STATUS_SEARCHING) {
+        winner = solver;
+      } else {
+        mcsat_backtrack_to(solver, solver->trail->decision_level_base);
+        mcsat_process_registeration_queue(solver);
+        mcsat_portfolio_exchange(solvers, n, i);
+      }
+    }
+    budget *= 2;
+  }
+
+  if (winner != NULL && winner != mcsat) {
+    if (winner->status == STATUS_UNSAT) {
+      mcsat->status = STATUS_UNSAT;
+      mcsat->interpolant = false_term;
+    } else {
+      assert(winner->status == STATUS_SAT);
+      mcsat_portfolio_import_model(mcsat, winner);
+    }
+  }
+
+  // Delete the other solvers
+  mcsat_portfolio_delete_solvers(mcsat);
+}
+
+void mcsat_solve(mcsat_solver_t* mcsat, const param_t *params, model_t* mdl, uint32_t n_assumptions, const term_t assumptions[]) {
+
+  // Make sure we have variables for all the assumptions
+  if (n_assumptions > 0) {
+    if (trace_enabled(mcsat->ctx->trace, "mcsat")) {
+      mcsat_trace_printf(mcsat->ctx->trace, "solving with assumptions\n");
+    }
+    assert(mcsat->assumption_vars.size == 0);
+    uint32_t i;
+    for (i = 0; i < n_assumptions; ++ i) {
+      // Apply the pre-processor. If the variable is substituted, we
+      // need to add the equality x = t
+      term_t x = assumptions[i];
+      assert(term_kind(mcsat->terms, x) == UNINTERPRETED_TERM || term_kind(mcsat->terms, x) == VARIABLE);
+      assert(is_pos_term(x));
+      term_t x_pre = preprocessor_apply(&mcsat->preprocessor, x, NULL, true);
+      if (x != x_pre) {
+        // Assert x = t although we solved it already :(
+        term_t eq = mk_eq(&mcsat->tm, x, x_pre);
+        mcsat_assert_formulas_internal(mcsat, 1, &eq, false);
+      }
+      // Make sure the variable is registered (maybe it doesn't appear in assertions)
+      variable_t x_var = variable_db_get_variable(mcsat->var_db, unsigned_term(x));
+      ivector_push(&mcsat->assumption_vars, x_var);
+      mcsat_process_registeration_queue(mcsat);
+    }
+  }
+
+  // Initialize assumption info
+  mcsat->interpolant = NULL_TERM;
+  mcsat->variable_in_conflict = variable_null;
+  mcsat->assumption_i = 0;
+  mcsat->assumptions_decided_level = -1;
+  mcsat->assumptions_model = mdl;
+
+  // Start the search
+  mcsat->status = STATUS_SEARCHING;
+
+  // If we're already unsat, just return
+  if (!mcsat_is_consistent(mcsat)) {
+    mcsat->interpolant = false_term;
+    mcsat->status = STATUS_UNSAT;
+    assert(int_queue_is_empty(&mcsat->registration_queue));
+    goto solve_done;
+  }
+
+  if (trace_enabled(mcsat->ctx->trace, "mcsat::solve")) {
+    static int count = 0;
+    mcsat_trace_printf(mcsat->ctx->trace, "solve %d\n", count ++);
+  }
+
+  // Remember existing terms
+  mcsat->terms_size_on_solver_entry = mcsat->terms->nelems;
+
+  // Prefer the values of the last model
+  trail_restore_cached_values(mcsat->trail);
+
+  // Initialize for search
+  mcsat_heuristics_init(mcsat);
+  mcsat_notify_plugins(mcsat, MCSAT_SOLVER_START);
+
+  // Run the portfolio first (it might finish the search)
+  if (n_assumptions == 0 && mcsat->portfolio.parent == NULL && mcsat->options->portfolio > 1) {
+    mcsat_portfolio_solve(mcsat);
+  }
+
+  // Search
+  if (mcsat->status == STATUS_SEARCHING) {
+    mcsat_search(mcsat, mdl, n_assumptions, assumptions, 0);
+  }
 
   if (mcsat->stop_search) {
     if (mcsat->status == STATUS_SEARCHING) {
@@ -2715,15 +3253,11 @@ void mcsat_flush_lemmas(mcsat_solver_t* mcsat, ivector_t* out) {
   mcsat->plugin_definition_lemmas_i = mcsat->plugin_definition_lemmas.size;
 }
 
+/** Preprocess and assert the formulas, without recording them as original assertions */
 static
-void mcsat_assert_formulas_internal(mcsat_solver_t* mcsat, uint32_t n, const term_t *f, bool preprocess) {
+void mcsat_add_formulas(mcsat_solver_t* mcsat, uint32_t n, const term_t *f, bool preprocess) {
   uint32_t i;
 
-  // Remember the original assertions
-  for (i = 0; i < n; ++ i) {
-    ivector_push(&mcsat->assertion_terms_original, f[i]);
-  }
-
   // Add any leftover lemmas
   ivector_t* assertions = &mcsat->assertions_tmp;
   ivector_reset(assertions);
@@ -2734,11 +3268,7 @@ void mcsat_assert_formulas_internal(mcsat_solver_t* mcsat, uint32_t n, const ter
 
   // Preprocess the formulas (preprocessor might throw)
   if (preprocess) {
-    for (i = 0; i < assertions->size; ++ i) {
-      term_t f = assertions->data[i];
-      term_t f_pre = preprocessor_apply(&mcsat->preprocessor, f, assertions, true);
-      assertions->data[i] = f_pre;
-    }
+    preprocessor_apply_assertions(&mcsat->preprocessor, assertions);
   }
 
   // Assert individual formulas
@@ -2753,6 +3283,18 @@ void mcsat_assert_formulas_internal(mcsat_solver_t* mcsat, uint32_t n, const ter
   ivector_reset(assertions);
 }
 
+static
+void mcsat_assert_formulas_internal(mcsat_solver_t* mcsat, uint32_t n, const term_t *f, bool preprocess) {
+  uint32_t i;
+
+  // Remember the original assertions
+  for (i = 0; i < n; ++ i) {
+    ivector_push(&mcsat->assertion_terms_original, f[i]);
+  }
+
+  mcsat_add_formulas(mcsat, n, f, preprocess);
+}
+
 int32_t mcsat_assert_formulas(mcsat_solver_t* mcsat, uint32_t n, const term_t *f) {
   mcsat_assert_formulas_internal(mcsat, n, f, true);
   mcsat->interpolant = NULL_TERM;
@@ -28,6 +28,7 @@ void trail_construct(mcsat_trail_t* trail, const variable_db_t* var_db) {
   trail->decision_level = 0;
   trail->decision_level_base = 0;
   mcsat_model_construct(&trail->model);
+  mcsat_model_construct(&trail->saved_model);
   init_ivector(&trail->type, 0);
   init_ivector(&trail->level, 0);
   init_ivector(&trail->index, 0);
@@ -50,6 +51,7 @@ void trail_construct_copy(mcsat_trail_t* trail, const mcsat_trail_t* from) {
   trail->decision_level = from->decision_level;
   trail->decision_level_base = from->decision_level_base;
   mcsat_model_construct_copy(&trail->model, &from->model);
+  mcsat_model_construct_copy(&trail->saved_model, &from->saved_model);
   init_ivector_copy(&trail->type, &from->type);
   init_ivector_copy(&trail->level, &from->level);
   init_ivector_copy(&trail->index, &from->index);
@@ -65,6 +67,7 @@ void trail_destruct(mcsat_trail_t* trail) {
   delete_ivector(&trail->level_sizes);
   trail->decision_level = 0;
   mcsat_model_destruct(&trail->model);
+  mcsat_model_destruct(&trail->saved_model);
   delete_ivector(&trail->type);
   delete_ivector(&trail->level);
   delete_ivector(&trail->index);
@@ -75,6 +78,7 @@ void trail_destruct(mcsat_trail_t* trail) {
 void trail_new_variable_notify(mcsat_trail_t* trail, variable_t x) {
   // Notify the model
   mcsat_model_new_variable_notify(&trail->model, x);
+  mcsat_model_new_variable_notify(&trail->saved_model, x);
   // Resize variable info
   while (trail->type.size <= x) {
     ivector_push(&trail->type, UNASSIGNED);
@@ -280,6 +284,30 @@ void trail_gc_mark(mcsat_trail_t* trail, gc_info_t* gc_vars) {
   }
 }
 
+void trail_save_values(mcsat_trail_t* trail) {
+  variable_t var;
+  // Forget the previous save: variables unassigned in this model keep no value
+  for (var = 0; var < trail->saved_model.size; ++ var) {
+    if (var != variable_null && mcsat_model_has_value(&trail->saved_model, var)) {
+      mcsat_model_unset_value(&trail->saved_model, var);
+    }
+  }
+  for (var = 0; var < trail->level.size; ++ var) {
+    if (var != variable_null && trail_has_value(trail, var)) {
+      mcsat_model_set_value(&trail->saved_model, var, mcsat_model_get_value(&trail->model, var));
+    }
+  }
+}
+
+void trail_restore_cached_values(mcsat_trail_t* trail) {
+  variable_t var;
+  for (var = 0; var < trail->saved_model.size && var < trail->level.size; ++ var) {
+    if (var != variable_null && !trail_has_value(trail, var) && mcsat_model_has_value(&trail->saved_model, var)) {
+      mcsat_model_set_value(&trail->model, var, mcsat_model_get_value(&trail->saved_model, var));
+    }
+  }
+}
+
 void trail_gc_sweep(mcsat_trail_t* trail, const gc_info_t* gc_vars) {
   variable_t var;
 
@@ -293,6 +321,9 @@ void trail_gc_sweep(mcsat_trail_t* trail, const gc_info_t* gc_vars) {
       if (mcsat_model_has_value(&trail->model, var)) {
         mcsat_model_unset_value(&trail->model, var);
       }
+      if (mcsat_model_has_value(&trail->saved_model, var)) {
+        mcsat_model_unset_value(&trail->saved_model, var);
+      }
       assert(!trail_has_value(trail, var));
     }
   }
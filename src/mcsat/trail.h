@@ -64,6 +64,9 @@ struct mcsat_trail_s {
   /** The values per variable */
   mcsat_model_t model;
 
+  /** Values of the last satisfying assignment, to be preferred in later searches */
+  mcsat_model_t saved_model;
+
   /** Type of the assignment per variable (assignment_tyep_t) */
   ivector_t type;
 
@@ -158,7 +161,7 @@ static inline
 bool trail_has_value(const mcsat_trail_t* trail, variable_t var) {
   assert(var < trail->level.size);
   bool has_value = (trail->level.data[var] >= 0);
-  assert(!has_value || mcsat_model_get_value(&trail->model, var)->type != VALUE_NONE);
+  assert(!has_value || mcsat_model_has_value(&trail->model, var));
   return has_value;
 }
 
@@ -166,7 +169,7 @@ bool trail_has_value(const mcsat_trail_t* trail, variable_t var) {
 static inline
 bool trail_has_cached_value(const mcsat_trail_t* trail, variable_t var) {
   assert(var < trail->model.size);
-  return mcsat_model_get_value(&trail->model, var)->type != VALUE_NONE;
+  return mcsat_model_has_value(&trail->model, var);
 }
 
 /** Returns true if the value of var is other than NONE at base level */
@@ -203,6 +206,13 @@ const mcsat_value_t* trail_get_cached_value(const mcsat_trail_t* trail, variable
   return mcsat_model_get_value(&trail->model, var);
 }
 
+/** Set the cached value of an unassigned variable (used as a hint for decisions) */
+static inline
+void trail_set_cached_value(mcsat_trail_t* trail, variable_t var, const mcsat_value_t* value) {
+  assert(!trail_has_value(trail, var));
+  mcsat_model_set_value(&trail->model, var, value);
+}
+
 /** Get the value timestamp of the variable */
 static inline
 uint32_t trail_get_value_timestamp(const mcsat_trail_t* trail, variable_t var) {
@@ -214,9 +224,8 @@ uint32_t trail_get_value_timestamp(const mcsat_trail_t* trail, variable_t var) {
 /** Get the boolean value of the variable */
 static inline
 bool trail_get_boolean_value(const mcsat_trail_t* trail, variable_t var) {
-  const mcsat_value_t* value = trail_get_value(trail, var);
-  assert(value->type == VALUE_BOOLEAN);
-  return value->b;
+  assert(trail_has_value(trail, var));
+  return mcsat_model_get_boolean(&trail->model, var);
 }
 
 /** Add a new decision x -> value */
@@ -254,6 +263,19 @@ ivector_t* trail_get_unassigned(mcsat_trail_t* trail) {
   return &trail->unassigned;
 }
 
+/**
+ * Save the current values of all assigned variables (e.g. a model). The saved
+ * values are kept until the next save, which first clears them: only the
+ * variables assigned in the latest model have a saved value.
+ */
+void trail_save_values(mcsat_trail_t* trail);
+
+/**
+ * Set the cached values of all unassigned variables to the saved values, so
+ * that the decisions prefer the saved assignment.
+ */
+void trail_restore_cached_values(mcsat_trail_t* trail);
+
 /** Mark all the variables in the trail */
 void trail_gc_mark(mcsat_trail_t* trail, gc_info_t* gc_vars);
 
@@ -202,6 +202,28 @@ void mcsat_value_delete(mcsat_value_t* value) {
 
 void mcsat_value_assign(mcsat_value_t* value, const mcsat_value_t* from) {
   if (value != from) {
+    // Same type: reuse the storage (no allocation for bit-vectors of the same
+    // size, or for small rationals)
+    if (value->type == from->type) {
+      switch (value->type) {
+      case VALUE_NONE:
+        return;
+      case VALUE_BOOLEAN:
+        value->b = from->b;
+        return;
+      case VALUE_RATIONAL:
+        q_set(&value->q, &from->q);
+        return;
+      case VALUE_LIBPOLY:
+        lp_value_assign(&value->lp_value, &from->lp_value);
+        return;
+      case VALUE_BV:
+        bvconstant_copy(&value->bv_value, from->bv_value.bitsize, from->bv_value.data);
+        return;
+      default:
+        assert(false);
+      }
+    }
     mcsat_value_destruct(value);
     mcsat_value_construct_copy(value, from);
   }
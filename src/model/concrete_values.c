@@ -613,6 +613,9 @@ void init_value_table(value_table_t *table, uint32_t n, type_table_t *ttbl) {
 
   table->aux_namer = NULL;
   table->unint_namer = NULL;
+
+  init_arena(&table->bv_store);
+  table->scache = NULL;
 }
 
 
@@ -759,6 +762,8 @@ static void vtbl_delete_descriptors(value_table_t *table, uint32_t k) {
       delete_value_fun(table->desc[i].ptr);
       break;
     case BITVECTOR_VALUE:
+      // allocated in table->bv_store
+      break;
     case TUPLE_VALUE:
     case MAP_VALUE:
     case UPDATE_VALUE:
@@ -776,6 +781,7 @@ static void vtbl_delete_descriptors(value_table_t *table, uint32_t k) {
  */
 void reset_value_table(value_table_t *table) {
   vtbl_delete_descriptors(table, 0);
+  arena_reset(&table->bv_store);
   reset_int_htbl(&table->htbl);
   reset_map_htbl(&table->mtbl);
   reset_vtbl_queue(&table->queue);
@@ -805,9 +811,12 @@ void delete_value_table(value_table_t *table) {
   delete_map_htbl(&table->mtbl);
   delete_vtbl_queue(&table->queue);
   delete_hsets(table);
+  delete_arena(&table->bv_store);
+  safe_free(table->scache);
   table->kind = NULL;
   table->desc = NULL;
   table->canonical = NULL;
+  table->scache = NULL;
 }
 
 
@@ -1604,7 +1613,7 @@ static value_t build_bv_value(bv_hobj_t *o) {
   value_t i;
 
   w = (o->nbits + 31) >> 5; // ceil(nbits/32)
-  d = (value_bv_t *) safe_malloc(sizeof(value_bv_t) + w * sizeof(uint32_t));
+  d = (value_bv_t *) arena_alloc(&o->table->bv_store, sizeof(value_bv_t) + w * sizeof(uint32_t));
   d->nbits = o->nbits;
   d->width = w;
   bvconst_set(d->data, w, o->data);
@@ -1752,37 +1761,138 @@ static value_t build_update_value(update_hobj_t *o) {
 }
 
 /*
- * Return a rational constant = v
+ * SCALAR CACHE
  */
-value_t vtbl_mk_rational(value_table_t *table, rational_t *v) {
+
+/*
+ * Cache index for a 64bit key and a tag
+ * - rationals use tag 0 and bitvectors use their number of bits
+ */
+static inline uint32_t scache_index(uint64_t key, uint32_t tag) {
+  key = (key ^ tag) * ((uint64_t) 0x9e3779b97f4a7c15ULL);
+  return (uint32_t) (key >> (64 - VTBL_SCACHE_BITS));
+}
+
+/*
+ * Get the cache (allocate it if needed)
+ */
+static value_t *get_scache(value_table_t *table) {
+  value_t *c;
+  uint32_t i;
+
+  c = table->scache;
+  if (c == NULL) {
+    c = (value_t *) safe_malloc(VTBL_SCACHE_SIZE * sizeof(value_t));
+    for (i=0; i<VTBL_SCACHE_SIZE; i++) {
+      c[i] = null_value;
+    }
+    table->scache = c;
+  }
+  return c;
+}
+
+/*
+ * Check whether i is a valid object of the given kind
+ * - the cache is not cleared when objects are deleted, so
+ *   entries may refer to deleted or reused indices
+ */
+static inline bool scache_hit(value_table_t *table, value_t i, value_kind_t kind) {
+  return 0 <= i && i < table->nobjects && table->kind[i] == kind;
+}
+
+
+/*
+ * Rational: use the cache if v is a small rational
+ */
+static value_t mk_rational_cached(value_table_t *table, rational_t *v) {
   rational_hobj_t rational_hobj;
+  value_t *c;
+  uint32_t k;
+  value_t i;
+
+  c = NULL;
+  k = 0;
+  if (is_rat32(v)) {
+    c = get_scache(table);
+    k = scache_index((uint64_t) v->p.gmp, 0);
+    i = c[k];
+    if (scache_hit(table, i, RATIONAL_VALUE) && q_eq(&table->desc[i].rational, v)) {
+      return i;
+    }
+  }
+
   rational_hobj.m.hash = (hobj_hash_t) hash_rational_value;
   rational_hobj.m.eq = (hobj_eq_t) equal_rational_value;
   rational_hobj.m.build = (hobj_build_t) build_rational_value;
   rational_hobj.table = table;
   rational_hobj.v = v;
+  i = int_htbl_get_obj(&table->htbl, (int_hobj_t *) &rational_hobj);
 
-  return int_htbl_get_obj(&table->htbl, (int_hobj_t *) &rational_hobj);
+  if (c != NULL) {
+    c[k] = i;
+  }
+
+  return i;
 }
 
+
+/*
+ * Bitvector of n bits defined by a 64bit integer c (normalized)
+ */
+static value_t mk_bv64_cached(value_table_t *table, uint32_t n, uint64_t c) {
+  bv_hobj_t bv_hobj;
+  value_bv_t *d;
+  value_t *cache;
+  uint32_t aux[2];
+  uint32_t k;
+  value_t i;
+
+  assert(1 <= n && n <= 64 && c == norm64(c, n));
+
+  cache = get_scache(table);
+  k = scache_index(c, n);
+  i = cache[k];
+  if (scache_hit(table, i, BITVECTOR_VALUE)) {
+    d = table->desc[i].ptr;
+    if (d->nbits == n && d->data[0] == (uint32_t) c &&
+        (n <= 32 || d->data[1] == (uint32_t) (c >> 32))) {
+      return i;
+    }
+  }
+
+  aux[0] = (uint32_t) c;
+  aux[1] = (uint32_t) (c >> 32);
+  bv_hobj.m.hash = (hobj_hash_t) hash_bv_value;
+  bv_hobj.m.eq = (hobj_eq_t) equal_bv_value;
+  bv_hobj.m.build = (hobj_build_t) build_bv_value;
+  bv_hobj.table = table;
+  bv_hobj.nbits = n;
+  bv_hobj.data = aux;
+  i = int_htbl_get_obj(&table->htbl, (int_hobj_t*) &bv_hobj);
+  cache[k] = i;
+
+  return i;
+}
+
+
+/*
+ * Return a rational constant = v
+ */
+value_t vtbl_mk_rational(value_table_t *table, rational_t *v) {
+  return mk_rational_cached(table, v);
+}
+
+
 /*
  * Return a rational constant equal to i
  */
 value_t vtbl_mk_int32(value_table_t *table, int32_t i) {
   rational_t aux;
   value_t k;
-  rational_hobj_t rational_hobj;
 
   q_init(&aux);
   q_set32(&aux, i);
-
-  rational_hobj.m.hash = (hobj_hash_t) hash_rational_value;
-  rational_hobj.m.eq = (hobj_eq_t) equal_rational_value;
-  rational_hobj.m.build = (hobj_build_t) build_rational_value;
-  rational_hobj.table = table;
-  rational_hobj.v = &aux;
-
-  k = int_htbl_get_obj(&table->htbl, (int_hobj_t *) &rational_hobj);
+  k = mk_rational_cached(table, &aux);
   q_clear(&aux);
 
   return k;
@@ -1845,6 +1955,11 @@ value_t vtbl_mk_bv_from_bv(value_table_t *table, uint32_t n, uint32_t *a) {
   bv_hobj_t bv_hobj;
 
   bvconst_normalize(a, n);
+  if (n <= 32) {
+    return mk_bv64_cached(table, n, a[0]);
+  } else if (n <= 64) {
+    return mk_bv64_cached(table, n, a[0] | (((uint64_t) a[1]) << 32));
+  }
 
   bv_hobj.m.hash = (hobj_hash_t) hash_bv_value;
   bv_hobj.m.eq = (hobj_eq_t) equal_bv_value;
@@ -1871,11 +1986,8 @@ value_t vtbl_mk_bv_from_constant(value_table_t *table, bvconstant_t *b) {
  * - n = number of bits to use
  */
 value_t vtbl_mk_bv_from_bv64(value_table_t *table, uint32_t n, uint64_t c) {
-  uint32_t aux[2];
-
-  aux[0] = (uint32_t) c;
-  aux[1] = (uint32_t) (c >> 32);
-  return vtbl_mk_bv_from_bv(table, n, aux);
+  assert(1 <= n && n <= 64);
+  return mk_bv64_cached(table, n, norm64(c, n));
 }
 
 
@@ -3252,6 +3364,7 @@ void value_table_start_tmp(value_table_t *table) {
 
   // set the tmp mark
   table->first_tmp = table->nobjects;
+  arena_push(&table->bv_store);
 }
 
 
@@ -3265,6 +3378,7 @@ void value_table_start_tmp(value_table_t *table) {
 void value_table_end_tmp(value_table_t *table) {
   if (table->first_tmp >= 0) {
     vtbl_delete_descriptors(table, table->first_tmp);
+    arena_pop(&table->bv_store);
     table->first_tmp = -1;
   }
 }
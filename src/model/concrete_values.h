@@ -53,6 +53,7 @@
 #include "terms/bv_constants.h"
 #include "terms/rationals.h"
 #include "terms/types.h"
+#include "utils/arena.h"
 #include "utils/bitvectors.h"
 #include "utils/int_hash_tables.h"
 #include "utils/int_queues.h"
@@ -320,6 +321,15 @@ typedef const char *(*unint_namer_fun_t)(void *aux, value_unint_t *d);
  *   and objects in [first_tmp .. nobjects - 1] are temporary.
  *
  * - pointer for getting names of uninterpreted constants
+ *
+ * Scalar values:
+ * - bitvector descriptors are allocated in an arena (bv_store) so
+ *   they're freed in blocks when the table is reset or deleted
+ *   (and when temporary objects are deleted).
+ * - scache is a direct-mapped cache for small rationals and
+ *   bitvectors of at most 64 bits. It maps a hash of the value to
+ *   the object last built for that hash. A hit avoids hashing the
+ *   value and probing htbl. The cache is allocated on demand.
  */
 typedef struct value_table_s {
   uint32_t size;
@@ -349,12 +359,18 @@ typedef struct value_table_s {
 
   void *aux_namer;
   unint_namer_fun_t unint_namer;
+
+  arena_t bv_store;
+  value_t *scache;
 } value_table_t;
 
 
 #define DEF_VALUE_TABLE_SIZE 200
 #define MAX_VALUE_TABLE_SIZE (UINT32_MAX/sizeof(value_desc_t))
 
+#define VTBL_SCACHE_BITS 12
+#define VTBL_SCACHE_SIZE (1 << VTBL_SCACHE_BITS)
+
 
 
 
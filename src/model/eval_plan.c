@@ -0,0 +1,946 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * COMPILED EVALUATION OF A FIXED SET OF TERMS
+ */
+
+#include <assert.h>
+
+#include "model/eval_plan.h"
+#include "model/model_eval.h"
+#include "terms/bv64_constants.h"
+#include "utils/int_hash_map.h"
+#include "utils/int_vectors.h"
+#include "utils/memalloc.h"
+
+
+/*
+ * PLAN CONSTRUCTION
+ */
+
+/*
+ * Builder:
+ * - plan = plan being constructed
+ * - map = map from terms to registers
+ * - operands = operand vector
+ * - size = size of the plan's instruction/register arrays
+ */
+typedef struct evp_builder_s {
+  eval_plan_t *plan;
+  int_hmap_t map;
+  ivector_t operands;
+  uint32_t size;
+} evp_builder_t;
+
+#define EVP_DEF_SIZE 64
+#define EVP_MAX_SIZE (UINT32_MAX/sizeof(rational_t))
+
+
+/*
+ * Register kind for term t
+ */
+static evp_kind_t evp_term_kind(term_table_t *terms, term_t t) {
+  if (is_boolean_term(terms, t)) {
+    return EVP_BOOL;
+  } else if (is_arithmetic_term(terms, t)) {
+    return EVP_RATIONAL;
+  } else if (is_bitvector_term(terms, t) && term_bitsize(terms, t) <= 64) {
+    return EVP_BV64;
+  } else {
+    return EVP_OBJECT;
+  }
+}
+
+
+/*
+ * Add a new instruction: return its index
+ */
+static uint32_t evp_new_instr(evp_builder_t *b, evp_opcode_t op, evp_kind_t kind, term_t t) {
+  eval_plan_t *plan;
+  evp_instr_t *ins;
+  uint32_t i, n;
+
+  plan = b->plan;
+  i = plan->ninstr;
+  if (i == b->size) {
+    n = b->size + (b->size >> 1) + 1;
+    if (n >= EVP_MAX_SIZE) {
+      out_of_memory();
+    }
+    plan->instr = (evp_instr_t *) safe_realloc(plan->instr, n * sizeof(evp_instr_t));
+    plan->word = (uint64_t *) safe_realloc(plan->word, n * sizeof(uint64_t));
+    plan->rat = (rational_t *) safe_realloc(plan->rat, n * sizeof(rational_t));
+    b->size = n;
+  }
+  assert(i < b->size);
+
+  ins = plan->instr + i;
+  ins->op = op;
+  ins->kind = kind;
+  ins->nbits = 0;
+  ins->term = t;
+  ins->args = b->operands.size;
+  ins->nargs = 0;
+  plan->word[i] = 0;
+  q_init(plan->rat + i);
+  plan->ninstr = i+1;
+
+  if (op == EVP_EVAL) {
+    plan->has_eval = true;
+  }
+
+  return i;
+}
+
+
+static int32_t evp_compile(evp_builder_t *b, term_t t);
+
+/*
+ * Operand for a term t that's already compiled
+ */
+static int32_t evp_operand(evp_builder_t *b, term_t t) {
+  int_hmap_pair_t *p;
+
+  p = int_hmap_find(&b->map, unsigned_term(t));
+  assert(p != NULL);
+  return (p->val << 1) | polarity_of(t);
+}
+
+/*
+ * Check whether all terms in a[0 ... n-1] have a scalar kind
+ */
+static bool evp_scalar_args(term_table_t *terms, const term_t *a, uint32_t n) {
+  uint32_t i;
+
+  for (i=0; i<n; i++) {
+    if (evp_term_kind(terms, a[i]) == EVP_OBJECT) return false;
+  }
+  return true;
+}
+
+
+/*
+ * Instruction with composite arguments
+ */
+static evp_opcode_t evp_composite(evp_opcode_t op, composite_term_t *d, ivector_t *args) {
+  uint32_t i;
+
+  for (i=0; i<d->arity; i++) {
+    ivector_push(args, d->arg[i]);
+  }
+  return op;
+}
+
+
+/*
+ * Compile t and return its operand
+ */
+static int32_t evp_compile(evp_builder_t *b, term_t t) {
+  eval_plan_t *plan;
+  term_table_t *terms;
+  int_hmap_pair_t *p;
+  polynomial_t *poly;
+  bvpoly64_t *bvpoly;
+  pprod_t *pp;
+  select_term_t *sel;
+  ivector_t args;
+  evp_opcode_t op;
+  evp_kind_t kind;
+  uint32_t i, n, k;
+  term_t r;
+
+  r = unsigned_term(t);
+  p = int_hmap_find(&b->map, r);
+  if (p != NULL) {
+    return (p->val << 1) | polarity_of(t);
+  }
+
+  plan = b->plan;
+  terms = plan->terms;
+  kind = evp_term_kind(terms, r);
+
+  init_ivector(&args, 0);
+  op = EVP_EVAL;
+
+  switch (term_kind(terms, r)) {
+  case CONSTANT_TERM:
+    if (r == true_term) op = EVP_CONST;
+    break;
+
+  case ARITH_CONSTANT:
+  case BV64_CONSTANT:
+    op = EVP_CONST;
+    break;
+
+  case UNINTERPRETED_TERM:
+    if (kind != EVP_OBJECT) op = EVP_LOAD;
+    break;
+
+  case OR_TERM:
+    op = evp_composite(EVP_OR, or_term_desc(terms, r), &args);
+    break;
+
+  case XOR_TERM:
+    op = evp_composite(EVP_XOR, xor_term_desc(terms, r), &args);
+    break;
+
+  case ITE_TERM:
+  case ITE_SPECIAL:
+    if (kind != EVP_OBJECT) {
+      op = evp_composite(EVP_ITE, ite_term_desc(terms, r), &args);
+    }
+    break;
+
+  case EQ_TERM:
+    if (evp_scalar_args(terms, eq_term_desc(terms, r)->arg, 2)) {
+      op = evp_composite(EVP_EQ, eq_term_desc(terms, r), &args);
+    }
+    break;
+
+  case DISTINCT_TERM:
+    if (evp_scalar_args(terms, distinct_term_desc(terms, r)->arg, distinct_term_desc(terms, r)->arity)) {
+      op = evp_composite(EVP_DISTINCT, distinct_term_desc(terms, r), &args);
+    }
+    break;
+
+  case ARITH_EQ_ATOM:
+    op = EVP_ARITH_EQ;
+    ivector_push(&args, arith_eq_arg(terms, r));
+    break;
+
+  case ARITH_GE_ATOM:
+    op = EVP_ARITH_GE;
+    ivector_push(&args, arith_ge_arg(terms, r));
+    break;
+
+  case ARITH_IS_INT_ATOM:
+    op = EVP_ARITH_IS_INT;
+    ivector_push(&args, arith_is_int_arg(terms, r));
+    break;
+
+  case ARITH_FLOOR:
+    op = EVP_ARITH_FLOOR;
+    ivector_push(&args, arith_floor_arg(terms, r));
+    break;
+
+  case ARITH_CEIL:
+    op = EVP_ARITH_CEIL;
+    ivector_push(&args, arith_ceil_arg(terms, r));
+    break;
+
+  case ARITH_ABS:
+    op = EVP_ARITH_ABS;
+    ivector_push(&args, arith_abs_arg(terms, r));
+    break;
+
+  case ARITH_BINEQ_ATOM:
+    op = evp_composite(EVP_ARITH_BINEQ, arith_bineq_atom_desc(terms, r), &args);
+    break;
+
+  case ARITH_POLY:
+    op = EVP_ARITH_POLY;
+    break;
+
+  case BV64_POLY:
+    op = EVP_BV64_POLY;
+    break;
+
+  case POWER_PRODUCT:
+    if (kind == EVP_RATIONAL) {
+      op = EVP_ARITH_PPROD;
+    } else if (kind == EVP_BV64) {
+      op = EVP_BV64_PPROD;
+    }
+    break;
+
+  case BV_ARRAY:
+    if (kind == EVP_BV64) {
+      op = evp_composite(EVP_BV64_ARRAY, bvarray_term_desc(terms, r), &args);
+    }
+    break;
+
+  case BV_DIV:
+    if (kind == EVP_BV64) op = evp_composite(EVP_BV64_DIV, bvdiv_term_desc(terms, r), &args);
+    break;
+
+  case BV_REM:
+    if (kind == EVP_BV64) op = evp_composite(EVP_BV64_REM, bvrem_term_desc(terms, r), &args);
+    break;
+
+  case BV_SDIV:
+    if (kind == EVP_BV64) op = evp_composite(EVP_BV64_SDIV, bvsdiv_term_desc(terms, r), &args);
+    break;
+
+  case BV_SREM:
+    if (kind == EVP_BV64) op = evp_composite(EVP_BV64_SREM, bvsrem_term_desc(terms, r), &args);
+    break;
+
+  case BV_SMOD:
+    if (kind == EVP_BV64) op = evp_composite(EVP_BV64_SMOD, bvsmod_term_desc(terms, r), &args);
+    break;
+
+  case BV_SHL:
+    if (kind == EVP_BV64) op = evp_composite(EVP_BV64_SHL, bvshl_term_desc(terms, r), &args);
+    break;
+
+  case BV_LSHR:
+    if (kind == EVP_BV64) op = evp_composite(EVP_BV64_LSHR, bvlshr_term_desc(terms, r), &args);
+    break;
+
+  case BV_ASHR:
+    if (kind == EVP_BV64) op = evp_composite(EVP_BV64_ASHR, bvashr_term_desc(terms, r), &args);
+    break;
+
+  case BV_EQ_ATOM:
+    if (evp_scalar_args(terms, bveq_atom_desc(terms, r)->arg, 2)) {
+      op = evp_composite(EVP_BV64_EQ, bveq_atom_desc(terms, r), &args);
+    }
+    break;
+
+  case BV_GE_ATOM:
+    if (evp_scalar_args(terms, bvge_atom_desc(terms, r)->arg, 2)) {
+      op = evp_composite(EVP_BV64_GE, bvge_atom_desc(terms, r), &args);
+    }
+    break;
+
+  case BV_SGE_ATOM:
+    if (evp_scalar_args(terms, bvsge_atom_desc(terms, r)->arg, 2)) {
+      op = evp_composite(EVP_BV64_SGE, bvsge_atom_desc(terms, r), &args);
+    }
+    break;
+
+  case BIT_TERM:
+    sel = bit_term_desc(terms, r);
+    if (evp_term_kind(terms, sel->arg) == EVP_BV64) {
+      op = EVP_BIT;
+      ivector_push(&args, sel->arg);
+    }
+    break;
+
+  default:
+    break;
+  }
+
+  /*
+   * Compile the arguments first, then create the instruction.
+   * Polynomials and power products have their own operand layout.
+   */
+  switch (op) {
+  case EVP_ARITH_POLY:
+    poly = poly_term_desc(terms, r);
+    n = poly->nterms;
+    for (i=0; i<n; i++) {
+      if (poly->mono[i].var != const_idx) (void) evp_compile(b, poly->mono[i].var);
+    }
+    k = evp_new_instr(b, op, kind, r);
+    for (i=0; i<n; i++) {
+      ivector_push(&b->operands, poly->mono[i].var == const_idx ? -1 : evp_operand(b, poly->mono[i].var));
+    }
+    break;
+
+  case EVP_BV64_POLY:
+    bvpoly = bvpoly64_term_desc(terms, r);
+    n = bvpoly->nterms;
+    for (i=0; i<n; i++) {
+      if (bvpoly->mono[i].var != const_idx) (void) evp_compile(b, bvpoly->mono[i].var);
+    }
+    k = evp_new_instr(b, op, kind, r);
+    for (i=0; i<n; i++) {
+      ivector_push(&b->operands, bvpoly->mono[i].var == const_idx ? -1 : evp_operand(b, bvpoly->mono[i].var));
+    }
+    break;
+
+  case EVP_ARITH_PPROD:
+  case EVP_BV64_PPROD:
+    pp = pprod_term_desc(terms, r);
+    n = pp->len;
+    for (i=0; i<n; i++) {
+      (void) evp_compile(b, pp->prod[i].var);
+    }
+    k = evp_new_instr(b, op, kind, r);
+    for (i=0; i<n; i++) {
+      ivector_push(&b->operands, evp_operand(b, pp->prod[i].var));
+    }
+    break;
+
+  default:
+    n = args.size;
+    for (i=0; i<n; i++) {
+      (void) evp_compile(b, args.data[i]);
+    }
+    k = evp_new_instr(b, op, kind, r);
+    for (i=0; i<n; i++) {
+      ivector_push(&b->operands, evp_operand(b, args.data[i]));
+    }
+    break;
+  }
+
+  plan->instr[k].nargs = b->operands.size - plan->instr[k].args;
+  if (kind == EVP_BV64) {
+    plan->instr[k].nbits = term_bitsize(terms, r);
+  } else if (op == EVP_BIT) {
+    plan->instr[k].nbits = bit_term_desc(terms, r)->idx;  // bit index
+  }
+
+  // constants
+  if (op == EVP_CONST) {
+    switch (kind) {
+    case EVP_BOOL:
+      assert(r == true_term);
+      plan->word[k] = 1;
+      break;
+    case EVP_RATIONAL:
+      q_set(plan->rat + k, rational_term_desc(terms, r));
+      break;
+    case EVP_BV64:
+      plan->word[k] = bvconst64_term_desc(terms, r)->value;
+      break;
+    default:
+      assert(false);
+      break;
+    }
+  }
+
+  delete_ivector(&args);
+  int_hmap_add(&b->map, r, k);
+
+  return (k << 1) | polarity_of(t);
+}
+
+
+/*
+ * Build the plan
+ */
+void init_eval_plan(eval_plan_t *plan, term_table_t *terms, const term_t *a, uint32_t n) {
+  evp_builder_t builder;
+  uint32_t i;
+
+  plan->terms = terms;
+  plan->ninstr = 0;
+  plan->instr = (evp_instr_t *) safe_malloc(EVP_DEF_SIZE * sizeof(evp_instr_t));
+  plan->word = (uint64_t *) safe_malloc(EVP_DEF_SIZE * sizeof(uint64_t));
+  plan->rat = (rational_t *) safe_malloc(EVP_DEF_SIZE * sizeof(rational_t));
+  plan->operands = NULL;
+  plan->nroots = n;
+  plan->root = (int32_t *) safe_malloc(n * sizeof(int32_t));
+  plan->code = (int32_t *) safe_malloc(n * sizeof(int32_t));
+  plan->value = (value_t *) safe_malloc(n * sizeof(value_t));
+  plan->vtbl = NULL;
+  plan->has_eval = false;
+  plan->slow = false;
+
+  builder.plan = plan;
+  builder.size = EVP_DEF_SIZE;
+  init_int_hmap(&builder.map, 0);
+  init_ivector(&builder.operands, 0);
+
+  for (i=0; i<n; i++) {
+    plan->root[i] = evp_compile(&builder, a[i]);
+    plan->code[i] = MDL_EVAL_INTERNAL_ERROR; // not evaluated yet
+    plan->value[i] = null_value;
+  }
+
+  n = builder.operands.size;
+  plan->operands = (int32_t *) safe_malloc(n * sizeof(int32_t));
+  for (i=0; i<n; i++) {
+    plan->operands[i] = builder.operands.data[i];
+  }
+
+  delete_ivector(&builder.operands);
+  delete_int_hmap(&builder.map);
+}
+
+
+/*
+ * Delete
+ */
+void delete_eval_plan(eval_plan_t *plan) {
+  uint32_t i;
+
+  for (i=0; i<plan->ninstr; i++) {
+    q_clear(plan->rat + i);
+  }
+  safe_free(plan->instr);
+  safe_free(plan->word);
+  safe_free(plan->rat);
+  safe_free(plan->operands);
+  safe_free(plan->root);
+  safe_free(plan->code);
+  safe_free(plan->value);
+  plan->instr = NULL;
+  plan->word = NULL;
+  plan->rat = NULL;
+  plan->operands = NULL;
+  plan->root = NULL;
+  plan->code = NULL;
+  plan->value = NULL;
+}
+
+
+
+/*
+ * Mark the terms of all instructions
+ */
+void eval_plan_gc_mark(eval_plan_t *plan) {
+  uint32_t i;
+
+  for (i=0; i<plan->ninstr; i++) {
+    term_table_set_gc_mark(plan->terms, index_of(plan->instr[i].term));
+  }
+}
+
+
+
+/*
+ * EXECUTION
+ */
+
+/*
+ * Operand values
+ */
+static inline bool evp_bool(eval_plan_t *plan, int32_t x) {
+  return (plan->word[x >> 1] ^ (x & 1)) != 0;
+}
+
+static inline uint64_t evp_bv64(eval_plan_t *plan, int32_t x) {
+  return plan->word[x >> 1];
+}
+
+static inline rational_t *evp_rational(eval_plan_t *plan, int32_t x) {
+  return plan->rat + (x >> 1);
+}
+
+
+/*
+ * Store object v into register i
+ * - return false if v doesn't fit the register
+ */
+static bool evp_store_object(eval_plan_t *plan, uint32_t i, value_table_t *vtbl, value_t v) {
+  value_bv_t *bv;
+  uint64_t c;
+
+  switch (plan->instr[i].kind) {
+  case EVP_BOOL:
+    if (! object_is_boolean(vtbl, v)) return false;
+    plan->word[i] = is_true(vtbl, v);
+    break;
+
+  case EVP_BV64:
+    if (! object_is_bitvector(vtbl, v)) return false;
+    bv = vtbl_bitvector(vtbl, v);
+    assert(1 <= bv->nbits && bv->nbits <= 64);
+    c = bv->data[0];
+    if (bv->nbits > 32) {
+      c += ((uint64_t) bv->data[1]) << 32;
+    }
+    plan->word[i] = c;
+    break;
+
+  case EVP_RATIONAL:
+    if (! object_is_rational(vtbl, v)) return false;
+    q_set(plan->rat + i, vtbl_rational(vtbl, v));
+    break;
+
+  default:
+    plan->word[i] = v;
+    break;
+  }
+
+  return true;
+}
+
+
+/*
+ * Equality of two scalar operands of the same kind
+ */
+static bool evp_equal(eval_plan_t *plan, int32_t x, int32_t y) {
+  switch (plan->instr[x >> 1].kind) {
+  case EVP_BOOL:
+    return evp_bool(plan, x) == evp_bool(plan, y);
+
+  case EVP_BV64:
+    return evp_bv64(plan, x) == evp_bv64(plan, y);
+
+  default:
+    assert(plan->instr[x >> 1].kind == EVP_RATIONAL);
+    return q_eq(evp_rational(plan, x), evp_rational(plan, y));
+  }
+}
+
+
+/*
+ * Power x^d modulo 2^64
+ */
+static uint64_t evp_power64(uint64_t x, uint32_t d) {
+  uint64_t y;
+
+  y = 1;
+  while (d > 0) {
+    if (d & 1) y *= x;
+    x *= x;
+    d >>= 1;
+  }
+  return y;
+}
+
+
+/*
+ * Execute instruction i: return false if it needs the evaluator
+ * or if the value can't be stored.
+ */
+static bool evp_exec(eval_plan_t *plan, uint32_t i, model_t *model) {
+  evp_instr_t *ins;
+  int32_t *a;
+  rational_t *q;
+  polynomial_t *poly;
+  bvpoly64_t *bvpoly;
+  pprod_t *pp;
+  uint64_t c;
+  uint32_t j, k, n;
+  value_t v;
+  bool x;
+
+  ins = plan->instr + i;
+  a = plan->operands + ins->args;
+  n = ins->nargs;
+
+  switch (ins->op) {
+  case EVP_CONST:
+    break;
+
+  case EVP_LOAD:
+    v = model_find_term_value(model, ins->term);
+    if (v == null_value) return false;
+    return evp_store_object(plan, i, &model->vtbl, v);
+
+  case EVP_EVAL:
+    return false;
+
+  case EVP_OR:
+    x = false;
+    for (j=0; j<n; j++) {
+      if (evp_bool(plan, a[j])) {
+        x = true;
+        break;
+      }
+    }
+    plan->word[i] = x;
+    break;
+
+  case EVP_XOR:
+    x = false;
+    for (j=0; j<n; j++) {
+      x ^= evp_bool(plan, a[j]);
+    }
+    plan->word[i] = x;
+    break;
+
+  case EVP_ITE:
+    j = evp_bool(plan, a[0]) ? 1 : 2;
+    switch (ins->kind) {
+    case EVP_BOOL:
+      plan->word[i] = evp_bool(plan, a[j]);
+      break;
+    case EVP_BV64:
+      plan->word[i] = evp_bv64(plan, a[j]);
+      break;
+    default:
+      q_set(plan->rat + i, evp_rational(plan, a[j]));
+      break;
+    }
+    break;
+
+  case EVP_EQ:
+  case EVP_ARITH_BINEQ:
+  case EVP_BV64_EQ:
+    plan->word[i] = evp_equal(plan, a[0], a[1]);
+    break;
+
+  case EVP_DISTINCT:
+    x = true;
+    for (j=0; j<n && x; j++) {
+      for (k=0; k<j; k++) {
+        if (evp_equal(plan, a[j], a[k])) {
+          x = false;
+          break;
+        }
+      }
+    }
+    plan->word[i] = x;
+    break;
+
+  case EVP_ARITH_EQ:
+    plan->word[i] = q_is_zero(evp_rational(plan, a[0]));
+    break;
+
+  case EVP_ARITH_GE:
+    plan->word[i] = q_is_nonneg(evp_rational(plan, a[0]));
+    break;
+
+  case EVP_ARITH_IS_INT:
+    plan->word[i] = q_is_integer(evp_rational(plan, a[0]));
+    break;
+
+  case EVP_ARITH_FLOOR:
+    q = plan->rat + i;
+    q_set(q, evp_rational(plan, a[0]));
+    q_floor(q);
+    q_normalize(q);
+    break;
+
+  case EVP_ARITH_CEIL:
+    q = plan->rat + i;
+    q_set(q, evp_rational(plan, a[0]));
+    q_ceil(q);
+    q_normalize(q);
+    break;
+
+  case EVP_ARITH_ABS:
+    q = plan->rat + i;
+    q_set_abs(q, evp_rational(plan, a[0]));
+    q_normalize(q);
+    break;
+
+  case EVP_ARITH_POLY:
+    poly = poly_term_desc(plan->terms, ins->term);
+    assert(poly->nterms == n);
+    q = plan->rat + i;
+    q_clear(q);
+    for (j=0; j<n; j++) {
+      if (a[j] < 0) {
+        q_add(q, &poly->mono[j].coeff);
+      } else {
+        q_addmul(q, &poly->mono[j].coeff, evp_rational(plan, a[j]));
+      }
+    }
+    q_normalize(q);
+    break;
+
+  case EVP_ARITH_PPROD:
+    pp = pprod_term_desc(plan->terms, ins->term);
+    assert(pp->len == n);
+    q = plan->rat + i;
+    q_set_one(q);
+    for (j=0; j<n; j++) {
+      q_mulexp(q, evp_rational(plan, a[j]), pp->prod[j].exp);
+    }
+    q_normalize(q);
+    break;
+
+  case EVP_BV64_POLY:
+    bvpoly = bvpoly64_term_desc(plan->terms, ins->term);
+    assert(bvpoly->nterms == n);
+    c = 0;
+    for (j=0; j<n; j++) {
+      if (a[j] < 0) {
+        c += bvpoly->mono[j].coeff;
+      } else {
+        c += bvpoly->mono[j].coeff * evp_bv64(plan, a[j]);
+      }
+    }
+    plan->word[i] = norm64(c, ins->nbits);
+    break;
+
+  case EVP_BV64_PPROD:
+    pp = pprod_term_desc(plan->terms, ins->term);
+    assert(pp->len == n);
+    c = 1;
+    for (j=0; j<n; j++) {
+      c *= evp_power64(evp_bv64(plan, a[j]), pp->prod[j].exp);
+    }
+    plan->word[i] = norm64(c, ins->nbits);
+    break;
+
+  case EVP_BV64_ARRAY:
+    c = 0;
+    for (j=0; j<n; j++) {
+      if (evp_bool(plan, a[j])) c = set_bit64(c, j);
+    }
+    plan->word[i] = c;
+    break;
+
+  case EVP_BV64_DIV:
+    plan->word[i] = bvconst64_udiv2z(evp_bv64(plan, a[0]), evp_bv64(plan, a[1]), ins->nbits);
+    break;
+
+  case EVP_BV64_REM:
+    plan->word[i] = bvconst64_urem2z(evp_bv64(plan, a[0]), evp_bv64(plan, a[1]), ins->nbits);
+    break;
+
+  case EVP_BV64_SDIV:
+    plan->word[i] = bvconst64_sdiv2z(evp_bv64(plan, a[0]), evp_bv64(plan, a[1]), ins->nbits);
+    break;
+
+  case EVP_BV64_SREM:
+    plan->word[i] = bvconst64_srem2z(evp_bv64(plan, a[0]), evp_bv64(plan, a[1]), ins->nbits);
+    break;
+
+  case EVP_BV64_SMOD:
+    plan->word[i] = bvconst64_smod2z(evp_bv64(plan, a[0]), evp_bv64(plan, a[1]), ins->nbits);
+    break;
+
+  case EVP_BV64_SHL:
+    plan->word[i] = bvconst64_lshl(evp_bv64(plan, a[0]), evp_bv64(plan, a[1]), ins->nbits);
+    break;
+
+  case EVP_BV64_LSHR:
+    plan->word[i] = bvconst64_lshr(evp_bv64(plan, a[0]), evp_bv64(plan, a[1]), ins->nbits);
+    break;
+
+  case EVP_BV64_ASHR:
+    plan->word[i] = bvconst64_ashr(evp_bv64(plan, a[0]), evp_bv64(plan, a[1]), ins->nbits);
+    break;
+
+  case EVP_BV64_GE:
+    plan->word[i] = evp_bv64(plan, a[0]) >= evp_bv64(plan, a[1]);
+    break;
+
+  case EVP_BV64_SGE:
+    plan->word[i] = signed64_ge(evp_bv64(plan, a[0]), evp_bv64(plan, a[1]), plan->instr[a[0] >> 1].nbits);
+    break;
+
+  case EVP_BIT:
+    plan->word[i] = tst_bit64(evp_bv64(plan, a[0]), ins->nbits);
+    break;
+
+  default:
+    assert(false);
+    return false;
+  }
+
+  return true;
+}
+
+
+/*
+ * Slow path: evaluate all roots with the evaluator
+ */
+static int32_t evp_run_evaluator(eval_plan_t *plan, evaluator_t *eval) {
+  evp_instr_t *ins;
+  uint32_t i;
+  int32_t code;
+  value_t v;
+
+  code = 0;
+  for (i=0; i<plan->nroots; i++) {
+    ins = plan->instr + (plan->root[i] >> 1);
+    v = eval_in_model(eval, ins->term | (plan->root[i] & 1));
+    plan->value[i] = v;
+    plan->code[i] = (v < 0) ? v : 0;
+    if (v < 0 && code == 0) {
+      code = v;
+    }
+  }
+  plan->slow = true;
+
+  return code;
+}
+
+
+/*
+ * Run the plan
+ */
+int32_t eval_plan_run(eval_plan_t *plan, model_t *model) {
+  evaluator_t eval;
+  uint32_t i, n;
+  int32_t code;
+  bool ready;
+  value_t v;
+
+  assert(model->terms == plan->terms);
+
+  plan->vtbl = &model->vtbl;
+  plan->slow = false;
+  ready = false;
+  code = 0;
+
+  n = plan->ninstr;
+  for (i=0; i<n; i++) {
+    if (! evp_exec(plan, i, model)) {
+      // use the evaluator for this instruction
+      if (! ready) {
+        init_evaluator(&eval, model);
+        ready = true;
+      }
+      v = eval_in_model(&eval, plan->instr[i].term);
+      if (v < 0 || ! evp_store_object(plan, i, &model->vtbl, v)) {
+        code = evp_run_evaluator(plan, &eval);
+        goto done;
+      }
+    }
+  }
+
+  for (i=0; i<plan->nroots; i++) {
+    plan->code[i] = 0;
+  }
+
+ done:
+  if (ready) {
+    delete_evaluator(&eval);
+  }
+
+  return code;
+}
+
+
+/*
+ * Check whether root i is true
+ */
+bool eval_plan_is_true(eval_plan_t *plan, uint32_t i) {
+  assert(i < plan->nroots && plan->code[i] == 0);
+
+  if (plan->slow) {
+    return is_true(plan->vtbl, plan->value[i]);
+  }
+  assert(plan->instr[plan->root[i] >> 1].kind == EVP_BOOL);
+  return evp_bool(plan, plan->root[i]);
+}
+
+
+/*
+ * Value of root i as an object in vtbl
+ */
+value_t eval_plan_value(eval_plan_t *plan, uint32_t i, value_table_t *vtbl) {
+  evp_instr_t *ins;
+  int32_t x;
+
+  assert(i < plan->nroots && plan->code[i] == 0);
+
+  if (plan->slow) {
+    assert(vtbl == plan->vtbl);
+    return plan->value[i];
+  }
+
+  x = plan->root[i];
+  ins = plan->instr + (x >> 1);
+  switch (ins->kind) {
+  case EVP_BOOL:
+    return vtbl_mk_bool(vtbl, evp_bool(plan, x));
+
+  case EVP_BV64:
+    return vtbl_mk_bv_from_bv64(vtbl, ins->nbits, evp_bv64(plan, x));
+
+  case EVP_RATIONAL:
+    return vtbl_mk_rational(vtbl, evp_rational(plan, x));
+
+  default:
+    assert(vtbl == plan->vtbl);
+    return (value_t) plan->word[x >> 1];
+  }
+}
@@ -0,0 +1,218 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * COMPILED EVALUATION OF A FIXED SET OF TERMS
+ */
+
+/*
+ * The evaluator (model_eval.h) is a good fit for evaluating arbitrary
+ * terms in a model. But it creates a concrete object in the model's
+ * value table for every subterm, and it uses a hash table to cache
+ * the values. That's expensive if the same terms are evaluated in
+ * many models (e.g., to check candidate models in a CEGAR loop).
+ *
+ * An evaluation plan is built once for a set of terms a[0 ... n-1]
+ * (the roots). The plan is an array of instructions, one per subterm
+ * of the roots, in topological order. Each instruction writes its
+ * result in a register:
+ * - Boolean subterms and bit-vector subterms of at most 64 bits
+ *   are stored in 64-bit words
+ * - arithmetic subterms are stored as rationals (which don't
+ *   require allocation if they're small)
+ * - constants are loaded once when the plan is built
+ * - uninterpreted terms are loaded from the model
+ * - other subterms (e.g., function applications, wide bit-vectors,
+ *   division, tuples) are evaluated by an evaluator: their subterms
+ *   are not part of the plan.
+ *
+ * Running the plan in a model executes all instructions in sequence.
+ * No objects are created in the model's value table unless the plan
+ * needs the evaluator. The results are read with the functions below.
+ *
+ * The plan evaluates all subterms, including the branches of
+ * if-then-else that are not taken. If something fails (e.g., the
+ * evaluator can't compute a value for a subterm, or the model gives
+ * an algebraic number), all roots are evaluated again with the
+ * evaluator, so the results and error codes are the same as
+ * eval_in_model's.
+ *
+ * The plan refers to terms in the term table: these terms must not
+ * be deleted (by the garbage collector) while the plan is in use
+ * (cf. eval_plan_gc_mark).
+ * Only uninterpreted terms are looked up in the model: the plan
+ * doesn't see values that a model may assign to other terms.
+ */
+
+#ifndef __EVAL_PLAN_H
+#define __EVAL_PLAN_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "model/models.h"
+#include "terms/rationals.h"
+#include "terms/terms.h"
+
+
+/*
+ * Register types
+ * - EVP_OBJECT: the register stores a value_t (computed by the evaluator)
+ */
+typedef enum evp_kind {
+  EVP_BOOL,
+  EVP_BV64,
+  EVP_RATIONAL,
+  EVP_OBJECT,
+} evp_kind_t;
+
+/*
+ * Instructions
+ */
+typedef enum evp_opcode {
+  EVP_CONST,        // constant: the register is set when the plan is built
+  EVP_LOAD,         // uninterpreted term: value from the model
+  EVP_EVAL,         // anything else: call the evaluator
+  EVP_OR,
+  EVP_XOR,
+  EVP_ITE,
+  EVP_EQ,
+  EVP_DISTINCT,
+  EVP_ARITH_EQ,     // (t == 0)
+  EVP_ARITH_GE,     // (t >= 0)
+  EVP_ARITH_BINEQ,  // (t1 == t2)
+  EVP_ARITH_IS_INT,
+  EVP_ARITH_FLOOR,
+  EVP_ARITH_CEIL,
+  EVP_ARITH_ABS,
+  EVP_ARITH_POLY,
+  EVP_ARITH_PPROD,
+  EVP_BV64_POLY,
+  EVP_BV64_PPROD,
+  EVP_BV64_ARRAY,
+  EVP_BV64_DIV,
+  EVP_BV64_REM,
+  EVP_BV64_SDIV,
+  EVP_BV64_SREM,
+  EVP_BV64_SMOD,
+  EVP_BV64_SHL,
+  EVP_BV64_LSHR,
+  EVP_BV64_ASHR,
+  EVP_BV64_EQ,
+  EVP_BV64_GE,
+  EVP_BV64_SGE,
+  EVP_BIT,
+} evp_opcode_t;
+
+
+/*
+ * Instruction descriptor:
+ * - op = opcode
+ * - kind = register type
+ * - nbits = number of bits for EVP_BV64
+ * - term = the term computed by this instruction (positive)
+ * - args = index of the first operand in plan->operands
+ * - nargs = number of operands
+ *
+ * The operands are (register index << 1) | polarity, where polarity is
+ * 1 for a negated Boolean term. For polynomials, there's one operand
+ * per monomial (the constant monomial has operand -1). For a power
+ * product, there's one operand per factor.
+ */
+typedef struct evp_instr_s {
+  uint8_t op;
+  uint8_t kind;
+  uint32_t nbits;
+  term_t term;
+  uint32_t args;
+  uint32_t nargs;
+} evp_instr_t;
+
+
+/*
+ * Plan:
+ * - terms = the term table
+ * - ninstr = number of instructions = number of registers
+ * - instr = array of instructions
+ * - operands = operand array
+ * - word = registers for Booleans, bit-vectors, and objects
+ * - rat = registers for rationals
+ * - nroots = number of roots
+ * - root = operand for each root
+ * - code = error code for each root after a run (0 means no error)
+ * - value = value of each root if the last run used the evaluator
+ * - vtbl = value table of the model used in the last run
+ * - has_eval = true if the plan contains EVP_EVAL instructions
+ * - slow = true if the last run fell back to the evaluator
+ */
+struct eval_plan_s {
+  term_table_t *terms;
+  uint32_t ninstr;
+  evp_instr_t *instr;
+  int32_t *operands;
+  uint64_t *word;
+  rational_t *rat;
+  uint32_t nroots;
+  int32_t *root;
+  int32_t *code;
+  value_t *value;
+  value_table_t *vtbl;
+  bool has_eval;
+  bool slow;
+};
+
+
+/*
+ * Build a plan for terms a[0 ... n-1]
+ * - all terms in a must be valid terms of the table
+ */
+extern void init_eval_plan(eval_plan_t *plan, term_table_t *terms, const term_t *a, uint32_t n);
+
+/*
+ * Delete the plan
+ */
+extern void delete_eval_plan(eval_plan_t *plan);
+
+/*
+ * Mark all the terms used by the plan (to preserve them in the next
+ * call to the garbage collector)
+ */
+extern void eval_plan_gc_mark(eval_plan_t *plan);
+
+/*
+ * Run the plan in model
+ * - the model must use the same term table as the plan
+ * - return 0 if all roots were evaluated without error, or
+ *   a negative error code (as returned by eval_in_model) for the
+ *   first root that couldn't be evaluated. The error code of
+ *   each root is stored in plan->code[i].
+ */
+extern int32_t eval_plan_run(eval_plan_t *plan, model_t *model);
+
+/*
+ * Results of the last run: root i must be valid and
+ * must have been evaluated without error.
+ */
+// Boolean root: check whether it's true
+extern bool eval_plan_is_true(eval_plan_t *plan, uint32_t i);
+
+// Convert the value of root i to an object in vtbl
+extern value_t eval_plan_value(eval_plan_t *plan, uint32_t i, value_table_t *vtbl);
+
+
+#endif /* __EVAL_PLAN_H */
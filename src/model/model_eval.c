@@ -1891,6 +1891,36 @@ void eval_terms_in_model(evaluator_t *eval, const term_t *a, uint32_t n) {
 }
 
 
+/*
+ * Compute the values of terms a[0 ... n-1] and store them in v[0 ... n-1]
+ * - all terms share the evaluator's cache so common subterms are
+ *   evaluated once
+ * - we set the jump buffer once for the whole array rather than once
+ *   per term. If the evaluation of a[i] fails, v[i] is set to the
+ *   error code and we continue with a[i+1].
+ */
+void eval_term_values_in_model(evaluator_t *eval, const term_t *a, uint32_t n, value_t *v) {
+  volatile uint32_t i;
+  value_t x;
+
+  i = 0;
+  while (i < n) {
+    x = setjmp(eval->env);
+    if (x == 0) {
+      while (i < n) {
+        v[i] = eval_term(eval, a[i]);
+        i ++;
+      }
+    } else {
+      assert(x < 0); // error code after longjmp
+      reset_istack(&eval->stack);
+      v[i] = x;
+      i ++;
+    }
+  }
+}
+
+
 /*
  * Check whether term t is useful:
  * - return true if t is unintepreted and has no existing value in eval->model
@@ -154,6 +154,15 @@ extern bool eval_to_unit_in_model(evaluator_t *eval, term_t t);
 extern void eval_terms_in_model(evaluator_t *eval, const term_t *a, uint32_t n);
 
 
+/*
+ * Compute the values of terms a[0 ... n-1] and store them in v[0 ... n-1]
+ * - v[i] is either the value of a[i] or a negative error code
+ * - this is equivalent to calling eval_in_model on each a[i] but cheaper
+ *   for large arrays
+ */
+extern void eval_term_values_in_model(evaluator_t *eval, const term_t *a, uint32_t n, value_t *v);
+
+
 /*
  * Add useful uninterpreted terms to the model.
  *
@@ -0,0 +1,160 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * ENVIRONMENT FOR LET BINDINGS
+ */
+
+#include <assert.h>
+#include <string.h>
+
+#include "parser_utils/let_env.h"
+#include "utils/hash_functions.h"
+#include "utils/memalloc.h"
+
+
+/*
+ * Initialize: the number of buckets is the same as the size
+ */
+void init_let_env(let_env_t *env) {
+  uint32_t i, n;
+
+  n = DEF_LET_ENV_SIZE;
+  env->data = (let_binding_t *) safe_malloc(n * sizeof(let_binding_t));
+  env->top = 0;
+  env->size = n;
+  env->bucket = (int32_t *) safe_malloc(n * sizeof(int32_t));
+  env->nbuckets = n;
+  for (i=0; i<n; i++) {
+    env->bucket[i] = -1;
+  }
+}
+
+void delete_let_env(let_env_t *env) {
+  safe_free(env->data);
+  safe_free(env->bucket);
+  env->data = NULL;
+  env->bucket = NULL;
+}
+
+void reset_let_env(let_env_t *env) {
+  uint32_t i, n;
+
+  n = env->nbuckets;
+  for (i=0; i<n; i++) {
+    env->bucket[i] = -1;
+  }
+  env->top = 0;
+}
+
+
+/*
+ * Make the data array and the bucket array twice as large
+ * - all bindings are added again to the new buckets, in order,
+ *   so that recent bindings still come first
+ */
+static void extend_let_env(let_env_t *env) {
+  let_binding_t *b;
+  uint32_t i, n, mask, h;
+
+  n = env->size * 2;
+  if (n > MAX_LET_ENV_SIZE || n > (uint32_t) INT32_MAX) {
+    out_of_memory();
+  }
+  env->data = (let_binding_t *) safe_realloc(env->data, n * sizeof(let_binding_t));
+  env->size = n;
+
+  safe_free(env->bucket);
+  env->bucket = (int32_t *) safe_malloc(n * sizeof(int32_t));
+  env->nbuckets = n;
+  for (i=0; i<n; i++) {
+    env->bucket[i] = -1;
+  }
+
+  mask = n - 1;
+  b = env->data;
+  for (i=0; i<env->top; i++) {
+    h = b[i].hash & mask;
+    b[i].next = env->bucket[h];
+    env->bucket[h] = i;
+  }
+}
+
+
+/*
+ * Add binding name --> t
+ */
+void let_env_push(let_env_t *env, const char *name, term_t t) {
+  let_binding_t *b;
+  uint32_t i, h;
+
+  i = env->top;
+  if (i == env->size) {
+    extend_let_env(env);
+  }
+  assert(i < env->size);
+
+  h = jenkins_hash_string(name);
+  b = env->data + i;
+  b->name = name;
+  b->term = t;
+  b->hash = h;
+  h &= env->nbuckets - 1;
+  b->next = env->bucket[h];
+  env->bucket[h] = i;
+  env->top = i+1;
+}
+
+
+/*
+ * Remove the last binding: it's the first in its bucket
+ */
+void let_env_pop(let_env_t *env) {
+  let_binding_t *b;
+  uint32_t h;
+
+  assert(env->top > 0);
+
+  env->top --;
+  b = env->data + env->top;
+  h = b->hash & (env->nbuckets - 1);
+  assert(env->bucket[h] == (int32_t) env->top);
+  env->bucket[h] = b->next;
+}
+
+
+/*
+ * Search for name
+ */
+term_t let_env_find_name(const let_env_t *env, const char *name) {
+  const let_binding_t *b;
+  uint32_t h;
+  int32_t i;
+
+  h = jenkins_hash_string(name);
+  i = env->bucket[h & (env->nbuckets - 1)];
+  while (i >= 0) {
+    b = env->data + i;
+    if (b->hash == h && strcmp(b->name, name) == 0) {
+      return b->term;
+    }
+    i = b->next;
+  }
+
+  return NULL_TERM;
+}
@@ -0,0 +1,112 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * ENVIRONMENT FOR LET BINDINGS
+ *
+ * The term stack used to give names to let-bound terms and bound
+ * variables in the global symbol table, and remove them at the end of
+ * the let or binder. This module replaces that by a local environment:
+ * a stack of bindings <name, term> with a hash table to find the most
+ * recent binding of a name. Let names and variables of quantifiers,
+ * lambdas, and function definitions share the environment, so the
+ * innermost binding of a name wins whatever its kind.
+ *
+ * Bindings are added and removed in LIFO order so both operations
+ * are constant time: a new binding is always the first element in
+ * its hash bucket. No string is copied: the names must remain valid
+ * until the binding is removed (the term stack keeps them in its arena).
+ */
+
+#ifndef __LET_ENV_H
+#define __LET_ENV_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "terms/terms.h"
+
+/*
+ * Binding record:
+ * - name = symbol
+ * - term = the term it's bound to
+ * - hash = hash code of name
+ * - next = index of the next binding in the same bucket (or -1)
+ */
+typedef struct let_binding_s {
+  const char *name;
+  term_t term;
+  uint32_t hash;
+  int32_t next;
+} let_binding_t;
+
+/*
+ * Environment:
+ * - data = array of bindings, top = number of bindings
+ * - size = size of the data array
+ * - bucket = hash table: bucket[h] = index of the most recent binding
+ *   with hash code h (modulo nbuckets) or -1
+ * - nbuckets = size of the bucket array (a power of two)
+ */
+typedef struct let_env_s {
+  let_binding_t *data;
+  uint32_t top;
+  uint32_t size;
+  int32_t *bucket;
+  uint32_t nbuckets;
+} let_env_t;
+
+#define DEF_LET_ENV_SIZE 64
+#define MAX_LET_ENV_SIZE (UINT32_MAX/sizeof(let_binding_t))
+
+
+/*
+ * Initialize/delete/empty the environment
+ */
+extern void init_let_env(let_env_t *env);
+extern void delete_let_env(let_env_t *env);
+extern void reset_let_env(let_env_t *env);
+
+/*
+ * Add binding name --> t (masks the previous bindings of name)
+ */
+extern void let_env_push(let_env_t *env, const char *name, term_t t);
+
+/*
+ * Remove the last binding (env must not be empty)
+ */
+extern void let_env_pop(let_env_t *env);
+
+/*
+ * Name of the last binding
+ */
+static inline const char *let_env_top_name(const let_env_t *env) {
+  return env->top == 0 ? NULL : env->data[env->top - 1].name;
+}
+
+/*
+ * Term bound to name or NULL_TERM if there's no binding for name
+ */
+extern term_t let_env_find_name(const let_env_t *env, const char *name);
+
+static inline term_t let_env_find(const let_env_t *env, const char *name) {
+  return env->top == 0 ? NULL_TERM : let_env_find_name(env, name);
+}
+
+
+#endif /* __LET_ENV_H */
@@ -40,6 +40,7 @@ static void init_lexer(lexer_t *lex) {
   lex->tk_line = 0;
   lex->tk_column = 0;
   lex->next = NULL;
+  lex->tokens = NULL;
 
   lex->buffer = (string_buffer_t *) safe_malloc(sizeof(string_buffer_t));
   init_string_buffer(lex->buffer, 128);
@@ -107,6 +108,15 @@ void init_string_lexer(lexer_t *lex, const char *data, const char *name) {
 }
 
 
+/*
+ * Initialize lexer for the first n characters of data
+ */
+void init_memory_lexer(lexer_t *lex, const char *data, uint64_t n, const char *name) {
+  init_memory_reader(&lex->reader, data, n, name);
+  init_lexer(lex);
+}
+
+
 /*
  * Change the input string for lex to data
  */
@@ -135,6 +145,7 @@ int32_t init_nested_lexer(lexer_t *lex, const char *filename, lexer_t *parent) {
   lex->tk_pos = 0;
   lex->tk_line = 0;
   lex->tk_column = 0;
+  lex->tokens = NULL;
 
   code = init_file_reader(&lex->reader, filename);
   if (code < 0) {
@@ -158,6 +169,7 @@ void init_nested_string_lexer(lexer_t *lex, const char *data, const char *name,
   lex->tk_pos = 0;
   lex->tk_line = 0;
   lex->tk_column = 0;
+  lex->tokens = NULL;
 
   init_string_reader(&lex->reader, data, name);
   lex->buffer = parent->buffer;
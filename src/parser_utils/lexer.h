@@ -52,6 +52,10 @@ typedef int32_t token_t;
  * String buffer is shared by all lexers in the stack.
  * Keywords is a hash table for storing the keywords. (Removed,
  * we now use a perfect hash function, generated using gperf).
+ *
+ * If tokens is not NULL, the lexer returns tokens that were
+ * scanned in advance (see smt2_prelexer.h) instead of reading
+ * them from the reader.
  */
 typedef struct lexer_s lexer_t;
 
@@ -62,6 +66,7 @@ struct lexer_s {
   reader_t reader;
   string_buffer_t *buffer;
   lexer_t *next;  // next in list = predecessor on lexer stack
+  void *tokens;   // pre-scanned tokens or NULL
 };
 
 
@@ -115,6 +120,11 @@ extern void init_wide_stream_lexer(lexer_t *lex, FILE *f, const char *name);
  */
 extern void init_string_lexer(lexer_t *lex, const char *data, const char *name);
 
+/*
+ * Read from the first n characters of data (no terminator required)
+ */
+extern void init_memory_lexer(lexer_t *lex, const char *data, uint64_t n, const char *name);
+
 
 /*
  * Change input string of lex to data
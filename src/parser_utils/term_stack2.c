@@ -42,6 +42,7 @@
 #include "terms/rba_buffer_terms.h"
 #include "utils/hash_functions.h"
 #include "utils/memalloc.h"
+#include "utils/refcount_strings.h"
 
 #include "yices.h"
 
@@ -78,6 +79,7 @@ void __attribute__((noreturn)) raise_exception(tstack_t *stack, stack_elem_t *e,
     stack->error_string = e->val.string;
     break;
   case TAG_BINDING:
+  case TAG_LET_BINDING:
     stack->error_string = e->val.binding.symbol;
     break;
   case TAG_TYPE_BINDING:
@@ -198,6 +200,8 @@ static void alloc_tstack(tstack_t *stack, uint32_t nops) {
   stack->name_buffer = NULL;
   stack->name_buffer_size = 0;
 
+  init_let_env(&stack->let_env);
+
   init_bvconstant(&stack->bvconst_buffer);
 
   stack->abuffer = NULL;
@@ -557,11 +561,25 @@ void tstack_push_type_by_name(tstack_t *stack, char *s, loc_t *loc) {
   e->loc = *loc;
 }
 
+/*
+ * Term of the given name: names bound by the enclosing let and
+ * binders first (innermost first), then the global symbol table
+ */
+term_t tstack_get_term_by_name(tstack_t *stack, const char *s) {
+  term_t t;
+
+  t = let_env_find(&stack->let_env, s);
+  if (t == NULL_TERM) {
+    t = _o_yices_get_term_by_name(s);
+  }
+  return t;
+}
+
 void tstack_push_term_by_name(tstack_t *stack, char *s, loc_t *loc) {
   stack_elem_t *e;
   term_t t;
 
-  t = _o_yices_get_term_by_name(s);
+  t = tstack_get_term_by_name(stack, s);
   if (t == NULL_TERM) push_exception(stack, loc, s, TSTACK_UNDEF_TERM);
 
   e = tstack_get_topelem(stack);
@@ -902,7 +920,9 @@ static void tstack_free_val(tstack_t *stack, stack_elem_t *e) {
     recycle_bvlbuffer(stack, e->val.bvlogic_buffer);
     break;
   case TAG_BINDING:
-    _o_yices_remove_term_name(e->val.binding.symbol);
+  case TAG_LET_BINDING:
+    assert(let_env_top_name(&stack->let_env) == e->val.binding.symbol);
+    let_env_pop(&stack->let_env);
     break;
   case TAG_TYPE_BINDING:
     _o_yices_remove_type_name(e->val.type_binding.symbol);
@@ -927,6 +947,7 @@ void tstack_reset(tstack_t *stack) {
     e --;
     tstack_free_val(stack, e);
   }
+  reset_let_env(&stack->let_env);
 
   arena_reset(&stack->mem);
   stack->top = 1;
@@ -1106,6 +1127,15 @@ void set_binding_result(tstack_t *stack, term_t t, char *symbol) {
   e->val.binding.symbol = symbol;
 }
 
+void set_let_binding_result(tstack_t *stack, term_t t, char *symbol) {
+  stack_elem_t *e;
+
+  e = stack->elem + (stack->top - 1);
+  e->tag = TAG_LET_BINDING;
+  e->val.binding.term = t;
+  e->val.binding.symbol = symbol;
+}
+
 void set_bv64_result(tstack_t *stack, uint32_t nbits, uint64_t c) {
   stack_elem_t *e;
 
@@ -1251,6 +1281,12 @@ static void print_elem(tstack_t *stack, stack_elem_t *e) {
     printf(">");
     break;
 
+  case TAG_LET_BINDING:
+    printf("<let-binding: %s --> ", e->val.binding.symbol);
+    print_term_id(stdout, e->val.binding.term);
+    printf(">");
+    break;
+
   case TAG_TYPE_BINDING:
     printf("<type-binding: %s --> ", e->val.type_binding.symbol);
     print_type_id(stdout, e->val.type_binding.type);
@@ -1445,7 +1481,7 @@ term_t get_term(tstack_t *stack, stack_elem_t *e) {
     break;
 
   case TAG_SYMBOL:
-    t = _o_yices_get_term_by_name(e->val.string);
+    t = tstack_get_term_by_name(stack, e->val.string);
     if (t == NULL_TERM) {
       raise_exception(stack, e, TSTACK_UNDEF_TERM);
     }
@@ -3002,6 +3038,8 @@ static void eval_define_term(tstack_t *stack, stack_elem_t *f, uint32_t n) {
 // the result of bind is a list of bindings object
 // they are pushed on the stack and will be removed when we
 // pop out of the enclosing let.
+// the names are added to the let environment, not to the
+// global symbol table.
 
 static void check_bind(tstack_t *stack, stack_elem_t *f, uint32_t n) {
   uint32_t i;
@@ -3019,7 +3057,7 @@ static void eval_bind(tstack_t *stack, stack_elem_t *f, uint32_t n) {
   char **names;
   char *name;
   term_t t;
-  uint32_t i, j, nb;
+  uint32_t i, j, k, nb;
 
   nb = n/2;
   assert(nb > 0);
@@ -3032,15 +3070,19 @@ static void eval_bind(tstack_t *stack, stack_elem_t *f, uint32_t n) {
     j ++;
     t = get_term(stack, f+j);
     j ++;
-    _o_yices_set_term_name(t, name);
     names[i] = name;
     values[i] = t;
   }
   tstack_pop_frame(stack);
 
-  // push back the bindings
+  // push back the bindings: one stack element per binding
   for (i=0; i<nb; i++) {
-    set_binding_result(stack, values[i], names[i]);
+    if (i > 0) {
+      k = tstack_get_top(stack);
+      stack->elem[k].loc = stack->elem[k-1].loc;
+    }
+    let_env_push(&stack->let_env, names[i], values[i]);
+    set_let_binding_result(stack, values[i], names[i]);
   }
 }
 
@@ -3064,8 +3106,10 @@ static void eval_declare_var(tstack_t *stack, stack_elem_t *f, uint32_t n) {
   tau = f[1].val.type;
   var = _o_yices_new_variable(tau);
 
-  _o_yices_set_term_name(var, name);
+  // the name is scoped like let names, the base name is kept for printing
+  set_term_base_name(__yices_globals.terms, var, clone_string(name));
   tstack_pop_frame(stack);
+  let_env_push(&stack->let_env, name, var);
   set_binding_result(stack, var, name);
 }
 
@@ -3100,7 +3144,7 @@ static void eval_declare_type_var(tstack_t *stack, stack_elem_t *f, uint32_t n)
 static void check_let(tstack_t *stack, stack_elem_t *f, uint32_t n) {
   check_op(stack, LET);
   check_size(stack, n>=2);
-  check_all_tags(stack, f, f + (n-1), TAG_BINDING);
+  check_all_tags(stack, f, f + (n-1), TAG_LET_BINDING);
 }
 
 static void eval_let(tstack_t *stack, stack_elem_t *f, uint32_t n) {
@@ -5854,6 +5898,7 @@ void delete_tstack(tstack_t *stack) {
   }
 
   delete_bvconstant(&stack->bvconst_buffer);
+  delete_let_env(&stack->let_env);
 
   if (stack->abuffer != NULL) {
     yices_free_arith_buffer(stack->abuffer);
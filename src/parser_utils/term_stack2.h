@@ -65,6 +65,7 @@
 #include <setjmp.h>
 
 #include "frontend/smt2/attribute_values.h"
+#include "parser_utils/let_env.h"
 #include "terms/bvlogic_buffers.h"
 #include "terms/terms.h"
 #include "utils/arena.h"
@@ -113,11 +114,12 @@ typedef enum tag_enum {
   TAG_BVARITH64_BUFFER, // polynomial buffer (bitvector coefficients, 1 to 64 bits)
   TAG_BVARITH_BUFFER,   // polynomial buffer (bitvector coefficients, more than 64 bits)
   TAG_BVLOGIC_BUFFER,   // array of bits
-  TAG_BINDING,          // pair <name, term>
+  TAG_BINDING,          // pair <name, variable> in the let environment
   TAG_TYPE_BINDING,     // pair <name, type>
+  TAG_LET_BINDING,      // pair <name, term> in the let environment
 } tag_t;
 
-#define NUM_TAGS (TAG_TYPE_BINDING+1)
+#define NUM_TAGS (TAG_LET_BINDING+1)
 
 // operator
 typedef struct opval_s {
@@ -232,6 +234,7 @@ typedef struct op_table_s {
  *
  * - auxiliary buffers for internal computations
  * - a global counter for creating fresh variables
+ * - let_env = terms bound by the enclosing let operators
  * - a longjmp buffer for simulating exceptions
  *
  * - some operations store a term or type result in
@@ -286,6 +289,9 @@ struct tstack_s {
   // counter for type-variable creation
   uint32_t tvar_id;
 
+  // let-bound names
+  let_env_t let_env;
+
   // result of BUILD_TERM/BUILD_TYPE
   union {
     term_t term;
@@ -633,6 +639,14 @@ extern void tstack_push_type_by_name(tstack_t *stack, char *s, loc_t *loc);
 extern void tstack_push_term_by_name(tstack_t *stack, char *s, loc_t *loc);
 extern void tstack_push_macro_by_name(tstack_t *stack, char *s, loc_t *loc);
 
+/*
+ * Term of name s: the names bound by the enclosing let and binders
+ * (quantifiers, lambda, function parameters) are searched first, the
+ * innermost binding first. Then the global symbol table.
+ * - return NULL_TERM if s is not mapped to a term
+ */
+extern term_t tstack_get_term_by_name(tstack_t *stack, const char *s);
+
 /*
  * Convert a string to a rational and push that
  * - s must be null-terminated and of rational or floating point formats
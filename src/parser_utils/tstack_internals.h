@@ -350,6 +350,7 @@ extern void tstack_pop_frame(tstack_t *stack);
 extern void set_term_result(tstack_t *stack, term_t t);
 extern void set_type_result(tstack_t *stack, type_t tau);
 extern void set_binding_result(tstack_t *stack, term_t t, char *symbol);
+extern void set_let_binding_result(tstack_t *stack, term_t t, char *symbol);
 extern void set_type_binding_result(tstack_t *stack, type_t, char *symbol);
 extern void set_bv64_result(tstack_t *stack, uint32_t nbits, uint64_t c);
 extern void set_bv_result(tstack_t *stack, uint32_t nbits, uint32_t *bv);
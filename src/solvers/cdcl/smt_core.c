@@ -1271,6 +1271,8 @@ static inline void reset_checkpoint_stack(checkpoint_stack_t *stack) {
  * Initialize a statistics record
  */
 static void init_statistics(dpll_stats_t *stat) {
+  uint32_t i;
+
   stat->restarts = 0;
   stat->simplify_calls = 0;
   stat->reduce_calls = 0;
@@ -1290,6 +1292,9 @@ static void init_statistics(dpll_stats_t *stat) {
   stat->bin_clauses_deleted = 0;
   stat->literals_before_simpl = 0;
   stat->subsumed_literals = 0;
+  for (i=0; i<DPLL_SIZE_BUCKETS; i++) {
+    stat->learned_size[i] = 0;
+  }
 }
 
 
@@ -2898,6 +2903,22 @@ static void direct_binary_clause(smt_core_t *s, literal_t l1, literal_t l2) {
 }
 
 
+/*
+ * Bucket index for a learned clause of size n (n >= 1)
+ */
+static inline uint32_t learned_size_bucket(uint32_t n) {
+  uint32_t i;
+
+  assert(n >= 1);
+  i = 0;
+  n --;
+  while (n > 0 && i < DPLL_SIZE_BUCKETS - 1) {
+    n >>= 1;
+    i ++;
+  }
+  return i;
+}
+
 /*
  * Add an array of literals a as a new learned clause, after conflict resolution.
  * - n must be at least 1
@@ -2912,6 +2933,8 @@ static void add_learned_clause(smt_core_t *s, uint32_t n, literal_t *a) {
   uint32_t i, j, k, q;
   literal_t l0, l1;
 
+  s->stats.learned_size[learned_size_bucket(n)] ++;
+
 #if TRACE
   printf("---> DPLL:   Learned clause: {");
   for (i=0; i<n; i++) {
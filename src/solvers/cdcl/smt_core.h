@@ -772,6 +772,14 @@ typedef struct checkpoint_stack_s {
  *  STATISTICS RECORD  *
  **********************/
 
+/*
+ * Histogram of learned clause sizes: bucket 0 counts the unit
+ * clauses, bucket i > 0 counts the clauses of size n where
+ * 2^(i-1) < n <= 2^i, and the last bucket counts everything
+ * larger than 2^(DPLL_SIZE_BUCKETS-2).
+ */
+#define DPLL_SIZE_BUCKETS 8
+
 /*
  * Search statistics
  */
@@ -800,6 +808,8 @@ typedef struct dpll_stats_s {
 
   uint64_t literals_before_simpl;
   uint64_t subsumed_literals;
+
+  uint64_t learned_size[DPLL_SIZE_BUCKETS]; // histogram of learned clause sizes
 } dpll_stats_t;
 
 
@@ -0,0 +1,216 @@
+#!/bin/bash
+
+#
+#  This file is part of the Yices SMT Solver.
+#  Copyright (C) 2017 SRI International.
+#
+#  Yices is free software: you can redistribute it and/or modify
+#  it under the terms of the GNU General Public License as published by
+#  the Free Software Foundation, either version 3 of the License, or
+#  (at your option) any later version.
+#
+#  Yices is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+#
+
+#
+# Round-trip regression for the binary SMT2 format
+#
+# Usage: check_binary.sh <test-dir> <bin-dir>
+#
+# For each SMT2 test file in test-dir, this converts the file to binary
+# format with yices_smt2 --write-binary, then replays the binary file
+# with yices_smt2 --binary-input, first in normal mode then with
+# --incremental. Each replay must produce the output in file.gold.
+# Command-line options in file.options are passed to all runs.
+#
+# Some expected outputs depend on the mode (e.g., the exists/forall
+# solver is not available with --incremental). If the text input does
+# not match file.gold in a mode, the replay is compared with the output
+# of the text input in that mode instead.
+#
+# The binary format does not keep source positions and commands that
+# fail to parse are not written to the binary file. So error messages
+# of the form (error "at line ...") are removed from the expected output.
+#
+
+if test $# != 2 ; then
+   echo "Usage: $0 <test-directory> <bin-directory>"
+   exit
+fi
+
+regress_dir=$1
+bin_dir=$2
+
+export LIBC_FATAL_STDERR_=1
+
+os_name=`uname 2>/dev/null` || os_name=unknown
+
+case "$os_name" in
+  *Darwin* )
+     mktemp_cmd="/usr/bin/mktemp -t out"
+  ;;
+
+  * )
+     mktemp_cmd=mktemp
+  ;;
+
+esac
+
+red=
+green=
+black=
+if test -t 1 ; then
+  red=`tput setaf 1`
+  green=`tput setaf 2`
+  black=`tput sgr0`
+fi
+
+outfile=`$mktemp_cmd` || { echo "Can't create temp file" ; exit 1 ; }
+binfile=`$mktemp_cmd` || { echo "Can't create temp file" ; exit 1 ; }
+textfile=`$mktemp_cmd` || { echo "Can't create temp file" ; exit 1 ; }
+expected=`$mktemp_cmd` || { echo "Can't create temp file" ; exit 1 ; }
+
+fail=0
+pass=0
+skip=0
+
+failed_tests=()
+
+if [[ -z "$REGRESS_FILTER" ]];
+then
+	REGRESS_FILTER="."
+fi
+
+if [[ -z "$TIME_LIMIT" ]];
+then
+  TIME_LIMIT=60
+fi
+
+./$bin_dir/yices_smt2 --mcsat >& /dev/null < /dev/null
+if [ $? -ne 0 ]
+then
+    MCSAT_FILTER="-v mcsat"
+else
+    MCSAT_FILTER="."
+fi
+
+all_tests=$(
+    find "$regress_dir" -name '*.smt2' |
+    grep $REGRESS_FILTER | grep $MCSAT_FILTER |
+    sort
+)
+
+for file in $all_tests; do
+
+    if [ -e "$file.options" ]
+    then
+        options=`cat $file.options`
+    else
+        options=
+    fi
+
+    if [ ! -e "$file.gold" ]
+    then
+        echo -n $red
+        echo "$file: FAIL: missing file: $file.gold"
+        echo -n $black
+        fail=`expr $fail + 1`
+        failed_tests+=("$file")
+        continue
+    fi
+
+    # Convert to binary
+    rm -f $binfile
+rm -f $textfile
+rm -f $expected
+    (
+      ulimit -S -t $TIME_LIMIT &> /dev/null
+      ulimit -H -t $((1+$TIME_LIMIT)) &> /dev/null
+      ./$bin_dir/yices_smt2 $options --write-binary=$binfile ./$file >& /dev/null
+    )
+    if [ ! -s $binfile ]
+    then
+        echo -n $red
+        echo "$file [ $options ]: FAIL: --write-binary produced no output"
+        echo -n $black
+        fail=`expr $fail + 1`
+        failed_tests+=("$file [ $options ]")
+        continue
+    fi
+
+    # Replay in normal and incremental mode
+    for mode in "" "--incremental"; do
+        test_string="$file [ $options $mode ]"
+        echo -n "$test_string "
+        (
+          ulimit -S -t $TIME_LIMIT &> /dev/null
+          ulimit -H -t $((1+$TIME_LIMIT)) &> /dev/null
+          ./$bin_dir/yices_smt2 $options $mode ./$file >& $textfile
+          ./$bin_dir/yices_smt2 $options $mode --binary-input $binfile >& $outfile
+        )
+
+        # The logic is not supported in this mode: the replay stops at
+        # the first command that depends on it, so there's nothing to compare.
+        if grep -q 'does not work in incremental mode' $textfile
+        then
+            echo SKIP
+            skip=`expr $skip + 1`
+            continue
+        fi
+
+        if diff -w -q $textfile $file.gold > /dev/null
+        then
+            reference=$file.gold
+        else
+            reference=$textfile
+        fi
+        grep -v '^(error "at line' $reference > $expected
+
+        DIFF=`diff -w $outfile $expected`
+
+        if [ $? -eq 0 ]
+        then
+            echo -n $green
+            echo PASS
+            echo -n $black
+            pass=`expr $pass + 1`
+        else
+            echo -n $red
+            echo FAIL
+            echo -n $black
+            fail=`expr $fail + 1`
+            failed_tests+=("$test_string"$'\n'"$DIFF")
+        fi
+    done
+
+done
+
+rm -f $outfile
+rm -f $binfile
+rm -f $textfile
+rm -f $expected
+
+if [ $fail -eq 0 ]
+then
+    echo -n $green
+else
+    echo -n $red
+fi
+echo Pass: $pass
+echo Fail: $fail
+echo Skip: $skip
+echo -n $black
+
+if [ $fail -eq 0 ]
+then
+    exit 0
+else
+    for i in "${!failed_tests[@]}"; do echo "$((i+1)). ${failed_tests[$i]}"; done
+    exit 1
+fi
@@ -0,0 +1,1006 @@
+(set-option :produce-models true)
+(set-logic QF_BV)
+; the first pair is wider than the pretty printer: no streaming
+(declare-fun v0 () (_ BitVec 8))
+(declare-fun v1 () (_ BitVec 8))
+(declare-fun v2 () (_ BitVec 8))
+(declare-fun v3 () (_ BitVec 8))
+(declare-fun v4 () (_ BitVec 8))
+(declare-fun v5 () (_ BitVec 8))
+(declare-fun v6 () (_ BitVec 8))
+(declare-fun v7 () (_ BitVec 8))
+(declare-fun v8 () (_ BitVec 8))
+(declare-fun v9 () (_ BitVec 8))
+(declare-fun v10 () (_ BitVec 8))
+(declare-fun v11 () (_ BitVec 8))
+(declare-fun v12 () (_ BitVec 8))
+(declare-fun v13 () (_ BitVec 8))
+(declare-fun v14 () (_ BitVec 8))
+(declare-fun v15 () (_ BitVec 8))
+(declare-fun v16 () (_ BitVec 8))
+(declare-fun v17 () (_ BitVec 8))
+(declare-fun v18 () (_ BitVec 8))
+(declare-fun v19 () (_ BitVec 8))
+(declare-fun v20 () (_ BitVec 8))
+(declare-fun v21 () (_ BitVec 8))
+(declare-fun v22 () (_ BitVec 8))
+(declare-fun v23 () (_ BitVec 8))
+(declare-fun v24 () (_ BitVec 8))
+(declare-fun v25 () (_ BitVec 8))
+(declare-fun v26 () (_ BitVec 8))
+(declare-fun v27 () (_ BitVec 8))
+(declare-fun v28 () (_ BitVec 8))
+(declare-fun v29 () (_ BitVec 8))
+(declare-fun v30 () (_ BitVec 8))
+(declare-fun v31 () (_ BitVec 8))
+(declare-fun v32 () (_ BitVec 8))
+(declare-fun v33 () (_ BitVec 8))
+(declare-fun v34 () (_ BitVec 8))
+(declare-fun v35 () (_ BitVec 8))
+(declare-fun v36 () (_ BitVec 8))
+(declare-fun v37 () (_ BitVec 8))
+(declare-fun v38 () (_ BitVec 8))
+(declare-fun v39 () (_ BitVec 8))
+(declare-fun v40 () (_ BitVec 8))
+(declare-fun v41 () (_ BitVec 8))
+(declare-fun v42 () (_ BitVec 8))
+(declare-fun v43 () (_ BitVec 8))
+(declare-fun v44 () (_ BitVec 8))
+(declare-fun v45 () (_ BitVec 8))
+(declare-fun v46 () (_ BitVec 8))
+(declare-fun v47 () (_ BitVec 8))
+(declare-fun v48 () (_ BitVec 8))
+(declare-fun v49 () (_ BitVec 8))
+(declare-fun v50 () (_ BitVec 8))
+(declare-fun v51 () (_ BitVec 8))
+(declare-fun v52 () (_ BitVec 8))
+(declare-fun v53 () (_ BitVec 8))
+(declare-fun v54 () (_ BitVec 8))
+(declare-fun v55 () (_ BitVec 8))
+(declare-fun v56 () (_ BitVec 8))
+(declare-fun v57 () (_ BitVec 8))
+(declare-fun v58 () (_ BitVec 8))
+(declare-fun v59 () (_ BitVec 8))
+(declare-fun v60 () (_ BitVec 8))
+(declare-fun v61 () (_ BitVec 8))
+(declare-fun v62 () (_ BitVec 8))
+(declare-fun v63 () (_ BitVec 8))
+(declare-fun v64 () (_ BitVec 8))
+(declare-fun v65 () (_ BitVec 8))
+(declare-fun v66 () (_ BitVec 8))
+(declare-fun v67 () (_ BitVec 8))
+(declare-fun v68 () (_ BitVec 8))
+(declare-fun v69 () (_ BitVec 8))
+(declare-fun v70 () (_ BitVec 8))
+(declare-fun v71 () (_ BitVec 8))
+(declare-fun v72 () (_ BitVec 8))
+(declare-fun v73 () (_ BitVec 8))
+(declare-fun v74 () (_ BitVec 8))
+(declare-fun v75 () (_ BitVec 8))
+(declare-fun v76 () (_ BitVec 8))
+(declare-fun v77 () (_ BitVec 8))
+(declare-fun v78 () (_ BitVec 8))
+(declare-fun v79 () (_ BitVec 8))
+(declare-fun v80 () (_ BitVec 8))
+(declare-fun v81 () (_ BitVec 8))
+(declare-fun v82 () (_ BitVec 8))
+(declare-fun v83 () (_ BitVec 8))
+(declare-fun v84 () (_ BitVec 8))
+(declare-fun v85 () (_ BitVec 8))
+(declare-fun v86 () (_ BitVec 8))
+(declare-fun v87 () (_ BitVec 8))
+(declare-fun v88 () (_ BitVec 8))
+(declare-fun v89 () (_ BitVec 8))
+(declare-fun v90 () (_ BitVec 8))
+(declare-fun v91 () (_ BitVec 8))
+(declare-fun v92 () (_ BitVec 8))
+(declare-fun v93 () (_ BitVec 8))
+(declare-fun v94 () (_ BitVec 8))
+(declare-fun v95 () (_ BitVec 8))
+(declare-fun v96 () (_ BitVec 8))
+(declare-fun v97 () (_ BitVec 8))
+(declare-fun v98 () (_ BitVec 8))
+(declare-fun v99 () (_ BitVec 8))
+(declare-fun v100 () (_ BitVec 8))
+(declare-fun v101 () (_ BitVec 8))
+(declare-fun v102 () (_ BitVec 8))
+(declare-fun v103 () (_ BitVec 8))
+(declare-fun v104 () (_ BitVec 8))
+(declare-fun v105 () (_ BitVec 8))
+(declare-fun v106 () (_ BitVec 8))
+(declare-fun v107 () (_ BitVec 8))
+(declare-fun v108 () (_ BitVec 8))
+(declare-fun v109 () (_ BitVec 8))
+(declare-fun v110 () (_ BitVec 8))
+(declare-fun v111 () (_ BitVec 8))
+(declare-fun v112 () (_ BitVec 8))
+(declare-fun v113 () (_ BitVec 8))
+(declare-fun v114 () (_ BitVec 8))
+(declare-fun v115 () (_ BitVec 8))
+(declare-fun v116 () (_ BitVec 8))
+(declare-fun v117 () (_ BitVec 8))
+(declare-fun v118 () (_ BitVec 8))
+(declare-fun v119 () (_ BitVec 8))
+(declare-fun v120 () (_ BitVec 8))
+(declare-fun v121 () (_ BitVec 8))
+(declare-fun v122 () (_ BitVec 8))
+(declare-fun v123 () (_ BitVec 8))
+(declare-fun v124 () (_ BitVec 8))
+(declare-fun v125 () (_ BitVec 8))
+(declare-fun v126 () (_ BitVec 8))
+(declare-fun v127 () (_ BitVec 8))
+(declare-fun v128 () (_ BitVec 8))
+(declare-fun v129 () (_ BitVec 8))
+(declare-fun v130 () (_ BitVec 8))
+(declare-fun v131 () (_ BitVec 8))
+(declare-fun v132 () (_ BitVec 8))
+(declare-fun v133 () (_ BitVec 8))
+(declare-fun v134 () (_ BitVec 8))
+(declare-fun v135 () (_ BitVec 8))
+(declare-fun v136 () (_ BitVec 8))
+(declare-fun v137 () (_ BitVec 8))
+(declare-fun v138 () (_ BitVec 8))
+(declare-fun v139 () (_ BitVec 8))
+(declare-fun v140 () (_ BitVec 8))
+(declare-fun v141 () (_ BitVec 8))
+(declare-fun v142 () (_ BitVec 8))
+(declare-fun v143 () (_ BitVec 8))
+(declare-fun v144 () (_ BitVec 8))
+(declare-fun v145 () (_ BitVec 8))
+(declare-fun v146 () (_ BitVec 8))
+(declare-fun v147 () (_ BitVec 8))
+(declare-fun v148 () (_ BitVec 8))
+(declare-fun v149 () (_ BitVec 8))
+(declare-fun v150 () (_ BitVec 8))
+(declare-fun v151 () (_ BitVec 8))
+(declare-fun v152 () (_ BitVec 8))
+(declare-fun v153 () (_ BitVec 8))
+(declare-fun v154 () (_ BitVec 8))
+(declare-fun v155 () (_ BitVec 8))
+(declare-fun v156 () (_ BitVec 8))
+(declare-fun v157 () (_ BitVec 8))
+(declare-fun v158 () (_ BitVec 8))
+(declare-fun v159 () (_ BitVec 8))
+(declare-fun v160 () (_ BitVec 8))
+(declare-fun v161 () (_ BitVec 8))
+(declare-fun v162 () (_ BitVec 8))
+(declare-fun v163 () (_ BitVec 8))
+(declare-fun v164 () (_ BitVec 8))
+(declare-fun v165 () (_ BitVec 8))
+(declare-fun v166 () (_ BitVec 8))
+(declare-fun v167 () (_ BitVec 8))
+(declare-fun v168 () (_ BitVec 8))
+(declare-fun v169 () (_ BitVec 8))
+(declare-fun v170 () (_ BitVec 8))
+(declare-fun v171 () (_ BitVec 8))
+(declare-fun v172 () (_ BitVec 8))
+(declare-fun v173 () (_ BitVec 8))
+(declare-fun v174 () (_ BitVec 8))
+(declare-fun v175 () (_ BitVec 8))
+(declare-fun v176 () (_ BitVec 8))
+(declare-fun v177 () (_ BitVec 8))
+(declare-fun v178 () (_ BitVec 8))
+(declare-fun v179 () (_ BitVec 8))
+(declare-fun v180 () (_ BitVec 8))
+(declare-fun v181 () (_ BitVec 8))
+(declare-fun v182 () (_ BitVec 8))
+(declare-fun v183 () (_ BitVec 8))
+(declare-fun v184 () (_ BitVec 8))
+(declare-fun v185 () (_ BitVec 8))
+(declare-fun v186 () (_ BitVec 8))
+(declare-fun v187 () (_ BitVec 8))
+(declare-fun v188 () (_ BitVec 8))
+(declare-fun v189 () (_ BitVec 8))
+(declare-fun v190 () (_ BitVec 8))
+(declare-fun v191 () (_ BitVec 8))
+(declare-fun v192 () (_ BitVec 8))
+(declare-fun v193 () (_ BitVec 8))
+(declare-fun v194 () (_ BitVec 8))
+(declare-fun v195 () (_ BitVec 8))
+(declare-fun v196 () (_ BitVec 8))
+(declare-fun v197 () (_ BitVec 8))
+(declare-fun v198 () (_ BitVec 8))
+(declare-fun v199 () (_ BitVec 8))
+(declare-fun v200 () (_ BitVec 8))
+(declare-fun v201 () (_ BitVec 8))
+(declare-fun v202 () (_ BitVec 8))
+(declare-fun v203 () (_ BitVec 8))
+(declare-fun v204 () (_ BitVec 8))
+(declare-fun v205 () (_ BitVec 8))
+(declare-fun v206 () (_ BitVec 8))
+(declare-fun v207 () (_ BitVec 8))
+(declare-fun v208 () (_ BitVec 8))
+(declare-fun v209 () (_ BitVec 8))
+(declare-fun v210 () (_ BitVec 8))
+(declare-fun v211 () (_ BitVec 8))
+(declare-fun v212 () (_ BitVec 8))
+(declare-fun v213 () (_ BitVec 8))
+(declare-fun v214 () (_ BitVec 8))
+(declare-fun v215 () (_ BitVec 8))
+(declare-fun v216 () (_ BitVec 8))
+(declare-fun v217 () (_ BitVec 8))
+(declare-fun v218 () (_ BitVec 8))
+(declare-fun v219 () (_ BitVec 8))
+(declare-fun v220 () (_ BitVec 8))
+(declare-fun v221 () (_ BitVec 8))
+(declare-fun v222 () (_ BitVec 8))
+(declare-fun v223 () (_ BitVec 8))
+(declare-fun v224 () (_ BitVec 8))
+(declare-fun v225 () (_ BitVec 8))
+(declare-fun v226 () (_ BitVec 8))
+(declare-fun v227 () (_ BitVec 8))
+(declare-fun v228 () (_ BitVec 8))
+(declare-fun v229 () (_ BitVec 8))
+(declare-fun v230 () (_ BitVec 8))
+(declare-fun v231 () (_ BitVec 8))
+(declare-fun v232 () (_ BitVec 8))
+(declare-fun v233 () (_ BitVec 8))
+(declare-fun v234 () (_ BitVec 8))
+(declare-fun v235 () (_ BitVec 8))
+(declare-fun v236 () (_ BitVec 8))
+(declare-fun v237 () (_ BitVec 8))
+(declare-fun v238 () (_ BitVec 8))
+(declare-fun v239 () (_ BitVec 8))
+(declare-fun v240 () (_ BitVec 8))
+(declare-fun v241 () (_ BitVec 8))
+(declare-fun v242 () (_ BitVec 8))
+(declare-fun v243 () (_ BitVec 8))
+(declare-fun v244 () (_ BitVec 8))
+(declare-fun v245 () (_ BitVec 8))
+(declare-fun v246 () (_ BitVec 8))
+(declare-fun v247 () (_ BitVec 8))
+(declare-fun v248 () (_ BitVec 8))
+(declare-fun v249 () (_ BitVec 8))
+(declare-fun v250 () (_ BitVec 8))
+(declare-fun v251 () (_ BitVec 8))
+(declare-fun v252 () (_ BitVec 8))
+(declare-fun v253 () (_ BitVec 8))
+(declare-fun v254 () (_ BitVec 8))
+(declare-fun v255 () (_ BitVec 8))
+(declare-fun v256 () (_ BitVec 8))
+(declare-fun v257 () (_ BitVec 8))
+(declare-fun v258 () (_ BitVec 8))
+(declare-fun v259 () (_ BitVec 8))
+(declare-fun v260 () (_ BitVec 8))
+(declare-fun v261 () (_ BitVec 8))
+(declare-fun v262 () (_ BitVec 8))
+(declare-fun v263 () (_ BitVec 8))
+(declare-fun v264 () (_ BitVec 8))
+(declare-fun v265 () (_ BitVec 8))
+(declare-fun v266 () (_ BitVec 8))
+(declare-fun v267 () (_ BitVec 8))
+(declare-fun v268 () (_ BitVec 8))
+(declare-fun v269 () (_ BitVec 8))
+(declare-fun v270 () (_ BitVec 8))
+(declare-fun v271 () (_ BitVec 8))
+(declare-fun v272 () (_ BitVec 8))
+(declare-fun v273 () (_ BitVec 8))
+(declare-fun v274 () (_ BitVec 8))
+(declare-fun v275 () (_ BitVec 8))
+(declare-fun v276 () (_ BitVec 8))
+(declare-fun v277 () (_ BitVec 8))
+(declare-fun v278 () (_ BitVec 8))
+(declare-fun v279 () (_ BitVec 8))
+(declare-fun v280 () (_ BitVec 8))
+(declare-fun v281 () (_ BitVec 8))
+(declare-fun v282 () (_ BitVec 8))
+(declare-fun v283 () (_ BitVec 8))
+(declare-fun v284 () (_ BitVec 8))
+(declare-fun v285 () (_ BitVec 8))
+(declare-fun v286 () (_ BitVec 8))
+(declare-fun v287 () (_ BitVec 8))
+(declare-fun v288 () (_ BitVec 8))
+(declare-fun v289 () (_ BitVec 8))
+(declare-fun v290 () (_ BitVec 8))
+(declare-fun v291 () (_ BitVec 8))
+(declare-fun v292 () (_ BitVec 8))
+(declare-fun v293 () (_ BitVec 8))
+(declare-fun v294 () (_ BitVec 8))
+(declare-fun v295 () (_ BitVec 8))
+(declare-fun v296 () (_ BitVec 8))
+(declare-fun v297 () (_ BitVec 8))
+(declare-fun v298 () (_ BitVec 8))
+(declare-fun v299 () (_ BitVec 8))
+(declare-fun v300 () (_ BitVec 8))
+(declare-fun v301 () (_ BitVec 8))
+(declare-fun v302 () (_ BitVec 8))
+(declare-fun v303 () (_ BitVec 8))
+(declare-fun v304 () (_ BitVec 8))
+(declare-fun v305 () (_ BitVec 8))
+(declare-fun v306 () (_ BitVec 8))
+(declare-fun v307 () (_ BitVec 8))
+(declare-fun v308 () (_ BitVec 8))
+(declare-fun v309 () (_ BitVec 8))
+(declare-fun v310 () (_ BitVec 8))
+(declare-fun v311 () (_ BitVec 8))
+(declare-fun v312 () (_ BitVec 8))
+(declare-fun v313 () (_ BitVec 8))
+(declare-fun v314 () (_ BitVec 8))
+(declare-fun v315 () (_ BitVec 8))
+(declare-fun v316 () (_ BitVec 8))
+(declare-fun v317 () (_ BitVec 8))
+(declare-fun v318 () (_ BitVec 8))
+(declare-fun v319 () (_ BitVec 8))
+(declare-fun v320 () (_ BitVec 8))
+(declare-fun v321 () (_ BitVec 8))
+(declare-fun v322 () (_ BitVec 8))
+(declare-fun v323 () (_ BitVec 8))
+(declare-fun v324 () (_ BitVec 8))
+(declare-fun v325 () (_ BitVec 8))
+(declare-fun v326 () (_ BitVec 8))
+(declare-fun v327 () (_ BitVec 8))
+(declare-fun v328 () (_ BitVec 8))
+(declare-fun v329 () (_ BitVec 8))
+(declare-fun v330 () (_ BitVec 8))
+(declare-fun v331 () (_ BitVec 8))
+(declare-fun v332 () (_ BitVec 8))
+(declare-fun v333 () (_ BitVec 8))
+(declare-fun v334 () (_ BitVec 8))
+(declare-fun v335 () (_ BitVec 8))
+(declare-fun v336 () (_ BitVec 8))
+(declare-fun v337 () (_ BitVec 8))
+(declare-fun v338 () (_ BitVec 8))
+(declare-fun v339 () (_ BitVec 8))
+(declare-fun v340 () (_ BitVec 8))
+(declare-fun v341 () (_ BitVec 8))
+(declare-fun v342 () (_ BitVec 8))
+(declare-fun v343 () (_ BitVec 8))
+(declare-fun v344 () (_ BitVec 8))
+(declare-fun v345 () (_ BitVec 8))
+(declare-fun v346 () (_ BitVec 8))
+(declare-fun v347 () (_ BitVec 8))
+(declare-fun v348 () (_ BitVec 8))
+(declare-fun v349 () (_ BitVec 8))
+(declare-fun v350 () (_ BitVec 8))
+(declare-fun v351 () (_ BitVec 8))
+(declare-fun v352 () (_ BitVec 8))
+(declare-fun v353 () (_ BitVec 8))
+(declare-fun v354 () (_ BitVec 8))
+(declare-fun v355 () (_ BitVec 8))
+(declare-fun v356 () (_ BitVec 8))
+(declare-fun v357 () (_ BitVec 8))
+(declare-fun v358 () (_ BitVec 8))
+(declare-fun v359 () (_ BitVec 8))
+(declare-fun v360 () (_ BitVec 8))
+(declare-fun v361 () (_ BitVec 8))
+(declare-fun v362 () (_ BitVec 8))
+(declare-fun v363 () (_ BitVec 8))
+(declare-fun v364 () (_ BitVec 8))
+(declare-fun v365 () (_ BitVec 8))
+(declare-fun v366 () (_ BitVec 8))
+(declare-fun v367 () (_ BitVec 8))
+(declare-fun v368 () (_ BitVec 8))
+(declare-fun v369 () (_ BitVec 8))
+(declare-fun v370 () (_ BitVec 8))
+(declare-fun v371 () (_ BitVec 8))
+(declare-fun v372 () (_ BitVec 8))
+(declare-fun v373 () (_ BitVec 8))
+(declare-fun v374 () (_ BitVec 8))
+(declare-fun v375 () (_ BitVec 8))
+(declare-fun v376 () (_ BitVec 8))
+(declare-fun v377 () (_ BitVec 8))
+(declare-fun v378 () (_ BitVec 8))
+(declare-fun v379 () (_ BitVec 8))
+(declare-fun v380 () (_ BitVec 8))
+(declare-fun v381 () (_ BitVec 8))
+(declare-fun v382 () (_ BitVec 8))
+(declare-fun v383 () (_ BitVec 8))
+(declare-fun v384 () (_ BitVec 8))
+(declare-fun v385 () (_ BitVec 8))
+(declare-fun v386 () (_ BitVec 8))
+(declare-fun v387 () (_ BitVec 8))
+(declare-fun v388 () (_ BitVec 8))
+(declare-fun v389 () (_ BitVec 8))
+(declare-fun v390 () (_ BitVec 8))
+(declare-fun v391 () (_ BitVec 8))
+(declare-fun v392 () (_ BitVec 8))
+(declare-fun v393 () (_ BitVec 8))
+(declare-fun v394 () (_ BitVec 8))
+(declare-fun v395 () (_ BitVec 8))
+(declare-fun v396 () (_ BitVec 8))
+(declare-fun v397 () (_ BitVec 8))
+(declare-fun v398 () (_ BitVec 8))
+(declare-fun v399 () (_ BitVec 8))
+(declare-fun v400 () (_ BitVec 8))
+(declare-fun v401 () (_ BitVec 8))
+(declare-fun v402 () (_ BitVec 8))
+(declare-fun v403 () (_ BitVec 8))
+(declare-fun v404 () (_ BitVec 8))
+(declare-fun v405 () (_ BitVec 8))
+(declare-fun v406 () (_ BitVec 8))
+(declare-fun v407 () (_ BitVec 8))
+(declare-fun v408 () (_ BitVec 8))
+(declare-fun v409 () (_ BitVec 8))
+(declare-fun v410 () (_ BitVec 8))
+(declare-fun v411 () (_ BitVec 8))
+(declare-fun v412 () (_ BitVec 8))
+(declare-fun v413 () (_ BitVec 8))
+(declare-fun v414 () (_ BitVec 8))
+(declare-fun v415 () (_ BitVec 8))
+(declare-fun v416 () (_ BitVec 8))
+(declare-fun v417 () (_ BitVec 8))
+(declare-fun v418 () (_ BitVec 8))
+(declare-fun v419 () (_ BitVec 8))
+(declare-fun v420 () (_ BitVec 8))
+(declare-fun v421 () (_ BitVec 8))
+(declare-fun v422 () (_ BitVec 8))
+(declare-fun v423 () (_ BitVec 8))
+(declare-fun v424 () (_ BitVec 8))
+(declare-fun v425 () (_ BitVec 8))
+(declare-fun v426 () (_ BitVec 8))
+(declare-fun v427 () (_ BitVec 8))
+(declare-fun v428 () (_ BitVec 8))
+(declare-fun v429 () (_ BitVec 8))
+(declare-fun v430 () (_ BitVec 8))
+(declare-fun v431 () (_ BitVec 8))
+(declare-fun v432 () (_ BitVec 8))
+(declare-fun v433 () (_ BitVec 8))
+(declare-fun v434 () (_ BitVec 8))
+(declare-fun v435 () (_ BitVec 8))
+(declare-fun v436 () (_ BitVec 8))
+(declare-fun v437 () (_ BitVec 8))
+(declare-fun v438 () (_ BitVec 8))
+(declare-fun v439 () (_ BitVec 8))
+(declare-fun v440 () (_ BitVec 8))
+(declare-fun v441 () (_ BitVec 8))
+(declare-fun v442 () (_ BitVec 8))
+(declare-fun v443 () (_ BitVec 8))
+(declare-fun v444 () (_ BitVec 8))
+(declare-fun v445 () (_ BitVec 8))
+(declare-fun v446 () (_ BitVec 8))
+(declare-fun v447 () (_ BitVec 8))
+(declare-fun v448 () (_ BitVec 8))
+(declare-fun v449 () (_ BitVec 8))
+(declare-fun v450 () (_ BitVec 8))
+(declare-fun v451 () (_ BitVec 8))
+(declare-fun v452 () (_ BitVec 8))
+(declare-fun v453 () (_ BitVec 8))
+(declare-fun v454 () (_ BitVec 8))
+(declare-fun v455 () (_ BitVec 8))
+(declare-fun v456 () (_ BitVec 8))
+(declare-fun v457 () (_ BitVec 8))
+(declare-fun v458 () (_ BitVec 8))
+(declare-fun v459 () (_ BitVec 8))
+(declare-fun v460 () (_ BitVec 8))
+(declare-fun v461 () (_ BitVec 8))
+(declare-fun v462 () (_ BitVec 8))
+(declare-fun v463 () (_ BitVec 8))
+(declare-fun v464 () (_ BitVec 8))
+(declare-fun v465 () (_ BitVec 8))
+(declare-fun v466 () (_ BitVec 8))
+(declare-fun v467 () (_ BitVec 8))
+(declare-fun v468 () (_ BitVec 8))
+(declare-fun v469 () (_ BitVec 8))
+(declare-fun v470 () (_ BitVec 8))
+(declare-fun v471 () (_ BitVec 8))
+(declare-fun v472 () (_ BitVec 8))
+(declare-fun v473 () (_ BitVec 8))
+(declare-fun v474 () (_ BitVec 8))
+(declare-fun v475 () (_ BitVec 8))
+(declare-fun v476 () (_ BitVec 8))
+(declare-fun v477 () (_ BitVec 8))
+(declare-fun v478 () (_ BitVec 8))
+(declare-fun v479 () (_ BitVec 8))
+(declare-fun v480 () (_ BitVec 8))
+(declare-fun v481 () (_ BitVec 8))
+(declare-fun v482 () (_ BitVec 8))
+(declare-fun v483 () (_ BitVec 8))
+(declare-fun v484 () (_ BitVec 8))
+(declare-fun v485 () (_ BitVec 8))
+(declare-fun v486 () (_ BitVec 8))
+(declare-fun v487 () (_ BitVec 8))
+(declare-fun v488 () (_ BitVec 8))
+(declare-fun v489 () (_ BitVec 8))
+(declare-fun v490 () (_ BitVec 8))
+(declare-fun v491 () (_ BitVec 8))
+(declare-fun v492 () (_ BitVec 8))
+(declare-fun v493 () (_ BitVec 8))
+(declare-fun v494 () (_ BitVec 8))
+(declare-fun v495 () (_ BitVec 8))
+(declare-fun v496 () (_ BitVec 8))
+(declare-fun v497 () (_ BitVec 8))
+(declare-fun v498 () (_ BitVec 8))
+(declare-fun v499 () (_ BitVec 8))
+(declare-fun v500 () (_ BitVec 8))
+(declare-fun v501 () (_ BitVec 8))
+(declare-fun v502 () (_ BitVec 8))
+(declare-fun v503 () (_ BitVec 8))
+(declare-fun v504 () (_ BitVec 8))
+(declare-fun v505 () (_ BitVec 8))
+(declare-fun v506 () (_ BitVec 8))
+(declare-fun v507 () (_ BitVec 8))
+(declare-fun v508 () (_ BitVec 8))
+(declare-fun v509 () (_ BitVec 8))
+(declare-fun v510 () (_ BitVec 8))
+(declare-fun v511 () (_ BitVec 8))
+(declare-fun v512 () (_ BitVec 8))
+(declare-fun v513 () (_ BitVec 8))
+(declare-fun v514 () (_ BitVec 8))
+(declare-fun v515 () (_ BitVec 8))
+(declare-fun v516 () (_ BitVec 8))
+(declare-fun v517 () (_ BitVec 8))
+(declare-fun v518 () (_ BitVec 8))
+(declare-fun v519 () (_ BitVec 8))
+(declare-fun v520 () (_ BitVec 8))
+(declare-fun v521 () (_ BitVec 8))
+(declare-fun v522 () (_ BitVec 8))
+(declare-fun v523 () (_ BitVec 8))
+(declare-fun v524 () (_ BitVec 8))
+(declare-fun v525 () (_ BitVec 8))
+(declare-fun v526 () (_ BitVec 8))
+(declare-fun v527 () (_ BitVec 8))
+(declare-fun v528 () (_ BitVec 8))
+(declare-fun v529 () (_ BitVec 8))
+(declare-fun v530 () (_ BitVec 8))
+(declare-fun v531 () (_ BitVec 8))
+(declare-fun v532 () (_ BitVec 8))
+(declare-fun v533 () (_ BitVec 8))
+(declare-fun v534 () (_ BitVec 8))
+(declare-fun v535 () (_ BitVec 8))
+(declare-fun v536 () (_ BitVec 8))
+(declare-fun v537 () (_ BitVec 8))
+(declare-fun v538 () (_ BitVec 8))
+(declare-fun v539 () (_ BitVec 8))
+(declare-fun v540 () (_ BitVec 8))
+(declare-fun v541 () (_ BitVec 8))
+(declare-fun v542 () (_ BitVec 8))
+(declare-fun v543 () (_ BitVec 8))
+(declare-fun v544 () (_ BitVec 8))
+(declare-fun v545 () (_ BitVec 8))
+(declare-fun v546 () (_ BitVec 8))
+(declare-fun v547 () (_ BitVec 8))
+(declare-fun v548 () (_ BitVec 8))
+(declare-fun v549 () (_ BitVec 8))
+(declare-fun v550 () (_ BitVec 8))
+(declare-fun v551 () (_ BitVec 8))
+(declare-fun v552 () (_ BitVec 8))
+(declare-fun v553 () (_ BitVec 8))
+(declare-fun v554 () (_ BitVec 8))
+(declare-fun v555 () (_ BitVec 8))
+(declare-fun v556 () (_ BitVec 8))
+(declare-fun v557 () (_ BitVec 8))
+(declare-fun v558 () (_ BitVec 8))
+(declare-fun v559 () (_ BitVec 8))
+(declare-fun v560 () (_ BitVec 8))
+(declare-fun v561 () (_ BitVec 8))
+(declare-fun v562 () (_ BitVec 8))
+(declare-fun v563 () (_ BitVec 8))
+(declare-fun v564 () (_ BitVec 8))
+(declare-fun v565 () (_ BitVec 8))
+(declare-fun v566 () (_ BitVec 8))
+(declare-fun v567 () (_ BitVec 8))
+(declare-fun v568 () (_ BitVec 8))
+(declare-fun v569 () (_ BitVec 8))
+(declare-fun v570 () (_ BitVec 8))
+(declare-fun v571 () (_ BitVec 8))
+(declare-fun v572 () (_ BitVec 8))
+(declare-fun v573 () (_ BitVec 8))
+(declare-fun v574 () (_ BitVec 8))
+(declare-fun v575 () (_ BitVec 8))
+(declare-fun v576 () (_ BitVec 8))
+(declare-fun v577 () (_ BitVec 8))
+(declare-fun v578 () (_ BitVec 8))
+(declare-fun v579 () (_ BitVec 8))
+(declare-fun v580 () (_ BitVec 8))
+(declare-fun v581 () (_ BitVec 8))
+(declare-fun v582 () (_ BitVec 8))
+(declare-fun v583 () (_ BitVec 8))
+(declare-fun v584 () (_ BitVec 8))
+(declare-fun v585 () (_ BitVec 8))
+(declare-fun v586 () (_ BitVec 8))
+(declare-fun v587 () (_ BitVec 8))
+(declare-fun v588 () (_ BitVec 8))
+(declare-fun v589 () (_ BitVec 8))
+(declare-fun v590 () (_ BitVec 8))
+(declare-fun v591 () (_ BitVec 8))
+(declare-fun v592 () (_ BitVec 8))
+(declare-fun v593 () (_ BitVec 8))
+(declare-fun v594 () (_ BitVec 8))
+(declare-fun v595 () (_ BitVec 8))
+(declare-fun v596 () (_ BitVec 8))
+(declare-fun v597 () (_ BitVec 8))
+(declare-fun v598 () (_ BitVec 8))
+(declare-fun v599 () (_ BitVec 8))
+(declare-fun v600 () (_ BitVec 8))
+(declare-fun v601 () (_ BitVec 8))
+(declare-fun v602 () (_ BitVec 8))
+(declare-fun v603 () (_ BitVec 8))
+(declare-fun v604 () (_ BitVec 8))
+(declare-fun v605 () (_ BitVec 8))
+(declare-fun v606 () (_ BitVec 8))
+(declare-fun v607 () (_ BitVec 8))
+(declare-fun v608 () (_ BitVec 8))
+(declare-fun v609 () (_ BitVec 8))
+(declare-fun v610 () (_ BitVec 8))
+(declare-fun v611 () (_ BitVec 8))
+(declare-fun v612 () (_ BitVec 8))
+(declare-fun v613 () (_ BitVec 8))
+(declare-fun v614 () (_ BitVec 8))
+(declare-fun v615 () (_ BitVec 8))
+(declare-fun v616 () (_ BitVec 8))
+(declare-fun v617 () (_ BitVec 8))
+(declare-fun v618 () (_ BitVec 8))
+(declare-fun v619 () (_ BitVec 8))
+(declare-fun v620 () (_ BitVec 8))
+(declare-fun v621 () (_ BitVec 8))
+(declare-fun v622 () (_ BitVec 8))
+(declare-fun v623 () (_ BitVec 8))
+(declare-fun v624 () (_ BitVec 8))
+(declare-fun v625 () (_ BitVec 8))
+(declare-fun v626 () (_ BitVec 8))
+(declare-fun v627 () (_ BitVec 8))
+(declare-fun v628 () (_ BitVec 8))
+(declare-fun v629 () (_ BitVec 8))
+(declare-fun v630 () (_ BitVec 8))
+(declare-fun v631 () (_ BitVec 8))
+(declare-fun v632 () (_ BitVec 8))
+(declare-fun v633 () (_ BitVec 8))
+(declare-fun v634 () (_ BitVec 8))
+(declare-fun v635 () (_ BitVec 8))
+(declare-fun v636 () (_ BitVec 8))
+(declare-fun v637 () (_ BitVec 8))
+(declare-fun v638 () (_ BitVec 8))
+(declare-fun v639 () (_ BitVec 8))
+(declare-fun v640 () (_ BitVec 8))
+(declare-fun v641 () (_ BitVec 8))
+(declare-fun v642 () (_ BitVec 8))
+(declare-fun v643 () (_ BitVec 8))
+(declare-fun v644 () (_ BitVec 8))
+(declare-fun v645 () (_ BitVec 8))
+(declare-fun v646 () (_ BitVec 8))
+(declare-fun v647 () (_ BitVec 8))
+(declare-fun v648 () (_ BitVec 8))
+(declare-fun v649 () (_ BitVec 8))
+(declare-fun v650 () (_ BitVec 8))
+(declare-fun v651 () (_ BitVec 8))
+(declare-fun v652 () (_ BitVec 8))
+(declare-fun v653 () (_ BitVec 8))
+(declare-fun v654 () (_ BitVec 8))
+(declare-fun v655 () (_ BitVec 8))
+(declare-fun v656 () (_ BitVec 8))
+(declare-fun v657 () (_ BitVec 8))
+(declare-fun v658 () (_ BitVec 8))
+(declare-fun v659 () (_ BitVec 8))
+(declare-fun v660 () (_ BitVec 8))
+(declare-fun v661 () (_ BitVec 8))
+(declare-fun v662 () (_ BitVec 8))
+(declare-fun v663 () (_ BitVec 8))
+(declare-fun v664 () (_ BitVec 8))
+(declare-fun v665 () (_ BitVec 8))
+(declare-fun v666 () (_ BitVec 8))
+(declare-fun v667 () (_ BitVec 8))
+(declare-fun v668 () (_ BitVec 8))
+(declare-fun v669 () (_ BitVec 8))
+(declare-fun v670 () (_ BitVec 8))
+(declare-fun v671 () (_ BitVec 8))
+(declare-fun v672 () (_ BitVec 8))
+(declare-fun v673 () (_ BitVec 8))
+(declare-fun v674 () (_ BitVec 8))
+(declare-fun v675 () (_ BitVec 8))
+(declare-fun v676 () (_ BitVec 8))
+(declare-fun v677 () (_ BitVec 8))
+(declare-fun v678 () (_ BitVec 8))
+(declare-fun v679 () (_ BitVec 8))
+(declare-fun v680 () (_ BitVec 8))
+(declare-fun v681 () (_ BitVec 8))
+(declare-fun v682 () (_ BitVec 8))
+(declare-fun v683 () (_ BitVec 8))
+(declare-fun v684 () (_ BitVec 8))
+(declare-fun v685 () (_ BitVec 8))
+(declare-fun v686 () (_ BitVec 8))
+(declare-fun v687 () (_ BitVec 8))
+(declare-fun v688 () (_ BitVec 8))
+(declare-fun v689 () (_ BitVec 8))
+(declare-fun v690 () (_ BitVec 8))
+(declare-fun v691 () (_ BitVec 8))
+(declare-fun v692 () (_ BitVec 8))
+(declare-fun v693 () (_ BitVec 8))
+(declare-fun v694 () (_ BitVec 8))
+(declare-fun v695 () (_ BitVec 8))
+(declare-fun v696 () (_ BitVec 8))
+(declare-fun v697 () (_ BitVec 8))
+(declare-fun v698 () (_ BitVec 8))
+(declare-fun v699 () (_ BitVec 8))
+(declare-fun v700 () (_ BitVec 8))
+(declare-fun v701 () (_ BitVec 8))
+(declare-fun v702 () (_ BitVec 8))
+(declare-fun v703 () (_ BitVec 8))
+(declare-fun v704 () (_ BitVec 8))
+(declare-fun v705 () (_ BitVec 8))
+(declare-fun v706 () (_ BitVec 8))
+(declare-fun v707 () (_ BitVec 8))
+(declare-fun v708 () (_ BitVec 8))
+(declare-fun v709 () (_ BitVec 8))
+(declare-fun v710 () (_ BitVec 8))
+(declare-fun v711 () (_ BitVec 8))
+(declare-fun v712 () (_ BitVec 8))
+(declare-fun v713 () (_ BitVec 8))
+(declare-fun v714 () (_ BitVec 8))
+(declare-fun v715 () (_ BitVec 8))
+(declare-fun v716 () (_ BitVec 8))
+(declare-fun v717 () (_ BitVec 8))
+(declare-fun v718 () (_ BitVec 8))
+(declare-fun v719 () (_ BitVec 8))
+(declare-fun v720 () (_ BitVec 8))
+(declare-fun v721 () (_ BitVec 8))
+(declare-fun v722 () (_ BitVec 8))
+(declare-fun v723 () (_ BitVec 8))
+(declare-fun v724 () (_ BitVec 8))
+(declare-fun v725 () (_ BitVec 8))
+(declare-fun v726 () (_ BitVec 8))
+(declare-fun v727 () (_ BitVec 8))
+(declare-fun v728 () (_ BitVec 8))
+(declare-fun v729 () (_ BitVec 8))
+(declare-fun v730 () (_ BitVec 8))
+(declare-fun v731 () (_ BitVec 8))
+(declare-fun v732 () (_ BitVec 8))
+(declare-fun v733 () (_ BitVec 8))
+(declare-fun v734 () (_ BitVec 8))
+(declare-fun v735 () (_ BitVec 8))
+(declare-fun v736 () (_ BitVec 8))
+(declare-fun v737 () (_ BitVec 8))
+(declare-fun v738 () (_ BitVec 8))
+(declare-fun v739 () (_ BitVec 8))
+(declare-fun v740 () (_ BitVec 8))
+(declare-fun v741 () (_ BitVec 8))
+(declare-fun v742 () (_ BitVec 8))
+(declare-fun v743 () (_ BitVec 8))
+(declare-fun v744 () (_ BitVec 8))
+(declare-fun v745 () (_ BitVec 8))
+(declare-fun v746 () (_ BitVec 8))
+(declare-fun v747 () (_ BitVec 8))
+(declare-fun v748 () (_ BitVec 8))
+(declare-fun v749 () (_ BitVec 8))
+(declare-fun v750 () (_ BitVec 8))
+(declare-fun v751 () (_ BitVec 8))
+(declare-fun v752 () (_ BitVec 8))
+(declare-fun v753 () (_ BitVec 8))
+(declare-fun v754 () (_ BitVec 8))
+(declare-fun v755 () (_ BitVec 8))
+(declare-fun v756 () (_ BitVec 8))
+(declare-fun v757 () (_ BitVec 8))
+(declare-fun v758 () (_ BitVec 8))
+(declare-fun v759 () (_ BitVec 8))
+(declare-fun v760 () (_ BitVec 8))
+(declare-fun v761 () (_ BitVec 8))
+(declare-fun v762 () (_ BitVec 8))
+(declare-fun v763 () (_ BitVec 8))
+(declare-fun v764 () (_ BitVec 8))
+(declare-fun v765 () (_ BitVec 8))
+(declare-fun v766 () (_ BitVec 8))
+(declare-fun v767 () (_ BitVec 8))
+(declare-fun v768 () (_ BitVec 8))
+(declare-fun v769 () (_ BitVec 8))
+(declare-fun v770 () (_ BitVec 8))
+(declare-fun v771 () (_ BitVec 8))
+(declare-fun v772 () (_ BitVec 8))
+(declare-fun v773 () (_ BitVec 8))
+(declare-fun v774 () (_ BitVec 8))
+(declare-fun v775 () (_ BitVec 8))
+(declare-fun v776 () (_ BitVec 8))
+(declare-fun v777 () (_ BitVec 8))
+(declare-fun v778 () (_ BitVec 8))
+(declare-fun v779 () (_ BitVec 8))
+(declare-fun v780 () (_ BitVec 8))
+(declare-fun v781 () (_ BitVec 8))
+(declare-fun v782 () (_ BitVec 8))
+(declare-fun v783 () (_ BitVec 8))
+(declare-fun v784 () (_ BitVec 8))
+(declare-fun v785 () (_ BitVec 8))
+(declare-fun v786 () (_ BitVec 8))
+(declare-fun v787 () (_ BitVec 8))
+(declare-fun v788 () (_ BitVec 8))
+(declare-fun v789 () (_ BitVec 8))
+(declare-fun v790 () (_ BitVec 8))
+(declare-fun v791 () (_ BitVec 8))
+(declare-fun v792 () (_ BitVec 8))
+(declare-fun v793 () (_ BitVec 8))
+(declare-fun v794 () (_ BitVec 8))
+(declare-fun v795 () (_ BitVec 8))
+(declare-fun v796 () (_ BitVec 8))
+(declare-fun v797 () (_ BitVec 8))
+(declare-fun v798 () (_ BitVec 8))
+(declare-fun v799 () (_ BitVec 8))
+(declare-fun v800 () (_ BitVec 8))
+(declare-fun v801 () (_ BitVec 8))
+(declare-fun v802 () (_ BitVec 8))
+(declare-fun v803 () (_ BitVec 8))
+(declare-fun v804 () (_ BitVec 8))
+(declare-fun v805 () (_ BitVec 8))
+(declare-fun v806 () (_ BitVec 8))
+(declare-fun v807 () (_ BitVec 8))
+(declare-fun v808 () (_ BitVec 8))
+(declare-fun v809 () (_ BitVec 8))
+(declare-fun v810 () (_ BitVec 8))
+(declare-fun v811 () (_ BitVec 8))
+(declare-fun v812 () (_ BitVec 8))
+(declare-fun v813 () (_ BitVec 8))
+(declare-fun v814 () (_ BitVec 8))
+(declare-fun v815 () (_ BitVec 8))
+(declare-fun v816 () (_ BitVec 8))
+(declare-fun v817 () (_ BitVec 8))
+(declare-fun v818 () (_ BitVec 8))
+(declare-fun v819 () (_ BitVec 8))
+(declare-fun v820 () (_ BitVec 8))
+(declare-fun v821 () (_ BitVec 8))
+(declare-fun v822 () (_ BitVec 8))
+(declare-fun v823 () (_ BitVec 8))
+(declare-fun v824 () (_ BitVec 8))
+(declare-fun v825 () (_ BitVec 8))
+(declare-fun v826 () (_ BitVec 8))
+(declare-fun v827 () (_ BitVec 8))
+(declare-fun v828 () (_ BitVec 8))
+(declare-fun v829 () (_ BitVec 8))
+(declare-fun v830 () (_ BitVec 8))
+(declare-fun v831 () (_ BitVec 8))
+(declare-fun v832 () (_ BitVec 8))
+(declare-fun v833 () (_ BitVec 8))
+(declare-fun v834 () (_ BitVec 8))
+(declare-fun v835 () (_ BitVec 8))
+(declare-fun v836 () (_ BitVec 8))
+(declare-fun v837 () (_ BitVec 8))
+(declare-fun v838 () (_ BitVec 8))
+(declare-fun v839 () (_ BitVec 8))
+(declare-fun v840 () (_ BitVec 8))
+(declare-fun v841 () (_ BitVec 8))
+(declare-fun v842 () (_ BitVec 8))
+(declare-fun v843 () (_ BitVec 8))
+(declare-fun v844 () (_ BitVec 8))
+(declare-fun v845 () (_ BitVec 8))
+(declare-fun v846 () (_ BitVec 8))
+(declare-fun v847 () (_ BitVec 8))
+(declare-fun v848 () (_ BitVec 8))
+(declare-fun v849 () (_ BitVec 8))
+(declare-fun v850 () (_ BitVec 8))
+(declare-fun v851 () (_ BitVec 8))
+(declare-fun v852 () (_ BitVec 8))
+(declare-fun v853 () (_ BitVec 8))
+(declare-fun v854 () (_ BitVec 8))
+(declare-fun v855 () (_ BitVec 8))
+(declare-fun v856 () (_ BitVec 8))
+(declare-fun v857 () (_ BitVec 8))
+(declare-fun v858 () (_ BitVec 8))
+(declare-fun v859 () (_ BitVec 8))
+(declare-fun v860 () (_ BitVec 8))
+(declare-fun v861 () (_ BitVec 8))
+(declare-fun v862 () (_ BitVec 8))
+(declare-fun v863 () (_ BitVec 8))
+(declare-fun v864 () (_ BitVec 8))
+(declare-fun v865 () (_ BitVec 8))
+(declare-fun v866 () (_ BitVec 8))
+(declare-fun v867 () (_ BitVec 8))
+(declare-fun v868 () (_ BitVec 8))
+(declare-fun v869 () (_ BitVec 8))
+(declare-fun v870 () (_ BitVec 8))
+(declare-fun v871 () (_ BitVec 8))
+(declare-fun v872 () (_ BitVec 8))
+(declare-fun v873 () (_ BitVec 8))
+(declare-fun v874 () (_ BitVec 8))
+(declare-fun v875 () (_ BitVec 8))
+(declare-fun v876 () (_ BitVec 8))
+(declare-fun v877 () (_ BitVec 8))
+(declare-fun v878 () (_ BitVec 8))
+(declare-fun v879 () (_ BitVec 8))
+(declare-fun v880 () (_ BitVec 8))
+(declare-fun v881 () (_ BitVec 8))
+(declare-fun v882 () (_ BitVec 8))
+(declare-fun v883 () (_ BitVec 8))
+(declare-fun v884 () (_ BitVec 8))
+(declare-fun v885 () (_ BitVec 8))
+(declare-fun v886 () (_ BitVec 8))
+(declare-fun v887 () (_ BitVec 8))
+(declare-fun v888 () (_ BitVec 8))
+(declare-fun v889 () (_ BitVec 8))
+(declare-fun v890 () (_ BitVec 8))
+(declare-fun v891 () (_ BitVec 8))
+(declare-fun v892 () (_ BitVec 8))
+(declare-fun v893 () (_ BitVec 8))
+(declare-fun v894 () (_ BitVec 8))
+(declare-fun v895 () (_ BitVec 8))
+(declare-fun v896 () (_ BitVec 8))
+(declare-fun v897 () (_ BitVec 8))
+(declare-fun v898 () (_ BitVec 8))
+(declare-fun v899 () (_ BitVec 8))
+(declare-fun v900 () (_ BitVec 8))
+(declare-fun v901 () (_ BitVec 8))
+(declare-fun v902 () (_ BitVec 8))
+(declare-fun v903 () (_ BitVec 8))
+(declare-fun v904 () (_ BitVec 8))
+(declare-fun v905 () (_ BitVec 8))
+(declare-fun v906 () (_ BitVec 8))
+(declare-fun v907 () (_ BitVec 8))
+(declare-fun v908 () (_ BitVec 8))
+(declare-fun v909 () (_ BitVec 8))
+(declare-fun v910 () (_ BitVec 8))
+(declare-fun v911 () (_ BitVec 8))
+(declare-fun v912 () (_ BitVec 8))
+(declare-fun v913 () (_ BitVec 8))
+(declare-fun v914 () (_ BitVec 8))
+(declare-fun v915 () (_ BitVec 8))
+(declare-fun v916 () (_ BitVec 8))
+(declare-fun v917 () (_ BitVec 8))
+(declare-fun v918 () (_ BitVec 8))
+(declare-fun v919 () (_ BitVec 8))
+(declare-fun v920 () (_ BitVec 8))
+(declare-fun v921 () (_ BitVec 8))
+(declare-fun v922 () (_ BitVec 8))
+(declare-fun v923 () (_ BitVec 8))
+(declare-fun v924 () (_ BitVec 8))
+(declare-fun v925 () (_ BitVec 8))
+(declare-fun v926 () (_ BitVec 8))
+(declare-fun v927 () (_ BitVec 8))
+(declare-fun v928 () (_ BitVec 8))
+(declare-fun v929 () (_ BitVec 8))
+(declare-fun v930 () (_ BitVec 8))
+(declare-fun v931 () (_ BitVec 8))
+(declare-fun v932 () (_ BitVec 8))
+(declare-fun v933 () (_ BitVec 8))
+(declare-fun v934 () (_ BitVec 8))
+(declare-fun v935 () (_ BitVec 8))
+(declare-fun v936 () (_ BitVec 8))
+(declare-fun v937 () (_ BitVec 8))
+(declare-fun v938 () (_ BitVec 8))
+(declare-fun v939 () (_ BitVec 8))
+(declare-fun v940 () (_ BitVec 8))
+(declare-fun v941 () (_ BitVec 8))
+(declare-fun v942 () (_ BitVec 8))
+(declare-fun v943 () (_ BitVec 8))
+(declare-fun v944 () (_ BitVec 8))
+(declare-fun v945 () (_ BitVec 8))
+(declare-fun v946 () (_ BitVec 8))
+(declare-fun v947 () (_ BitVec 8))
+(declare-fun v948 () (_ BitVec 8))
+(declare-fun v949 () (_ BitVec 8))
+(declare-fun v950 () (_ BitVec 8))
+(declare-fun v951 () (_ BitVec 8))
+(declare-fun v952 () (_ BitVec 8))
+(declare-fun v953 () (_ BitVec 8))
+(declare-fun v954 () (_ BitVec 8))
+(declare-fun v955 () (_ BitVec 8))
+(declare-fun v956 () (_ BitVec 8))
+(declare-fun v957 () (_ BitVec 8))
+(declare-fun v958 () (_ BitVec 8))
+(declare-fun v959 () (_ BitVec 8))
+(declare-fun v960 () (_ BitVec 8))
+(declare-fun v961 () (_ BitVec 8))
+(declare-fun v962 () (_ BitVec 8))
+(declare-fun v963 () (_ BitVec 8))
+(declare-fun v964 () (_ BitVec 8))
+(declare-fun v965 () (_ BitVec 8))
+(declare-fun v966 () (_ BitVec 8))
+(declare-fun v967 () (_ BitVec 8))
+(declare-fun v968 () (_ BitVec 8))
+(declare-fun v969 () (_ BitVec 8))
+(declare-fun v970 () (_ BitVec 8))
+(declare-fun v971 () (_ BitVec 8))
+(declare-fun v972 () (_ BitVec 8))
+(declare-fun v973 () (_ BitVec 8))
+(declare-fun v974 () (_ BitVec 8))
+(declare-fun v975 () (_ BitVec 8))
+(declare-fun v976 () (_ BitVec 8))
+(declare-fun v977 () (_ BitVec 8))
+(declare-fun v978 () (_ BitVec 8))
+(declare-fun v979 () (_ BitVec 8))
+(declare-fun v980 () (_ BitVec 8))
+(declare-fun v981 () (_ BitVec 8))
+(declare-fun v982 () (_ BitVec 8))
+(declare-fun v983 () (_ BitVec 8))
+(declare-fun v984 () (_ BitVec 8))
+(declare-fun v985 () (_ BitVec 8))
+(declare-fun v986 () (_ BitVec 8))
+(declare-fun v987 () (_ BitVec 8))
+(declare-fun v988 () (_ BitVec 8))
+(declare-fun v989 () (_ BitVec 8))
+(declare-fun v990 () (_ BitVec 8))
+(declare-fun v991 () (_ BitVec 8))
+(declare-fun v992 () (_ BitVec 8))
+(declare-fun v993 () (_ BitVec 8))
+(declare-fun v994 () (_ BitVec 8))
+(declare-fun v995 () (_ BitVec 8))
+(declare-fun v996 () (_ BitVec 8))
+(declare-fun v997 () (_ BitVec 8))
+(declare-fun v998 () (_ BitVec 8))
+(declare-fun v999 () (_ BitVec 8))
+(assert (= v0 #x01))
+(check-sat)
+(get-value ((bvadd v0 v1 v2 v3 v4 v5 v6 v7 v8 v9 v10 v11 v12 v13 v14 v15 v16 v17 v18 v19 v20 v21 v22 v23 v24 v25 v26 v27 v28 v29 v30 v31 v32 v33 v34 v35 v36 v37 v38 v39 v40 v41 v42 v43 v44 v45 v46 v47 v48 v49 v50 v51 v52 v53 v54 v55 v56 v57 v58 v59) v1 v2 v3 v4 v5 v6 v7 v8 v9 v10 v11 v12 v13 v14 v15 v16 v17 v18 v19 v20 v21 v22 v23 v24 v25 v26 v27 v28 v29 v30 v31 v32 v33 v34 v35 v36 v37 v38 v39 v40 v41 v42 v43 v44 v45 v46 v47 v48 v49 v50 v51 v52 v53 v54 v55 v56 v57 v58 v59 v60 v61 v62 v63 v64 v65 v66 v67 v68 v69 v70 v71 v72 v73 v74 v75 v76 v77 v78 v79 v80 v81 v82 v83 v84 v85 v86 v87 v88 v89 v90 v91 v92 v93 v94 v95 v96 v97 v98 v99 v100 v101 v102 v103 v104 v105 v106 v107 v108 v109 v110 v111 v112 v113 v114 v115 v116 v117 v118 v119 v120 v121 v122 v123 v124 v125 v126 v127 v128 v129 v130 v131 v132 v133 v134 v135 v136 v137 v138 v139 v140 v141 v142 v143 v144 v145 v146 v147 v148 v149 v150 v151 v152 v153 v154 v155 v156 v157 v158 v159 v160 v161 v162 v163 v164 v165 v166 v167 v168 v169 v170 v171 v172 v173 v174 v175 v176 v177 v178 v179 v180 v181 v182 v183 v184 v185 v186 v187 v188 v189 v190 v191 v192 v193 v194 v195 v196 v197 v198 v199 v200 v201 v202 v203 v204 v205 v206 v207 v208 v209 v210 v211 v212 v213 v214 v215 v216 v217 v218 v219 v220 v221 v222 v223 v224 v225 v226 v227 v228 v229 v230 v231 v232 v233 v234 v235 v236 v237 v238 v239 v240 v241 v242 v243 v244 v245 v246 v247 v248 v249 v250 v251 v252 v253 v254 v255 v256 v257 v258 v259 v260 v261 v262 v263 v264 v265 v266 v267 v268 v269 v270 v271 v272 v273 v274 v275 v276 v277 v278 v279 v280 v281 v282 v283 v284 v285 v286 v287 v288 v289 v290 v291 v292 v293 v294 v295 v296 v297 v298 v299 v300 v301 v302 v303 v304 v305 v306 v307 v308 v309 v310 v311 v312 v313 v314 v315 v316 v317 v318 v319 v320 v321 v322 v323 v324 v325 v326 v327 v328 v329 v330 v331 v332 v333 v334 v335 v336 v337 v338 v339 v340 v341 v342 v343 v344 v345 v346 v347 v348 v349 v350 v351 v352 v353 v354 v355 v356 v357 v358 v359 v360 v361 v362 v363 v364 v365 v366 v367 v368 v369 v370 v371 v372 v373 v374 v375 v376 v377 v378 v379 v380 v381 v382 v383 v384 v385 v386 v387 v388 v389 v390 v391 v392 v393 v394 v395 v396 v397 v398 v399 v400 v401 v402 v403 v404 v405 v406 v407 v408 v409 v410 v411 v412 v413 v414 v415 v416 v417 v418 v419 v420 v421 v422 v423 v424 v425 v426 v427 v428 v429 v430 v431 v432 v433 v434 v435 v436 v437 v438 v439 v440 v441 v442 v443 v444 v445 v446 v447 v448 v449 v450 v451 v452 v453 v454 v455 v456 v457 v458 v459 v460 v461 v462 v463 v464 v465 v466 v467 v468 v469 v470 v471 v472 v473 v474 v475 v476 v477 v478 v479 v480 v481 v482 v483 v484 v485 v486 v487 v488 v489 v490 v491 v492 v493 v494 v495 v496 v497 v498 v499 v500 v501 v502 v503 v504 v505 v506 v507 v508 v509 v510 v511 v512 v513 v514 v515 v516 v517 v518 v519 v520 v521 v522 v523 v524 v525 v526 v527 v528 v529 v530 v531 v532 v533 v534 v535 v536 v537 v538 v539 v540 v541 v542 v543 v544 v545 v546 v547 v548 v549 v550 v551 v552 v553 v554 v555 v556 v557 v558 v559 v560 v561 v562 v563 v564 v565 v566 v567 v568 v569 v570 v571 v572 v573 v574 v575 v576 v577 v578 v579 v580 v581 v582 v583 v584 v585 v586 v587 v588 v589 v590 v591 v592 v593 v594 v595 v596 v597 v598 v599 v600 v601 v602 v603 v604 v605 v606 v607 v608 v609 v610 v611 v612 v613 v614 v615 v616 v617 v618 v619 v620 v621 v622 v623 v624 v625 v626 v627 v628 v629 v630 v631 v632 v633 v634 v635 v636 v637 v638 v639 v640 v641 v642 v643 v644 v645 v646 v647 v648 v649 v650 v651 v652 v653 v654 v655 v656 v657 v658 v659 v660 v661 v662 v663 v664 v665 v666 v667 v668 v669 v670 v671 v672 v673 v674 v675 v676 v677 v678 v679 v680 v681 v682 v683 v684 v685 v686 v687 v688 v689 v690 v691 v692 v693 v694 v695 v696 v697 v698 v699 v700 v701 v702 v703 v704 v705 v706 v707 v708 v709 v710 v711 v712 v713 v714 v715 v716 v717 v718 v719 v720 v721 v722 v723 v724 v725 v726 v727 v728 v729 v730 v731 v732 v733 v734 v735 v736 v737 v738 v739 v740 v741 v742 v743 v744 v745 v746 v747 v748 v749 v750 v751 v752 v753 v754 v755 v756 v757 v758 v759 v760 v761 v762 v763 v764 v765 v766 v767 v768 v769 v770 v771 v772 v773 v774 v775 v776 v777 v778 v779 v780 v781 v782 v783 v784 v785 v786 v787 v788 v789 v790 v791 v792 v793 v794 v795 v796 v797 v798 v799 v800 v801 v802 v803 v804 v805 v806 v807 v808 v809 v810 v811 v812 v813 v814 v815 v816 v817 v818 v819 v820 v821 v822 v823 v824 v825 v826 v827 v828 v829 v830 v831 v832 v833 v834 v835 v836 v837 v838 v839 v840 v841 v842 v843 v844 v845 v846 v847 v848 v849 v850 v851 v852 v853 v854 v855 v856 v857 v858 v859 v860 v861 v862 v863 v864 v865 v866 v867 v868 v869 v870 v871 v872 v873 v874 v875 v876 v877 v878 v879 v880 v881 v882 v883 v884 v885 v886 v887 v888 v889 v890 v891 v892 v893 v894 v895 v896 v897 v898 v899 v900 v901 v902 v903 v904 v905 v906 v907 v908 v909 v910 v911 v912 v913 v914 v915 v916 v917 v918 v919 v920 v921 v922 v923 v924 v925 v926 v927 v928 v929 v930 v931 v932 v933 v934 v935 v936 v937 v938 v939 v940 v941 v942 v943 v944 v945 v946 v947 v948 v949 v950 v951 v952 v953 v954 v955 v956 v957 v958 v959 v960 v961 v962 v963 v964 v965 v966 v967 v968 v969 v970 v971 v972 v973 v974 v975 v976 v977 v978 v979 v980 v981 v982 v983 v984 v985 v986 v987 v988 v989 v990 v991 v992 v993 v994 v995 v996 v997 v998 v999))
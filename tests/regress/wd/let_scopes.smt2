@@ -0,0 +1,16 @@
+(set-option :produce-models true)
+(set-logic QF_LIA)
+(declare-fun a () Int)
+(declare-fun b () Int)
+(assert (let ((x (+ a 1)) (y b)) (let ((x (* 2 x))) (and (= x 10) (= y (+ x 1))))))
+(assert (let ((z a)) (> z 0)))
+(check-sat)
+(get-value (a b))
+(declare-fun x () Int)
+(assert (= x (let ((x 3)) (+ x a))))
+(check-sat)
+(get-value (x (let ((x (+ x 1))) (* x x))))
+(declare-fun z () Int)
+(assert (= z (let ((z 1) (w z)) (+ w z))))
+(check-sat)
+(assert (let ((c a)) (! (> c 0) :named c)))
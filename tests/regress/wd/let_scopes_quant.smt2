@@ -0,0 +1,9 @@
+(set-option :produce-models true)
+(set-logic BV)
+(declare-fun y () (_ BitVec 4))
+(declare-fun u () (_ BitVec 4))
+(define-fun f ((u (_ BitVec 4))) (_ BitVec 4) (let ((v (bvadd u #x1))) (bvmul v #x2)))
+(assert (let ((x #x1)) (exists ((x (_ BitVec 4))) (and (= x #x2) (= y x)))))
+(assert (exists ((x (_ BitVec 4))) (let ((x #x3)) (= u (bvadd x (f x))))))
+(check-sat)
+(get-value (y u))
@@ -0,0 +1,39 @@
+(set-option :produce-unsat-cores true)
+(set-option :yices-minimize-core true)
+(set-logic QF_UF)
+(declare-fun p0 () Bool)
+(declare-fun p1 () Bool)
+(declare-fun p2 () Bool)
+(declare-fun p3 () Bool)
+(declare-fun p4 () Bool)
+(declare-fun p5 () Bool)
+(assert (! (or p0 (not p2) (not p5)) :named c0))
+(assert (! (or p2 (not p1) (not p4)) :named c1))
+(assert (! (or (not p3) (not p5) (not p4)) :named c2))
+(assert (! (or (not p4) p4 (not p0)) :named c3))
+(assert (! (or p2 (not p2) (not p3)) :named c4))
+(assert (! (or p4 p1 p0) :named c5))
+(assert (! (or p1 p4 (not p4)) :named c6))
+(assert (! (or (not p1) (not p3) (not p5)) :named c7))
+(assert (! (or (not p2) p2 p3) :named c8))
+(assert (! (or (not p3) (not p3) p1) :named c9))
+(assert (! (or (not p3) (not p2) (not p3)) :named c10))
+(assert (! (or p3 (not p5) p5) :named c11))
+(assert (! (or p5 (not p2) (not p1)) :named c12))
+(assert (! (or p4 p3 (not p5)) :named c13))
+(assert (! (or (not p4) (not p5) p3) :named c14))
+(assert (! (or p1 (not p2) (not p4)) :named c15))
+(assert (! (or (not p2) (not p1) p0) :named c16))
+(assert (! (or p5 p4 (not p0)) :named c17))
+(assert (! (or (not p1) (not p1) p0) :named c18))
+(assert (! (or (not p5) p0 p1) :named c19))
+(assert (! (or p0 p0 (not p5)) :named c20))
+(assert (! (or p2 (not p1) (not p4)) :named c21))
+(assert (! (or (not p3) p1 p0) :named c22))
+(assert (! (or (not p4) p5 p2) :named c23))
+(assert (! (or p2 (not p4) (not p2)) :named c24))
+(assert (! (or (not p4) (not p3) (not p0)) :named c25))
+(assert (! (or (not p2) p0 (not p1)) :named c26))
+(assert (! (or p3 p2 p2) :named c27))
+(check-sat)
+(get-unsat-core)
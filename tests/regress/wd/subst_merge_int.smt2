@@ -0,0 +1,7 @@
+(set-logic QF_LIRA)
+(declare-fun b () Real)
+(declare-fun i () Int)
+(declare-fun r () Real)
+(assert (<= r 0.0))
+(assert (and (= b r) (= b (to_real i)) (= (+ 0.5 r) 0)))
+(check-sat)
@@ -0,0 +1,162 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * TEST THE TELEMETRY CALLBACK
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "yices.h"
+
+/*
+ * Pigeon-hole problem: n+1 pigeons, n holes
+ * - p[i * n + j] means pigeon i is in hole j
+ */
+static void assert_pigeon_hole(context_t *ctx, uint32_t n) {
+  term_t p[(n+1) * n];
+  term_t a[n];
+  uint32_t i, j, k;
+
+  for (i=0; i<(n+1)*n; i++) {
+    p[i] = yices_new_uninterpreted_term(yices_bool_type());
+  }
+
+  // every pigeon is in a hole
+  for (i=0; i<=n; i++) {
+    for (j=0; j<n; j++) {
+      a[j] = p[i * n + j];
+    }
+    yices_assert_formula(ctx, yices_or(n, a));
+  }
+
+  // no two pigeons in the same hole
+  for (j=0; j<n; j++) {
+    for (i=0; i<=n; i++) {
+      for (k=i+1; k<=n; k++) {
+        yices_assert_formula(ctx, yices_or2(yices_not(p[i * n + j]), yices_not(p[k * n + j])));
+      }
+    }
+  }
+}
+
+
+/*
+ * Samples: we keep the first and last
+ */
+typedef struct samples_s {
+  uint32_t count;
+  char first[2000];
+  char last[2000];
+} samples_t;
+
+static void collect_sample(void *aux, const char *json) {
+  samples_t *s;
+
+  s = aux;
+  if (s->count == 0) {
+    strncpy(s->first, json, sizeof(s->first) - 1);
+  }
+  strncpy(s->last, json, sizeof(s->last) - 1);
+  s->count ++;
+}
+
+
+int main(void) {
+  samples_t samples;
+  context_t *ctx;
+  smt_status_t status;
+  int32_t code;
+
+  yices_init();
+
+  memset(&samples, 0, sizeof(samples));
+  ctx = yices_new_context(NULL);
+
+  code = yices_set_context_telemetry(ctx, collect_sample, &samples, -1.0);
+  if (code >= 0 || yices_error_code() != CTX_INVALID_PARAMETER_VALUE) {
+    fprintf(stderr, "negative period should be rejected\n");
+    return 1;
+  }
+
+  code = yices_set_context_telemetry(ctx, collect_sample, &samples, 0.0);
+  if (code < 0) {
+    yices_print_error(stderr);
+    return 1;
+  }
+
+  assert_pigeon_hole(ctx, 7);
+  status = yices_check_context(ctx, NULL);
+  printf("status = %d, %"PRIu32" samples\n", (int) status, samples.count);
+  printf("first: %s\n", samples.first);
+  printf("last: %s\n", samples.last);
+
+  if (status != STATUS_UNSAT || samples.count < 3 ||
+      strncmp(samples.first, "{\"event\":\"start\"", 16) != 0 ||
+      strncmp(samples.last, "{\"event\":\"done\"", 15) != 0 ||
+      strstr(samples.last, "\"status\":\"unsat\"") == NULL) {
+    fprintf(stderr, "unexpected telemetry samples\n");
+    return 1;
+  }
+
+  // telemetry is kept after a reset
+  samples.count = 0;
+  yices_reset_context(ctx);
+  assert_pigeon_hole(ctx, 4);
+  status = yices_check_context(ctx, NULL);
+  if (status != STATUS_UNSAT || samples.count < 2) {
+    fprintf(stderr, "telemetry should still be enabled after reset\n");
+    return 1;
+  }
+
+  // after disabling telemetry: no more samples
+  code = yices_set_context_telemetry(ctx, NULL, NULL, 0.0);
+  assert(code == 0);
+  samples.count = 0;
+  yices_reset_context(ctx);
+  assert_pigeon_hole(ctx, 4);
+  status = yices_check_context(ctx, NULL);
+  if (status != STATUS_UNSAT || samples.count != 0) {
+    fprintf(stderr, "telemetry should be disabled\n");
+    return 1;
+  }
+
+  yices_free_context(ctx);
+
+  // free a context with telemetry still enabled
+  ctx = yices_new_context(NULL);
+  code = yices_set_context_telemetry(ctx, collect_sample, &samples, 0.0);
+  assert(code == 0);
+  samples.count = 0;
+  assert_pigeon_hole(ctx, 4);
+  status = yices_check_context(ctx, NULL);
+  if (status != STATUS_UNSAT || samples.count < 2) {
+    fprintf(stderr, "unexpected telemetry samples\n");
+    return 1;
+  }
+  yices_free_context(ctx);
+
+  yices_exit();
+
+  printf("All tests succeeded\n");
+  return 0;
+}
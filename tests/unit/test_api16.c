@@ -0,0 +1,162 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * TEST UNSAT-CORE MINIMIZATION
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <inttypes.h>
+
+#include "yices.h"
+
+#ifdef MINGW
+static inline long int random(void) {
+  return rand();
+}
+#endif
+
+
+#define NVARS 20
+#define NCLAUSES 100
+
+/*
+ * Random 3-clause over x[0 ... NVARS-1]
+ */
+static term_t random_clause(const term_t *x) {
+  term_t l[3];
+  uint32_t i;
+
+  for (i=0; i<3; i++) {
+    l[i] = x[random() % NVARS];
+    if (random() & 1) l[i] = yices_not(l[i]);
+  }
+  return yices_or(3, l);
+}
+
+
+/*
+ * Check assumptions a[0 ... n-1], skipping a[skip] (skip = n means none)
+ */
+static smt_status_t check_without(context_t *ctx, const term_t *a, uint32_t n, uint32_t skip) {
+  term_t b[n];
+  uint32_t i, j;
+
+  j = 0;
+  for (i=0; i<n; i++) {
+    if (i != skip) b[j++] = a[i];
+  }
+  return yices_check_context_with_assumptions(ctx, NULL, j, b);
+}
+
+
+/*
+ * Return false if the core is not a minimal unsat subset
+ */
+static bool check_minimal(context_t *ctx, term_vector_t *core) {
+  uint32_t i, n;
+
+  n = core->size;
+  if (check_without(ctx, core->data, n, n) != STATUS_UNSAT) {
+    fprintf(stderr, "the core is not unsat\n");
+    return false;
+  }
+  for (i=0; i<n; i++) {
+    if (check_without(ctx, core->data, n, i) != STATUS_SAT) {
+      fprintf(stderr, "the core is not minimal\n");
+      return false;
+    }
+  }
+  return true;
+}
+
+
+int main(void) {
+  term_t x[NVARS];
+  term_t a[NCLAUSES];
+  term_vector_t core;
+  param_t *params;
+  context_t *ctx;
+  smt_status_t status;
+  uint32_t i, k, tests, initial, minimized;
+
+  yices_init();
+
+  params = yices_new_param_record();
+  if (yices_set_param(params, "core-min-timeout", "-1") >= 0 ||
+      yices_set_param(params, "minimize-core", "true") < 0 ||
+      yices_set_param(params, "core-min-timeout", "0") < 0) {
+    fprintf(stderr, "bad parameter handling\n");
+    return 1;
+  }
+
+  yices_init_term_vector(&core);
+  tests = 0;
+  initial = 0;
+  minimized = 0;
+
+  for (k=0; k<50; k++) {
+    ctx = yices_new_context(NULL);
+    for (i=0; i<NVARS; i++) {
+      x[i] = yices_new_uninterpreted_term(yices_bool_type());
+    }
+    for (i=0; i<NCLAUSES; i++) {
+      a[i] = random_clause(x);
+    }
+
+    status = yices_check_context_with_assumptions(ctx, NULL, NCLAUSES, a);
+    if (status == STATUS_UNSAT) {
+      tests ++;
+      yices_get_unsat_core(ctx, &core);
+      initial += core.size;
+
+      status = yices_check_context_with_assumptions(ctx, params, NCLAUSES, a);
+      if (status != STATUS_UNSAT) {
+        fprintf(stderr, "minimization changed the status\n");
+        return 1;
+      }
+      yices_get_unsat_core(ctx, &core);
+      minimized += core.size;
+      if (!check_minimal(ctx, &core)) {
+        return 1;
+      }
+
+      // with a tiny budget: the core may not be minimal but it must be unsat
+      yices_set_param(params, "core-min-timeout", "0.000001");
+      status = yices_check_context_with_assumptions(ctx, params, NCLAUSES, a);
+      yices_set_param(params, "core-min-timeout", "0");
+      yices_get_unsat_core(ctx, &core);
+      if (status != STATUS_UNSAT || check_without(ctx, core.data, core.size, core.size) != STATUS_UNSAT) {
+        fprintf(stderr, "bad core after timeout\n");
+        return 1;
+      }
+    }
+    yices_free_context(ctx);
+  }
+
+  printf("%"PRIu32" unsat tests: %"PRIu32" assumptions in the cores, %"PRIu32" after minimization\n",
+         tests, initial, minimized);
+
+  yices_delete_term_vector(&core);
+  yices_free_param_record(params);
+  yices_exit();
+
+  return 0;
+}
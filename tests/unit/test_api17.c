@@ -0,0 +1,262 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * TEST ENUMERATION OF MUSES AND MCSES
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "yices.h"
+
+#ifdef MINGW
+static inline long int random(void) {
+  return rand();
+}
+#endif
+
+
+#define NVARS 6
+#define NASSUMPTIONS 10
+#define NSUBSETS (1 << NASSUMPTIONS)
+
+/*
+ * Random clause of size k over x[0 ... NVARS-1]
+ */
+static term_t random_clause(const term_t *x, uint32_t k) {
+  term_t l[3];
+  uint32_t i;
+
+  for (i=0; i<k; i++) {
+    l[i] = x[random() % NVARS];
+    if (random() & 1) l[i] = yices_not(l[i]);
+  }
+  return yices_or(k, l);
+}
+
+
+/*
+ * Enumeration result:
+ * - a = assumptions
+ * - found[s] = bit 0 set if s was reported as an MUS, bit 1 set if s
+ *   was reported as an MCS (a set can be both)
+ * - stop = number of sets after which the callback stops the enumeration
+ * - count = number of sets reported
+ * - error = true if something is wrong
+ */
+typedef struct enum_result_s {
+  const term_t *a;
+  uint8_t found[NSUBSETS];
+  uint32_t stop;
+  uint32_t count;
+  bool error;
+} enum_result_t;
+
+static int32_t collect(void *aux, int32_t is_mus, uint32_t n, const term_t s[]) {
+  enum_result_t *r;
+  uint32_t i, j, mask;
+  uint8_t bit;
+
+  r = aux;
+  mask = 0;
+  j = 0;
+  for (i=0; i<n; i++) {
+    // s must be in the same order as a
+    while (j < NASSUMPTIONS && r->a[j] != s[i]) j ++;
+    if (j == NASSUMPTIONS) {
+      fprintf(stderr, "bad element in reported set\n");
+      r->error = true;
+      return 1;
+    }
+    mask |= 1 << j;
+  }
+  bit = is_mus ? 1 : 2;
+  if (r->found[mask] & bit) {
+    fprintf(stderr, "set reported twice\n");
+    r->error = true;
+  }
+  r->found[mask] |= bit;
+  r->count ++;
+
+  return r->count == r->stop;
+}
+
+
+/*
+ * Check the subset of a defined by mask
+ */
+static smt_status_t check_subset(context_t *ctx, const term_t *a, uint32_t mask) {
+  term_t b[NASSUMPTIONS];
+  uint32_t i, j;
+
+  j = 0;
+  for (i=0; i<NASSUMPTIONS; i++) {
+    if (mask & (1 << i)) b[j++] = a[i];
+  }
+  return yices_check_context_with_assumptions(ctx, NULL, j, b);
+}
+
+
+/*
+ * Compute the MUSes and MCSes by brute force: store them in expected
+ * (with the same encoding as found). Return the number of MUSes.
+ */
+static uint32_t brute_force(context_t *ctx, const term_t *a, uint8_t *expected) {
+  static bool sat[NSUBSETS];
+  uint32_t s, i, nmus;
+  bool minimal, maximal;
+
+  for (s=0; s<NSUBSETS; s++) {
+    sat[s] = check_subset(ctx, a, s) == STATUS_SAT;
+  }
+
+  nmus = 0;
+  memset(expected, 0, NSUBSETS);
+  for (s=0; s<NSUBSETS; s++) {
+    minimal = true;
+    maximal = true;
+    for (i=0; i<NASSUMPTIONS; i++) {
+      if (s & (1 << i)) {
+        minimal &= sat[s & ~(1 << i)];
+      } else {
+        maximal &= !sat[s | (1 << i)];
+      }
+    }
+    if (!sat[s] && minimal) {
+      expected[s] |= 1;
+      nmus ++;
+    } else if (sat[s] && maximal && s != NSUBSETS - 1) {
+      // s is an MSS: its complement is an MCS
+      expected[(NSUBSETS - 1) & ~s] |= 2;
+    }
+  }
+
+  return nmus;
+}
+
+
+int main(void) {
+  static uint8_t expected[NSUBSETS];
+  enum_result_t r;
+  term_t x[NVARS];
+  term_t a[NASSUMPTIONS];
+  term_t dup[2];
+  context_t *ctx;
+  ctx_config_t *config;
+  smt_status_t status;
+  uint32_t i, j, k, nmus, tests, total;
+
+  yices_init();
+
+  tests = 0;
+  total = 0;
+  for (k=0; k<40; k++) {
+    ctx = yices_new_context(NULL);
+    for (i=0; i<NVARS; i++) {
+      x[i] = yices_new_uninterpreted_term(yices_bool_type());
+    }
+    yices_assert_formula(ctx, random_clause(x, 3));
+    // the assumptions must be distinct
+    i = 0;
+    while (i < NASSUMPTIONS) {
+      a[i] = random_clause(x, 2);
+      for (j=0; j<i; j++) {
+        if (a[j] == a[i]) break;
+      }
+      if (j == i) i ++;
+    }
+
+    nmus = brute_force(ctx, a, expected);
+
+    memset(&r, 0, sizeof(r));
+    r.a = a;
+    status = yices_enumerate_mus_mcs(ctx, NULL, NASSUMPTIONS, a, collect, &r);
+    if (r.error || status != (nmus > 0 ? STATUS_UNSAT : STATUS_SAT) ||
+        memcmp(r.found, expected, NSUBSETS) != 0) {
+      fprintf(stderr, "enumeration failed (test %"PRIu32")\n", k);
+      return 1;
+    }
+    if (yices_context_status(ctx) != STATUS_IDLE) {
+      fprintf(stderr, "bad context status after enumeration\n");
+      return 1;
+    }
+    if (nmus > 0) tests ++;
+    total += r.count;
+
+    // stop after the first set
+    if (r.count > 1) {
+      memset(&r, 0, sizeof(r));
+      r.a = a;
+      r.stop = 1;
+      status = yices_enumerate_mus_mcs(ctx, NULL, NASSUMPTIONS, a, collect, &r);
+      if (status != STATUS_INTERRUPTED || r.count != 1) {
+        fprintf(stderr, "the callback did not stop the enumeration\n");
+        return 1;
+      }
+    }
+
+    yices_free_context(ctx);
+  }
+
+  // duplicate assumptions: if (not p) is asserted, {p, p} has one MUS {p}
+  // and one MCS {p}
+  ctx = yices_new_context(NULL);
+  dup[0] = yices_new_uninterpreted_term(yices_bool_type());
+  dup[1] = dup[0];
+  yices_assert_formula(ctx, yices_not(dup[0]));
+  memset(&r, 0, sizeof(r));
+  r.a = dup;
+  status = yices_enumerate_mus_mcs(ctx, NULL, 2, dup, collect, &r);
+  if (status != STATUS_UNSAT || r.count != 2 || r.found[1] != 3) {
+    fprintf(stderr, "bad result with duplicate assumptions\n");
+    return 1;
+  }
+
+  // unsat context: the only MUS is empty
+  yices_assert_formula(ctx, dup[0]);
+  memset(&r, 0, sizeof(r));
+  r.a = dup;
+  status = yices_enumerate_mus_mcs(ctx, NULL, 2, dup, collect, &r);
+  if (status != STATUS_UNSAT || r.count != 1 || r.found[0] != 1) {
+    fprintf(stderr, "bad result with an unsat context\n");
+    return 1;
+  }
+  yices_free_context(ctx);
+
+  // one-shot contexts are not supported
+  config = yices_new_config();
+  yices_set_config(config, "mode", "one-shot");
+  ctx = yices_new_context(config);
+  status = yices_enumerate_mus_mcs(ctx, NULL, 0, NULL, collect, &r);
+  if (status != STATUS_ERROR || yices_error_code() != CTX_OPERATION_NOT_SUPPORTED) {
+    fprintf(stderr, "one-shot context not rejected\n");
+    return 1;
+  }
+  yices_free_context(ctx);
+  yices_free_config(config);
+
+  printf("%"PRIu32" unsat tests: %"PRIu32" MUSes and MCSes\n", tests, total);
+
+  yices_exit();
+
+  return 0;
+}
@@ -0,0 +1,319 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * TEST MODEL ENUMERATION
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "yices.h"
+
+#ifdef MINGW
+static inline long int random(void) {
+  return rand();
+}
+#endif
+
+
+#define NVARS 12
+#define NPROJ 8
+#define NCLAUSES 30
+#define NASSIGNMENTS (1 << NPROJ)
+
+/*
+ * Random clause of size 3 over x[0 ... NVARS-1]
+ */
+static term_t random_clause(const term_t *x) {
+  term_t l[3];
+  uint32_t i;
+
+  for (i=0; i<3; i++) {
+    l[i] = x[random() % NVARS];
+    if (random() & 1) l[i] = yices_not(l[i]);
+  }
+  return yices_or(3, l);
+}
+
+
+/*
+ * Enumeration result:
+ * - proj = projection terms (Boolean) and nproj = their number
+ * - f = the asserted formulas (conjunction)
+ * - found[s] = true if assignment s was reported
+ * - stop = number of models after which the callback stops the enumeration
+ * - count = number of models reported
+ * - error = true if something is wrong
+ */
+typedef struct enum_result_s {
+  const term_t *proj;
+  uint32_t nproj;
+  term_t f;
+  bool found[NASSIGNMENTS];
+  uint32_t stop;
+  uint32_t count;
+  bool error;
+} enum_result_t;
+
+static int32_t collect(void *aux, model_t *mdl) {
+  enum_result_t *r;
+  uint32_t i, mask;
+  int32_t v;
+
+  r = aux;
+  if (yices_formula_true_in_model(mdl, r->f) != 1) {
+    fprintf(stderr, "reported model doesn't satisfy the assertions\n");
+    r->error = true;
+    return 1;
+  }
+
+  mask = 0;
+  for (i=0; i<r->nproj; i++) {
+    if (yices_get_bool_value(mdl, r->proj[i], &v) < 0) {
+      fprintf(stderr, "no value for projection term\n");
+      r->error = true;
+      return 1;
+    }
+    if (v) mask |= 1 << i;
+  }
+  if (r->found[mask]) {
+    fprintf(stderr, "model reported twice\n");
+    r->error = true;
+  }
+  r->found[mask] = true;
+  r->count ++;
+
+  return r->count == r->stop;
+}
+
+
+/*
+ * Compute the satisfiable assignments to x[0 ... NPROJ-1] by brute force
+ */
+static uint32_t brute_force(context_t *ctx, const term_t *x, bool *expected) {
+  term_t a[NPROJ];
+  uint32_t s, i, n;
+
+  n = 0;
+  for (s=0; s<NASSIGNMENTS; s++) {
+    for (i=0; i<NPROJ; i++) {
+      a[i] = (s & (1 << i)) ? x[i] : yices_not(x[i]);
+    }
+    expected[s] = yices_check_context_with_assumptions(ctx, NULL, NPROJ, a) == STATUS_SAT;
+    n += expected[s];
+  }
+
+  return n;
+}
+
+
+static void fail(const char *msg) {
+  fprintf(stderr, "%s\n", msg);
+  exit(1);
+}
+
+
+/*
+ * Random CNF problems with a projection on the first variables
+ */
+static uint32_t test_boolean(void) {
+  static bool expected[NASSIGNMENTS];
+  enum_result_t r;
+  term_t x[NVARS];
+  term_t f[NCLAUSES];
+  term_t all;
+  context_t *ctx;
+  smt_status_t status;
+  uint64_t count;
+  uint32_t i, k, n, total;
+
+  total = 0;
+  for (k=0; k<30; k++) {
+    ctx = yices_new_context(NULL);
+    for (i=0; i<NVARS; i++) {
+      x[i] = yices_new_uninterpreted_term(yices_bool_type());
+    }
+    for (i=0; i<NCLAUSES; i++) {
+      f[i] = random_clause(x);
+    }
+    yices_assert_formulas(ctx, NCLAUSES, f);
+    // yices_and may modify f so we build the conjunction once
+    all = yices_and(NCLAUSES, f);
+
+    n = brute_force(ctx, x, expected);
+
+    memset(&r, 0, sizeof(r));
+    r.proj = x;
+    r.nproj = NPROJ;
+    r.f = all;
+    status = yices_enumerate_models(ctx, NULL, NPROJ, x, collect, &r, &count);
+    if (r.error || status != (n > 0 ? STATUS_SAT : STATUS_UNSAT) || count != n ||
+	memcmp(r.found, expected, sizeof(expected)) != 0) {
+      fprintf(stderr, "enumeration failed (test %"PRIu32")\n", k);
+      exit(1);
+    }
+    if (yices_context_status(ctx) != (n > 0 ? STATUS_IDLE : STATUS_UNSAT)) {
+      fail("bad context status after enumeration");
+    }
+
+    // count only
+    status = yices_enumerate_models(ctx, NULL, NPROJ, x, NULL, NULL, &count);
+    if (count != n) {
+      fail("wrong count");
+    }
+
+    // stop after the first model: the blocking clauses must be removed
+    if (n > 1) {
+      memset(&r, 0, sizeof(r));
+      r.proj = x;
+      r.nproj = NPROJ;
+      r.f = all;
+      r.stop = 1;
+      status = yices_enumerate_models(ctx, NULL, NPROJ, x, collect, &r, &count);
+      if (status != STATUS_INTERRUPTED || r.count != 1 || count != 1) {
+	fail("the callback did not stop the enumeration");
+      }
+      if (yices_context_status(ctx) != STATUS_IDLE ||
+	  yices_enumerate_models(ctx, NULL, NPROJ, x, NULL, NULL, &count) != STATUS_SAT || count != n) {
+	fail("the context was modified by the enumeration");
+      }
+    }
+
+    // empty projection: one model
+    status = yices_enumerate_models(ctx, NULL, 0, NULL, NULL, NULL, &count);
+    if (count != (n > 0)) {
+      fail("bad count with an empty projection");
+    }
+
+    total += n;
+    yices_free_context(ctx);
+  }
+
+  return total;
+}
+
+
+/*
+ * Bitvector projection: x + y = z with x < y (unsigned) on 4 bits
+ * - z is eliminated by substitution
+ * - the projection on x has 15 models (x can't be 0b1111)
+ * - the projection on z has 16 models
+ * - the projection on (x, y) has 120 models
+ */
+static void test_bitvectors(void) {
+  term_t x, y, z, t[2];
+  context_t *ctx;
+  uint64_t count;
+
+  x = yices_new_uninterpreted_term(yices_bv_type(4));
+  y = yices_new_uninterpreted_term(yices_bv_type(4));
+  z = yices_new_uninterpreted_term(yices_bv_type(4));
+
+  ctx = yices_new_context(NULL);
+  yices_assert_formula(ctx, yices_eq(z, yices_bvadd(x, y)));
+  yices_assert_formula(ctx, yices_bvlt_atom(x, y));
+
+  if (yices_enumerate_models(ctx, NULL, 1, &x, NULL, NULL, &count) != STATUS_SAT || count != 15) {
+    fail("bad count for x");
+  }
+  if (yices_enumerate_models(ctx, NULL, 1, &z, NULL, NULL, &count) != STATUS_SAT || count != 16) {
+    fail("bad count for z");
+  }
+  t[0] = x;
+  t[1] = y;
+  if (yices_enumerate_models(ctx, NULL, 2, t, NULL, NULL, &count) != STATUS_SAT || count != 120) {
+    fail("bad count for (x, y)");
+  }
+
+  // non-Boolean, non-bitvector term
+  t[0] = yices_new_uninterpreted_term(yices_int_type());
+  if (yices_enumerate_models(ctx, NULL, 1, t, NULL, NULL, &count) != STATUS_ERROR ||
+      yices_error_code() != BITVECTOR_REQUIRED) {
+    fail("integer projection term not rejected");
+  }
+
+  yices_free_context(ctx);
+}
+
+
+/*
+ * Arithmetic atoms: p[i] = (x > i) for i=0 ... 4 has 6 models
+ */
+static void test_arithmetic(void) {
+  term_t x, p[5];
+  context_t *ctx;
+  uint64_t count;
+  int32_t i;
+
+  x = yices_new_uninterpreted_term(yices_real_type());
+  for (i=0; i<5; i++) {
+    p[i] = yices_arith_gt_atom(x, yices_int32(i));
+  }
+  ctx = yices_new_context(NULL);
+  yices_assert_formula(ctx, yices_arith_lt_atom(x, yices_int32(10)));
+  if (yices_enumerate_models(ctx, NULL, 5, p, NULL, NULL, &count) != STATUS_SAT || count != 6) {
+    fail("bad count for arithmetic atoms");
+  }
+  yices_free_context(ctx);
+}
+
+
+int main(void) {
+  context_t *ctx;
+  ctx_config_t *config;
+  term_t p;
+  uint64_t count;
+  uint32_t total;
+
+  yices_init();
+
+  total = test_boolean();
+  test_bitvectors();
+  test_arithmetic();
+
+  // unsat context
+  ctx = yices_new_context(NULL);
+  p = yices_new_uninterpreted_term(yices_bool_type());
+  yices_assert_formula(ctx, p);
+  yices_assert_formula(ctx, yices_not(p));
+  if (yices_enumerate_models(ctx, NULL, 1, &p, NULL, NULL, &count) != STATUS_UNSAT || count != 0) {
+    fail("bad result with an unsat context");
+  }
+  yices_free_context(ctx);
+
+  // contexts without push/pop are not supported
+  config = yices_new_config();
+  yices_set_config(config, "mode", "multi-checks");
+  ctx = yices_new_context(config);
+  if (yices_enumerate_models(ctx, NULL, 1, &p, NULL, NULL, &count) != STATUS_ERROR ||
+      yices_error_code() != CTX_OPERATION_NOT_SUPPORTED) {
+    fail("multi-checks context not rejected");
+  }
+  yices_free_context(ctx);
+  yices_free_config(config);
+
+  printf("%"PRIu32" models\n", total);
+
+  yices_exit();
+
+  return 0;
+}
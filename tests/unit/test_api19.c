@@ -0,0 +1,154 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * TEST EVALUATION PLANS
+ */
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <inttypes.h>
+
+#include "yices.h"
+
+#ifdef MINGW
+static inline long int random(void) {
+  return rand();
+}
+#endif
+
+
+#define NMODELS 500
+#define NFORMULAS 4
+
+/*
+ * Variables: x, y integers, u, v bitvectors (16 bits), p Boolean
+ */
+static term_t var[5];
+
+static void init_vars(void) {
+  type_t bv16;
+
+  bv16 = yices_bv_type(16);
+  var[0] = yices_new_uninterpreted_term(yices_int_type());
+  var[1] = yices_new_uninterpreted_term(yices_int_type());
+  var[2] = yices_new_uninterpreted_term(bv16);
+  var[3] = yices_new_uninterpreted_term(bv16);
+  var[4] = yices_new_uninterpreted_term(yices_bool_type());
+}
+
+/*
+ * Formulas: no names, so they are deleted by the garbage collector
+ * unless something keeps them.
+ */
+static void build_formulas(term_t *f) {
+  term_t x, y, u, v, p;
+
+  x = var[0];
+  y = var[1];
+  u = var[2];
+  v = var[3];
+  p = var[4];
+
+  // (x + 2y >= 3) or p
+  f[0] = yices_or2(yices_arith_geq_atom(yices_add(x, yices_mul(yices_int32(2), y)), yices_int32(3)), p);
+  // (x * y < 100)
+  f[1] = yices_arith_lt_atom(yices_mul(x, y), yices_int32(100));
+  // (bvadd u v) >= 12 (unsigned) implies p
+  f[2] = yices_implies(yices_bvge_atom(yices_bvadd(u, v), yices_bvconst_uint32(16, 12)), p);
+  // ite(p, x, y) /= 7
+  f[3] = yices_arith_neq_atom(yices_ite(p, x, y), yices_int32(7));
+}
+
+/*
+ * Random model for the variables
+ */
+static model_t *random_model(void) {
+  term_t val[5];
+
+  val[0] = yices_int32((int32_t) (random() % 21) - 10);
+  val[1] = yices_int32((int32_t) (random() % 21) - 10);
+  val[2] = yices_bvconst_uint32(16, (uint32_t) (random() % 16));
+  val[3] = yices_bvconst_uint32(16, (uint32_t) (random() % 16));
+  val[4] = (random() & 1) ? yices_true() : yices_false();
+
+  return yices_model_from_map(5, var, val);
+}
+
+
+int main(void) {
+  term_t f[NFORMULAS], g[NFORMULAS];
+  eval_plan_t *plan;
+  model_t *mdl;
+  int32_t expected, code;
+  uint32_t i, ntrue;
+
+  yices_init();
+  init_vars();
+  yices_set_term_name(var[0], "x");
+  yices_set_term_name(var[1], "y");
+  yices_set_term_name(var[2], "u");
+  yices_set_term_name(var[3], "v");
+  yices_set_term_name(var[4], "p");
+
+  // not a Boolean term
+  plan = yices_new_eval_plan(1, var);
+  if (plan != NULL || yices_error_code() != TYPE_MISMATCH) {
+    fprintf(stderr, "yices_new_eval_plan should fail on non-Boolean terms\n");
+    return 1;
+  }
+
+  // the plan must keep the formulas alive
+  build_formulas(f);
+  plan = yices_new_eval_plan(NFORMULAS, f);
+  if (plan == NULL) {
+    yices_print_error(stderr);
+    return 1;
+  }
+  yices_garbage_collect(NULL, 0, NULL, 0, true);
+  build_formulas(g);
+  for (i=0; i<NFORMULAS; i++) {
+    if (f[i] != g[i]) {
+      fprintf(stderr, "formula %"PRIu32" was deleted by the garbage collector\n", i);
+      return 1;
+    }
+  }
+
+  ntrue = 0;
+  for (i=0; i<NMODELS; i++) {
+    mdl = random_model();
+    expected = yices_formulas_true_in_model(mdl, NFORMULAS, f);
+    code = yices_eval_plan_true_in_model(mdl, plan);
+    if (code != expected) {
+      fprintf(stderr, "model %"PRIu32": plan gives %"PRId32", expected %"PRId32"\n", i, code, expected);
+      yices_print_model(stderr, mdl);
+      return 1;
+    }
+    if (code == 1) ntrue ++;
+    yices_free_model(mdl);
+  }
+  printf("%"PRIu32" models out of %d satisfy the formulas\n", ntrue, NMODELS);
+
+  yices_free_eval_plan(plan);
+  yices_exit();
+
+  printf("All tests succeeded\n");
+  return 0;
+}
@@ -0,0 +1,235 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Round trip: write terms in binary format then read them back.
+ * Since terms are hash-consed, the reader must return the same terms.
+ */
+
+#include <stdio.h>
+#include <assert.h>
+#include <stdlib.h>
+#include <inttypes.h>
+
+#include "api/yices_globals.h"
+#include "io/binary_terms.h"
+#include "io/term_printer.h"
+#include "yices.h"
+
+
+/*
+ * Uninterpreted terms: they are registered on both sides
+ */
+#define NVARS 8
+
+static term_t var[NVARS];
+
+/*
+ * Terms to test
+ */
+#define MAX_TERMS 40
+
+static term_t test[MAX_TERMS];
+static uint32_t ntests;
+
+/*
+ * The reader creates fresh variables for the terms with bound
+ * variables: for test[nclosed ... ntests-1], we just check that
+ * the term read has the same kind and type.
+ */
+static uint32_t nclosed;
+
+static void add_test(term_t t) {
+  if (t < 0) {
+    fprintf(stderr, "BUG: can't build test term\n");
+    yices_print_error(stderr);
+    exit(1);
+  }
+  assert(ntests < MAX_TERMS);
+  test[ntests] = t;
+  ntests ++;
+}
+
+static void init_terms(void) {
+  type_t bv8, fun;
+  term_t x, y, z, u, v, f, p, q, w;
+  term_t aux[3];
+
+  bv8 = yices_bv_type(8);
+  aux[0] = yices_int_type();
+  aux[1] = bv8;
+  fun = yices_function_type(2, aux, yices_bool_type());
+
+  var[0] = x = yices_new_uninterpreted_term(yices_int_type());
+  var[1] = y = yices_new_uninterpreted_term(yices_int_type());
+  var[2] = z = yices_new_uninterpreted_term(yices_real_type());
+  var[3] = u = yices_new_uninterpreted_term(bv8);
+  var[4] = v = yices_new_uninterpreted_term(bv8);
+  var[5] = f = yices_new_uninterpreted_term(fun);
+  var[6] = p = yices_new_uninterpreted_term(yices_bool_type());
+  var[7] = q = yices_new_uninterpreted_term(yices_bool_type());
+
+  // arithmetic
+  add_test(yices_arith_eq_atom(x, y));
+  add_test(yices_arith_geq_atom(yices_add(x, yices_mul(y, yices_int32(3))), z));
+  add_test(yices_arith_eq0_atom(yices_sub(yices_mul(x, y), yices_rational32(1, 2))));
+  add_test(yices_arith_lt_atom(yices_floor(z), yices_abs(y)));
+  add_test(yices_is_int_atom(z));
+  add_test(yices_arith_eq_atom(yices_idiv(x, yices_int32(7)), yices_imod(y, yices_int32(-5))));
+  add_test(yices_arith_eq_atom(yices_division(z, x), yices_parse_rational("123456789012345678901234567890/7")));
+  add_test(yices_divides_atom(yices_int32(3), x));
+
+  // bitvectors
+  add_test(yices_bveq_atom(yices_bvadd(u, yices_bvmul(v, yices_bvconst_uint32(8, 5))), v));
+  add_test(yices_bvsge_atom(yices_bvshl(u, v), yices_bvashr(v, u)));
+  add_test(yices_bvgt_atom(yices_bvdiv(u, v), yices_bvsmod(u, v)));
+  add_test(yices_bveq_atom(yices_bvand2(u, v), yices_bvnot(yices_bvor2(u, v))));
+  add_test(yices_bveq_atom(yices_bvconcat2(u, v), yices_bvconst_uint64(16, 0xABCD)));
+  add_test(yices_bveq_atom(yices_zero_extend(u, 60), yices_bvconst_uint64(68, 0)));
+  add_test(yices_bitextract(yices_bvsquare(u), 3));
+
+  // booleans, ite, functions, tuples
+  add_test(yices_xor2(p, yices_or2(q, yices_not(p))));
+  add_test(yices_ite(p, yices_arith_gt_atom(x, y), q));
+  add_test(yices_arith_eq_atom(yices_ite(q, x, y), yices_int32(0)));
+  aux[0] = x;
+  aux[1] = u;
+  add_test(yices_application(f, 2, aux));
+  w = yices_update(f, 2, aux, p);
+  aux[0] = y;
+  aux[1] = v;
+  add_test(yices_application(w, 2, aux));
+  aux[0] = x;
+  aux[1] = u;
+  add_test(yices_arith_gt_atom(yices_select(1, yices_tuple(2, aux)), y));
+  add_test(yices_distinct(3, var));
+  add_test(yices_eq(f, w));
+
+  // quantifiers and lambda
+  nclosed = ntests;
+  aux[0] = yices_new_variable(yices_int_type());
+  aux[1] = yices_new_variable(bv8);
+  add_test(yices_forall(2, aux, yices_application(f, 2, aux)));
+  add_test(yices_lambda(2, aux, yices_arith_eq_atom(aux[0], x)));
+}
+
+
+/*
+ * Write all the test terms to f
+ */
+static void write_terms(FILE *f) {
+  bin_writer_t writer;
+  uint32_t i;
+
+  init_bin_writer(&writer, f, __yices_globals.terms);
+  for (i=0; i<NVARS; i++) {
+    bin_writer_register_term(&writer, var[i]);
+  }
+  for (i=0; i<ntests; i++) {
+    if (! bin_write_term_def(&writer, test[i])) {
+      fprintf(stderr, "BUG: failed to write test term %"PRIu32"\n", i);
+      exit(1);
+    }
+    bin_write_byte(&writer, BIN_CLIENT_OP);
+    bin_write_term_ref(&writer, test[i]);
+  }
+  bin_writer_flush(&writer);
+  if (writer.failed) {
+    perror("test_binary_terms");
+    exit(2);
+  }
+  delete_bin_writer(&writer);
+}
+
+
+/*
+ * Read them back and compare
+ */
+static bin_reader_t reader;
+
+static void read_terms(FILE *f) {
+  bin_error_t error;
+  uint32_t i, op;
+  term_t t;
+
+  init_bin_reader(&reader, f, __yices_globals.manager);
+  for (i=0; i<NVARS; i++) {
+    bin_reader_register_term(&reader, var[i]);
+  }
+
+  error = setjmp(reader.env);
+  if (error != BIN_NO_ERROR) {
+    fprintf(stderr, "BUG: reader error %"PRId32"\n", (int32_t) error);
+    exit(1);
+  }
+
+  bin_read_header(&reader);
+  i = 0;
+  while (! bin_reader_eof(&reader)) {
+    op = bin_read_byte(&reader);
+    if (op < BIN_CLIENT_OP) {
+      bin_read_def(&reader, op);
+    } else {
+      t = bin_read_term_ref(&reader);
+      printf("test %"PRIu32": ", i);
+      print_term(stdout, __yices_globals.terms, test[i]);
+      if (t != test[i] &&
+          (i < nclosed ||
+           term_kind(__yices_globals.terms, t) != term_kind(__yices_globals.terms, test[i]) ||
+           term_type(__yices_globals.terms, t) != term_type(__yices_globals.terms, test[i]))) {
+        printf("\nBUG: read ");
+        print_term(stdout, __yices_globals.terms, t);
+        printf("\n");
+        fflush(stdout);
+        exit(1);
+      }
+      printf(": ok\n");
+      i ++;
+    }
+  }
+
+  if (i != ntests) {
+    fprintf(stderr, "BUG: read %"PRIu32" terms, expected %"PRIu32"\n", i, ntests);
+    exit(1);
+  }
+
+  delete_bin_reader(&reader);
+}
+
+
+int main(void) {
+  FILE *f;
+
+  yices_init();
+  init_terms();
+
+  f = tmpfile();
+  if (f == NULL) {
+    perror("tmpfile");
+    exit(2);
+  }
+  write_terms(f);
+  rewind(f);
+  read_terms(f);
+  fclose(f);
+
+  printf("All tests passed\n");
+  yices_exit();
+
+  return 0;
+}
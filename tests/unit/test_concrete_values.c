@@ -202,9 +202,63 @@ static void test_constants(void) {
 }
 
 
+/*
+ * Check that v is the bitvector c of n bits
+ */
+static void check_bv64(value_t v, uint32_t n, uint64_t c) {
+  value_bv_t *d;
+  uint64_t x;
+
+  assert_true(object_is_bitvector(&vtbl, v));
+  d = vtbl_bitvector(&vtbl, v);
+  assert_true(d->nbits == n);
+  x = d->data[0];
+  if (n > 32) {
+    x |= ((uint64_t) d->data[1]) << 32;
+  }
+  assert_true(x == c);
+}
+
+/*
+ * Reset: the small-value cache must not return deleted objects.
+ */
+static void test_reset(void) {
+  value_t v, v1;
+  uint32_t i;
+  int32_t k;
+
+  printf("\n=== Reset ===\n");
+  for (i=0; i<256; i++) {
+    v = vtbl_mk_bv_from_bv64(&vtbl, 40, ((uint64_t) i) << 30);
+    check_bv64(v, 40, ((uint64_t) i) << 30);
+    v1 = vtbl_mk_bv_from_bv64(&vtbl, 40, ((uint64_t) i) << 30);
+    assert_true(v == v1);
+  }
+  for (k=-100; k<=100; k++) {
+    v = vtbl_mk_int32(&vtbl, k);
+    v1 = vtbl_mk_int32(&vtbl, k);
+    assert_true(v == v1);
+  }
+
+  reset_value_table(&vtbl);
+
+  // the cache still refers to deleted indices
+  for (i=0; i<256; i++) {
+    v = vtbl_mk_bv_from_bv64(&vtbl, 40, ((uint64_t) (255 - i)) << 30);
+    check_bv64(v, 40, ((uint64_t) (255 - i)) << 30);
+  }
+  for (k=-100; k<=100; k++) {
+    v = vtbl_mk_int32(&vtbl, k);
+    assert_true(object_is_rational(&vtbl, v) && q_cmp_int32(vtbl_rational(&vtbl, v), k, 1) == 0);
+  }
+  printf("%"PRIu32" objects\n", vtbl.nobjects);
+}
+
+
 int main(void) {
   init_tables();
   test_constants();
+  test_reset();
   delete_tables();
   return 0;
 }
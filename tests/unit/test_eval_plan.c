@@ -0,0 +1,269 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Test of evaluation plans: compare with eval_in_model on random
+ * terms and random models.
+ */
+
+#ifdef NDEBUG
+# undef NDEBUG
+#endif
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <inttypes.h>
+
+#include "api/yices_globals.h"
+#include "model/eval_plan.h"
+#include "model/model_eval.h"
+#include "yices.h"
+
+#ifdef MINGW
+static inline long int random(void) {
+  return rand();
+}
+#endif
+
+
+/*
+ * Variables
+ */
+#define NB 4
+#define NX 3
+#define NI 3
+
+static term_t bvar[NB];
+static term_t xvar[NX];   // bitvectors of 8 bits
+static term_t ivar[NI];   // integers
+static term_t wvar;       // bitvector of 70 bits
+
+static void init_vars(void) {
+  type_t bool_type, bv8_type, int_type, bv70_type;
+  uint32_t i;
+
+  bool_type = yices_bool_type();
+  bv8_type = yices_bv_type(8);
+  int_type = yices_int_type();
+  bv70_type = yices_bv_type(70);
+
+  for (i=0; i<NB; i++) bvar[i] = yices_new_uninterpreted_term(bool_type);
+  for (i=0; i<NX; i++) xvar[i] = yices_new_uninterpreted_term(bv8_type);
+  for (i=0; i<NI; i++) ivar[i] = yices_new_uninterpreted_term(int_type);
+  wvar = yices_new_uninterpreted_term(bv70_type);
+}
+
+
+/*
+ * Random terms of depth at most d
+ */
+static term_t random_bool(uint32_t d);
+static term_t random_bv(uint32_t d);
+static term_t random_int(uint32_t d);
+
+static term_t random_bool(uint32_t d) {
+  term_t a[3];
+
+  if (d == 0) return bvar[random() % NB];
+
+  switch (random() % 14) {
+  case 0: return yices_not(random_bool(d-1));
+  case 1: return yices_or2(random_bool(d-1), random_bool(d-1));
+  case 2: return yices_xor2(random_bool(d-1), random_bool(d-1));
+  case 3: return yices_ite(random_bool(d-1), random_bool(d-1), random_bool(d-1));
+  case 4: return yices_eq(random_bool(d-1), random_bool(d-1));
+  case 5: return yices_arith_geq_atom(random_int(d-1), random_int(d-1));
+  case 6: return yices_arith_eq_atom(random_int(d-1), random_int(d-1));
+  case 7: return yices_arith_eq0_atom(random_int(d-1));
+  case 8: return yices_bveq_atom(random_bv(d-1), random_bv(d-1));
+  case 9: return yices_bvge_atom(random_bv(d-1), random_bv(d-1));
+  case 10: return yices_bvsge_atom(random_bv(d-1), random_bv(d-1));
+  case 11: return yices_bitextract(random_bv(d-1), random() % 8);
+  case 12: return yices_bitextract(yices_bvadd(wvar, yices_zero_extend(random_bv(d-1), 62)), random() % 70);
+  default:
+    a[0] = random_int(d-1);
+    a[1] = random_int(d-1);
+    a[2] = random_int(d-1);
+    return yices_distinct(3, a);
+  }
+}
+
+static term_t random_bv(uint32_t d) {
+  term_t a[8];
+  uint32_t i;
+
+  if (d == 0) {
+    if (random() % 4 == 0) return yices_bvconst_uint64(8, random());
+    return xvar[random() % NX];
+  }
+
+  switch (random() % 14) {
+  case 0: return yices_bvadd(random_bv(d-1), random_bv(d-1));
+  case 1: return yices_bvmul(random_bv(d-1), random_bv(d-1));
+  case 2: return yices_bvpower(random_bv(d-1), 1 + random() % 5);
+  case 3: return yices_bvdiv(random_bv(d-1), random_bv(d-1));
+  case 4: return yices_bvrem(random_bv(d-1), random_bv(d-1));
+  case 5: return yices_bvsdiv(random_bv(d-1), random_bv(d-1));
+  case 6: return yices_bvsrem(random_bv(d-1), random_bv(d-1));
+  case 7: return yices_bvsmod(random_bv(d-1), random_bv(d-1));
+  case 8: return yices_bvshl(random_bv(d-1), random_bv(d-1));
+  case 9: return yices_bvlshr(random_bv(d-1), random_bv(d-1));
+  case 10: return yices_bvashr(random_bv(d-1), random_bv(d-1));
+  case 11: return yices_ite(random_bool(d-1), random_bv(d-1), random_bv(d-1));
+  case 12:
+    for (i=0; i<8; i++) a[i] = random_bool(d-1);
+    return yices_bvarray(8, a);
+  default:
+    return yices_bvsub(yices_bvextract(wvar, 3, 10), random_bv(d-1));
+  }
+}
+
+static term_t random_int(uint32_t d) {
+  if (d == 0) {
+    if (random() % 4 == 0) return yices_int32(((int32_t) (random() % 21)) - 10);
+    return ivar[random() % NI];
+  }
+
+  switch (random() % 9) {
+  case 0: return yices_add(random_int(d-1), random_int(d-1));
+  case 1: return yices_sub(random_int(d-1), yices_mul(yices_int32(3), random_int(d-1)));
+  case 2: return yices_mul(random_int(d-1), random_int(d-1));
+  case 3: return yices_abs(random_int(d-1));
+  case 4: return yices_floor(random_int(d-1));
+  case 5: return yices_ite(random_bool(d-1), random_int(d-1), random_int(d-1));
+  case 6: return yices_idiv(random_int(d-1), random_int(d-1));
+  case 7: return yices_ceil(random_int(d-1));
+  default:
+    return yices_square(random_int(d-1));
+  }
+}
+
+
+/*
+ * Random model
+ * - if partial is true, some variables don't get a value and
+ *   the model has no alias map so the evaluator fails on them
+ */
+static model_t *random_model(bool partial) {
+  model_t *mdl;
+  uint32_t i;
+
+  mdl = yices_new_model();
+  if (partial) {
+    assert(mdl->alias_map == NULL);
+    mdl->has_alias = false;
+  }
+  for (i=0; i<NB; i++) {
+    if (!partial || random() % 8 != 0) yices_model_set_bool(mdl, bvar[i], random() % 2);
+  }
+  for (i=0; i<NX; i++) {
+    if (!partial || random() % 8 != 0) yices_model_set_bv_uint64(mdl, xvar[i], random() % 256);
+  }
+  for (i=0; i<NI; i++) {
+    if (!partial || random() % 8 != 0) yices_model_set_int64(mdl, ivar[i], ((int64_t) (random() % 41)) - 20);
+  }
+  yices_model_set_bv_uint64(mdl, wvar, ((uint64_t) random()) << 20);
+
+  return mdl;
+}
+
+
+/*
+ * Compare the plan with the evaluator in mdl
+ */
+static void check_plan(eval_plan_t *plan, const term_t *a, uint32_t n, model_t *mdl) {
+  evaluator_t eval;
+  int32_t code;
+  uint32_t i;
+  value_t v, w;
+
+  code = eval_plan_run(plan, mdl);
+
+  init_evaluator(&eval, mdl);
+  for (i=0; i<n; i++) {
+    v = eval_in_model(&eval, a[i]);
+    if (v < 0) {
+      assert(plan->code[i] == v);
+      assert(code < 0);
+    } else {
+      assert(plan->code[i] == 0);
+      w = eval_plan_value(plan, i, &mdl->vtbl);
+      if (v != w) {
+        printf("BUG: different values for root %"PRIu32"\n", i);
+        yices_pp_term(stdout, a[i], 120, 20, 0);
+        fflush(stdout);
+        abort();
+      }
+      if (is_boolean_term(__yices_globals.terms, a[i])) {
+        assert(eval_plan_is_true(plan, i) == is_true(&mdl->vtbl, v));
+      }
+    }
+  }
+  delete_evaluator(&eval);
+}
+
+
+#define NROOTS 40
+#define NMODELS 200
+
+static void test_random_plans(uint32_t depth, bool partial) {
+  eval_plan_t plan;
+  term_t a[NROOTS];
+  model_t *mdl;
+  uint32_t i, slow;
+
+  for (i=0; i<NROOTS; i++) {
+    switch (i % 3) {
+    case 0: a[i] = random_bool(depth); break;
+    case 1: a[i] = random_bv(depth); break;
+    default: a[i] = random_int(depth); break;
+    }
+    assert(a[i] >= 0);
+  }
+
+  init_eval_plan(&plan, __yices_globals.terms, a, NROOTS);
+  slow = 0;
+  for (i=0; i<NMODELS; i++) {
+    mdl = random_model(partial);
+    check_plan(&plan, a, NROOTS, mdl);
+    slow += plan.slow;
+    yices_free_model(mdl);
+  }
+  printf("depth %"PRIu32"%s: %"PRIu32" instructions, %"PRIu32" slow runs out of %"PRIu32"\n",
+         depth, partial ? " (partial models)" : "", plan.ninstr, slow, (uint32_t) NMODELS);
+  delete_eval_plan(&plan);
+}
+
+
+int main(void) {
+  uint32_t d;
+
+  yices_init();
+  init_vars();
+
+  for (d=0; d<5; d++) {
+    test_random_plans(d, false);
+    test_random_plans(d, true);
+  }
+
+  yices_exit();
+
+  return 0;
+}
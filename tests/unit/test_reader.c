@@ -18,30 +18,90 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <inttypes.h>
 
 #include "io/reader.h"
 
 static reader_t reader;
+static reader_t stream_reader;
 
-int main(int argc, char *argv[]) {
-  char *filename;
+/*
+ * Check that the file reader and stream reader agree
+ */
+static void check_same(reader_t *r1, reader_t *r2) {
+  if (reader_current_char(r1) != reader_current_char(r2) ||
+      reader_position(r1) != reader_position(r2) ||
+      reader_line(r1) != reader_line(r2) ||
+      reader_column(r1) != reader_column(r2)) {
+    fprintf(stderr, "BUG: readers disagree at pos %"PRIu64" (line %"PRIu32", column %"PRIu32")\n",
+            reader_position(r2), reader_line(r2), reader_column(r2));
+    exit(1);
+  }
+}
+
+/*
+ * Compare the file reader with a stream reader on the same file.
+ * If the file is mapped, also check reader_advance with steps of size
+ * 1, 2, ..., 7.
+ */
+static void test_file(const char *filename) {
+  FILE *f;
+  uint64_t n, k;
   int c;
 
-  if (argc <= 1) {
-    init_stdin_reader(&reader);
-  } else {
-    filename = argv[1];
-    if (init_file_reader(&reader, filename) < 0) {
-      perror(filename);
-      exit(2);
-    }
+  if (init_file_reader(&reader, filename) < 0) {
+    perror(filename);
+    exit(2);
+  }
+  f = fopen(filename, "r");
+  if (f == NULL) {
+    perror(filename);
+    exit(2);
   }
+  init_stream_reader(&stream_reader, f, filename);
+
+  printf("%s: %s\n", filename, reader_in_memory(&reader) ? "mapped" : "not mapped");
 
+  k = 0;
   c = reader_current_char(&reader);
   while (c != EOF) {
+    if (reader_in_memory(&reader)) {
+      k = k % 7 + 1;
+      (void) reader_lookahead(&reader, &n);
+      if (k <= n) {
+        reader_advance(&reader, k);
+        for (n=0; n<k; n++) {
+          reader_next_char(&stream_reader);
+        }
+        check_same(&reader, &stream_reader);
+        c = reader_current_char(&reader);
+        continue;
+      }
+    }
     c = reader_next_char(&reader);
+    reader_next_char(&stream_reader);
+    check_same(&reader, &stream_reader);
   }
 
+  printf("%"PRIu32" lines\n", reader_line(&reader));
+
   close_reader(&reader);
+  close_reader(&stream_reader);
+}
+
+int main(int argc, char *argv[]) {
+  int c;
+
+  if (argc <= 1) {
+    init_stdin_reader(&reader);
+    c = reader_current_char(&reader);
+    while (c != EOF) {
+      c = reader_next_char(&reader);
+    }
+    close_reader(&reader);
+  } else {
+    test_file(argv[1]);
+  }
+
   return 0;
 }
@@ -0,0 +1,165 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Test of the let-introduction in the term printer:
+ * print terms with lots of sharing, parse the result, and check
+ * that we get the same term back.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <inttypes.h>
+
+#include "yices.h"
+
+
+static term_t x, y, p, u, v;
+
+static void init_vars(void) {
+  x = yices_new_uninterpreted_term(yices_int_type());
+  yices_set_term_name(x, "x");
+  y = yices_new_uninterpreted_term(yices_int_type());
+  yices_set_term_name(y, "y");
+  p = yices_new_uninterpreted_term(yices_bool_type());
+  yices_set_term_name(p, "p");
+  u = yices_new_uninterpreted_term(yices_bv_type(12));
+  yices_set_term_name(u, "u");
+  v = yices_new_uninterpreted_term(yices_bv_type(12));
+  yices_set_term_name(v, "v");
+}
+
+
+/*
+ * Print t, parse it back and compare
+ * - n = size of t's DAG, to check that the output is not too large
+ * - if t has quantifiers, parsing creates fresh variables so we
+ *   can't get t back: then we just check that the output parses
+ *   (i.e., no let variable refers to a bound variable).
+ */
+static void test_term(const char *msg, term_t t, uint32_t n, bool closed) {
+  char *s;
+  term_t t2;
+  size_t len;
+
+  if (t < 0) {
+    fprintf(stderr, "BUG: %s: can't build the term\n", msg);
+    yices_print_error(stderr);
+    exit(1);
+  }
+
+  s = yices_term_to_string(t, 120, UINT32_MAX, 0);
+  len = strlen(s);
+  printf("%s: %zu characters\n", msg, len);
+  if (len > 200 * n) {
+    printf("%s\n", s);
+    fprintf(stderr, "BUG: %s: output too large\n", msg);
+    exit(1);
+  }
+
+  t2 = yices_parse_term(s);
+  if (t2 < 0 || (closed && t2 != t)) {
+    printf("%s\n", s);
+    fprintf(stderr, "BUG: %s: parsing the output gives a different term\n", msg);
+    yices_print_error(stderr);
+    exit(1);
+  }
+  yices_free_string(s);
+}
+
+
+/*
+ * Arithmetic: t_{i+1} = (ite (> t_i i) (* t_i x) (- t_i y))
+ */
+static void test_arith(uint32_t n) {
+  term_t t;
+  uint32_t i;
+
+  t = yices_add(x, y);
+  for (i=0; i<n; i++) {
+    t = yices_ite(yices_arith_gt_atom(t, yices_int32(i)), yices_mul(t, x), yices_sub(t, y));
+  }
+  test_term("arith", yices_arith_geq0_atom(t), n, true);
+}
+
+/*
+ * Boolean: b_{i+1} = (and (or b_i p) (xor b_i (> x i)))
+ */
+static void test_bool(uint32_t n) {
+  term_t b;
+  uint32_t i;
+
+  b = yices_arith_gt_atom(x, y);
+  for (i=0; i<n; i++) {
+    b = yices_and2(yices_or2(b, p), yices_xor2(b, yices_arith_gt_atom(x, yices_int32(i))));
+  }
+  test_term("bool", b, n, true);
+}
+
+/*
+ * Bitvectors: w_{i+1} = (bvudiv (bvadd w_i u) (bvshl w_i v))
+ */
+static void test_bv(uint32_t n) {
+  term_t w;
+  uint32_t i;
+
+  w = yices_bvadd(u, v);
+  for (i=0; i<n; i++) {
+    w = yices_bvdiv(yices_bvadd(w, u), yices_bvshl(w, v));
+  }
+  test_term("bv", yices_bveq_atom(w, u), n, true);
+}
+
+/*
+ * Quantifier: the shared terms that contain the bound variable
+ * must not be let-bound. The shared closed terms can be.
+ */
+static void test_forall(uint32_t n) {
+  term_t z, t, c, b;
+  uint32_t i;
+
+  z = yices_new_variable(yices_int_type());
+  yices_set_term_name(z, "z");
+  t = yices_add(x, z);
+  c = yices_add(x, y);
+  for (i=0; i<n; i++) {
+    t = yices_ite(yices_arith_gt_atom(t, yices_int32(i)), yices_add(t, c), yices_sub(t, x));
+    c = yices_ite(yices_arith_gt_atom(c, yices_int32(i)), yices_mul(c, x), yices_sub(c, y));
+  }
+  b = yices_or2(yices_arith_gt_atom(c, x), yices_forall(1, &z, yices_arith_geq0_atom(t)));
+  test_term("forall", b, 1 << n, false);
+}
+
+
+int main(void) {
+  yices_init();
+  init_vars();
+
+  test_arith(5);
+  test_arith(100);
+  test_bool(100);
+  test_bv(100);
+  test_forall(5);
+
+  printf("All tests passed\n");
+  yices_exit();
+
+  return 0;
+}